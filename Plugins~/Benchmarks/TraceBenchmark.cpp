@@ -0,0 +1,1267 @@
+// -------------------------------------------------------------------------------------------- //
+//  Copyright (c) KLab Inc.. All rights reserved.                                               //
+//  Licensed under the MIT License. See 'LICENSE' in the project root for license information.  //
+// -------------------------------------------------------------------------------------------- //
+
+#include <KLab/Profiling/Internal.hpp>
+
+
+// -------- //
+// INCLUDES //
+// -------- //
+
+#include <IUnityInterface.h>
+#include <IUnityProfilerCallbacks.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+namespace
+{
+    using namespace KLab::Profiling;
+
+
+    // Number of Enter/Leave pairs each producer thread emits
+    constexpr uint32_t _pairsPerThread = 200000;
+
+
+    // Section every producer emits
+    const Trace::SectionInfo _section = { "Benchmark", "TraceBenchmark.Section", 0, 0x2d89ef, 0 };
+
+
+    // Copies string the way C# trace does
+    // @param out - Output buffer
+    // @param in - Input string
+    // @param outCapacity - Capacity of output buffer in characters
+    void _copyString(char *out, const char *in, const size_t outCapacity)
+    {
+        out[outCapacity - 1] = '\0';
+
+
+        for (auto end = (out + outCapacity); out < end; ++out, ++in)
+        {
+            *out = *in;
+
+
+            if (!(*in))
+            {
+                break;
+            }
+        }
+    }
+
+
+    // Runs producers in parallel
+    // @param threadCount - Number of producer threads
+    // @param producer - Function run per thread
+    // @return the wall time in nanoseconds
+    template<typename TProducer>
+    double _runProducers(const uint32_t threadCount, TProducer producer)
+    {
+        std::vector<std::thread> threads;
+        std::atomic<bool>        go = { false };
+
+
+        for (uint32_t t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&go, &producer]()
+            {
+                while (!go.load(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+
+
+                producer();
+            });
+        }
+
+
+        const auto begin = std::chrono::steady_clock::now();
+
+
+        go.store(true, std::memory_order_release);
+
+
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+
+        return double(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+    }
+
+
+    // Measures shared atomic buffer (baseline)
+    // @param threadCount - Number of producer threads
+    // @return the cost per event in nanoseconds
+    double _measureSharedBuffer(const uint32_t threadCount)
+    {
+        const uint32_t                              capacity = (threadCount * _pairsPerThread * 2);
+        std::vector<KLab_Profiling_Trace_EventInfo> storage(capacity);
+        AtomicBuffer<KLab_Profiling_Trace_EventInfo> buffer;
+        Stopwatch                                   timer;
+
+
+        buffer.Initialize(storage.data(), capacity);
+        timer.Reset();
+
+
+        const double wallNs = _runProducers(threadCount, [&buffer, &timer]()
+        {
+            for (uint32_t i = 0; i < (_pairsPerThread * 2); ++i)
+            {
+                auto event = buffer.Allocate();
+
+
+                // Mirror work done by C# trace per event
+                if (event)
+                {
+                    event->Type        = (i & 1);
+                    event->TimestampNs = timer.GetTicks();
+                    event->ThreadID    = _section.ThreadID;
+                    event->Color       = _section.Color;
+
+                    _copyString(event->GroupName, _section.GroupName, sizeof(event->GroupName));
+                    _copyString(event->Name,      _section.Name,      sizeof(event->Name));
+                }
+            }
+        });
+
+
+        return (wallNs / (double(threadCount) * _pairsPerThread * 2));
+    }
+
+
+    // Measures C# trace per-thread chunks
+    // @param threadCount - Number of producer threads
+    // @return the cost per event in nanoseconds
+    double _measureCSharpTrace(const uint32_t threadCount)
+    {
+        const uint32_t                              capacity = (threadCount * _pairsPerThread * 2);
+        std::vector<KLab_Profiling_Trace_EventInfo> storage(capacity);
+        KLab_Profiling_Trace_TraceInfo              info;
+        auto                                       &trace = Trace::GetCSharpTrace();
+        const uint32_t                              marker = Trace::GetMarkerTable().Intern({ _section.Name, _section.GroupName, _section.Color, 0 });
+
+
+        KLab_Profiling_TraceUtility_BeginTrace(storage.data(), int32_t(capacity));
+
+
+        const double wallNs = _runProducers(threadCount, [&trace, marker]()
+        {
+            auto &thread = Trace::GetThreadContext();
+
+
+            for (uint32_t i = 0; i < _pairsPerThread; ++i)
+            {
+                trace.EnterSection(thread, marker);
+                trace.LeaveSection(thread, marker);
+            }
+        });
+
+
+        KLab_Profiling_TraceUtility_EndTrace(&info);
+
+
+        if (info.DidRunOutOfEventMemory)
+        {
+            std::fprintf(stderr, "[WARNING] Event buffer ran full with %u threads\n", threadCount);
+        }
+
+
+        return (wallNs / (double(threadCount) * _pairsPerThread * 2));
+    }
+
+
+    // Measures per-call cost of clock
+    // @param clock - Function reading clock
+    // @return the cost per call in nanoseconds
+    template<typename TClock>
+    double _measureClock(TClock clock)
+    {
+        constexpr uint32_t callCount = 10000000;
+        volatile uint64_t  sink      = 0;
+
+
+        const auto begin = std::chrono::steady_clock::now();
+
+
+        for (uint32_t c = 0; c < callCount; ++c)
+        {
+            sink = sink + clock();
+        }
+
+
+        return (double(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count()) / callCount);
+    }
+
+
+    // Measures resolving UTF-16 sample name
+    // @param name - Null-terminated UTF-16 name
+    // @param isCached - Whether to resolve through marker table cache instead of converting and interning
+    // @return the cost per name in nanoseconds
+    double _measureUtf16Name(const char16_t *name, const bool isCached)
+    {
+        constexpr uint32_t callCount = 1000000;
+        size_t             length    = 0;
+        char               utf8[sizeof(Utils::Utf8Buffer::CString)];
+        volatile size_t    sink      = 0;
+        auto              &markers   = Trace::GetMarkerTable();
+        Trace::MarkerInfo  base      = { _section.Name, _section.GroupName, _section.Color, 0 };
+
+
+        while (name[length])
+        {
+            ++length;
+        }
+
+
+        const auto begin = std::chrono::steady_clock::now();
+
+
+        for (uint32_t c = 0; c < callCount; ++c)
+        {
+            if (isCached)
+            {
+                sink = sink + markers.InternUtf16(name, length, base);
+            }
+            else
+            {
+                Utils::ConvertUtf16ToUtf8(utf8, sizeof(utf8), name, length);
+
+                sink = sink + markers.InternDynamic(utf8, base);
+            }
+        }
+
+
+        return (double(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count()) / callCount);
+    }
+
+
+    // Unity host mock reporting benchmark markers and capturing plugin callbacks
+    struct _MockHost final
+    {
+        // Registered marker event callback
+        struct Registration final
+        {
+            // Callback
+            IUnityProfilerMarkerEventCallback Handler;
+            // User data
+            void *UserData;
+        };
+
+
+        // Interfaces
+        IUnityInterfaces Interfaces;
+        // Profiler callbacks
+        IUnityProfilerCallbacks Callbacks;
+        // Marker descriptor events get dispatched for
+        UnityProfilerMarkerDesc Marker;
+        // Registered marker creation callback
+        IUnityProfilerCreateMarkerCallback CreateMarker;
+        // Registered marker creation user data
+        void *CreateMarkerUserData;
+        // Registered marker event callbacks by descriptor
+        std::unordered_map<const UnityProfilerMarkerDesc *, Registration> Registrations;
+    };
+
+    _MockHost _host = {};
+
+
+    // Mocks Unity interface lookup
+    IUnityInterface *UNITY_INTERFACE_API _getInterface(UnityInterfaceGUID)
+    {
+        return &_host.Callbacks;
+    }
+
+    // Mocks (un)registering category callback
+    int UNITY_INTERFACE_API _ignoreCategoryCallback(IUnityProfilerCreateCategoryCallback, void *)
+    {
+        return 0;
+    }
+
+    // Mocks (un)registering thread callback
+    int UNITY_INTERFACE_API _ignoreThreadCallback(IUnityProfilerCreateThreadCallback, void *)
+    {
+        return 0;
+    }
+
+    // Mocks (un)registering frame callback (never firing to flip through update instead)
+    int UNITY_INTERFACE_API _ignoreFrameCallback(IUnityProfilerFrameCallback, void *)
+    {
+        return 0;
+    }
+
+    // Mocks registering marker creation callback (reporting existing marker)
+    int UNITY_INTERFACE_API _registerCreateMarkerCallback(IUnityProfilerCreateMarkerCallback callback, void *userData)
+    {
+        _host.CreateMarker         = callback;
+        _host.CreateMarkerUserData = userData;
+
+
+        callback(&_host.Marker, userData);
+
+
+        return 0;
+    }
+
+    // Mocks unregistering marker creation callback
+    int UNITY_INTERFACE_API _unregisterCreateMarkerCallback(IUnityProfilerCreateMarkerCallback, void *)
+    {
+        _host.CreateMarker         = nullptr;
+        _host.CreateMarkerUserData = nullptr;
+
+
+        return 0;
+    }
+
+    // Mocks registering marker event callback
+    int UNITY_INTERFACE_API _registerMarkerEventCallback(const UnityProfilerMarkerDesc *descriptor, IUnityProfilerMarkerEventCallback callback, void *userData)
+    {
+        _host.Registrations[descriptor] = { callback, userData };
+
+
+        return 0;
+    }
+
+    // Mocks unregistering marker event callback
+    int UNITY_INTERFACE_API _unregisterMarkerEventCallback(const UnityProfilerMarkerDesc *descriptor, IUnityProfilerMarkerEventCallback, void *)
+    {
+        _host.Registrations.erase(descriptor);
+
+
+        return 0;
+    }
+
+
+    // Loads plugin into mock host
+    void _loadMockHost()
+    {
+        _host.Interfaces.GetInterface                    = _getInterface;
+        _host.Callbacks.RegisterCreateCategoryCallback   = _ignoreCategoryCallback;
+        _host.Callbacks.UnregisterCreateCategoryCallback = _ignoreCategoryCallback;
+        _host.Callbacks.RegisterCreateThreadCallback     = _ignoreThreadCallback;
+        _host.Callbacks.UnregisterCreateThreadCallback   = _ignoreThreadCallback;
+        _host.Callbacks.RegisterCreateMarkerCallback     = _registerCreateMarkerCallback;
+        _host.Callbacks.UnregisterCreateMarkerCallback   = _unregisterCreateMarkerCallback;
+        _host.Callbacks.RegisterMarkerEventCallback      = _registerMarkerEventCallback;
+        _host.Callbacks.UnregisterMarkerEventCallback    = _unregisterMarkerEventCallback;
+        _host.Callbacks.RegisterFrameCallback            = _ignoreFrameCallback;
+        _host.Callbacks.UnregisterFrameCallback          = _ignoreFrameCallback;
+        _host.Marker.categoryId                          = 0;
+        _host.Marker.name                                = _section.Name;
+
+
+        UnityPluginLoad(&_host.Interfaces);
+    }
+
+
+    // Stand-in extern trace (counting sections to keep calls observable)
+    struct _BenchmarkExternTrace final : Trace::IExternTrace
+    {
+        // Flag whether tracing
+        std::atomic<bool> IsEnabled = { false };
+
+        bool IsTracing() override
+        {
+            return IsEnabled.load(std::memory_order_relaxed);
+        }
+
+        void EnterSection(const Trace::SectionInfo &) override
+        {
+            ++_sectionCount;
+        }
+
+        void LeaveSection(const Trace::SectionInfo &) override
+        {
+            --_sectionCount;
+        }
+
+        // Open section count of calling thread
+        static thread_local uint64_t _sectionCount;
+    };
+
+    thread_local uint64_t _BenchmarkExternTrace::_sectionCount = 0;
+
+    _BenchmarkExternTrace _externTrace;
+
+
+    // Extern trace never tracing (checked per event by generic dispatch)
+    struct _IdleExternTrace final : Trace::IExternTrace
+    {
+        bool IsTracing() override { return false; }
+        void EnterSection(const Trace::SectionInfo &) override {}
+        void LeaveSection(const Trace::SectionInfo &) override {}
+    };
+
+
+    // Android native trace check never tracing (checked per event by generic dispatch)
+    bool _isATraceIdle()
+    {
+        return false;
+    }
+
+
+    // Sink set dispatch gets measured for
+    struct _SinkSet final
+    {
+        // Name
+        const char *Name;
+        // Sinks as ::Plugin::Sink flags
+        uint32_t Sinks;
+    };
+
+
+    // Enables sinks
+    // @param sinks - Sinks as ::Plugin::Sink flags
+    // @param capacity - Event capacity of C# buffer
+    // @param storage - C# buffer
+    void _beginSinks(const uint32_t sinks, const uint32_t capacity, std::vector<KLab_Profiling_Trace_EventRecord> &storage)
+    {
+        if (sinks & Plugin::Sink_CSharp)
+        {
+            storage.resize(capacity);
+
+
+            KLab_Profiling_TraceUtility_BeginCompactTrace(storage.data(), int32_t(capacity));
+        }
+        if (sinks & Plugin::Sink_Stats)
+        {
+            KLab_Profiling_TraceUtility_BeginStatsTrace();
+        }
+        if (sinks & (Plugin::Sink_Extern | Plugin::Sink_AsyncExtern))
+        {
+            _externTrace.IsEnabled = true;
+        }
+        if (sinks & Plugin::Sink_AsyncExtern)
+        {
+            KLab_Profiling_TraceUtility_BeginAsyncExternTrace(KLab_Profiling_Trace_BackpressurePolicy_Drop, 0);
+        }
+        if (sinks & Plugin::Sink_Histogram)
+        {
+            int32_t histogramID;
+
+
+            KLab_Profiling_TraceUtility_AddHistogramMarker(_section.Name, &histogramID);
+            KLab_Profiling_TraceUtility_BeginHistogramTrace();
+        }
+        if (sinks & Plugin::Sink_Alloc)
+        {
+            KLab_Profiling_TraceUtility_BeginAllocationTrace();
+        }
+        if (sinks & Plugin::Sink_CallTree)
+        {
+            KLab_Profiling_TraceUtility_BeginCallTreeTrace();
+        }
+        if (sinks & Plugin::Sink_LiveFeed)
+        {
+            KLab_Profiling_TraceUtility_BeginLiveFeed("/klab-profiling-benchmark", 64, 65536);
+        }
+
+
+        // Swap to dispatch of sinks (picking up extern trace)
+        KLab_Profiling_Plugin_Update();
+    }
+
+
+    // Disables sinks
+    // @param sinks - Sinks as ::Plugin::Sink flags
+    void _endSinks(const uint32_t sinks)
+    {
+        KLab_Profiling_Trace_TraceInfo info;
+
+
+        if (sinks & Plugin::Sink_CSharp)
+        {
+            KLab_Profiling_TraceUtility_EndTrace(&info);
+
+
+            if (info.DidRunOutOfEventMemory)
+            {
+                std::fprintf(stderr, "[WARNING] Event buffer ran full\n");
+            }
+        }
+        if (sinks & Plugin::Sink_Stats)
+        {
+            KLab_Profiling_TraceUtility_EndStatsTrace();
+        }
+        if (sinks & Plugin::Sink_AsyncExtern)
+        {
+            KLab_Profiling_TraceUtility_EndAsyncExternTrace();
+        }
+        if (sinks & (Plugin::Sink_Extern | Plugin::Sink_AsyncExtern))
+        {
+            _externTrace.IsEnabled = false;
+        }
+        if (sinks & Plugin::Sink_Histogram)
+        {
+            KLab_Profiling_TraceUtility_EndHistogramTrace();
+        }
+        if (sinks & Plugin::Sink_Alloc)
+        {
+            KLab_Profiling_TraceUtility_EndAllocationTrace();
+        }
+        if (sinks & Plugin::Sink_CallTree)
+        {
+            KLab_Profiling_TraceUtility_EndCallTreeTrace();
+        }
+        if (sinks & Plugin::Sink_LiveFeed)
+        {
+            KLab_Profiling_TraceUtility_EndLiveFeed();
+        }
+
+
+        // Swap back to no dispatch
+        KLab_Profiling_Plugin_Update();
+    }
+
+
+    // Measures dispatching marker events through plugin registered callback
+    // @param sinks - Sinks to enable as ::Plugin::Sink flags
+    // @param threadCount - Number of producer threads
+    // @return the cost per event in nanoseconds
+    double _measureDispatch(const uint32_t sinks, const uint32_t threadCount)
+    {
+        std::vector<KLab_Profiling_Trace_EventRecord> storage;
+
+
+        _beginSinks(sinks, (threadCount * _pairsPerThread * 2), storage);
+
+
+        const auto registration = _host.Registrations[&_host.Marker];
+
+
+        const double wallNs = _runProducers(threadCount, [&registration]()
+        {
+            for (uint32_t i = 0; i < (_pairsPerThread * 2); ++i)
+            {
+                registration.Handler(&_host.Marker, uint16_t(i & 1), 0, nullptr, registration.UserData);
+            }
+        });
+
+
+        _endSinks(sinks);
+
+
+        return (wallNs / (double(threadCount) * _pairsPerThread * 2));
+    }
+
+
+    // Measures dispatching marker events checking enablement of all sinks per event the way generic dispatch does
+    // @param sinks - Sinks to enable as ::Plugin::Sink flags
+    // @return the cost per event in nanoseconds
+    double _measureCheckedDispatch(const uint32_t sinks)
+    {
+        std::vector<KLab_Profiling_Trace_EventRecord> storage;
+        _IdleExternTrace                              externTrace;
+        auto                                         &csharp   = Trace::GetCSharpTrace();
+        auto                                         &stats    = Trace::GetStatsTrace();
+
+        // Opaque to optimizer like real sink interfaces
+        Trace::IExternTrace *volatile idleExtern   = &externTrace;
+        bool              (*volatile idleATrace)() = _isATraceIdle;
+
+
+        _beginSinks(sinks, (_pairsPerThread * 2), storage);
+
+
+        const auto registration = _host.Registrations[&_host.Marker];
+        uint32_t   checks       = 0;
+
+
+        const auto begin = std::chrono::steady_clock::now();
+
+
+        for (uint32_t i = 0; i < (_pairsPerThread * 2); ++i)
+        {
+            checks += (idleATrace() + csharp.IsTracing() + stats.IsTracing() + idleExtern->IsTracing());
+
+
+            registration.Handler(&_host.Marker, uint16_t(i & 1), 0, nullptr, registration.UserData);
+        }
+
+
+        const double wallNs = double(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+
+
+        _endSinks(sinks);
+
+
+        if (checks == ~0u)
+        {
+            std::fprintf(stderr, "[WARNING] Unexpected check result\n");
+        }
+
+
+        return (wallNs / (_pairsPerThread * 2));
+    }
+
+
+    // Measures reporting marker creation to plugin
+    // @param descriptors - Descriptors to report
+    // @return the cost per marker in nanoseconds
+    double _measureCreateMarker(const std::vector<UnityProfilerMarkerDesc> &descriptors)
+    {
+        std::vector<KLab_Profiling_Trace_EventRecord> storage;
+
+
+        // Enable sink to get creation callback registered
+        _beginSinks(Plugin::Sink_Stats, 0, storage);
+
+
+        const auto createMarker = _host.CreateMarker;
+        const auto userData     = _host.CreateMarkerUserData;
+
+
+        const auto begin = std::chrono::steady_clock::now();
+
+
+        for (const auto &descriptor : descriptors)
+        {
+            createMarker(&descriptor, userData);
+        }
+
+
+        const double wallNs = double(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+
+
+        _endSinks(Plugin::Sink_Stats);
+
+
+        return (wallNs / double(descriptors.size()));
+    }
+
+
+    // Frames of recorded trace (event records by frame)
+    typedef std::vector<std::vector<KLab_Profiling_Trace_EventRecord>> _RecordedFrames;
+
+
+    // Loads frames of streamed trace file
+    // @param path - Path of trace file
+    // @param frames - Frames
+    // @return true on success; false otherwise
+    bool _loadRecordedFrames(const char *path, _RecordedFrames &frames)
+    {
+        auto file = std::fopen(path, "rb");
+
+
+        if (!file)
+        {
+            return false;
+        }
+
+
+        Trace::StreamFormat::FileHeader  fileHeader;
+        Trace::StreamFormat::BlockHeader blockHeader;
+        Trace::StreamDecoder             decoder;
+        std::vector<char>                payload;
+        KLab_Profiling_Trace_FrameInfo   frame;
+        bool                             isValid = ((std::fread(&fileHeader, sizeof(fileHeader), 1, file) == 1) && (fileHeader.Magic == Trace::StreamFormat::Magic));
+
+
+        while (isValid && (std::fread(&blockHeader, sizeof(blockHeader), 1, file) == 1))
+        {
+            payload.resize(blockHeader.Size);
+
+
+            if ((std::fread(payload.data(), 1, payload.size(), file) != payload.size()))
+            {
+                isValid = false;
+            }
+            else if (((blockHeader.Type == Trace::StreamFormat::BlockType_Frame) || (blockHeader.Type == Trace::StreamFormat::BlockType_EncodedFrame)) && (blockHeader.Size >= sizeof(frame)))
+            {
+                std::memcpy(&frame, payload.data(), sizeof(frame));
+                frames.emplace_back();
+
+
+                if (blockHeader.Type == Trace::StreamFormat::BlockType_EncodedFrame)
+                {
+                    isValid = decoder.Decode((payload.data() + sizeof(frame)), (payload.size() - sizeof(frame)), frame.EventCount, frames.back());
+                }
+                else
+                {
+                    frames.back().resize(std::min<size_t>(frame.EventCount, ((payload.size() - sizeof(frame)) / sizeof(KLab_Profiling_Trace_EventRecord))));
+
+
+                    if (!frames.back().empty())
+                    {
+                        std::memcpy(frames.back().data(), (payload.data() + sizeof(frame)), (frames.back().size() * sizeof(KLab_Profiling_Trace_EventRecord)));
+                    }
+                }
+            }
+        }
+
+
+        std::fclose(file);
+
+
+        return (isValid && !frames.empty());
+    }
+
+
+    // Records synthetic trace (replaying fixed call structure per thread with jittered durations, drained chunk by chunk like continuous trace)
+    // @param frames - Frames
+    void _recordSyntheticFrames(_RecordedFrames &frames)
+    {
+        constexpr uint32_t frameCount    = 120;
+        constexpr uint32_t threadCount   = 8;
+        constexpr uint32_t markerCount   = 512;
+        constexpr uint32_t chunkCapacity = Trace::CSharpTrace::EventChunk::Capacity;
+        constexpr uint32_t maxDepth      = 8;
+
+        std::vector<std::vector<KLab_Profiling_Trace_EventRecord>> scripts(threadCount);
+        std::vector<KLab_Profiling_Trace_EventRecord>              threadRecords;
+        uint32_t                                                   seed      = 0x2545f491;
+        uint64_t                                                   timestamp = 0;
+
+
+        // Deterministic generator (keeping runs comparable)
+        auto next = [&seed](const uint32_t range)
+        {
+            seed = ((seed * 1664525u) + 1013904223u);
+
+
+            return ((seed >> 8) % range);
+        };
+
+
+        // Generate call structure of threads (main thread running more and wider sections than workers)
+        for (uint16_t t = 0; t < threadCount; ++t)
+        {
+            uint32_t stack[maxDepth];
+            uint32_t depth = 0;
+
+
+            for (uint32_t e = 0, eventCount = (t ? 400 : 1600); (e < eventCount) || depth; ++e)
+            {
+                if (depth && ((depth == maxDepth) || (e >= eventCount) || next(2)))
+                {
+                    scripts[t].push_back({ stack[--depth], t, KLab_Profiling_Trace_EventType_LeaveSection, 0 });
+                }
+                else
+                {
+                    // Favor few hot markers per thread
+                    stack[depth] = (next(4) ? ((t * 16) + next(16)) : next(markerCount));
+
+                    scripts[t].push_back({ stack[depth++], t, KLab_Profiling_Trace_EventType_EnterSection, 0 });
+                }
+            }
+        }
+
+
+        // Replay structure every frame
+        frames.resize(frameCount);
+
+
+        for (auto &frame : frames)
+        {
+            for (uint16_t t = 0; t < threadCount; ++t)
+            {
+                uint64_t threadTimestamp = timestamp;
+
+
+                threadRecords = scripts[t];
+
+
+                for (auto &record : threadRecords)
+                {
+                    threadTimestamp += (50 + next(t ? 4000 : 1500));
+
+                    record.TimestampNs = threadTimestamp;
+                }
+
+
+                // Interleave chunks of threads
+                for (size_t c = 0; c < threadRecords.size(); c += chunkCapacity)
+                {
+                    const size_t chunkEnd = std::min<size_t>((c + chunkCapacity), threadRecords.size());
+
+
+                    frame.insert(frame.begin() + std::min<size_t>(frame.size(), (size_t(next(8)) * chunkCapacity)), (threadRecords.begin() + c), (threadRecords.begin() + chunkEnd));
+                }
+            }
+
+
+            timestamp += 16666666;
+        }
+    }
+
+
+    // Measured codec performance
+    struct _CodecResult final
+    {
+        // Encode cost per event in nanoseconds
+        double EncodeNsPerEvent;
+        // Decode cost per event in nanoseconds
+        double DecodeNsPerEvent;
+        // Ratio of raw to encoded size
+        double Ratio;
+    };
+
+
+    // Measures encoding and decoding frames
+    // @param frames - Frames
+    // @param compression - Compression
+    // @return the measurement
+    _CodecResult _measureCodec(const _RecordedFrames &frames, const KLab_Profiling_Trace_StreamCompression compression)
+    {
+        Trace::StreamEncoder                          encoder;
+        Trace::StreamDecoder                          decoder;
+        std::vector<std::string>                      encoded(frames.size());
+        std::vector<KLab_Profiling_Trace_EventRecord> decoded;
+        size_t                                        eventCount  = 0;
+        size_t                                        encodedSize = 0;
+
+
+        for (const auto &frame : frames)
+        {
+            eventCount += frame.size();
+        }
+
+
+        // Repeat to measure at least about 2M events
+        const uint32_t passCount = uint32_t(std::max<size_t>(1, ((2000000 + eventCount - 1) / std::max<size_t>(1, eventCount))));
+
+
+        auto begin = std::chrono::steady_clock::now();
+
+
+        for (uint32_t p = 0; p < passCount; ++p)
+        {
+            encoder.Reset();
+
+
+            for (size_t f = 0; f < frames.size(); ++f)
+            {
+                encoder.Encode(frames[f].data(), uint32_t(frames[f].size()), compression, encoded[f]);
+            }
+        }
+
+
+        const double encodeNs = double(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+
+
+        begin = std::chrono::steady_clock::now();
+
+
+        for (uint32_t p = 0; p < passCount; ++p)
+        {
+            decoder.Reset();
+
+
+            for (size_t f = 0; f < frames.size(); ++f)
+            {
+                if (!decoder.Decode(encoded[f].data(), encoded[f].size(), uint32_t(frames[f].size()), decoded) || (decoded.size() != frames[f].size()))
+                {
+                    std::fprintf(stderr, "[WARNING] Failed to decode frame %u\n", uint32_t(f));
+                }
+            }
+        }
+
+
+        const double decodeNs = double(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+
+
+        for (const auto &frame : encoded)
+        {
+            encodedSize += frame.size();
+        }
+
+
+        const double events = (double(eventCount) * passCount);
+
+
+        return { (encodeNs / events), (decodeNs / events), (double(eventCount * sizeof(KLab_Profiling_Trace_EventRecord)) / double(std::max<size_t>(1, encodedSize))) };
+    }
+
+
+    // Single measurement
+    struct _Result final
+    {
+        // Initializes result (leaving throughput and ratio unmeasured unless given)
+        // @param group - Group of measurement
+        // @param caseName - Case within group
+        // @param threadCount - Number of threads measured with
+        // @param nsPerEvent - Cost per event in nanoseconds
+        // @param megabytesPerSecond - [Optional] Throughput in megabytes per second
+        // @param ratio - [Optional] Ratio of raw to compressed size
+        _Result(const char *group, std::string caseName, const uint32_t threadCount, const double nsPerEvent, const double megabytesPerSecond = 0.0, const double ratio = 0.0)
+            : Group(group), Case(std::move(caseName)), ThreadCount(threadCount), NsPerEvent(nsPerEvent), MegabytesPerSecond(megabytesPerSecond), Ratio(ratio)
+        {
+        }
+
+
+        // Group of measurement (e.g. 'dispatch')
+        const char *Group;
+        // Case within group (e.g. sink set)
+        std::string Case;
+        // Number of threads measured with
+        uint32_t ThreadCount;
+        // Cost per event (or call) in nanoseconds amortized over all threads
+        double NsPerEvent;
+        // Throughput in megabytes of raw event records per second (0 if not measured)
+        double MegabytesPerSecond;
+        // Ratio of raw to compressed size (0 if not measured)
+        double Ratio;
+    };
+
+
+    // Output format
+    enum class _Format
+    {
+        // Human-readable table
+        Table,
+        // JSON document
+        Json,
+        // Comma-separated values with header
+        Csv
+    };
+
+
+    // Writes string as JSON string literal
+    // @param file - File to write to
+    // @param value - String
+    void _writeJsonString(std::FILE *file, const char *value)
+    {
+        std::fputc('"', file);
+
+
+        for (; *value; ++value)
+        {
+            if ((*value == '"') || (*value == '\\'))
+            {
+                std::fputc('\\', file);
+            }
+
+
+            if (static_cast<unsigned char>(*value) >= 0x20)
+            {
+                std::fputc(*value, file);
+            }
+        }
+
+
+        std::fputc('"', file);
+    }
+
+
+    // Writes results
+    // @param file - File to write to
+    // @param format - Output format
+    // @param label - Label of run (e.g. version measured)
+    // @param results - Results
+    void _writeResults(std::FILE *file, const _Format format, const char *label, const std::vector<_Result> &results)
+    {
+        switch (format)
+        {
+            case _Format::Json:
+            {
+                std::fprintf(file, "{\n  \"label\": ");
+                _writeJsonString(file, label);
+                std::fprintf(file, ",\n  \"clock\": \"%s\",\n  \"hardwareThreads\": %u,\n  \"results\": [", (Clock::IsCounterReliable() ? "counter" : "steady"), std::thread::hardware_concurrency());
+
+
+                for (size_t r = 0; r < results.size(); ++r)
+                {
+                    std::fprintf(file, "%s\n    { \"group\": \"%s\", \"case\": ", (r ? "," : ""), results[r].Group);
+                    _writeJsonString(file, results[r].Case.c_str());
+                    std::fprintf(file, ", \"threads\": %u, \"nsPerEvent\": %.3f, \"eventsPerSecond\": %.0f", results[r].ThreadCount, results[r].NsPerEvent, (1e9 / results[r].NsPerEvent));
+
+
+                    if (results[r].Ratio > 0)
+                    {
+                        std::fprintf(file, ", \"megabytesPerSecond\": %.1f, \"ratio\": %.3f", results[r].MegabytesPerSecond, results[r].Ratio);
+                    }
+
+
+                    std::fprintf(file, " }");
+                }
+
+
+                std::fprintf(file, "\n  ]\n}\n");
+            }
+            break;
+
+
+            case _Format::Csv:
+            {
+                std::fprintf(file, "label,group,case,threads,nsPerEvent,eventsPerSecond,megabytesPerSecond,ratio\n");
+
+
+                for (const auto &result : results)
+                {
+                    std::fprintf(file, "%s,%s,%s,%u,%.3f,%.0f,", label, result.Group, result.Case.c_str(), result.ThreadCount, result.NsPerEvent, (1e9 / result.NsPerEvent));
+
+
+                    if (result.Ratio > 0)
+                    {
+                        std::fprintf(file, "%.1f,%.3f\n", result.MegabytesPerSecond, result.Ratio);
+                    }
+                    else
+                    {
+                        std::fprintf(file, ",\n");
+                    }
+                }
+            }
+            break;
+
+
+            default:
+            {
+                const char *group = "";
+
+
+                for (const auto &result : results)
+                {
+                    if (std::strcmp(group, result.Group))
+                    {
+                        group = result.Group;
+
+
+                        std::fprintf(file, "\n%-32s %-8s %-14s %-14s%s\n", group, "Threads", "[ns/event]", "[events/s]", ((result.Ratio > 0) ? " [MB/s]         [ratio]" : ""));
+                    }
+
+
+                    std::fprintf(file, "%-32s %-8u %-14.2f %-14.0f", result.Case.c_str(), result.ThreadCount, result.NsPerEvent, (1e9 / result.NsPerEvent));
+
+
+                    if (result.Ratio > 0)
+                    {
+                        std::fprintf(file, " %-14.1f %-14.2f", result.MegabytesPerSecond, result.Ratio);
+                    }
+
+
+                    std::fprintf(file, "\n");
+                }
+            }
+            break;
+        }
+    }
+}
+
+
+// ------------ //
+// EXTERN TRACE //
+// ------------ //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    IExternTrace &LoadExternTrace()
+    {
+        return _externTrace;
+    }
+}}}
+
+
+// ---- //
+// MAIN //
+// ---- //
+
+int main(int argc, char **argv)
+{
+    auto        format     = _Format::Table;
+    const char *outputPath = nullptr;
+    const char *label      = "";
+    const char *tracePath  = nullptr;
+
+
+    // Parse arguments
+    for (int a = 1; a < argc; ++a)
+    {
+        if (!std::strcmp(argv[a], "--json"))
+        {
+            format = _Format::Json;
+        }
+        else if (!std::strcmp(argv[a], "--csv"))
+        {
+            format = _Format::Csv;
+        }
+        else if (!std::strcmp(argv[a], "--output") && ((a + 1) < argc))
+        {
+            outputPath = argv[++a];
+        }
+        else if (!std::strcmp(argv[a], "--label") && ((a + 1) < argc))
+        {
+            label = argv[++a];
+        }
+        else if (!std::strcmp(argv[a], "--trace") && ((a + 1) < argc))
+        {
+            tracePath = argv[++a];
+        }
+        else
+        {
+            std::fprintf(stderr, "Usage: %s [--json|--csv] [--output <path>] [--label <label>] [--trace <recorded.klpt>]\n", argv[0]);
+
+
+            return 1;
+        }
+    }
+
+
+    const uint32_t       maxThreadCount = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<_Result> results;
+
+
+    // Capture
+    for (uint32_t threadCount = 1; threadCount <= maxThreadCount; threadCount *= 2)
+    {
+        results.push_back({ "capture", "Shared buffer", threadCount, _measureSharedBuffer(threadCount) });
+        results.push_back({ "capture", "Per-thread chunks", threadCount, _measureCSharpTrace(threadCount) });
+    }
+
+
+    // Clock
+    results.push_back({ "clock", (Clock::IsCounterReliable() ? "Clock (cycle counter)" : "Clock (steady fallback)"), 1, _measureClock([]() { return Clock::GetTicks(); }) });
+    results.push_back({ "clock", "steady_clock", 1, _measureClock([]() { return uint64_t(std::chrono::steady_clock::now().time_since_epoch().count()); }) });
+    results.push_back({ "clock", "high_resolution_clock", 1, _measureClock([]() { return uint64_t(std::chrono::high_resolution_clock::now().time_since_epoch().count()); }) });
+
+
+    // UTF-16 names
+    const char16_t *asciiName = u"PlayerController.UpdateMovementAndAnimation";
+    const char16_t *mixedName = u"\u30D7\u30EC\u30A4\u30E4\u30FC.Update \U0001F3AE Movement";
+
+
+    results.push_back({ "utf16-name", "ASCII (43 characters) convert + intern", 1, _measureUtf16Name(asciiName, false) });
+    results.push_back({ "utf16-name", "ASCII (43 characters) cached", 1, _measureUtf16Name(asciiName, true) });
+    results.push_back({ "utf16-name", "Mixed (24 characters) convert + intern", 1, _measureUtf16Name(mixedName, false) });
+    results.push_back({ "utf16-name", "Mixed (24 characters) cached", 1, _measureUtf16Name(mixedName, true) });
+
+
+    _loadMockHost();
+
+
+    // Marker creation (first report interns marker, later reports hit descriptor cache)
+    std::vector<std::string>             markerNames(2048);
+    std::vector<UnityProfilerMarkerDesc> markerDescriptors(markerNames.size());
+
+
+    for (size_t m = 0; m < markerNames.size(); ++m)
+    {
+        markerNames[m] = ("TraceBenchmark.Marker." + std::to_string(m));
+
+        markerDescriptors[m]            = UnityProfilerMarkerDesc();
+        markerDescriptors[m].categoryId = 0;
+        markerDescriptors[m].name       = markerNames[m].c_str();
+    }
+
+
+    results.push_back({ "create-marker", "New", 1, _measureCreateMarker(markerDescriptors) });
+    results.push_back({ "create-marker", "Known", 1, _measureCreateMarker(markerDescriptors) });
+
+
+    // Dispatch (checks emulate enablement checks of generic dispatch including Android native and extern trace)
+    const _SinkSet sinkSets[] =
+    {
+        { "C#",                       Plugin::Sink_CSharp },
+        { "Statistics",               Plugin::Sink_Stats },
+        { "Extern",                   Plugin::Sink_Extern },
+        { "Extern (asynchronous)",    Plugin::Sink_AsyncExtern },
+        { "Histogram",                Plugin::Sink_Histogram },
+        { "Allocation",               Plugin::Sink_Alloc },
+        { "Call tree",                Plugin::Sink_CallTree },
+        { "Live feed",                Plugin::Sink_LiveFeed },
+        { "C# + Statistics",          (Plugin::Sink_CSharp | Plugin::Sink_Stats) },
+        { "C# + Statistics + Extern", (Plugin::Sink_CSharp | Plugin::Sink_Stats | Plugin::Sink_Extern) }
+    };
+
+
+    for (const auto &sinkSet : sinkSets)
+    {
+        for (uint32_t threadCount = 1; threadCount <= maxThreadCount; threadCount *= 2)
+        {
+            results.push_back({ "dispatch", sinkSet.Name, threadCount, _measureDispatch(sinkSet.Sinks, threadCount) });
+        }
+    }
+
+
+    for (const auto &sinkSet : sinkSets)
+    {
+        if (!(sinkSet.Sinks & (Plugin::Sink_Extern | Plugin::Sink_AsyncExtern)))
+        {
+            results.push_back({ "dispatch-checked", sinkSet.Name, 1, _measureCheckedDispatch(sinkSet.Sinks) });
+        }
+    }
+
+
+    UnityPluginUnload();
+
+
+    // Stream codec (on recorded trace if given; MB/s in raw event records)
+    _RecordedFrames recordedFrames;
+
+
+    if (tracePath && !_loadRecordedFrames(tracePath, recordedFrames))
+    {
+        std::fprintf(stderr, "[ERROR] Failed to load '%s'\n", tracePath);
+
+
+        return 1;
+    }
+    if (!tracePath)
+    {
+        _recordSyntheticFrames(recordedFrames);
+    }
+
+
+    const struct
+    {
+        // Name
+        const char *Name;
+        // Compression
+        KLab_Profiling_Trace_StreamCompression Compression;
+    }
+    codecs[] =
+    {
+        { "Delta",         KLab_Profiling_Trace_StreamCompression_Delta },
+        { "Delta + block", KLab_Profiling_Trace_StreamCompression_DeltaBlock }
+    };
+
+
+    for (const auto &codec : codecs)
+    {
+        const auto   result        = _measureCodec(recordedFrames, codec.Compression);
+        const double bytesPerEvent = double(sizeof(KLab_Profiling_Trace_EventRecord));
+
+
+        results.push_back({ "stream-codec", (std::string(codec.Name) + " encode"), 1, result.EncodeNsPerEvent, (bytesPerEvent * 1e3 / result.EncodeNsPerEvent), result.Ratio });
+        results.push_back({ "stream-codec", (std::string(codec.Name) + " decode"), 1, result.DecodeNsPerEvent, (bytesPerEvent * 1e3 / result.DecodeNsPerEvent), result.Ratio });
+    }
+
+
+    // Report
+    auto file = (outputPath ? std::fopen(outputPath, "w") : stdout);
+
+
+    if (!file)
+    {
+        std::fprintf(stderr, "[ERROR] Failed to open '%s'\n", outputPath);
+
+
+        return 1;
+    }
+
+
+    _writeResults(file, format, label, results);
+
+
+    if (file != stdout)
+    {
+        std::fclose(file);
+    }
+
+
+    return 0;
+}
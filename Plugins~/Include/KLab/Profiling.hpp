@@ -47,6 +47,14 @@ namespace KLab { namespace Profiling { namespace Trace
         // Handles section leave
         /// @param section - Info on section
         virtual void LeaveSection(const SectionInfo &section) = 0;
+        /// [Optional] Handles section enter delivered after the fact (e.g. by asynchronous extern trace; ignoring timestamp by default)
+        /// @param section - Info on section
+        /// @param timestampNs - Time of enter on steady clock in nanoseconds
+        virtual void EnterSectionAt(const SectionInfo &section, const uint64_t timestampNs) { (void)timestampNs; EnterSection(section); }
+        /// [Optional] Handles section leave delivered after the fact (e.g. by asynchronous extern trace; ignoring timestamp by default)
+        /// @param section - Info on section
+        /// @param timestampNs - Time of leave on steady clock in nanoseconds
+        virtual void LeaveSectionAt(const SectionInfo &section, const uint64_t timestampNs) { (void)timestampNs; LeaveSection(section); }
         /// [Optional] Unloads interface
         virtual void Unload() {}
 
@@ -53,6 +53,7 @@ typedef int32_t KLab_Profiling_ErrorCode;
 /// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
 KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_Plugin_Initialize();
 /// Called once per game frame to allow internal update
+/// Frames get flipped by Unity frame callback at engine frame edge; this call only flips if that callback didn't fire since last call.
 void KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_Plugin_Update();
 
 
@@ -78,11 +79,37 @@ enum
     /// Section enter event
     KLab_Profiling_Trace_EventType_EnterSection = 0,
     /// Section leave event
-    KLab_Profiling_Trace_EventType_LeaveSection = 1
+    KLab_Profiling_Trace_EventType_LeaveSection = 1,
+    /// Metadata of section entered last by same thread (::KLab_Profiling_Trace_EventRecord::MarkerID holding byte offset of ::KLab_Profiling_Trace_MetadataHeader in metadata buffer)
+    KLab_Profiling_Trace_EventType_Metadata = 2
 };
 typedef uint32_t KLab_Profiling_Trace_EventType;
 
 
+/// Trace export format
+enum
+{
+    /// Chrome Trace Event JSON ('traceEvents')
+    KLab_Profiling_Trace_ExportFormat_ChromeJson = 0,
+    /// Perfetto protobuf trace
+    KLab_Profiling_Trace_ExportFormat_Perfetto   = 1
+};
+typedef int32_t KLab_Profiling_Trace_ExportFormat;
+
+
+/// Compression of frames streamed to trace file
+enum
+{
+    /// Raw event records
+    KLab_Profiling_Trace_StreamCompression_None       = 0,
+    /// Timestamps delta-encoded per thread and IDs varint-encoded
+    KLab_Profiling_Trace_StreamCompression_Delta      = 1,
+    /// Delta encoding followed by LZ block compression of call structure against previous frame
+    KLab_Profiling_Trace_StreamCompression_DeltaBlock = 2
+};
+typedef int32_t KLab_Profiling_Trace_StreamCompression;
+
+
 /// Trace event info
 typedef struct
 {
@@ -102,6 +129,96 @@ typedef struct
 KLab_Profiling_Trace_EventInfo;
 
 
+/// Compact trace event record
+typedef struct
+{
+    /// Interned marker ID (see ::KLab_Profiling_TraceUtility_GetMarkerInfo)
+    uint32_t MarkerID;
+    /// Dense thread index (see ::KLab_Profiling_TraceUtility_GetThreadInfo)
+    uint16_t ThreadIndex;
+    /// Event type
+    uint16_t Type;
+    /// Offset since trace begin in nanoseconds
+    uint64_t TimestampNs;
+}
+KLab_Profiling_Trace_EventRecord;
+
+
+/// Trace span record (single record per section emitted once section is left)
+typedef struct
+{
+    /// Interned marker ID (see ::KLab_Profiling_TraceUtility_GetMarkerInfo)
+    uint32_t MarkerID;
+    /// Dense thread index (see ::KLab_Profiling_TraceUtility_GetThreadInfo)
+    uint16_t ThreadIndex;
+    /// Nesting depth on thread (0 for outermost sections)
+    uint16_t Depth;
+    /// Offset of section enter since trace begin in nanoseconds
+    uint64_t BeginNs;
+    /// Duration of section in nanoseconds
+    uint64_t DurationNs;
+}
+KLab_Profiling_Trace_SpanRecord;
+
+
+/// Header of metadata captured on section enter (followed by entries, each padded to 4 bytes)
+typedef struct
+{
+    /// Size of metadata including header in bytes
+    uint32_t Size;
+    /// Number of entries
+    uint32_t EntryCount;
+}
+KLab_Profiling_Trace_MetadataHeader;
+
+
+/// Header of metadata entry (followed by data)
+typedef struct
+{
+    /// Unity data type ('UnityProfilerMarkerDataType')
+    uint16_t Type;
+    /// Size of data in bytes (truncated to ::KLab_Profiling_Trace_MaxMetadataEntrySize)
+    uint16_t Size;
+}
+KLab_Profiling_Trace_MetadataEntry;
+
+
+/// Metadata limits
+enum
+{
+    /// Maximum size of data of single metadata entry in bytes (longer data gets truncated)
+    KLab_Profiling_Trace_MaxMetadataEntrySize = 1024
+};
+
+
+/// Info on interned marker
+typedef struct
+{
+    /// Name of marker as null-terminated UTF-8 string
+    const char *Name;
+    /// Name of group as null-terminated UTF-8 string
+    const char *GroupName;
+    /// RGBA Color
+    uint32_t Color;
+    /// Unity category ID
+    uint32_t CategoryID;
+}
+KLab_Profiling_Trace_MarkerInfo;
+
+
+/// Info on traced thread
+typedef struct
+{
+    /// C-casted thread ID
+    uint64_t ThreadID;
+    /// Thread group name as null-terminated UTF-8 string (empty if unknown)
+    const char *GroupName;
+    /// Thread name as null-terminated UTF-8 string (empty if unknown)
+    const char *Name;
+}
+KLab_Profiling_Trace_ThreadInfo;
+
+
 /// Trace info
 typedef struct
 {
@@ -115,15 +232,558 @@ typedef struct
 KLab_Profiling_Trace_TraceInfo;
 
 
+/// Info on frame of continuous trace
+typedef struct
+{
+    /// Index of frame since trace begin
+    uint64_t FrameIndex;
+    /// Offset of frame begin since trace begin in nanoseconds
+    uint64_t BeginNs;
+    /// Duration of frame in nanoseconds
+    uint64_t DurationNs;
+    /// Number of trace event records
+    uint32_t EventCount;
+    /// Flag whether frame buffer or output buffer couldn't fit trace events
+    uint32_t DidRunOutOfEventMemory;
+}
+KLab_Profiling_Trace_FrameInfo;
+
+
+/// Info on continuous trace
+typedef struct
+{
+    /// Number of frames recorded since trace begin
+    uint64_t RecordedFrameCount;
+    /// Number of frames overwritten before being dequeued
+    uint64_t DroppedFrameCount;
+    /// Number of completed frames waiting to be dequeued
+    uint32_t PendingFrameCount;
+    /// Flag whether continuous trace is running
+    uint32_t IsTracing;
+}
+KLab_Profiling_Trace_ContinuousTraceInfo;
+
+
+/// Info on streaming trace
+typedef struct
+{
+    /// Number of bytes written to trace file
+    uint64_t BytesWritten;
+    /// Time spent writing to trace file in nanoseconds
+    uint64_t WriteDurationNs;
+    /// Number of frames written
+    uint64_t WrittenFrameCount;
+    /// Number of frames overwritten before being written
+    uint64_t DroppedFrameCount;
+    /// Number of frames that ran out of event chunks
+    uint64_t OverflowFrameCount;
+    /// Number of event bytes of written frames before compression
+    uint64_t RawEventBytes;
+    /// Number of event bytes of written frames after compression
+    uint64_t EncodedEventBytes;
+    /// Flag whether writing to trace file failed
+    uint32_t DidFailToWrite;
+    /// Flag whether streaming trace is running
+    uint32_t IsStreaming;
+}
+KLab_Profiling_Trace_StreamingTraceInfo;
+
+
+/// Info on live feed
+typedef struct
+{
+    /// Number of events published over all thread regions
+    uint64_t PublishedEventCount;
+    /// Number of frames published
+    uint64_t PublishedFrameCount;
+    /// Size of shared memory mapping in bytes
+    uint64_t MappingSize;
+    /// Number of thread regions
+    uint32_t RegionCount;
+    /// Event capacity of each thread region
+    uint32_t RegionCapacity;
+    /// Number of threads not publishing as their index exceeds region count
+    uint32_t UnmappedThreadCount;
+    /// Flag whether live feed is publishing
+    uint32_t IsPublishing;
+}
+KLab_Profiling_Trace_LiveFeedInfo;
+
+
+/// Number of latency histogram buckets of marker statistics
+enum
+{
+    /// Bucket 0 counts sections below 1us, bucket n sections in [2^(n-1), 2^n) us, and the last bucket all longer sections
+    KLab_Profiling_Trace_HistogramBucketCount = 20
+};
+
+
+/// Statistics of marker over single frame (merged over all threads)
+typedef struct
+{
+    /// Interned marker ID
+    uint32_t MarkerID;
+    /// Number of sections left
+    uint32_t Count;
+    /// Total inclusive time in nanoseconds
+    uint64_t TotalNs;
+    /// Total exclusive time (excluding child sections on same thread) in nanoseconds
+    uint64_t SelfNs;
+    /// Shortest inclusive time in nanoseconds
+    uint64_t MinNs;
+    /// Longest inclusive time in nanoseconds
+    uint64_t MaxNs;
+    /// Inclusive time histogram
+    uint32_t Histogram[KLab_Profiling_Trace_HistogramBucketCount];
+}
+KLab_Profiling_Trace_MarkerStats;
+
+
+/// Info on frame of statistics trace
+typedef struct
+{
+    /// Index of frame since trace begin
+    uint64_t FrameIndex;
+    /// Duration of frame in nanoseconds
+    uint64_t DurationNs;
+    /// Number of markers with statistics in frame
+    uint32_t MarkerCount;
+    /// Flag whether statistics trace is running
+    uint32_t IsTracing;
+}
+KLab_Profiling_Trace_StatsFrameInfo;
+
+
+/// Histogram IDs
+enum
+{
+    /// Histogram of frame times (other IDs get assigned to markers by ::KLab_Profiling_TraceUtility_AddHistogramMarker)
+    KLab_Profiling_Trace_FrameHistogramID = 0,
+    /// Pseudo ID addressing all histograms
+    KLab_Profiling_Trace_AllHistogramsID  = -1,
+    /// Maximum number of histograms (including frame histogram)
+    KLab_Profiling_Trace_MaxHistogramCount = 16
+};
+
+
+/// Summary of histogram
+typedef struct
+{
+    /// Number of recorded durations
+    uint64_t Count;
+    /// Sum of recorded durations in nanoseconds
+    uint64_t TotalNs;
+    /// Shortest recorded duration in nanoseconds (0 if empty)
+    uint64_t MinNs;
+    /// Longest recorded duration in nanoseconds
+    uint64_t MaxNs;
+}
+KLab_Profiling_Trace_HistogramInfo;
+
+
+/// Scope of call tree
+enum
+{
+    /// Last merged frame
+    KLab_Profiling_Trace_CallTreeScope_Frame  = 0,
+    /// All frames merged since trace begin or window reset
+    KLab_Profiling_Trace_CallTreeScope_Window = 1
+};
+typedef int32_t KLab_Profiling_Trace_CallTreeScope;
+
+
+/// Call tree node (nodes listed in pre-order per thread, children following parent)
+typedef struct
+{
+    /// Interned marker ID
+    uint32_t MarkerID;
+    /// Dense thread index (see ::KLab_Profiling_TraceUtility_GetThreadInfo)
+    uint16_t ThreadIndex;
+    /// Depth in tree of thread (0 for outermost sections)
+    uint16_t Depth;
+    /// Number of sections left
+    uint32_t Calls;
+    /// Number of nodes in subtree (excluding node itself)
+    uint32_t DescendantCount;
+    /// Total inclusive time in nanoseconds
+    uint64_t TotalNs;
+    /// Total exclusive time (excluding child sections) in nanoseconds
+    uint64_t SelfNs;
+}
+KLab_Profiling_Trace_CallTreeNode;
+
+
+/// Info on call tree
+typedef struct
+{
+    /// Index of last merged frame
+    uint64_t FrameIndex;
+    /// Number of frames merged into tree
+    uint64_t FrameCount;
+    /// Number of nodes (may exceed capacity of buffer)
+    uint32_t NodeCount;
+    /// Flag whether call tree trace is running
+    uint32_t IsTracing;
+    /// Flag whether sections got dropped as thread ran out of nodes
+    uint32_t DidRunOutOfNodes;
+}
+KLab_Profiling_Trace_CallTreeInfo;
+
+
+/// Allocation path IDs
+enum
+{
+    /// Path of allocations made outside traced sections (parent of outermost paths)
+    KLab_Profiling_Trace_RootAllocationPathID = 0
+};
+
+
+/// Managed allocations of marker path over single frame (merged over all threads)
+typedef struct
+{
+    /// Path ID (stable while trace runs)
+    uint32_t PathID;
+    /// ID of parent path (::KLab_Profiling_Trace_RootAllocationPathID for root path itself)
+    uint32_t ParentPathID;
+    /// Interned marker ID of innermost section of path (UINT32_MAX for root path)
+    uint32_t MarkerID;
+    /// Number of allocations made directly in path
+    uint32_t Count;
+    /// Bytes allocated directly in path
+    uint64_t Bytes;
+    /// Bytes allocated in path including child paths
+    uint64_t TotalBytes;
+}
+KLab_Profiling_Trace_AllocationStats;
+
+
+/// Info on frame of allocation trace
+typedef struct
+{
+    /// Index of frame since trace begin
+    uint64_t FrameIndex;
+    /// Bytes allocated in frame
+    uint64_t TotalBytes;
+    /// Number of allocations in frame
+    uint32_t TotalCount;
+    /// Number of paths in frame (including ancestors without allocations)
+    uint32_t PathCount;
+    /// Flag whether allocation trace is running
+    uint32_t IsTracing;
+    /// Flag whether allocations got dropped as thread ran out of paths
+    uint32_t DidRunOutOfPaths;
+}
+KLab_Profiling_Trace_AllocationFrameInfo;
+
+
+/// Info on marker filter
+typedef struct
+{
+    /// Number of Unity marker descriptors seen
+    uint32_t KnownMarkerCount;
+    /// Number of Unity marker descriptors with event callback registered
+    uint32_t RegisteredMarkerCount;
+}
+KLab_Profiling_Trace_MarkerFilterInfo;
+
+
+/// Policy applied by asynchronous extern trace once queue of thread is full
+enum
+{
+    /// Drop events right away
+    KLab_Profiling_Trace_BackpressurePolicy_Drop  = 0,
+    /// Wait for consumer up to timeout before dropping events (stalling thread emitting marker, e.g. Unity main thread)
+    KLab_Profiling_Trace_BackpressurePolicy_Block = 1
+};
+typedef int32_t KLab_Profiling_Trace_BackpressurePolicy;
+
+
+/// Info on asynchronous extern trace
+typedef struct
+{
+    /// Number of events delivered to extern trace
+    uint64_t DeliveredEventCount;
+    /// Number of events dropped due to full queues
+    uint64_t DroppedEventCount;
+    /// Number of events currently queued over all threads
+    uint32_t QueueDepth;
+    /// Number of events queued at once at most (sampled by consumer)
+    uint32_t MaxQueueDepth;
+    /// Number of thread queues
+    uint32_t QueueCount;
+    /// Flag whether asynchronous extern trace is running
+    uint32_t IsRunning;
+}
+KLab_Profiling_Trace_AsyncExternTraceInfo;
+
+
+/// Info on flight recorder
+typedef struct
+{
+    /// Number of snapshots taken
+    uint64_t SnapshotCount;
+    /// Number of snapshots skipped as previous snapshot was still being taken
+    uint64_t SkippedSnapshotCount;
+    /// Duration of frame that triggered last snapshot in nanoseconds (0 if triggered explicitly)
+    uint64_t LastHitchDurationNs;
+    /// Number of frames in last snapshot
+    uint32_t SnapshotFrameCount;
+    /// Number of frames of last snapshot waiting to be dequeued
+    uint32_t PendingFrameCount;
+    /// Flag whether writing last snapshot file failed
+    uint32_t DidFailToWrite;
+    /// Flag whether flight recorder is running
+    uint32_t IsRecording;
+}
+KLab_Profiling_Trace_FlightRecorderInfo;
+
+
 /// Enables C# callback driven tracing
 /// @param eventBuffer - Buffer for trace events
 /// @param eventBufferSize - Capacity of buffer
 /// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
 KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginTrace(KLab_Profiling_Trace_EventInfo *eventBuffer, const int32_t eventBufferSize);
+/// Enables C# callback driven tracing into compact event records
+/// @param eventBuffer - Buffer for trace event records
+/// @param eventBufferSize - Capacity of buffer
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginCompactTrace(KLab_Profiling_Trace_EventRecord *eventBuffer, const int32_t eventBufferSize);
 /// Ends C# started tracing
 /// @param info - Buffer for info on trace
 /// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
 KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_EndTrace(KLab_Profiling_Trace_TraceInfo *info);
+/// Enables continuous tracing rotating native frame buffers on every frame (see ::KLab_Profiling_Plugin_Update)
+/// @param frameCount - Number of frame buffers (at least 3)
+/// @param eventsPerFrame - Event capacity of each frame buffer
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginContinuousTrace(const int32_t frameCount, const int32_t eventsPerFrame);
+/// Ends continuous tracing (frames recorded so far stay dequeueable)
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_EndContinuousTrace();
+/// Dequeues oldest completed frame of continuous trace
+/// @param eventBuffer - Buffer for trace event records
+/// @param eventBufferSize - Capacity of buffer
+/// @param info - Buffer for info on frame
+/// @return ::KLab_Profiling_ErrorCode_NoError if frame dequeued; ::KLab_Profiling_ErrorCode_NotAvailable if no frame completed; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_DequeueFrame(KLab_Profiling_Trace_EventRecord *eventBuffer, const int32_t eventBufferSize, KLab_Profiling_Trace_FrameInfo *info);
+/// Dequeues oldest completed frame of continuous trace together with metadata captured (see ::KLab_Profiling_TraceUtility_SetMetadataCapture)
+/// @param eventBuffer - Buffer for trace event records
+/// @param eventBufferSize - Capacity of buffer
+/// @param metadataBuffer - Buffer for metadata
+/// @param metadataBufferSize - Capacity of buffer in bytes
+/// @param metadataLength - Buffer for number of metadata bytes written
+/// @param info - Buffer for info on frame
+/// @return ::KLab_Profiling_ErrorCode_NoError if frame dequeued; ::KLab_Profiling_ErrorCode_NotAvailable if no frame completed; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_DequeueFrameWithMetadata(KLab_Profiling_Trace_EventRecord *eventBuffer, const int32_t eventBufferSize, uint8_t *metadataBuffer, const int32_t metadataBufferSize, int32_t *metadataLength, KLab_Profiling_Trace_FrameInfo *info);
+/// Enables continuous tracing of spans (pairing section enter and leave per thread natively instead of recording both events)
+/// Spans get reported in frame they end in (beginning in earlier frame if open across flip). End and query trace like continuous trace.
+/// @param frameCount - Number of frame buffers (at least 3)
+/// @param spansPerFrame - Span capacity of each frame buffer
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginSpanTrace(const int32_t frameCount, const int32_t spansPerFrame);
+/// Dequeues oldest completed frame of span trace (spans ordered by begin)
+/// @param spanBuffer - Buffer for span records
+/// @param spanBufferSize - Capacity of buffer
+/// @param info - Buffer for info on frame (::KLab_Profiling_Trace_FrameInfo::EventCount holding number of spans)
+/// @return ::KLab_Profiling_ErrorCode_NoError if frame dequeued; ::KLab_Profiling_ErrorCode_NotAvailable if no frame completed; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_DequeueSpanFrame(KLab_Profiling_Trace_SpanRecord *spanBuffer, const int32_t spanBufferSize, KLab_Profiling_Trace_FrameInfo *info);
+/// Gets info on continuous trace
+/// @param info - Buffer for info on trace
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetContinuousTraceInfo(KLab_Profiling_Trace_ContinuousTraceInfo *info);
+/// Enables continuous tracing streamed to binary trace file by background thread
+/// @param path - Path of trace file as null-terminated UTF-8 string (truncated if existing)
+/// @param frameCount - Number of frame buffers (at least 3)
+/// @param eventsPerFrame - Event capacity of each frame buffer
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginStreamingTrace(const char *path, const int32_t frameCount, const int32_t eventsPerFrame);
+/// Enables continuous tracing streamed to binary trace file by background thread compressing completed frames
+/// @param path - Path of trace file as null-terminated UTF-8 string (truncated if existing)
+/// @param frameCount - Number of frame buffers (at least 3)
+/// @param eventsPerFrame - Event capacity of each frame buffer
+/// @param compression - Compression of frames
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginCompressedStreamingTrace(const char *path, const int32_t frameCount, const int32_t eventsPerFrame, const KLab_Profiling_Trace_StreamCompression compression);
+/// Ends streaming trace (writing remaining frames and closing trace file)
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_EndStreamingTrace();
+/// Gets info on streaming trace
+/// @param info - Buffer for info on trace
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetStreamingTraceInfo(KLab_Profiling_Trace_StreamingTraceInfo *info);
+/// Enables publishing events into POSIX shared memory for external reader processes (header, frame ring, names, and a single-writer event ring per thread region)
+/// @param name - Name of shared memory object as null-terminated UTF-8 string (e.g. '/klab-profiling'; replaced if existing)
+/// @param regionCount - Number of thread regions (threads with higher dense index don't publish)
+/// @param eventsPerRegion - Event capacity of each thread region (rounded up to power of 2)
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; ::KLab_Profiling_ErrorCode_NotAvailable if platform lacks shared memory; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginLiveFeed(const char *name, const int32_t regionCount, const int32_t eventsPerRegion);
+/// Ends live feed (unlinking shared memory object; attached readers keep their mapping and see feed ended)
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_EndLiveFeed();
+/// Gets info on live feed
+/// @param info - Buffer for info on feed
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetLiveFeedInfo(KLab_Profiling_Trace_LiveFeedInfo *info);
+/// Enables statistics trace aggregating per-marker statistics per frame instead of capturing events
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginStatsTrace();
+/// Ends statistics trace (last merged frame stays readable)
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_EndStatsTrace();
+/// Gets marker statistics of last merged frame (frames get merged one frame after they completed)
+/// @param statsBuffer - [Optional] Buffer for marker statistics
+/// @param statsBufferSize - Capacity of buffer
+/// @param info - Buffer for info on frame (::KLab_Profiling_Trace_StatsFrameInfo::MarkerCount may exceed capacity)
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; ::KLab_Profiling_ErrorCode_NotAvailable if no frame merged yet; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetStatsFrame(KLab_Profiling_Trace_MarkerStats *statsBuffer, const int32_t statsBufferSize, KLab_Profiling_Trace_StatsFrameInfo *info);
+/// Enables allocation trace attributing managed allocations ('GC.Alloc' samples) to marker path of allocating thread per frame
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginAllocationTrace();
+/// Ends allocation trace (last merged frame stays readable)
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_EndAllocationTrace();
+/// Gets allocations by marker path of last merged frame (frames get merged one frame after they completed; parents precede children)
+/// @param statsBuffer - [Optional] Buffer for path statistics
+/// @param statsBufferSize - Capacity of buffer
+/// @param info - Buffer for info on frame (::KLab_Profiling_Trace_AllocationFrameInfo::PathCount may exceed capacity)
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; ::KLab_Profiling_ErrorCode_NotAvailable if no frame merged yet; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetAllocationFrame(KLab_Profiling_Trace_AllocationStats *statsBuffer, const int32_t statsBufferSize, KLab_Profiling_Trace_AllocationFrameInfo *info);
+/// Enables call tree trace merging sections into call tree per thread and frame
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginCallTreeTrace();
+/// Ends call tree trace (merged trees stay readable)
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_EndCallTreeTrace();
+/// Gets call trees of all threads (frames get merged one frame after they completed; sections get counted in frame they end in)
+/// @param nodeBuffer - [Optional] Buffer for nodes
+/// @param nodeBufferSize - Capacity of buffer
+/// @param scope - Scope of trees
+/// @param info - Buffer for info on trees
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; ::KLab_Profiling_ErrorCode_NotAvailable if no frame merged yet; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetCallTree(KLab_Profiling_Trace_CallTreeNode *nodeBuffer, const int32_t nodeBufferSize, const KLab_Profiling_Trace_CallTreeScope scope, KLab_Profiling_Trace_CallTreeInfo *info);
+/// Clears call trees merged over frames to start new window
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_ResetCallTreeWindow();
+/// Exports trace events (e.g. result of ::KLab_Profiling_TraceUtility_EndTrace) to viewer format
+/// @param path - Path of output file as null-terminated UTF-8 string
+/// @param format - Export format
+/// @param events - Trace events
+/// @param eventCount - Number of trace events
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_ExportEvents(const char *path, const KLab_Profiling_Trace_ExportFormat format, const KLab_Profiling_Trace_EventInfo *events, const int32_t eventCount);
+/// Exports streamed trace file (see ::KLab_Profiling_TraceUtility_BeginStreamingTrace; decoding compressed frames) to viewer format in single pass
+/// @param inputPath - Path of streamed trace file as null-terminated UTF-8 string
+/// @param outputPath - Path of output file as null-terminated UTF-8 string
+/// @param format - Export format
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_ExportStreamingTrace(const char *inputPath, const char *outputPath, const KLab_Profiling_Trace_ExportFormat format);
+/// Enables recording frame times and durations of chosen markers into log-linear histograms (clearing histograms)
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginHistogramTrace();
+/// Ends histogram trace (histograms stay queryable)
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_EndHistogramTrace();
+/// Chooses marker to record durations of (sections on all threads; samples of 'Profiler.Default' can't be chosen)
+/// @param name - Marker name as null-terminated UTF-8 string
+/// @param histogramID - Buffer for ID of histogram (same ID if already chosen)
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_AddHistogramMarker(const char *name, int32_t *histogramID);
+/// Gets summary of histogram
+/// @param histogramID - ID of histogram
+/// @param info - Buffer for summary
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetHistogramInfo(const int32_t histogramID, KLab_Profiling_Trace_HistogramInfo *info);
+/// Gets durations at percentiles of histogram (within 1% of recorded durations)
+/// @param histogramID - ID of histogram
+/// @param percentiles - Percentiles in range [0, 100]
+/// @param valuesNs - Buffer for durations in nanoseconds
+/// @param count - Number of percentiles
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetHistogramPercentiles(const int32_t histogramID, const double *percentiles, uint64_t *valuesNs, const int32_t count);
+/// Clears histogram to start new window
+/// @param histogramID - ID of histogram (::KLab_Profiling_Trace_AllHistogramsID for all)
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_ResetHistogram(const int32_t histogramID);
+/// Sets filter selecting Unity markers to trace (re-registering only markers whose selection changed)
+/// Rules are separated by ';' or new lines, prefixed with '+' to include (default) or '-' to exclude, and either match category IDs ('category:<ID>') or marker names (glob with '*' and '?', e.g. 'Physics.*').
+/// Excludes take precedence, and no includes select all markers. 'Profiler.Default' is never filtered.
+/// @param filter - Rules as null-terminated UTF-8 string (empty to clear filter)
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_SetMarkerFilter(const char *filter);
+/// Sets filter selecting Unity markers whose metadata (e.g. instance IDs, sizes) continuous trace captures on section enter
+/// Rules follow ::KLab_Profiling_TraceUtility_SetMarkerFilter, except that no rules capture nothing; 'Profiler.Default' selects all its samples.
+/// Metadata is only kept while dequeuing through ::KLab_Profiling_TraceUtility_DequeueFrameWithMetadata.
+/// @param filter - Rules as null-terminated UTF-8 string (empty to stop capturing)
+/// @param bytesPerFrame - Metadata capacity of each frame buffer in bytes (applied on next ::KLab_Profiling_TraceUtility_BeginContinuousTrace)
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_SetMetadataCapture(const char *filter, const int32_t bytesPerFrame);
+/// Gets info on marker filter
+/// @param info - Buffer for info on filter
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetMarkerFilterInfo(KLab_Profiling_Trace_MarkerFilterInfo *info);
+/// Loads trace sink from shared object exporting 'KLab_Profiling_TraceSink_Create' and attaches it (see 'KLab/Profiling/TraceSink.h')
+/// @param path - Path of shared object as null-terminated UTF-8 string
+/// @param sinkID - Buffer for ID of attached sink
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_LoadTraceSink(const char *path, int32_t *sinkID);
+/// Detaches trace sink (flushing pending records to it, then releasing it and unloading its shared object if loaded)
+/// @param sinkID - ID of sink
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_DetachTraceSink(const int32_t sinkID);
+/// Delivers events to extern trace (see ::KLab_Profiling_PluginInfo_SupportsExternTrace) from consumer thread instead of from marker callbacks
+/// Events get queued per thread; sections entered while queue is full get dropped together with nested sections.
+/// Events get timestamped on queueing (see ::KLab::Profiling::Trace::IExternTrace::EnterSectionAt).
+/// @param policy - Backpressure policy
+/// @param blockTimeoutUs - Time to wait for free queue entries per event before dropping in microseconds (::KLab_Profiling_Trace_BackpressurePolicy_Block only; 1000 at most)
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginAsyncExternTrace(const KLab_Profiling_Trace_BackpressurePolicy policy, const int32_t blockTimeoutUs);
+/// Ends asynchronous extern trace (delivering remaining events and restoring synchronous delivery)
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_EndAsyncExternTrace();
+/// Gets info on asynchronous extern trace
+/// @param info - Buffer for info on trace
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetAsyncExternTraceInfo(KLab_Profiling_Trace_AsyncExternTraceInfo *info);
+/// Records all marker events into ring of last frames, freezing ring into snapshot once frame exceeds threshold or on trigger
+/// Snapshots replace previous snapshot and get written to '<pathPrefix>-<snapshot index>.klpt' in streamed trace format if prefix given.
+/// @param frameCount - Number of frames kept (at least 3)
+/// @param eventsPerFrame - Event capacity of each frame
+/// @param hitchThresholdUs - Frame duration triggering snapshot in microseconds (0 to only snapshot on trigger)
+/// @param pathPrefix - [Optional] Path prefix of snapshot files as null-terminated UTF-8 string
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginFlightRecorder(const int32_t frameCount, const int32_t eventsPerFrame, const int32_t hitchThresholdUs, const char *pathPrefix);
+/// Ends flight recorder (waiting for snapshot being taken; last snapshot stays dequeueable)
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_EndFlightRecorder();
+/// Requests snapshot of flight recorder (taken on next frame flip)
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_TriggerFlightRecorder();
+/// Gets info on flight recorder
+/// @param info - Buffer for info on recorder
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetFlightRecorderInfo(KLab_Profiling_Trace_FlightRecorderInfo *info);
+/// Dequeues oldest frame of last flight recorder snapshot
+/// @param eventBuffer - Buffer for trace event records
+/// @param eventBufferSize - Capacity of buffer
+/// @param info - Buffer for info on frame
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; ::KLab_Profiling_ErrorCode_NotAvailable if no frame pending; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_DequeueSnapshotFrame(KLab_Profiling_Trace_EventRecord *eventBuffer, const int32_t eventBufferSize, KLab_Profiling_Trace_FrameInfo *info);
+/// Gets number of interned markers
+/// @return the number of markers
+uint32_t KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetMarkerCount();
+/// Gets info on interned marker
+/// @param markerID - ID of marker
+/// @param info - Buffer for info on marker
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetMarkerInfo(const uint32_t markerID, KLab_Profiling_Trace_MarkerInfo *info);
+/// Gets number of traced threads
+/// @return the number of threads
+uint32_t KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetThreadCount();
+/// Gets info on traced thread
+/// @param threadIndex - Dense index of thread
+/// @param info - Buffer for info on thread
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetThreadInfo(const uint32_t threadIndex, KLab_Profiling_Trace_ThreadInfo *info);
 
 
 #if (__cplusplus)
@@ -0,0 +1,80 @@
+// -------------------------------------------------------------------------------------------- //
+//  Copyright (c) KLab Inc.. All rights reserved.                                               //
+//  Licensed under the MIT License. See 'LICENSE' in the project root for license information.  //
+// -------------------------------------------------------------------------------------------- //
+
+#pragma once
+
+
+// -------- //
+// INCLUDES //
+// -------- //
+
+#include <KLab/Profiling/CSharpInterface.h>
+
+
+#if (__cplusplus)
+extern "C"
+{
+#endif
+
+
+// ---------- //
+// TRACE SINK //
+// ---------- //
+
+/// Version of trace sink ABI (bumped on incompatible changes)
+enum
+{
+    KLab_Profiling_TraceSink_Version = 1
+};
+
+
+/// Plugin functions available to trace sinks
+typedef struct
+{
+    /// ABI version of plugin (see ::KLab_Profiling_TraceSink_Version)
+    uint32_t Version;
+    /// Gets info on interned marker (see ::KLab_Profiling_TraceUtility_GetMarkerInfo)
+    KLab_Profiling_ErrorCode (*GetMarkerInfo)(const uint32_t markerID, KLab_Profiling_Trace_MarkerInfo *info);
+    /// Gets info on traced thread (see ::KLab_Profiling_TraceUtility_GetThreadInfo)
+    KLab_Profiling_ErrorCode (*GetThreadInfo)(const uint32_t threadIndex, KLab_Profiling_Trace_ThreadInfo *info);
+}
+KLab_Profiling_TraceSinkHost;
+
+
+/// Consumer of batched trace event records
+typedef struct
+{
+    /// [Optional] User data passed to sink functions
+    void *UserData;
+    /// Handles batch of event records of single thread (timestamps in nanoseconds since first sink got attached)
+    /// Might get called concurrently from several threads (each delivering batch of its own thread or flushing idle threads)
+    /// @param userData - User data
+    /// @param records - Event records
+    /// @param recordCount - Number of event records
+    void (*HandleBatch)(void *userData, const KLab_Profiling_Trace_EventRecord *records, const uint32_t recordCount);
+    /// [Optional] Releases sink once detached (after pending records got flushed and last batch got delivered)
+    /// @param userData - User data
+    void (*Release)(void *userData);
+}
+KLab_Profiling_TraceSink;
+
+
+/// Entry point shared objects loaded by ::KLab_Profiling_TraceUtility_LoadTraceSink have to export as 'KLab_Profiling_TraceSink_Create'
+/// @param host - Plugin functions
+/// @param sink - Sink to fill in
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+typedef KLab_Profiling_ErrorCode (*KLab_Profiling_TraceSink_CreateFunction)(const KLab_Profiling_TraceSinkHost *host, KLab_Profiling_TraceSink *sink);
+
+
+/// Attaches sink receiving batches of event records (flushed when full and on first event of capturing thread after frame flip)
+/// @param sink - Sink (copied)
+/// @param sinkID - Buffer for ID of attached sink
+/// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_AttachTraceSink(const KLab_Profiling_TraceSink *sink, int32_t *sinkID);
+
+
+#if (__cplusplus)
+}
+#endif
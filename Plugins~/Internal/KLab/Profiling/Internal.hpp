@@ -12,13 +12,37 @@
 
 #include <KLab/Profiling.hpp>
 #include <KLab/Profiling/CSharpInterface.h>
+#include <KLab/Profiling/TraceSink.h>
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(_M_X64))
+#if (_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define KLAB_PROFILING_HAS_CYCLE_COUNTER 1
+#elif (defined(__aarch64__))
+#define KLAB_PROFILING_HAS_CYCLE_COUNTER 1
+#endif
 
 struct IUnityInterfaces;
 struct IUnityProfilerCallbacks;
 struct UnityProfilerMarkerDesc;
+struct UnityProfilerMarkerData;
 
 
 // ------- //
@@ -27,6 +51,82 @@ struct UnityProfilerMarkerDesc;
 
 namespace KLab { namespace Profiling
 {
+    /// Assumed size of a cache line in bytes
+    constexpr size_t CacheLineSize = 64;
+
+
+    /// Allocates cache line aligned memory
+    /// @param size - Size of memory in bytes
+    /// @return a valid pointer on success; null otherwise
+    inline void *AllocateAligned(const size_t size)
+    {
+        auto storage = static_cast<char *>(std::malloc(size + CacheLineSize));
+
+
+        if (!storage)
+        {
+            return nullptr;
+        }
+
+
+        // Store offset to storage in front of aligned address
+        auto aligned = storage + (CacheLineSize - (reinterpret_cast<uintptr_t>(storage) % CacheLineSize));
+
+
+        aligned[-1] = char(aligned - storage);
+
+
+        return aligned;
+    }
+
+    /// Frees memory allocated with ::AllocateAligned
+    /// @param memory - Memory to free
+    inline void FreeAligned(void *memory)
+    {
+        if (memory)
+        {
+            auto aligned = static_cast<char *>(memory);
+
+
+            std::free(aligned - uint8_t(aligned[-1]));
+        }
+    }
+
+
+    /// Creates array of cache line aligned objects
+    /// @param count - Number of objects
+    /// @return a valid pointer on success; null otherwise
+    template<typename T>
+    T *NewAlignedArray(const size_t count)
+    {
+        auto objects = static_cast<T *>(AllocateAligned(sizeof(T) * count));
+
+
+        for (size_t o = 0; objects && (o < count); ++o)
+        {
+            new (objects + o) T();
+        }
+
+
+        return objects;
+    }
+
+    /// Destroys array created with ::NewAlignedArray
+    /// @param objects - Objects to destroy
+    /// @param count - Number of objects
+    template<typename T>
+    void DeleteAlignedArray(T *objects, const size_t count)
+    {
+        for (size_t o = 0; objects && (o < count); ++o)
+        {
+            objects[o].~T();
+        }
+
+
+        FreeAligned(objects);
+    }
+
+
     /// Non-growing buffer with thread-safe allocate function
     template<typename T>
     struct AtomicBuffer final
@@ -81,73 +181,342 @@ namespace KLab { namespace Profiling
     };
 
 
-    /// Array-like list with fixed capacity
+    /// Cache line aligned chunk of data written by a single thread
     template<typename T, uint32_t N>
-    struct FixedCapacityList final
+    struct alignas(CacheLineSize) ThreadChunk final
     {
-        /// Tries to get datum at index
-        /// @param index - Index of datum to get
-        /// @return copy of datum at given index if available; default datum otherwise
-        const T GetAtOrDefault(const uint32_t index) const
+        /// Capacity in data
+        static constexpr uint32_t Capacity = N;
+
+
+        /// Number of committed data (only written by owning thread)
+        std::atomic<uint32_t> Length;
+        /// Data (starting on own cache line)
+        alignas(CacheLineSize) T Data[N];
+    };
+
+
+    /// Non-growing pool of thread chunks with thread-safe allocate function
+    template<typename TChunk>
+    struct ThreadChunkPool final
+    {
+        /// Gets base address
+        /// @return the base address
+        TChunk *GetBase()
+        {
+            return _base;
+        }
+
+        /// Gets number of chunks currently allocated
+        /// @return the number of chunks allocated
+        uint32_t GetLength() const
         {
-            T default_;
+            const uint32_t position = _position.load(std::memory_order_acquire);
 
 
-            return (index < _position ? _base[index] : default_);
+            return ((position < _capacity) ? position : _capacity);
         }
 
+        /// Reserves storage for chunks and resets pool
+        /// @param capacity - Capacity in chunks
+        /// @return true on success; false on out-of-memory
+        bool Reserve(const uint32_t capacity)
+        {
+            // Grow only (retiring previous storage as late writers might still reference its chunks)
+            if (capacity > _capacity)
+            {
+                auto base = static_cast<TChunk *>(AllocateAligned(sizeof(TChunk) * capacity));
+
+
+                if (!base)
+                {
+                    return false;
+                }
+
+
+                if (_base)
+                {
+                    _retiredBases.push_back(_base);
+                }
+
 
-        /// Adds datum
-        /// @returns true on success; false on out-of-memory
-        bool Add(const T &datum)
+                _base     = base;
+                _capacity = capacity;
+            }
+
+
+            Reset();
+
+
+            return true;
+        }
+
+        /// Resets pool
+        void Reset()
         {
-            const uint32_t index = _position++;
+            for (auto chunk = _base, end = (_base + _capacity); chunk < end; ++chunk)
+            {
+                chunk->Length.store(0, std::memory_order_relaxed);
+            }
+
 
+            _didRunOutOfMemory.store(false, std::memory_order_relaxed);
+            _position.store(0, std::memory_order_release);
+        }
+
+        /// Flags whether allocation failed since last reset
+        /// @return true if allocation failed; false otherwise
+        bool DidRunOutOfMemory() const
+        {
+            return _didRunOutOfMemory.load(std::memory_order_relaxed);
+        }
 
-            if (index >= _capacity)
+        /// Allocates chunk
+        /// @return a valid pointer to allocated chunk on success; null otherwise
+        TChunk *Allocate()
+        {
+            // Don't touch shared position once ran full
+            if (_position.load(std::memory_order_relaxed) < _capacity)
             {
-                return false;
+                const uint32_t index = _position.fetch_add(1, std::memory_order_acq_rel);
+
+
+                if (index < _capacity)
+                {
+                    return (_base + index);
+                }
             }
-            
 
-            _base[index] = datum;
+
+            if (!_didRunOutOfMemory.load(std::memory_order_relaxed))
+            {
+                _didRunOutOfMemory.store(true, std::memory_order_relaxed);
+            }
 
 
-            return true;
+            return nullptr;
         }
 
+        /// Swaps storage and state with other pool (expecting no thread to write to either)
+        /// @param other - Pool to swap with
+        void Swap(ThreadChunkPool &other)
+        {
+            const uint32_t position          = _position.load(std::memory_order_relaxed);
+            const bool     didRunOutOfMemory = _didRunOutOfMemory.load(std::memory_order_relaxed);
+
+
+            std::swap(_base, other._base);
+            std::swap(_capacity, other._capacity);
+            _retiredBases.swap(other._retiredBases);
+
+            _position.store(other._position.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            _didRunOutOfMemory.store(other._didRunOutOfMemory.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            other._position.store(position, std::memory_order_relaxed);
+            other._didRunOutOfMemory.store(didRunOutOfMemory, std::memory_order_relaxed);
+        }
 
         // Base address
-        T _base[N];
-        // Capacity
-        static constexpr uint32_t _capacity = N;
-        // Position
-        uint32_t _position = 0;
+        TChunk *_base = nullptr;
+        // Storage replaced by growth (never freed, as late writers might still reference its chunks)
+        std::vector<TChunk *> _retiredBases;
+        // Capacity in chunks
+        uint32_t _capacity = 0;
+        // Position (on own cache line as written by all threads)
+        alignas(CacheLineSize) std::atomic<uint32_t> _position = { 0 };
+        // Flag whether allocation failed since last reset
+        std::atomic<bool> _didRunOutOfMemory = { false };
+    };
+
+
+    /// Growable table with lock-free access by index (pages never move once allocated)
+    template<typename T, uint32_t PageCapacity = 256, uint32_t PageCount = 256>
+    struct PagedTable final
+    {
+        /// Maximum number of data
+        static constexpr uint32_t Capacity = (PageCapacity * PageCount);
+
+
+        /// Tries to get datum at index
+        /// @param index - Index of datum to get
+        /// @return a valid pointer if page allocated; null otherwise
+        T *TryGet(const uint32_t index) const
+        {
+            if (index >= Capacity)
+            {
+                return nullptr;
+            }
+
+
+            auto page = _pages[index / PageCapacity].load(std::memory_order_acquire);
+
+
+            return (page ? (page + (index % PageCapacity)) : nullptr);
+        }
+
+        /// Gets datum at index allocating its page if necessary
+        /// @param index - Index of datum to get
+        /// @return a valid pointer on success; null on out-of-memory or index out of range
+        T *GetOrCreate(const uint32_t index)
+        {
+            if (index >= Capacity)
+            {
+                return nullptr;
+            }
+
+
+            auto &slot = _pages[index / PageCapacity];
+            auto  page = slot.load(std::memory_order_acquire);
+
+
+            if (!page)
+            {
+                T *expected = nullptr;
+
+
+                page = NewAlignedArray<T>(PageCapacity);
+
+
+                if (!page)
+                {
+                    return nullptr;
+                }
+
+
+                // Drop own page if other thread was faster
+                if (!slot.compare_exchange_strong(expected, page, std::memory_order_acq_rel))
+                {
+                    DeleteAlignedArray(page, PageCapacity);
+
+
+                    page = expected;
+                }
+            }
+
+
+            return (page + (index % PageCapacity));
+        }
+
+        // Pages
+        std::atomic<T *> _pages[PageCount] = {};
+    };
+
+
+    /// Low-overhead clock reading raw cycle counter (falling back to steady clock if unreliable)
+    struct Clock final
+    {
+        /// Reads current ticks
+        /// @return the raw counter value if reliable; the steady clock time in nanoseconds otherwise
+        static inline uint64_t GetTicks()
+        {
+            #if (KLAB_PROFILING_HAS_CYCLE_COUNTER)
+            if (_isCounterReliable)
+            {
+                return _readCounter();
+            }
+            #endif
+
+
+            return GetSteadyNs();
+        }
+
+        /// Reads steady clock
+        /// @return the steady clock time in nanoseconds
+        static inline uint64_t GetSteadyNs()
+        {
+            return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        /// Flags whether raw counter is used
+        /// @return true if raw counter used; false if falling back to steady clock
+        static bool IsCounterReliable()
+        {
+            return _isCounterReliable;
+        }
+
+        /// Gets nominal counter frequency
+        /// @return the frequency in Hz if known; 0 otherwise
+        static uint64_t GetNominalFrequency();
+
+        #if (KLAB_PROFILING_HAS_CYCLE_COUNTER)
+        // Reads raw counter
+        // @return the counter value
+        static inline uint64_t _readCounter()
+        {
+            #if (defined(__aarch64__))
+            uint64_t ticks;
+
+
+            asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+
+
+            return ticks;
+            #else
+            return __rdtsc();
+            #endif
+        }
+        #endif
+
+        // Flag whether raw counter is reliable (detected once on load)
+        static const bool _isCounterReliable;
     };
 
 
-    /// Stopwatch utility
+    /// Stopwatch utility (timestamping in raw ticks, converting to nanoseconds on export)
     struct Stopwatch final
     {
-        /// Gets offset since last frame flip
-        /// @return the offset since last frame flip in nanoseconds
-        inline uint64_t GetTimestampNs() const
+        /// Gets offset since last reset
+        /// @return the offset since last reset in ticks
+        inline uint64_t GetTicks() const
         {
-            // Be explicit about nanoseconds
-            std::chrono::nanoseconds offset = (std::chrono::high_resolution_clock::now() - _lastFlip);
+            return (Clock::GetTicks() - _baseTicks);
+        }
 
+        /// Gets offset since last reset
+        /// @return the offset since last reset in nanoseconds
+        inline uint64_t GetTimestampNs() const
+        {
+            return (Clock::GetSteadyNs() - _baseNs);
+        }
 
-            return uint64_t(offset.count());
+        /// Converts ticks to nanoseconds (using last calibration)
+        /// @param ticks - Offset since last reset in ticks
+        /// @return the offset in nanoseconds
+        inline uint64_t ToNs(const uint64_t ticks) const
+        {
+            return uint64_t(double(ticks) * _nsPerTick);
         }
 
         /// Resets timer
         inline void Reset()
         {
-            _lastFlip = std::chrono::high_resolution_clock::now();
+            const uint64_t frequency = Clock::GetNominalFrequency();
+
+
+            _baseTicks = Clock::GetTicks();
+            _baseNs    = Clock::GetSteadyNs();
+            _nsPerTick = (frequency ? (1e9 / double(frequency)) : 1.0);
+        }
+
+        /// Calibrates ticks against steady clock (usually called on frame flip)
+        inline void Calibrate()
+        {
+            const uint64_t ticks = GetTicks();
+            const uint64_t ns    = GetTimestampNs();
+
+
+            // Wait for meaningful interval
+            if (Clock::IsCounterReliable() && (ticks > 0) && (ns > 100000))
+            {
+                _nsPerTick = (double(ns) / double(ticks));
+            }
         }
 
-        // Time at last flip
-        std::chrono::high_resolution_clock::time_point _lastFlip;
+        // Ticks at last reset
+        uint64_t _baseTicks = 0;
+        // Steady clock nanoseconds at last reset
+        uint64_t _baseNs = 0;
+        // Nanoseconds per tick
+        double _nsPerTick = 1.0;
     };
 
 
@@ -205,120 +574,2196 @@ namespace KLab { namespace Profiling { namespace Trace
 }}}
 
 
-// -------- //
-// C# TRACE //
-// -------- //
+// -------------- //
+// CATEGORY TABLE //
+// -------------- //
 
 namespace KLab { namespace Profiling { namespace Trace
 {
-    /// C# trace interface
-    struct CSharpTrace final
+    /// Table of Unity categories indexed by category ID (lock-free, growing by pages)
+    struct CategoryTable final
     {
-        /// Flags whether should trace
-        /// @return whether tracer is tracing 
-        bool IsTracing() const;
-        /// Ticks interface
-        void Flip();
-        /// Handles entering section enter
-        /// @param section - Info on section
-        void EnterSection(const SectionInfo &section);
-        // Handles section leave
-        /// @param section - Info on section
-        void LeaveSection(const SectionInfo &section);
-
-        // Frame time
-        Stopwatch _timer;
-        // Trace event buffer
-        AtomicBuffer<KLab_Profiling_Trace_EventInfo> _eventBuffer;
-        // Flag whether to trace current frame
-        bool _isTracing = false;
-        // Flag whether event buffer ran full
-        bool _didEventBufferRunOutOfMemory = false;
-
-        // Flags whether tracing is enabled
-        // @return true if enabled; false otherwise
-        bool _isEnabled() const;
-        // Enables tracing (expecting valid arguments)
-        // @param eventBuffer - Trace frame flip function
-        // @param eventBufferCapacity - Event buffer capacity
-        void _enable(KLab_Profiling_Trace_EventInfo *eventBuffer, const uint32_t eventBufferCapacity);
-        // Disables tracing
-        // @return Info on trace
-        KLab_Profiling_Trace_TraceInfo _disable();
+        /// Sets category (names have to be persistent)
+        /// @param id - Unity category ID
+        /// @param name - Name of category
+        /// @param color - RGBA color of category
+        void Set(const uint32_t id, const char *name, const uint32_t color);
+        /// Gets category
+        /// @param id - Unity category ID
+        /// @return info on category if known; default group otherwise
+        SectionGroupInfo GetOrDefault(const uint32_t id) const;
+
+        // Category entry (name published last to mark entry valid)
+        struct _Entry final
+        {
+            // RGBA color
+            std::atomic<uint32_t> Color;
+            // Name (null while not set)
+            std::atomic<const char *> Name;
+        };
 
-        // Defaults construction
-        CSharpTrace() = default;
-        // Prevents copy construction
-        CSharpTrace(const CSharpTrace &) = delete;
-        // Prevents move construction
-        CSharpTrace(CSharpTrace &&) = delete;
+        // Entries by category ID (Unity category IDs are 16-bit)
+        PagedTable<_Entry, 256, 256> _entries;
     };
 
 
-    /// Get C# trace interface
-    /// @return the interface
-    CSharpTrace &GetCSharpTrace();
+    /// Gets category table
+    /// @return the singleton table
+    CategoryTable &GetCategoryTable();
 }}}
 
 
 // ------------ //
-// EXTERN TRACE //
+// MARKER TABLE //
 // ------------ //
 
 namespace KLab { namespace Profiling { namespace Trace
 {
-    /// Tries to get extern trace interface
-    /// @return the interface if available; null otherwise
-    inline IExternTrace *TryGetExternTrace()
-    {
-        static IExternTrace *trace = nullptr;
+    /// Info on interned marker
+    typedef KLab_Profiling_Trace_MarkerInfo MarkerInfo;
 
 
-        #if KLAB_PROFILING_HAS_EXTERN_TRACE
-        if (!trace)
-        {
-            trace = LoadExternTrace();
-        }
-        #endif
+    /// Table of interned markers mapping IDs to full names, group names, and colors
+    struct MarkerTable final
+    {
+        /// Maximum number of dynamically named markers
+        static constexpr uint32_t DynamicCapacity = 8192;
+
+
+        /// Gets number of interned markers
+        /// @return the number of markers
+        uint32_t GetLength() const;
+        /// Tries to get info on marker
+        /// @param id - Marker ID
+        /// @return a valid pointer if available; null otherwise
+        const MarkerInfo *TryGet(const uint32_t id) const;
+        /// Interns marker (once per Unity marker descriptor, names have to be persistent)
+        /// @param info - Info on marker
+        /// @return the marker ID on success; ::InvalidID otherwise
+        uint32_t Intern(const MarkerInfo &info);
+        /// Interns dynamically named marker (e.g. 'Profiler.Default' samples) by copying its name
+        /// @param name - Name as null-terminated UTF-8 string
+        /// @param base - Info on marker to inherit group and color from
+        /// @return the marker ID on success; ::InvalidID otherwise
+        uint32_t InternDynamic(const char *name, const MarkerInfo &base);
+        /// Interns dynamically named marker from UTF-16 name (converting only on cache miss; hits verified against interned name)
+        /// @param name - Name as UTF-16 string
+        /// @param length - Length of name in characters (stops early at terminator)
+        /// @param base - Info on marker to inherit group and color from
+        /// @return the marker ID on success; ::InvalidID otherwise
+        uint32_t InternUtf16(const char16_t *name, const size_t length, const MarkerInfo &base);
+
+        /// Invalid marker ID
+        static constexpr uint32_t InvalidID = ~uint32_t(0);
+        /// Number of entries of UTF-16 name cache
+        static constexpr uint32_t Utf16CacheCapacity = 1024;
+
+        // Markers
+        PagedTable<MarkerInfo> _markers;
+        // Number of markers published (only advanced after entry got written)
+        std::atomic<uint32_t> _length = { 0 };
+        // Guard for interning markers
+        std::mutex _internMutex;
+        // Dynamic marker IDs (+1) in hash order
+        std::atomic<uint32_t> _dynamicIDs[DynamicCapacity] = {};
+        // Guard for interning dynamic markers
+        std::mutex _dynamicMutex;
+        // Direct-mapped UTF-16 name cache (marker ID + 1 in low and UTF-8 name length in high half; 0 if empty)
+        std::atomic<uint64_t> _utf16Cache[Utf16CacheCapacity] = {};
+    };
 
 
-        return trace;
-    }
+    /// Gets marker table
+    /// @return the singleton table
+    MarkerTable &GetMarkerTable();
 }}}
 
 
-// ----- //
-// UTILS //
-// ----- //
+// ------------- //
+// MARKER FILTER //
+// ------------- //
 
-namespace KLab { namespace Profiling { namespace Utils
+namespace KLab { namespace Profiling { namespace Trace
 {
-    /// Utility functions interface
-    typedef IExternUtils IUtils;
-
-
-    /// Gets utility interface
-    /// @return the singleton interface
-    IUtils &GetUtils();
+    /// Include/exclude rules selecting Unity markers to register callbacks on (evaluated once per descriptor)
+    struct MarkerFilter final
+    {
+        /// Parses rules replacing current ones
+        /// Rules are separated by ';' or new lines and are prefixed with '+' to include (default) or '-' to exclude;
+        /// 'category:<ID>' matches category IDs, everything else matches marker names as glob ('*', '?').
+        /// @param spec - Rules as null-terminated UTF-8 string (empty to clear)
+        /// @return true on success; false on syntax error (keeping current rules)
+        bool Parse(const char *spec);
+        /// Checks whether marker passes filter (excludes win, empty includes match everything)
+        /// @param name - Marker name
+        /// @param categoryID - Marker category ID
+        /// @return true if passing; false otherwise
+        bool Matches(const char *name, const uint32_t categoryID) const;
+        /// Checks whether filter has no rules
+        /// @return true if empty; false otherwise
+        bool IsEmpty() const;
+
+        // Included category IDs
+        std::vector<uint32_t> _includeCategoryIDs;
+        // Excluded category IDs
+        std::vector<uint32_t> _excludeCategoryIDs;
+        // Included name patterns
+        std::vector<std::string> _includePatterns;
+        // Excluded name patterns
+        std::vector<std::string> _excludePatterns;
+    };
 }}}
 
 
-// -------------- //
-// PLUGIN CONTEXT //
-// -------------- //
+// ------------ //
+// THREAD TABLE //
+// ------------ //
 
-namespace KLab { namespace Profiling { namespace Plugin
+namespace KLab { namespace Profiling { namespace Trace
 {
-    /// Plugin context
-    struct PluginContext final
+    /// Info on traced thread
+    typedef KLab_Profiling_Trace_ThreadInfo ThreadInfo;
+
+    /// Chunk of event records captured by single thread (4KB, timestamps in raw ticks until gathered)
+    typedef ThreadChunk<KLab_Profiling_Trace_EventRecord, 252> EventChunk;
+    /// Chunk of metadata words captured by single thread (4KB side arena referenced by metadata event records)
+    typedef ThreadChunk<uint32_t, 1008> MetadataChunk;
+    /// Chunk of span records captured by single thread (4KB, timestamps in raw ticks until gathered)
+    typedef ThreadChunk<KLab_Profiling_Trace_SpanRecord, 168> SpanChunk;
+
+
+    /// Statistics accumulators of single thread
+    struct ThreadStats;
+    /// Batch of event records of single thread
+    struct ThreadBatch;
+    /// Queue of events of single thread for asynchronous extern trace
+    struct ThreadExternQueue;
+    /// Open sections of single thread for histogram trace
+    struct ThreadHistograms;
+    /// Open sections of single thread for span trace
+    struct ThreadSpans;
+    /// Allocation accumulators of single thread
+    struct ThreadAllocs;
+    /// Call trees of single thread
+    struct ThreadCallTree;
+
+
+    /// Trace context of a single thread (only written by owning thread after creation)
+    struct alignas(CacheLineSize) ThreadContext final
     {
+        /// Index of contexts of threads beyond table capacity (events of which get dropped)
+        static constexpr uint16_t InvalidIndex = 0xffff;
+
+
+        /// Info on thread (unnamed)
+        ThreadInfo Info;
+        /// [Optional] Info on thread including its name once named (published by ::ThreadTable after creation; never freed)
+        std::atomic<const ThreadInfo *> NamedInfo;
+        /// Dense thread index (::InvalidIndex if untracked)
+        uint16_t Index;
+        /// Trace generation chunk belongs to
+        uint32_t ChunkGeneration;
+        /// Chunk currently written to
+        EventChunk *Chunk;
+        /// Trace generation metadata chunk belongs to
+        uint32_t MetadataChunkGeneration;
+        /// Index of metadata chunk in its pool
+        uint32_t MetadataChunkIndex;
+        /// Metadata chunk currently written to
+        MetadataChunk *Metadata;
+        /// Trace generation span chunk belongs to
+        uint32_t SpanChunkGeneration;
+        /// Span chunk currently written to
+        SpanChunk *CurrentSpanChunk;
+        /// [Optional] Open sections for span trace (created on first use)
+        ThreadSpans *Spans;
+        /// [Optional] Statistics accumulators (created on first use)
+        ThreadStats *Stats;
+        /// [Optional] Batch of event records for trace sinks (created on first use)
+        ThreadBatch *Batch;
+        /// [Optional] Queue of events for asynchronous extern trace (created on first use)
+        ThreadExternQueue *ExternQueue;
+        /// [Optional] Open sections for histogram trace (created on first use)
+        ThreadHistograms *Histograms;
+        /// [Optional] Allocation accumulators (created on first use)
+        ThreadAllocs *Allocs;
+        /// [Optional] Call trees (created on first use)
+        ThreadCallTree *CallTree;
+    };
 
 
-
-        /// Unity context
-        struct
+    /// Table of traced threads mapping dense indices to thread contexts
+    struct ThreadTable final
+    {
+        /// Gets number of registered threads
+        /// @return the number of threads
+        uint32_t GetLength() const;
+        /// Tries to get info on thread
+        /// @param index - Thread index
+        /// @return a valid pointer if available; null otherwise
+        const ThreadInfo *TryGet(const uint32_t index) const;
+        /// Creates context of calling thread
+        /// @return the context (untracked context of calling thread once table ran full)
+        ThreadContext &CreateCurrent();
+        /// Names thread (usually called by Unity on thread creation)
+        /// @param threadID - C-casted thread ID
+        /// @param groupName - Thread group name as null-terminated UTF-8 string
+        /// @param name - Thread name as null-terminated UTF-8 string
+        void SetName(const uint64_t threadID, const char *groupName, const char *name);
+
+        // Thread name (never freed, also once renamed, as readers might still reference it)
+        struct _Name final
         {
-            /// Unity interfaces
+            // Group name
+            std::string GroupName;
+            // Name
+            std::string Name;
+            // Info on thread referencing names
+            ThreadInfo Info;
+        };
+
+        // Thread contexts (indices below ::ThreadContext::InvalidIndex only)
+        PagedTable<ThreadContext, 64, 1024> _threads;
+        // Number of threads
+        std::atomic<uint32_t> _length = { 0 };
+        // Thread names by thread ID
+        std::unordered_map<uint64_t, const _Name *> _names;
+        // Guard for thread names (and for publishing contexts, so naming sees their thread IDs)
+        std::mutex _namesMutex;
+    };
+
+
+    /// Gets thread table
+    /// @return the singleton table
+    ThreadTable &GetThreadTable();
+
+    /// Gets trace context of calling thread (creating it on first call)
+    /// @return the context
+    inline ThreadContext &GetThreadContext()
+    {
+        static thread_local ThreadContext *context = nullptr;
+
+
+        if (!context)
+        {
+            context = &GetThreadTable().CreateCurrent();
+        }
+
+
+        return *context;
+    }
+}}}
+
+
+// -------- //
+// C# TRACE //
+// -------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    /// Open sections of single thread for span trace (only written by owning thread; never freed while plugin loaded)
+    struct alignas(CacheLineSize) ThreadSpans final
+    {
+        /// Maximum section depth tracked
+        static constexpr uint32_t MaxDepth = 64;
+
+
+        /// Open section
+        struct Section final
+        {
+            /// Interned marker ID
+            uint32_t MarkerID;
+            /// Enter timestamp in ticks
+            uint64_t BeginTicks;
+        };
+
+
+        /// Open sections
+        Section Stack[MaxDepth];
+        /// Section depth (may exceed ::MaxDepth)
+        uint32_t Depth = 0;
+        /// Span trace generation stack belongs to
+        uint32_t Generation = 0;
+    };
+
+
+    /// C# trace interface
+    struct CSharpTrace final
+    {
+        /// Chunk of event records captured by single thread
+        typedef Trace::EventChunk EventChunk;
+        /// Chunk of metadata captured by single thread
+        typedef Trace::MetadataChunk MetadataChunk;
+        /// Chunk of span records captured by single thread
+        typedef Trace::SpanChunk SpanChunk;
+
+
+        /// Number of chunks reserved on top of capacity for threads not created yet (each writing thread holding a partly filled chunk)
+        static constexpr uint32_t SpareChunkCount = 16;
+
+
+        /// Frame buffer of continuous trace
+        struct Frame final
+        {
+            /// Per-thread event chunks
+            ThreadChunkPool<EventChunk> Chunks;
+            /// Per-thread metadata chunks
+            ThreadChunkPool<MetadataChunk> MetadataChunks;
+            /// Per-thread span chunks
+            ThreadChunkPool<SpanChunk> SpanChunks;
+            /// Index of frame since trace begin
+            uint64_t Index = 0;
+            /// Offset since trace begin in nanoseconds
+            uint64_t BeginNs = 0;
+            /// Duration in nanoseconds
+            uint64_t DurationNs = 0;
+        };
+
+
+        /// Trace mode
+        enum class Mode
+        {
+            /// Not tracing
+            None,
+            /// Single capture window into C# buffer
+            Single,
+            /// Continuous capture into native frame swapchain
+            Continuous
+        };
+
+
+        /// Flags whether should trace
+        /// @return whether tracer is tracing 
+        bool IsTracing() const;
+        /// Ticks interface (rotating frame buffers in continuous mode)
+        void Flip();
+        /// Handles entering section enter
+        /// @param thread - Context of calling thread
+        /// @param markerID - Interned marker ID of section
+        void EnterSection(ThreadContext &thread, const uint32_t markerID);
+        // Handles section leave
+        /// @param thread - Context of calling thread
+        /// @param markerID - Interned marker ID of section
+        void LeaveSection(ThreadContext &thread, const uint32_t markerID);
+        /// Captures metadata of section entered last (in continuous mode with metadata capacity only)
+        /// @param thread - Context of calling thread
+        /// @param data - Unity marker data
+        /// @param dataCount - Number of data
+        /// @param skippedIndex - Index of datum to skip (e.g. sample name of 'Profiler.Default'; ::dataCount to skip none)
+        void WriteMetadata(ThreadContext &thread, const UnityProfilerMarkerData *data, const uint16_t dataCount, const uint16_t skippedIndex);
+
+        // Frame time
+        Stopwatch _timer;
+        // Per-thread event chunks of single capture
+        ThreadChunkPool<EventChunk> _eventChunks;
+        // Chunks threads currently allocate from
+        std::atomic<ThreadChunkPool<EventChunk> *> _activeChunks = { nullptr };
+        // [Optional] Metadata chunks threads currently allocate from
+        std::atomic<ThreadChunkPool<MetadataChunk> *> _activeMetadataChunks = { nullptr };
+        // Metadata capacity of each frame buffer in bytes (applied on next continuous trace begin)
+        std::atomic<uint32_t> _metadataBytesPerFrame = { 0 };
+        // Flag whether frame buffers of current continuous trace capture metadata
+        bool _capturesMetadata = false;
+        // [Optional] Span chunks threads currently allocate from
+        std::atomic<ThreadChunkPool<SpanChunk> *> _activeSpanChunks = { nullptr };
+        // Span trace generation (invalidating open sections of previous span trace only, unlike frame flips)
+        std::atomic<uint32_t> _spanGeneration = { 1 };
+        // Flag whether continuous trace records spans instead of events
+        bool _isSpanMode = false;
+        // [Optional] C# event buffer events get expanded into
+        KLab_Profiling_Trace_EventInfo *_eventBuffer = nullptr;
+        // [Optional] C# event record buffer events get merged into
+        KLab_Profiling_Trace_EventRecord *_recordBuffer = nullptr;
+        // Capacity of C# event buffer
+        uint32_t _eventBufferCapacity = 0;
+        // Frame swapchain of continuous trace
+        Frame *_frames = nullptr;
+        // Number of frame buffers in swapchain
+        uint32_t _frameCount = 0;
+        // Swapchains replaced on frame count change (never freed as late writers might still reference their chunks)
+        std::vector<Frame *> _retiredFrames;
+        // Index of frame currently recorded
+        uint64_t _recordingFrameIndex = 0;
+        // Index of oldest frame not yet dequeued
+        uint64_t _oldestFrameIndex = 0;
+        // Number of frames overwritten before being dequeued
+        uint64_t _droppedFrameCount = 0;
+        // Guard for frame swapchain
+        std::mutex _framesMutex;
+        // Frame whose chunks got swapped out of swapchain for gathering without frame guard (only touched under dequeue guard)
+        Frame _dequeuedFrame;
+        // Guard for dequeued frame (serializing dequeuers without stalling flips; locked before frame guard)
+        std::mutex _dequeueMutex;
+        // Trace generation (invalidating per-thread chunk cursors)
+        std::atomic<uint32_t> _generation = { 1 };
+        // Trace mode
+        Mode _mode = Mode::None;
+        // Flag whether to trace current frame
+        bool _isTracing = false;
+
+        // Flags whether tracing is enabled
+        // @return true if enabled; false otherwise
+        bool _isEnabled() const;
+        // Enables tracing (expecting valid arguments and exactly one buffer)
+        // @param eventBuffer - [Optional] Buffer for expanded events
+        // @param recordBuffer - [Optional] Buffer for compact event records
+        // @param eventBufferCapacity - Event buffer capacity
+        // @return true on success; false on out-of-memory
+        bool _enable(KLab_Profiling_Trace_EventInfo *eventBuffer, KLab_Profiling_Trace_EventRecord *recordBuffer, const uint32_t eventBufferCapacity);
+        // Disables tracing and merges per-thread chunks into event buffer
+        // @return Info on trace
+        KLab_Profiling_Trace_TraceInfo _disable();
+        // Enables continuous tracing (expecting valid arguments)
+        // @param frameCount - Number of frame buffers
+        // @param eventsPerFrame - Event capacity of each frame buffer
+        // @param metadataBytesPerFrame - Metadata capacity of each frame buffer in bytes (0 to not capture metadata)
+        // @param isSpanMode - Flag whether to record spans instead of events (::eventsPerFrame being span capacity)
+        // @return true on success; false on out-of-memory
+        bool _enableContinuous(const uint32_t frameCount, const uint32_t eventsPerFrame, const uint32_t metadataBytesPerFrame = 0, const bool isSpanMode = false);
+        // Disables continuous tracing (keeping recorded frames dequeueable)
+        void _disableContinuous();
+        // Dequeues oldest completed frame of continuous trace
+        // @param recordBuffer - Buffer for compact event records
+        // @param recordBufferCapacity - Capacity of buffer
+        // @param info - Info on frame
+        // @param metadataBuffer - [Optional] Buffer for metadata (dropping metadata records if null)
+        // @param metadataBufferCapacity - Capacity of metadata buffer in bytes
+        // @param metadataLength - [Optional] Number of metadata bytes written
+        // @return true if frame dequeued; false if no frame completed
+        bool _dequeueFrame(KLab_Profiling_Trace_EventRecord *recordBuffer, const uint32_t recordBufferCapacity, KLab_Profiling_Trace_FrameInfo &info, uint8_t *metadataBuffer = nullptr, const uint32_t metadataBufferCapacity = 0, uint32_t *metadataLength = nullptr);
+        // Dequeues oldest completed frame of span trace
+        // @param spanBuffer - Buffer for span records
+        // @param spanBufferCapacity - Capacity of buffer
+        // @param info - Info on frame
+        // @return true if frame dequeued; false if no frame completed
+        bool _dequeueSpanFrame(KLab_Profiling_Trace_SpanRecord *spanBuffer, const uint32_t spanBufferCapacity, KLab_Profiling_Trace_FrameInfo &info);
+        // Gets oldest completed frame not yet dequeued (expecting frame guard locked)
+        // @return a valid pointer if available; null otherwise
+        Frame *_tryGetCompletedFrame();
+        // Swaps chunks of oldest completed frame into ::_dequeuedFrame and dequeues it (expecting dequeue guard locked)
+        // @param timer - Buffer for timer records got timestamped with
+        // @return true if frame detached; false if no frame completed
+        bool _detachCompletedFrame(Stopwatch &timer);
+        // Gets info on continuous trace
+        // @return the info
+        KLab_Profiling_Trace_ContinuousTraceInfo _getContinuousInfo();
+        // Activates chunks and invalidates per-thread cursors
+        // @param chunks - Chunks to allocate from
+        // @param metadataChunks - [Optional] Metadata chunks to allocate from
+        // @param spanChunks - [Optional] Span chunks to allocate from
+        void _activateChunks(ThreadChunkPool<EventChunk> *chunks, ThreadChunkPool<MetadataChunk> *metadataChunks, ThreadChunkPool<SpanChunk> *spanChunks);
+        // Writes event to chunk of calling thread
+        // @param type - Trace event type
+        // @param thread - Context of calling thread
+        // @param markerID - Interned marker ID of section
+        void _writeEvent(const KLab_Profiling_Trace_EventType type, ThreadContext &thread, const uint32_t markerID);
+        // Opens span on calling thread
+        // @param thread - Context of calling thread
+        // @param markerID - Interned marker ID of section
+        void _enterSpan(ThreadContext &thread, const uint32_t markerID);
+        // Closes innermost span of calling thread writing its record
+        // @param thread - Context of calling thread
+        // @param markerID - Interned marker ID of section
+        void _leaveSpan(ThreadContext &thread, const uint32_t markerID);
+        // Gets open sections of calling thread (creating them on first use, and forgetting sections of previous trace)
+        // @param thread - Context of calling thread
+        // @return a valid pointer on success; null on out-of-memory
+        ThreadSpans *_getThreadSpans(ThreadContext &thread);
+
+        // Defaults construction
+        CSharpTrace() = default;
+        // Prevents copy construction
+        CSharpTrace(const CSharpTrace &) = delete;
+        // Prevents move construction
+        CSharpTrace(CSharpTrace &&) = delete;
+    };
+
+
+    /// Get C# trace interface
+    /// @return the interface
+    CSharpTrace &GetCSharpTrace();
+}}}
+
+
+// ----------- //
+// STATS TRACE //
+// ----------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    /// Statistics of marker
+    typedef KLab_Profiling_Trace_MarkerStats MarkerStats;
+
+
+    /// Statistics accumulators of single thread (only written by owning thread; never freed while plugin loaded)
+    struct alignas(CacheLineSize) ThreadStats final
+    {
+        /// Number of accumulator sets rotated by frame (one being written, one sealed for a frame, one merged)
+        static constexpr uint32_t SetCount = 3;
+        /// Maximum section depth tracked
+        static constexpr uint32_t MaxDepth = 64;
+
+
+        /// Accumulators of single frame
+        struct Set final
+        {
+            /// Statistics by marker ID
+            PagedTable<MarkerStats> Markers;
+            /// IDs of markers with statistics
+            std::vector<uint32_t> TouchedIDs;
+            /// Trace generation accumulators belong to (stale sets get reset by owning thread on next write and skipped by merges)
+            std::atomic<uint32_t> Generation = { 0 };
+        };
+
+
+        /// Open section
+        struct Section final
+        {
+            /// Interned marker ID
+            uint32_t MarkerID;
+            /// Enter timestamp in ticks
+            uint64_t BeginTicks;
+            /// Inclusive time of child sections in nanoseconds
+            uint64_t ChildNs;
+        };
+
+
+        /// Accumulator sets
+        Set Sets[SetCount];
+        /// Open sections
+        Section Stack[MaxDepth];
+        /// Section depth (may exceed ::MaxDepth)
+        uint32_t Depth = 0;
+        /// Trace generation stack belongs to
+        uint32_t Generation = 0;
+        /// Index of frame last accumulated into (released after accumulating, so merges acquire accumulators)
+        std::atomic<uint64_t> CommittedFrameIndex = { 0 };
+        /// Next accumulators of registry
+        ThreadStats *Next = nullptr;
+    };
+
+
+    /// Statistics trace (aggregating per-marker statistics per thread and merging them on frame flip)
+    struct StatsTrace final
+    {
+        /// Flags whether should trace
+        /// @return whether tracer is tracing
+        bool IsTracing() const;
+        /// Ticks interface (merging frame sealed on previous flip)
+        void Flip();
+        /// Handles section enter
+        /// @param thread - Context of calling thread
+        /// @param markerID - Interned marker ID of section
+        void EnterSection(ThreadContext &thread, const uint32_t markerID);
+        /// Handles section leave
+        /// @param thread - Context of calling thread
+        /// @param markerID - Interned marker ID of section
+        void LeaveSection(ThreadContext &thread, const uint32_t markerID);
+
+        // Frame time (started on first begin)
+        Stopwatch _timer;
+        // Nanoseconds per tick (copied from timer on calibration)
+        std::atomic<double> _nsPerTick = { 1.0 };
+        // Index of frame currently recorded
+        std::atomic<uint64_t> _frameIndex = { 0 };
+        // Trace generation (invalidating per-thread stacks and accumulator sets)
+        std::atomic<uint32_t> _generation = { 1 };
+        // Registry of per-thread accumulators
+        std::atomic<ThreadStats *> _threads = { nullptr };
+        // Begin of frames by accumulator set in nanoseconds
+        uint64_t _frameBeginNs[ThreadStats::SetCount] = {};
+        // Duration of frames by accumulator set in nanoseconds
+        uint64_t _frameDurationNs[ThreadStats::SetCount] = {};
+        // Merged statistics of last merged frame
+        std::vector<MarkerStats> _results;
+        // Indices into merged statistics by marker ID (+1)
+        std::vector<uint32_t> _resultIndices;
+        // Index of last merged frame
+        uint64_t _resultFrameIndex = 0;
+        // Duration of last merged frame in nanoseconds
+        uint64_t _resultDurationNs = 0;
+        // Flag whether any frame got merged
+        bool _hasResults = false;
+        // Guard for merged statistics
+        std::mutex _resultsMutex;
+        // Flag whether tracing
+        std::atomic<bool> _isTracing = { false };
+
+        // Enables tracing
+        void _enable();
+        // Disables tracing
+        void _disable();
+        // Copies merged statistics of last merged frame
+        // @param statsBuffer - [Optional] Buffer for statistics
+        // @param statsBufferCapacity - Capacity of buffer
+        // @param info - Info on frame
+        // @return true if frame merged before; false otherwise
+        bool _getResults(MarkerStats *statsBuffer, const uint32_t statsBufferCapacity, KLab_Profiling_Trace_StatsFrameInfo &info);
+        // Gets accumulators of calling thread (creating them on first use)
+        // @param thread - Context of calling thread
+        // @return a valid pointer on success; null on out-of-memory
+        ThreadStats *_getThreadStats(ThreadContext &thread);
+        // Merges and resets accumulator set of all threads
+        // @param set - Index of set
+        // @param frameIndex - Index of frame set recorded
+        void _merge(const uint32_t set, const uint64_t frameIndex);
+
+        // Defaults construction
+        StatsTrace() = default;
+        // Prevents copy construction
+        StatsTrace(const StatsTrace &) = delete;
+        // Prevents move construction
+        StatsTrace(StatsTrace &&) = delete;
+    };
+
+
+    /// Gets statistics trace
+    /// @return the singleton trace
+    StatsTrace &GetStatsTrace();
+}}}
+
+
+// ----------- //
+// BATCH TRACE //
+// ----------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    /// Batch of event records of single thread (timestamps in raw ticks until delivered)
+    struct alignas(CacheLineSize) ThreadBatch final
+    {
+        /// Capacity in records
+        static constexpr uint32_t Capacity = 256;
+
+
+        /// Flag whether batch is held (by owning thread while writing or by flip while flushing it on behalf of idle thread)
+        std::atomic<bool> IsHeld = { false };
+        /// Number of records
+        uint32_t Length;
+        /// Flip generation records belong to
+        uint32_t Generation;
+        /// Next batch of all batches
+        ThreadBatch *Next;
+        /// Records
+        KLab_Profiling_Trace_EventRecord Records[Capacity];
+    };
+
+
+    /// Trace delivering event records in per-thread batches to runtime attached sinks
+    struct BatchTrace final
+    {
+        /// Maximum number of attached sinks
+        static constexpr uint32_t MaxSinkCount = 8;
+
+
+        /// Flags whether any sink is attached
+        /// @return true if tracing; false otherwise
+        bool IsTracing() const;
+        /// Flips frame (flushing batch of calling thread and batches of threads idle since previous flip; others flush on their next event)
+        void Flip();
+        /// Handles section enter
+        /// @param thread - Context of calling thread
+        /// @param markerID - Interned marker ID
+        void EnterSection(ThreadContext &thread, const uint32_t markerID);
+        /// Handles section leave
+        /// @param thread - Context of calling thread
+        /// @param markerID - Interned marker ID
+        void LeaveSection(ThreadContext &thread, const uint32_t markerID);
+
+        // Attached sink
+        struct _Slot final
+        {
+            // Sink
+            KLab_Profiling_TraceSink Sink;
+            // [Optional] Shared object sink got loaded from
+            void *Library;
+            // Flag whether batches get delivered
+            std::atomic<bool> IsActive;
+            // Number of deliveries in flight
+            std::atomic<uint32_t> DeliveryCount;
+        };
+
+        // Attaches sink
+        // @param sink - Sink
+        // @param library - [Optional] Shared object sink got loaded from (unloaded on detach)
+        // @param sinkID - Buffer for ID of sink
+        // @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+        KLab_Profiling_ErrorCode _attach(const KLab_Profiling_TraceSink &sink, void *library, int32_t &sinkID);
+        // Detaches sink (flushing pending records first and waiting for deliveries in flight)
+        // @param sinkID - ID of sink
+        // @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+        KLab_Profiling_ErrorCode _detach(const int32_t sinkID);
+        // Writes event record
+        // @param type - Event type
+        // @param thread - Context of calling thread
+        // @param markerID - Interned marker ID
+        void _writeEvent(const KLab_Profiling_Trace_EventType type, ThreadContext &thread, const uint32_t markerID);
+        // Delivers batch to all active sinks and resets it
+        // @param batch - Batch to deliver (held by caller)
+        void _deliver(ThreadBatch &batch);
+        // Flushes batches of all threads (holding each, so records written concurrently either get flushed or follow later)
+        // @param shouldDeliver - Flag whether to deliver records instead of discarding them
+        void _flushBatches(const bool shouldDeliver);
+        // Holds batch (spinning while held by other thread)
+        // @param batch - Batch to hold
+        static void _hold(ThreadBatch &batch);
+        // Releases held batch
+        // @param batch - Batch to release
+        static void _unhold(ThreadBatch &batch);
+        // Gets batch of calling thread
+        // @param thread - Context of calling thread
+        // @return a valid pointer on success; null on out-of-memory
+        ThreadBatch *_getThreadBatch(ThreadContext &thread);
+
+        // Timer (reset once first sink gets attached)
+        Stopwatch _timer;
+        // Nanoseconds per tick of last calibration (read by delivering threads)
+        std::atomic<double> _nsPerTick = { 1.0 };
+        // Flip generation
+        std::atomic<uint32_t> _generation = { 0 };
+        // Batches of all threads (never freed while tracing)
+        std::atomic<ThreadBatch *> _batches = { nullptr };
+        // Sink slots
+        _Slot _slots[MaxSinkCount] = {};
+        // Number of active sinks
+        std::atomic<uint32_t> _sinkCount = { 0 };
+        // Guard for attaching and detaching sinks
+        std::mutex _slotsMutex;
+    };
+
+
+    /// Gets batch trace
+    /// @return the singleton trace
+    BatchTrace &GetBatchTrace();
+}}}
+
+
+// --------------- //
+// HISTOGRAM TRACE //
+// --------------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    /// Log-linear histogram of durations (HDR-style; constant memory, lock-free recording)
+    struct Histogram final
+    {
+        /// Bits of sub-buckets per power of 2 (relative error below 1%)
+        static constexpr uint32_t SubBucketBits = 7;
+        /// Number of sub-buckets per power of 2
+        static constexpr uint32_t SubBucketCount = (1u << SubBucketBits);
+        /// Largest shift of bucketed values (durations from 2^42 nanoseconds on share last bucket)
+        static constexpr uint32_t MaxShift = 34;
+        /// Number of buckets
+        static constexpr uint32_t BucketCount = ((MaxShift + 2) * SubBucketCount);
+
+
+        /// Gets bucket of value
+        /// @param value - Value
+        /// @return the bucket index
+        static uint32_t GetBucketIndex(const uint64_t value);
+        /// Gets highest value of bucket
+        /// @param index - Bucket index
+        /// @return the highest value counted by bucket
+        static uint64_t GetBucketUpperBound(const uint32_t index);
+
+        /// Records duration
+        /// @param durationNs - Duration in nanoseconds
+        void Record(const uint64_t durationNs);
+        /// Clears recorded durations
+        void Reset();
+        /// Gets summary
+        /// @return the summary
+        KLab_Profiling_Trace_HistogramInfo GetInfo() const;
+        /// Gets durations at percentiles (clamped to recorded range)
+        /// @param percentiles - Percentiles in range [0, 100]
+        /// @param valuesNs - Buffer for durations in nanoseconds (0 if empty)
+        /// @param count - Number of percentiles
+        void GetPercentiles(const double *percentiles, uint64_t *valuesNs, const uint32_t count) const;
+
+        // Counts by bucket
+        std::atomic<uint32_t> _buckets[BucketCount];
+        // Number of recorded durations
+        std::atomic<uint64_t> _count;
+        // Sum of recorded durations in nanoseconds
+        std::atomic<uint64_t> _totalNs;
+        // Shortest recorded duration in nanoseconds
+        std::atomic<uint64_t> _minNs;
+        // Longest recorded duration in nanoseconds
+        std::atomic<uint64_t> _maxNs;
+    };
+
+
+    /// Open sections of single thread (only written by owning thread; never freed while plugin loaded)
+    struct alignas(CacheLineSize) ThreadHistograms final
+    {
+        /// Maximum section depth tracked
+        static constexpr uint32_t MaxDepth = 16;
+
+
+        /// Open section
+        struct Section final
+        {
+            /// Histogram ID
+            uint32_t HistogramID;
+            /// Enter timestamp in ticks
+            uint64_t BeginTicks;
+        };
+
+
+        /// Open sections
+        Section Stack[MaxDepth];
+        /// Section depth (may exceed ::MaxDepth)
+        uint32_t Depth = 0;
+        /// Trace generation stack belongs to
+        uint32_t Generation = 0;
+        /// Next sections of registry
+        ThreadHistograms *Next = nullptr;
+    };
+
+
+    /// Histogram trace (recording frame times and durations of chosen markers into histograms)
+    struct HistogramTrace final
+    {
+        /// Flags whether should trace
+        /// @return whether tracer is tracing
+        bool IsTracing() const;
+        /// Records frame time
+        void Flip();
+        /// Handles section enter of chosen marker
+        /// @param thread - Context of calling thread
+        /// @param histogramID - Histogram ID of marker
+        void EnterSection(ThreadContext &thread, const uint32_t histogramID);
+        /// Handles section leave of chosen marker
+        /// @param thread - Context of calling thread
+        /// @param histogramID - Histogram ID of marker
+        void LeaveSection(ThreadContext &thread, const uint32_t histogramID);
+        /// Finds histogram of marker
+        /// @param name - Marker name as null-terminated UTF-8 string
+        /// @return the histogram ID if marker got chosen; 0 otherwise
+        uint32_t FindMarkerHistogram(const char *name);
+        /// Chooses marker to record durations of
+        /// @param name - Marker name as null-terminated UTF-8 string
+        /// @return the histogram ID on success; 0 if out of histograms
+        uint32_t AddMarkerHistogram(const char *name);
+        /// Tries to get histogram
+        /// @param histogramID - Histogram ID
+        /// @return a valid pointer if available; null otherwise
+        Histogram *TryGet(const int32_t histogramID);
+
+        // Frame time
+        Stopwatch _timer;
+        // Nanoseconds per tick (copied from timer on calibration)
+        std::atomic<double> _nsPerTick = { 1.0 };
+        // Frame begin in ticks (0 until first flip)
+        uint64_t _frameBeginTicks = 0;
+        // Trace generation (invalidating per-thread stacks)
+        std::atomic<uint32_t> _generation = { 1 };
+        // Registry of per-thread sections
+        std::atomic<ThreadHistograms *> _threads = { nullptr };
+        // Histograms by ID (created on first enable)
+        Histogram *_histograms = nullptr;
+        // Marker names by histogram ID (guarded by names guard)
+        std::string _markerNames[KLab_Profiling_Trace_MaxHistogramCount];
+        // Number of histograms in use
+        std::atomic<uint32_t> _histogramCount = { 1 };
+        // Guard for marker names
+        std::mutex _namesMutex;
+        // Flag whether tracing
+        std::atomic<bool> _isTracing = { false };
+
+        // Enables tracing (clearing histograms)
+        // @return true on success; false on out-of-memory
+        bool _enable();
+        // Disables tracing (keeping histograms queryable)
+        void _disable();
+        // Gets sections of calling thread
+        // @param thread - Context of calling thread
+        // @return a valid pointer on success; null on out-of-memory
+        ThreadHistograms *_getThreadHistograms(ThreadContext &thread);
+    };
+
+
+    /// Gets histogram trace
+    /// @return the singleton trace
+    HistogramTrace &GetHistogramTrace();
+}}}
+
+
+// ----------- //
+// ALLOC TRACE //
+// ----------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    /// Managed allocations of marker path
+    typedef KLab_Profiling_Trace_AllocationStats AllocationStats;
+
+
+    /// Allocation accumulators of single thread (only written by owning thread; never freed while plugin loaded)
+    struct alignas(CacheLineSize) ThreadAllocs final
+    {
+        /// Number of accumulator sets rotated by frame (one being written, one sealed for a frame, one merged)
+        static constexpr uint32_t SetCount = 3;
+        /// Maximum section depth tracked
+        static constexpr uint32_t MaxDepth = 64;
+
+
+        /// Marker path interned by thread
+        struct Path final
+        {
+            /// Thread-local ID of parent path
+            uint32_t ParentID;
+            /// Interned marker ID of innermost section
+            uint32_t MarkerID;
+        };
+
+
+        /// Allocations of path
+        struct Accumulator final
+        {
+            /// Number of allocations
+            uint32_t Count;
+            /// Bytes allocated
+            uint64_t Bytes;
+        };
+
+
+        /// Accumulators of single frame
+        struct Set final
+        {
+            /// Accumulators by thread-local path ID
+            PagedTable<Accumulator> Paths;
+            /// Thread-local IDs of paths with allocations
+            std::vector<uint32_t> TouchedIDs;
+            /// Flag whether allocations got dropped
+            bool DidRunOutOfPaths = false;
+        };
+
+
+        /// Accumulator sets
+        Set Sets[SetCount];
+        /// Paths by thread-local path ID (0 being root path)
+        PagedTable<Path> Paths;
+        /// Thread-local path IDs by parent path ID (high bits) and marker ID (low bits)
+        std::unordered_map<uint64_t, uint32_t> PathIDs;
+        /// Number of paths interned
+        uint32_t PathCount = 0;
+        /// Open sections as thread-local path IDs
+        uint32_t Stack[MaxDepth];
+        /// Section depth (may exceed ::MaxDepth)
+        uint32_t Depth = 0;
+        /// Trace generation stack belongs to
+        uint32_t Generation = 0;
+        /// Merged path IDs by thread-local path ID (+1; only accessed while merging)
+        std::vector<uint32_t> MergedIDs;
+        /// Next accumulators of registry
+        ThreadAllocs *Next = nullptr;
+    };
+
+
+    /// Allocation trace (attributing managed allocations to marker path per thread and merging paths on frame flip)
+    struct AllocTrace final
+    {
+        /// Flags whether should trace
+        /// @return whether tracer is tracing
+        bool IsTracing() const;
+        /// Ticks interface (merging frame sealed on previous flip)
+        void Flip();
+        /// Handles section enter
+        /// @param thread - Context of calling thread
+        /// @param markerID - Interned marker ID of section
+        void EnterSection(ThreadContext &thread, const uint32_t markerID);
+        /// Handles section leave
+        /// @param thread - Context of calling thread
+        void LeaveSection(ThreadContext &thread);
+        /// Handles allocation sample
+        /// @param thread - Context of calling thread
+        /// @param data - Sample data (first integral datum holding size in bytes)
+        /// @param dataCount - Number of data
+        void RecordAllocation(ThreadContext &thread, const UnityProfilerMarkerData *data, const uint16_t dataCount);
+
+        // Index of frame currently recorded
+        std::atomic<uint64_t> _frameIndex = { 0 };
+        // Trace generation (invalidating per-thread stacks)
+        std::atomic<uint32_t> _generation = { 1 };
+        // Registry of per-thread accumulators
+        std::atomic<ThreadAllocs *> _threads = { nullptr };
+        // Paths merged over threads by path ID (kept for whole trace to keep IDs stable)
+        std::vector<ThreadAllocs::Path> _paths;
+        // Merged path IDs by parent path ID (high bits) and marker ID (low bits)
+        std::unordered_map<uint64_t, uint32_t> _pathIDs;
+        // Merged statistics of last merged frame (parents preceding children)
+        std::vector<AllocationStats> _results;
+        // Indices into merged statistics by path ID (+1)
+        std::vector<uint32_t> _resultIndices;
+        // Info on last merged frame
+        KLab_Profiling_Trace_AllocationFrameInfo _resultInfo = {};
+        // Flag whether any frame got merged
+        bool _hasResults = false;
+        // Guard for merged paths and statistics
+        std::mutex _resultsMutex;
+        // Flag whether tracing
+        std::atomic<bool> _isTracing = { false };
+
+        // Enables tracing
+        void _enable();
+        // Disables tracing
+        void _disable();
+        // Copies merged statistics of last merged frame
+        // @param statsBuffer - [Optional] Buffer for statistics
+        // @param statsBufferCapacity - Capacity of buffer
+        // @param info - Info on frame
+        // @return true if frame merged before; false otherwise
+        bool _getResults(AllocationStats *statsBuffer, const uint32_t statsBufferCapacity, KLab_Profiling_Trace_AllocationFrameInfo &info);
+        // Gets accumulators of calling thread (creating them on first use)
+        // @param thread - Context of calling thread
+        // @return a valid pointer on success; null on out-of-memory
+        ThreadAllocs *_getThreadAllocs(ThreadContext &thread);
+        // Interns path of calling thread
+        // @param allocs - Accumulators of calling thread
+        // @param parentID - Thread-local ID of parent path
+        // @param markerID - Interned marker ID of section
+        // @return the thread-local path ID on success; ::MarkerTable::InvalidID if out of paths
+        uint32_t _internPath(ThreadAllocs &allocs, const uint32_t parentID, const uint32_t markerID);
+        // Maps thread-local path to merged path (expecting results guard locked)
+        // @param allocs - Accumulators of thread
+        // @param localID - Thread-local path ID
+        // @return the merged path ID
+        uint32_t _mergePath(ThreadAllocs &allocs, const uint32_t localID);
+        // Gets merged statistics of path adding ancestors first (expecting results guard locked)
+        // @param pathID - Merged path ID
+        // @return the statistics
+        AllocationStats &_getResult(const uint32_t pathID);
+        // Merges and resets accumulator set of all threads
+        // @param set - Index of set
+        // @param frameIndex - Index of frame set recorded
+        void _merge(const uint32_t set, const uint64_t frameIndex);
+
+        // Defaults construction
+        AllocTrace() = default;
+        // Prevents copy construction
+        AllocTrace(const AllocTrace &) = delete;
+        // Prevents move construction
+        AllocTrace(AllocTrace &&) = delete;
+    };
+
+
+    /// Gets allocation trace
+    /// @return the singleton trace
+    AllocTrace &GetAllocTrace();
+}}}
+
+
+// --------------- //
+// CALL TREE TRACE //
+// --------------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    /// Call tree node
+    typedef KLab_Profiling_Trace_CallTreeNode CallTreeNode;
+
+
+    /// Call tree of single thread with nodes pooled in array (node 0 being root)
+    struct CallTree final
+    {
+        /// Maximum number of nodes (including root)
+        static constexpr uint32_t MaxNodeCount = 65536;
+        /// Index marking absent node
+        static constexpr uint32_t InvalidIndex = ~uint32_t(0);
+
+
+        /// Node linked to first child and next sibling
+        struct Node final
+        {
+            /// Interned marker ID
+            uint32_t MarkerID;
+            /// Index of first child
+            uint32_t FirstChild;
+            /// Index of next sibling
+            uint32_t NextSibling;
+            /// Number of sections left
+            uint32_t Calls;
+            /// Total inclusive time in nanoseconds
+            uint64_t TotalNs;
+            /// Total exclusive time in nanoseconds
+            uint64_t SelfNs;
+        };
+
+
+        /// Nodes (empty until first node interned; capacity kept on clear)
+        std::vector<Node> Nodes;
+        /// Flag whether nodes ran out
+        bool DidRunOutOfNodes = false;
+
+
+        /// Gets child of node with marker (creating it if absent)
+        /// @param parent - Index of parent node
+        /// @param markerID - Interned marker ID
+        /// @return the child index on success; ::InvalidIndex if out of nodes
+        uint32_t Intern(const uint32_t parent, const uint32_t markerID);
+        /// Merges other tree into tree
+        /// @param other - Tree to merge
+        void Merge(const CallTree &other);
+        /// Clears nodes (keeping capacity)
+        void Clear();
+    };
+
+
+    /// Call trees of single thread (sets only written by owning thread; never freed while plugin loaded)
+    struct alignas(CacheLineSize) ThreadCallTree final
+    {
+        /// Number of trees rotated by frame (one being written, one sealed for a frame, one merged)
+        static constexpr uint32_t SetCount = 3;
+        /// Maximum section depth tracked
+        static constexpr uint32_t MaxDepth = 64;
+
+
+        /// Open section
+        struct Section final
+        {
+            /// Interned marker ID
+            uint32_t MarkerID;
+            /// Index of node in tree of frame open sections got interned into
+            uint32_t Node;
+            /// Enter timestamp in ticks
+            uint64_t BeginTicks;
+            /// Inclusive time of child sections in nanoseconds
+            uint64_t ChildNs;
+        };
+
+
+        /// Trees by frame
+        CallTree Sets[SetCount];
+        /// Tree of last merged frame (only accessed while merging or reading)
+        CallTree Frame;
+        /// Tree merged over frames (only accessed while merging or reading)
+        CallTree Window;
+        /// Open sections
+        Section Stack[MaxDepth];
+        /// Section depth (may exceed ::MaxDepth)
+        uint32_t Depth = 0;
+        /// Trace generation stack belongs to
+        uint32_t Generation = 0;
+        /// Index of frame nodes of open sections belong to
+        uint64_t StackFrameIndex = 0;
+        /// Dense thread index
+        uint16_t ThreadIndex = 0;
+        /// Next trees of registry
+        ThreadCallTree *Next = nullptr;
+    };
+
+
+    /// Call tree trace (merging sections into call tree per thread and frame)
+    struct CallTreeTrace final
+    {
+        /// Flags whether should trace
+        /// @return whether tracer is tracing
+        bool IsTracing() const;
+        /// Ticks interface (merging frame sealed on previous flip)
+        void Flip();
+        /// Handles section enter
+        /// @param thread - Context of calling thread
+        /// @param markerID - Interned marker ID of section
+        void EnterSection(ThreadContext &thread, const uint32_t markerID);
+        /// Handles section leave
+        /// @param thread - Context of calling thread
+        /// @param markerID - Interned marker ID of section
+        void LeaveSection(ThreadContext &thread, const uint32_t markerID);
+
+        // Frame time (started on first begin)
+        Stopwatch _timer;
+        // Nanoseconds per tick (copied from timer on calibration)
+        std::atomic<double> _nsPerTick = { 1.0 };
+        // Index of frame currently recorded
+        std::atomic<uint64_t> _frameIndex = { 0 };
+        // Trace generation (invalidating per-thread stacks)
+        std::atomic<uint32_t> _generation = { 1 };
+        // Registry of per-thread trees
+        std::atomic<ThreadCallTree *> _threads = { nullptr };
+        // Index of last merged frame
+        uint64_t _resultFrameIndex = 0;
+        // Number of frames merged into window
+        uint64_t _windowFrameCount = 0;
+        // Flag whether any frame got merged
+        bool _hasResults = false;
+        // Guard for merged trees
+        std::mutex _resultsMutex;
+        // Flag whether tracing
+        std::atomic<bool> _isTracing = { false };
+
+        // Enables tracing
+        void _enable();
+        // Disables tracing
+        void _disable();
+        // Clears trees merged over frames
+        void _resetWindow();
+        // Copies merged trees of all threads in pre-order
+        // @param nodeBuffer - [Optional] Buffer for nodes
+        // @param nodeBufferCapacity - Capacity of buffer
+        // @param scope - Scope of trees
+        // @param info - Info on trees
+        // @return true if frame merged before; false otherwise
+        bool _getResults(CallTreeNode *nodeBuffer, const uint32_t nodeBufferCapacity, const KLab_Profiling_Trace_CallTreeScope scope, KLab_Profiling_Trace_CallTreeInfo &info);
+        // Gets trees of calling thread (creating them on first use)
+        // @param thread - Context of calling thread
+        // @return a valid pointer on success; null on out-of-memory
+        ThreadCallTree *_getThreadCallTree(ThreadContext &thread);
+        // Gets tree of frame currently recorded (re-interning open sections on first access per frame)
+        // @param tree - Trees of calling thread
+        // @return the tree
+        CallTree &_getFrameTree(ThreadCallTree &tree);
+        // Merges and resets tree set of all threads
+        // @param set - Index of set
+        // @param frameIndex - Index of frame set recorded
+        void _merge(const uint32_t set, const uint64_t frameIndex);
+
+        // Defaults construction
+        CallTreeTrace() = default;
+        // Prevents copy construction
+        CallTreeTrace(const CallTreeTrace &) = delete;
+        // Prevents move construction
+        CallTreeTrace(CallTreeTrace &&) = delete;
+    };
+
+
+    /// Gets call tree trace
+    /// @return the singleton trace
+    CallTreeTrace &GetCallTreeTrace();
+}}}
+
+
+// --------------- //
+// STREAMING TRACE //
+// --------------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    /// Layout of streamed trace file (native endianness, header followed by append-only blocks)
+    namespace StreamFormat
+    {
+        /// File magic ('KLPT')
+        static constexpr uint32_t Magic = 0x54504c4b;
+        /// File format version
+        static constexpr uint32_t Version = 2;
+        /// Oldest file format version readers accept (lacking encoded frames)
+        static constexpr uint32_t OldestVersion = 1;
+
+
+        /// Block type
+        enum BlockType : uint32_t
+        {
+            /// Marker definition (ID, color, category ID as uint32_t followed by null-terminated name and group name)
+            BlockType_Marker = 1,
+            /// Thread definition (index as uint32_t, padding, thread ID as uint64_t followed by null-terminated group name and name; later definitions override earlier ones)
+            BlockType_Thread = 2,
+            /// Frame (::KLab_Profiling_Trace_FrameInfo followed by its event records)
+            BlockType_Frame = 3,
+            /// End of trace (::KLab_Profiling_Trace_StreamingTraceInfo)
+            BlockType_End = 4,
+            /// Encoded frame (::KLab_Profiling_Trace_FrameInfo followed by ::EncodedFrameHeader and encoded events)
+            BlockType_EncodedFrame = 5
+        };
+
+
+        /// File header
+        struct FileHeader final
+        {
+            /// File magic
+            uint32_t Magic;
+            /// File format version
+            uint32_t Version;
+            /// Size of event record in bytes
+            uint32_t EventRecordSize;
+            /// Reserved
+            uint32_t Reserved;
+        };
+
+
+        /// Block header
+        struct BlockHeader final
+        {
+            /// Block type
+            uint32_t Type;
+            /// Size of block payload in bytes
+            uint32_t Size;
+        };
+
+
+        /// Header of encoded events
+        ///
+        /// Events get delta-encoded into two columns (keeping call structure repeating across frames apart from timestamps):
+        /// structure as varints of thread index and type ('(ThreadIndex << 2) | Type', with type 3 followed by actual type) and marker ID per event,
+        /// followed by timestamps as zig-zagged varint deltas to previous event of same thread (starting from 0 on every frame).
+        /// Block compression only applies to structure column, matching against structure column of previous frame (so frames decode in order).
+        struct EncodedFrameHeader final
+        {
+            /// Compression as ::KLab_Profiling_Trace_StreamCompression
+            uint32_t Compression;
+            /// Size of structure column (before block compression) in bytes
+            uint32_t StructureSize;
+            /// Size of structure column as stored in bytes
+            uint32_t StoredStructureSize;
+        };
+    }
+
+
+    /// Encoder of streamed frames (keeping buffers and previous frame across frames)
+    struct StreamEncoder final
+    {
+        /// Encodes events of frame
+        /// @param records - Event records
+        /// @param recordCount - Number of records
+        /// @param compression - Compression as ::KLab_Profiling_Trace_StreamCompression (other than none)
+        /// @param out - Buffer for ::StreamFormat::EncodedFrameHeader followed by encoded events (replaced)
+        void Encode(const KLab_Profiling_Trace_EventRecord *records, const uint32_t recordCount, const KLab_Profiling_Trace_StreamCompression compression, std::string &out);
+        /// Forgets previous frame (e.g. for new file)
+        void Reset();
+
+        // Last timestamp by thread index
+        std::vector<uint64_t> _timestamps;
+        // Structure column of previous frame followed by structure column being encoded
+        std::string _history;
+        // Timestamp column (staged for appending to structure column)
+        std::string _timestampColumn;
+        // Latest positions by hash of 4-byte sequence (for block compression)
+        std::vector<uint32_t> _positions;
+    };
+
+
+    /// Decoder of streamed frames (expecting frames in order encoded)
+    struct StreamDecoder final
+    {
+        /// Decodes events of encoded frame
+        /// @param data - ::StreamFormat::EncodedFrameHeader followed by encoded events
+        /// @param size - Size of data in bytes
+        /// @param recordCount - Number of records encoded
+        /// @param out - Buffer for records (replaced)
+        /// @return true on success; false on corrupt input
+        bool Decode(const char *data, const size_t size, const uint32_t recordCount, std::vector<KLab_Profiling_Trace_EventRecord> &out);
+        /// Forgets previous frame (e.g. for new file)
+        void Reset();
+
+        // Last timestamp by thread index
+        std::vector<uint64_t> _timestamps;
+        // Structure column of previous frame followed by structure column being decoded
+        std::vector<char> _history;
+    };
+
+
+    /// Lowers priority of calling thread (best effort; e.g. for background writers)
+    void LowerCurrentThreadPriority();
+
+
+    /// Writer of streamed trace files (staging blocks into large sequential writes)
+    struct StreamWriter final
+    {
+        /// Size of staging buffer flushed by single sequential write
+        static constexpr size_t BufferSize = (1 << 20);
+
+
+        /// Opens trace file (truncating it) and stages file header
+        /// @param path - Path of trace file
+        /// @return true on success; false otherwise
+        bool Open(const char *path);
+        /// Writes staged bytes and closes trace file
+        void Close();
+        /// Stages markers and threads not yet written
+        /// @param shouldRewriteThreads - Flag whether to write all threads again (picking up late names)
+        void WriteDefinitions(const bool shouldRewriteThreads);
+        /// Stages block
+        /// @param type - Block type
+        /// @param payload - Payload
+        /// @param payloadSize - Size of payload in bytes
+        /// @param extra - [Optional] Data appended to payload
+        /// @param extraSize - Size of extra data in bytes
+        void WriteBlock(const uint32_t type, const void *payload, const size_t payloadSize, const void *extra = nullptr, const size_t extraSize = 0);
+        /// Writes staged bytes to trace file
+        void Flush();
+
+        // Trace file
+        std::FILE *_file = nullptr;
+        // Staging buffer
+        std::vector<char> _buffer;
+        // Number of bytes staged
+        size_t _bufferLength = 0;
+        // Number of markers written
+        uint32_t _writtenMarkerCount = 0;
+        // Number of threads written
+        uint32_t _writtenThreadCount = 0;
+        // Number of bytes written
+        std::atomic<uint64_t> _bytesWritten = { 0 };
+        // Time spent writing in nanoseconds
+        std::atomic<uint64_t> _writeDurationNs = { 0 };
+        // Flag whether write failed
+        std::atomic<bool> _didFailToWrite = { false };
+
+        // Stages bytes (flushing staging buffer if full)
+        // @param data - Data
+        // @param size - Size of data in bytes
+        void _stage(const void *data, size_t size);
+    };
+
+
+    /// Streaming trace (continuous C# trace drained into binary trace file by background writer)
+    struct StreamingTrace final
+    {
+        /// Flags whether streaming
+        /// @return true if streaming; false otherwise
+        bool IsStreaming() const;
+        /// Wakes writer (e.g. after frame flip; never blocks)
+        void Notify();
+
+        // C# trace streamed from
+        CSharpTrace *_trace = nullptr;
+        // Writer thread
+        std::thread _thread;
+        // Trace file writer
+        StreamWriter _writer;
+        // Buffer frames get dequeued into
+        std::vector<KLab_Profiling_Trace_EventRecord> _records;
+        // Compression of frames
+        KLab_Profiling_Trace_StreamCompression _compression = KLab_Profiling_Trace_StreamCompression_None;
+        // Frame encoder (only used by writer)
+        StreamEncoder _encoder;
+        // Buffer frames get encoded into
+        std::string _encoded;
+        // Guard for wake state
+        std::mutex _wakeMutex;
+        // Wake signal
+        std::condition_variable _wakeCondition;
+        // Flag whether writer got notified
+        bool _isNotified = false;
+        // Flag whether writer should finish
+        bool _isStopRequested = false;
+        // Number of frames written
+        std::atomic<uint64_t> _writtenFrameCount = { 0 };
+        // Number of frames that ran out of chunks
+        std::atomic<uint64_t> _overflowFrameCount = { 0 };
+        // Number of event bytes before compression
+        std::atomic<uint64_t> _rawEventBytes = { 0 };
+        // Number of event bytes after compression
+        std::atomic<uint64_t> _encodedEventBytes = { 0 };
+        // Flag whether streaming
+        std::atomic<bool> _isStreaming = { false };
+
+        // Begins streaming (expecting valid arguments and C# trace not to be enabled)
+        // @param path - Path of trace file
+        // @param frameCount - Number of frame buffers
+        // @param eventsPerFrame - Event capacity of each frame buffer
+        // @param compression - Compression of frames
+        // @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+        KLab_Profiling_ErrorCode _begin(const char *path, const uint32_t frameCount, const uint32_t eventsPerFrame, const KLab_Profiling_Trace_StreamCompression compression);
+        // Ends streaming (blocking until remaining frames are written)
+        void _end();
+        // Gets info on streaming
+        // @return the info
+        KLab_Profiling_Trace_StreamingTraceInfo _getInfo() const;
+        // Runs writer
+        void _run();
+
+        // Defaults construction
+        StreamingTrace() = default;
+        // Prevents copy construction
+        StreamingTrace(const StreamingTrace &) = delete;
+        // Prevents move construction
+        StreamingTrace(StreamingTrace &&) = delete;
+    };
+
+
+    /// Gets streaming trace
+    /// @return the singleton trace
+    StreamingTrace &GetStreamingTrace();
+}}}
+
+
+// --------- //
+// LIVE FEED //
+// --------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    /// Layout of live feed shared memory (native endianness; header, frame ring, marker names, thread names, and thread regions, each aligned to cache line)
+    ///
+    /// Each thread region gets written by its thread only: a record gets written first, then the write sequence gets advanced with release semantics.
+    /// Readers track a read sequence per region: records older than 'WriteSequence - RegionCapacity' got overwritten,
+    /// and records the write sequence advanced past by more than region capacity while reading them got overwritten as well.
+    /// Frames, marker names, and thread names get published by frame flips, with record timestamps in ticks since feed begin.
+    namespace LiveFeedFormat
+    {
+        /// Shared memory magic ('KLLF')
+        static constexpr uint32_t Magic = 0x464c4c4b;
+        /// Shared memory layout version
+        static constexpr uint32_t Version = 1;
+        /// Number of frames kept in frame ring
+        static constexpr uint32_t FrameCapacity = 256;
+        /// Number of marker names (markers with higher ID stay unnamed)
+        static constexpr uint32_t MarkerCapacity = 16384;
+        /// Size of name in bytes (including terminator, longer names get truncated)
+        static constexpr uint32_t NameSize = 64;
+
+
+        /// Feed state
+        enum State : uint32_t
+        {
+            /// Writer publishing
+            State_Publishing = 1,
+            /// Writer ended feed (no more events get published)
+            State_Ended = 2
+        };
+
+
+        /// Shared memory header
+        struct alignas(CacheLineSize) Header final
+        {
+            /// Shared memory magic
+            uint32_t Magic;
+            /// Shared memory layout version
+            uint32_t Version;
+            /// Size of event record in bytes
+            uint32_t EventRecordSize;
+            /// Number of thread regions
+            uint32_t RegionCount;
+            /// Event capacity of each thread region (power of 2)
+            uint32_t RegionCapacity;
+            /// Number of frames kept in frame ring
+            uint32_t FrameCapacity;
+            /// Number of marker names
+            uint32_t MarkerCapacity;
+            /// Size of name in bytes
+            uint32_t NameSize;
+            /// Size of mapping in bytes
+            uint64_t MappingSize;
+            /// Feed state as ::State
+            std::atomic<uint32_t> State;
+            /// Number of markers named
+            std::atomic<uint32_t> MarkerCount;
+            /// Number of threads named
+            std::atomic<uint32_t> ThreadCount;
+            /// Number of frames published (frame of sequence 's' stored at 's % FrameCapacity')
+            std::atomic<uint64_t> FrameSequence;
+            /// Nanoseconds per tick (updated on frame flip)
+            std::atomic<double> NsPerTick;
+        };
+
+
+        /// Frame boundary
+        struct Frame final
+        {
+            /// Frame index
+            uint64_t Index;
+            /// Frame begin in ticks since feed begin
+            uint64_t BeginTicks;
+        };
+
+
+        /// Name of marker or thread
+        struct Name final
+        {
+            /// Name as null-terminated UTF-8 string
+            char Text[NameSize];
+        };
+
+
+        /// Header of thread region (followed by event records)
+        struct alignas(CacheLineSize) RegionHeader final
+        {
+            /// Number of events written (event of sequence 's' stored at 's % RegionCapacity')
+            std::atomic<uint64_t> WriteSequence;
+        };
+
+
+        /// Offsets of sections within shared memory
+        struct Layout final
+        {
+            /// Offset of frame ring in bytes
+            size_t FramesOffset;
+            /// Offset of marker names in bytes
+            size_t MarkerNamesOffset;
+            /// Offset of thread names (one per region) in bytes
+            size_t ThreadNamesOffset;
+            /// Offset of first thread region in bytes
+            size_t RegionsOffset;
+            /// Size of each thread region in bytes
+            size_t RegionSize;
+            /// Size of shared memory in bytes
+            size_t Size;
+        };
+
+
+        /// Computes offsets of sections
+        /// @param regionCount - Number of thread regions
+        /// @param regionCapacity - Event capacity of each thread region
+        /// @return the layout
+        inline Layout GetLayout(const uint32_t regionCount, const uint32_t regionCapacity)
+        {
+            const auto align = [](const size_t offset)
+            {
+                return ((offset + (CacheLineSize - 1)) & ~(CacheLineSize - 1));
+            };
+
+
+            Layout layout;
+
+
+            layout.FramesOffset      = align(sizeof(Header));
+            layout.MarkerNamesOffset = align(layout.FramesOffset + (sizeof(Frame) * FrameCapacity));
+            layout.ThreadNamesOffset = align(layout.MarkerNamesOffset + (sizeof(Name) * MarkerCapacity));
+            layout.RegionsOffset     = align(layout.ThreadNamesOffset + (sizeof(Name) * regionCount));
+            layout.RegionSize        = align(sizeof(RegionHeader) + (sizeof(KLab_Profiling_Trace_EventRecord) * regionCapacity));
+            layout.Size              = (layout.RegionsOffset + (layout.RegionSize * regionCount));
+
+
+            return layout;
+        }
+    }
+
+
+    /// Live feed (publishing events into POSIX shared memory for external reader processes)
+    struct LiveFeed final
+    {
+        /// Maximum number of thread regions
+        static constexpr uint32_t MaxRegionCount = 1024;
+        /// Maximum event capacity of each thread region
+        static constexpr uint32_t MaxRegionCapacity = (1u << 24);
+
+
+        /// Flags whether publishing
+        /// @return true if publishing; false otherwise
+        bool IsPublishing() const;
+        /// Ticks interface (publishing frame boundary and new names)
+        void Flip();
+        /// Handles section enter
+        /// @param thread - Context of calling thread
+        /// @param markerID - Interned marker ID of section
+        void EnterSection(ThreadContext &thread, const uint32_t markerID);
+        /// Handles section leave
+        /// @param thread - Context of calling thread
+        /// @param markerID - Interned marker ID of section
+        void LeaveSection(ThreadContext &thread, const uint32_t markerID);
+
+        // Shared memory mapping of single feed (immutable once published apart from calibration)
+        struct _Mapping final
+        {
+            // Base address
+            char *Base;
+            // Offsets of sections within mapping
+            LiveFeedFormat::Layout Layout;
+            // First thread region
+            char *Regions;
+            // Number of thread regions
+            uint32_t RegionCount;
+            // Mask mapping write sequences to record indices
+            uint32_t RegionMask;
+            // Feed time (reset on begin, calibrated on flips)
+            Stopwatch Timer;
+            // Number of flips when feed ended
+            uint64_t EndFlipCount;
+        };
+
+        // Name of shared memory object
+        std::string _name;
+        // [Optional] Mapping being published into (loaded once per event by writers; null while not publishing)
+        std::atomic<_Mapping *> _activeMapping = { nullptr };
+        // Mappings of ended feeds (unmapped once a full frame passed, as late writers might still write into them)
+        std::vector<_Mapping *> _endedMappings;
+        // Flag whether ended mappings are pending (to not lock guard on flips otherwise)
+        std::atomic<bool> _hasEndedMappings = { false };
+        // Number of flips (counting while mappings are active or pending)
+        uint64_t _flipCount = 0;
+        // Info on last ended feed
+        KLab_Profiling_Trace_LiveFeedInfo _endedInfo = {};
+        // Guard for mappings
+        std::mutex _mutex;
+
+        // Begins publishing (expecting valid arguments)
+        // @param name - Name of shared memory object
+        // @param regionCount - Number of thread regions
+        // @param regionCapacity - Event capacity of each thread region (power of 2)
+        // @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+        KLab_Profiling_ErrorCode _begin(const char *name, const uint32_t regionCount, const uint32_t regionCapacity);
+        // Ends publishing if publishing (unlinking shared memory object)
+        void _end();
+        // Gets info on feed
+        // @return the info
+        KLab_Profiling_Trace_LiveFeedInfo _getInfo();
+        // Gets info on feed (expecting guard held)
+        // @param mapping - Mapping of feed
+        // @return the info
+        KLab_Profiling_Trace_LiveFeedInfo _getInfo(const _Mapping &mapping);
+        // Publishes event into region of calling thread
+        // @param thread - Context of calling thread
+        // @param markerID - Interned marker ID
+        // @param type - Event type
+        void _publish(ThreadContext &thread, const uint32_t markerID, const KLab_Profiling_Trace_EventType type);
+        // Publishes names of new markers and all threads (expecting guard held)
+        // @param mapping - Mapping to publish into
+        void _publishNames(_Mapping &mapping);
+        // Unmaps mappings of feeds ended a full frame ago (expecting guard held)
+        void _unmapEnded();
+
+        // Defaults construction
+        LiveFeed() = default;
+        // Prevents copy construction
+        LiveFeed(const LiveFeed &) = delete;
+        // Prevents move construction
+        LiveFeed(LiveFeed &&) = delete;
+    };
+
+
+    /// Gets live feed
+    /// @return the singleton feed
+    LiveFeed &GetLiveFeed();
+}}}
+
+
+// --------------- //
+// FLIGHT RECORDER //
+// --------------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    /// Flight recorder (continuous C# trace frozen into snapshot on hitch or trigger)
+    struct FlightRecorder final
+    {
+        /// Flags whether recording
+        /// @return true if recording; false otherwise
+        bool IsRecording() const;
+        /// Takes snapshot on hitch or pending trigger and resumes recording once snapshot got taken (after C# trace flip)
+        void Flip();
+        /// Requests snapshot on next flip (never blocks)
+        void Trigger();
+
+        // C# trace recorded into
+        CSharpTrace *_trace = nullptr;
+        // Writer thread
+        std::thread _thread;
+        // Snapshot file writer
+        StreamWriter _writer;
+        // [Optional] Path prefix of snapshot files
+        std::string _pathPrefix;
+        // Frame duration triggering snapshot in nanoseconds (0 if disabled)
+        uint64_t _hitchThresholdNs = 0;
+        // Number of frame buffers
+        uint32_t _frameCount = 0;
+        // Event capacity of each frame buffer
+        uint32_t _eventsPerFrame = 0;
+        // Record capacity of each snapshot frame
+        uint32_t _recordsPerFrame = 0;
+        // Timestamp of last flip in nanoseconds
+        uint64_t _lastFlipNs = 0;
+        // Event records of snapshot (one slice per frame)
+        std::vector<KLab_Profiling_Trace_EventRecord> _records;
+        // Frames of snapshot
+        std::vector<KLab_Profiling_Trace_FrameInfo> _frames;
+        // Event records of snapshot being taken (swapped with ::_records once taken; only touched by writer)
+        std::vector<KLab_Profiling_Trace_EventRecord> _stagedRecords;
+        // Frames of snapshot being taken (likewise)
+        std::vector<KLab_Profiling_Trace_FrameInfo> _stagedFrames;
+        // Number of frames in snapshot
+        uint32_t _snapshotFrameCount = 0;
+        // Index of oldest snapshot frame not yet dequeued
+        uint32_t _dequeuedFrameCount = 0;
+        // Guard for snapshot
+        std::mutex _snapshotMutex;
+        // Guard for wake state
+        std::mutex _wakeMutex;
+        // Wake signal
+        std::condition_variable _wakeCondition;
+        // Flag whether writer should take snapshot
+        bool _isSnapshotRequested = false;
+        // Flag whether writer should finish
+        bool _isStopRequested = false;
+        // Flag whether snapshot is being taken (C# trace frozen)
+        std::atomic<bool> _isSnapshotting = { false };
+        // Flag whether trigger is pending
+        std::atomic<bool> _isTriggered = { false };
+        // Number of snapshots taken
+        std::atomic<uint64_t> _snapshotCount = { 0 };
+        // Number of snapshots skipped
+        std::atomic<uint64_t> _skippedSnapshotCount = { 0 };
+        // Duration of frame that triggered last snapshot in nanoseconds
+        std::atomic<uint64_t> _lastHitchDurationNs = { 0 };
+        // Flag whether recording
+        std::atomic<bool> _isRecording = { false };
+
+        // Begins recording (expecting valid arguments and C# trace not to be enabled)
+        // @param frameCount - Number of frame buffers
+        // @param eventsPerFrame - Event capacity of each frame buffer
+        // @param hitchThresholdNs - Frame duration triggering snapshot in nanoseconds (0 if disabled)
+        // @param pathPrefix - [Optional] Path prefix of snapshot files
+        // @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+        KLab_Profiling_ErrorCode _begin(const uint32_t frameCount, const uint32_t eventsPerFrame, const uint64_t hitchThresholdNs, const char *pathPrefix);
+        // Ends recording (blocking until snapshot being taken got taken)
+        void _end();
+        // Gets info on recorder
+        // @return the info
+        KLab_Profiling_Trace_FlightRecorderInfo _getInfo();
+        // Dequeues oldest snapshot frame
+        // @param recordBuffer - Buffer for compact event records
+        // @param recordBufferCapacity - Capacity of buffer
+        // @param info - Info on frame
+        // @return true if frame dequeued; false if no frame pending
+        bool _dequeueFrame(KLab_Profiling_Trace_EventRecord *recordBuffer, const uint32_t recordBufferCapacity, KLab_Profiling_Trace_FrameInfo &info);
+        // Freezes C# trace and wakes writer
+        // @param hitchDurationNs - Duration of frame triggering snapshot in nanoseconds (0 if triggered explicitly)
+        void _freeze(const uint64_t hitchDurationNs);
+        // Runs writer
+        void _run();
+        // Takes snapshot of frozen C# trace
+        void _takeSnapshot();
+        // Writes snapshot file
+        // @param snapshotIndex - Index of snapshot
+        void _writeSnapshot(const uint64_t snapshotIndex);
+
+        // Defaults construction
+        FlightRecorder() = default;
+        // Prevents copy construction
+        FlightRecorder(const FlightRecorder &) = delete;
+        // Prevents move construction
+        FlightRecorder(FlightRecorder &&) = delete;
+    };
+
+
+    /// Gets flight recorder
+    /// @return the singleton recorder
+    FlightRecorder &GetFlightRecorder();
+}}}
+
+
+// ------------ //
+// TRACE EXPORT //
+// ------------ //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    /// Streams trace events into viewer format (memory bounded by number of threads, not events)
+    struct TraceExporter final
+    {
+        /// Size of staging buffer flushed to file
+        static constexpr size_t FlushThreshold = (64 << 10);
+
+
+        /// Begins export
+        /// @param file - File to write to (kept open)
+        /// @param format - Export format
+        void Begin(std::FILE *file, const KLab_Profiling_Trace_ExportFormat format);
+        /// Names thread (may be called again to rename)
+        /// @param threadID - C-casted thread ID
+        /// @param groupName - Thread group name
+        /// @param name - Thread name
+        void WriteThread(const uint64_t threadID, const char *groupName, const char *name);
+        /// Writes event
+        /// @param type - Trace event type
+        /// @param timestampNs - Timestamp in nanoseconds
+        /// @param threadID - C-casted thread ID
+        /// @param name - Section name
+        /// @param groupName - Section group name (mapped to category)
+        /// @param color - RGBA color
+        void WriteEvent(const uint32_t type, const uint64_t timestampNs, const uint64_t threadID, const char *name, const char *groupName, const uint32_t color);
+        /// Ends export (flushing output)
+        /// @return true on success; false if writing failed
+        bool End();
+
+        // File
+        std::FILE *_file = nullptr;
+        // Export format
+        KLab_Profiling_Trace_ExportFormat _format = KLab_Profiling_Trace_ExportFormat_ChromeJson;
+        // Staging buffer
+        std::string _buffer;
+        // Scratch buffer for nested protobuf messages
+        std::string _message;
+        // Dense track indices by thread ID
+        std::unordered_map<uint64_t, uint32_t> _tracks;
+        // Flag whether any JSON event got written
+        bool _hasWrittenEvent = false;
+
+        // Gets track of thread (describing it on first use)
+        // @param threadID - C-casted thread ID
+        // @return the dense track index
+        uint32_t _getTrack(const uint64_t threadID);
+        // Writes track descriptor
+        // @param track - Track index
+        // @param name - Track name
+        void _writeTrack(const uint32_t track, const char *name);
+        // Writes staging buffer to file once full
+        // @param shouldForce - Flag whether to write regardless of threshold
+        void _flush(const bool shouldForce);
+    };
+
+
+    /// Exports streamed trace file in single pass
+    /// @param input - Streamed trace file
+    /// @param output - Output file
+    /// @param format - Export format
+    /// @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+    KLab_Profiling_ErrorCode ExportStream(std::FILE *input, std::FILE *output, const KLab_Profiling_Trace_ExportFormat format);
+}}}
+
+
+// ------------ //
+// EXTERN TRACE //
+// ------------ //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    /// Tries to get extern trace interface
+    /// @return the interface if available; null otherwise
+    inline IExternTrace *TryGetExternTrace()
+    {
+        static IExternTrace *trace = nullptr;
+
+
+        #if KLAB_PROFILING_HAS_EXTERN_TRACE
+        if (!trace)
+        {
+            trace = &LoadExternTrace();
+        }
+        #endif
+
+
+        return trace;
+    }
+}}}
+
+
+// ------------------ //
+// ASYNC EXTERN TRACE //
+// ------------------ //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    /// Single-producer single-consumer queue of events of single thread
+    struct alignas(CacheLineSize) ThreadExternQueue final
+    {
+        /// Capacity in events (power of 2)
+        static constexpr uint32_t Capacity = 4096;
+
+
+        /// Queued event
+        struct Entry final
+        {
+            /// Interned marker ID
+            uint32_t MarkerID;
+            /// Event type
+            uint32_t Type;
+            /// Ticks of event (captured on queueing)
+            uint64_t Ticks;
+        };
+
+
+        /// Read position (written by consumer)
+        alignas(CacheLineSize) std::atomic<uint32_t> Head;
+        /// Write position (written by producer)
+        alignas(CacheLineSize) std::atomic<uint32_t> Tail;
+        /// Read position last seen by producer (producer only)
+        uint32_t CachedHead;
+        /// Session producer state belongs to (producer only)
+        uint32_t Session;
+        /// Number of open sections (producer only)
+        uint32_t Depth;
+        /// Number of open sections whose enter got queued (each reserving an entry for its leave; producer only)
+        uint32_t QueuedDepth;
+        /// Depth events get dropped from until unwound (0 if not dropping; producer only)
+        uint32_t DropDepth;
+        /// C-casted thread ID
+        uint64_t ThreadID;
+        /// Next queue of all queues
+        ThreadExternQueue *Next;
+        /// Entries
+        Entry Entries[Capacity];
+    };
+
+
+    /// Extern trace delivered from consumer thread instead of marker callbacks
+    struct AsyncExternTrace final
+    {
+        /// Maximum time producers wait for free entries in microseconds (bounding stall of marker callbacks)
+        static constexpr uint32_t MaxBlockTimeoutUs = 1000;
+
+
+        /// Flags whether running
+        /// @return true if running; false otherwise
+        bool IsRunning() const;
+        /// Wakes consumer (e.g. after frame flip; never blocks)
+        void Notify();
+        /// Handles section enter
+        /// @param thread - Context of calling thread
+        /// @param markerID - Interned marker ID
+        void EnterSection(ThreadContext &thread, const uint32_t markerID);
+        /// Handles section leave
+        /// @param thread - Context of calling thread
+        /// @param markerID - Interned marker ID
+        void LeaveSection(ThreadContext &thread, const uint32_t markerID);
+
+        // Extern trace delivered to
+        IExternTrace *_trace = nullptr;
+        // Consumer thread
+        std::thread _thread;
+        // Backpressure policy
+        KLab_Profiling_Trace_BackpressurePolicy _policy = KLab_Profiling_Trace_BackpressurePolicy_Drop;
+        // Time producers wait for free entries before dropping in nanoseconds (block policy only)
+        uint64_t _blockNs = 0;
+        // Timer converting ticks of events to steady clock time (calibrated by consumer)
+        Stopwatch _timer;
+        // Queues of all threads (never freed while running)
+        std::atomic<ThreadExternQueue *> _queues = { nullptr };
+        // Session counter (resetting producer state of queues on begin)
+        std::atomic<uint32_t> _session = { 0 };
+        // Guard for wake state
+        std::mutex _wakeMutex;
+        // Wake signal
+        std::condition_variable _wakeCondition;
+        // Flag whether consumer got notified
+        bool _isNotified = false;
+        // Flag whether consumer should finish
+        bool _isStopRequested = false;
+        // Number of events delivered
+        std::atomic<uint64_t> _deliveredEventCount = { 0 };
+        // Number of events dropped
+        std::atomic<uint64_t> _droppedEventCount = { 0 };
+        // Number of events queued at once at most (sampled by consumer)
+        std::atomic<uint32_t> _maxQueueDepth = { 0 };
+        // Flag whether running
+        std::atomic<bool> _isRunning = { false };
+
+        // Begins delivering (expecting valid arguments and extern trace to be available)
+        // @param trace - Extern trace
+        // @param policy - Backpressure policy
+        // @param blockTimeoutUs - Time producers wait for free entries before dropping in microseconds (block policy only)
+        // @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+        KLab_Profiling_ErrorCode _begin(IExternTrace &trace, const KLab_Profiling_Trace_BackpressurePolicy policy, const uint32_t blockTimeoutUs);
+        // Ends delivering (blocking until queued events are delivered)
+        void _end();
+        // Gets info on delivery
+        // @return the info
+        KLab_Profiling_Trace_AsyncExternTraceInfo _getInfo() const;
+        // Runs consumer
+        void _run();
+        // Converts ticks of event to steady clock time (consumer only)
+        // @param ticks - Ticks of event
+        // @return the time in nanoseconds
+        uint64_t _toSteadyNs(const uint64_t ticks) const;
+        // Delivers queued events of all threads
+        // @return the number of events delivered
+        uint32_t _drain();
+        // Queues event
+        // @param queue - Queue of calling thread
+        // @param entry - Event
+        // @param reservedCount - Number of entries to keep free besides event
+        // @return true if queued; false if dropped
+        bool _enqueue(ThreadExternQueue &queue, const ThreadExternQueue::Entry &entry, const uint32_t reservedCount);
+        // Gets queue of calling thread
+        // @param thread - Context of calling thread
+        // @return a valid pointer on success; null on out-of-memory
+        ThreadExternQueue *_getThreadQueue(ThreadContext &thread);
+
+        // Defaults construction
+        AsyncExternTrace() = default;
+        // Prevents copy construction
+        AsyncExternTrace(const AsyncExternTrace &) = delete;
+        // Prevents move construction
+        AsyncExternTrace(AsyncExternTrace &&) = delete;
+    };
+
+
+    /// Gets asynchronous extern trace
+    /// @return the singleton trace
+    AsyncExternTrace &GetAsyncExternTrace();
+}}}
+
+
+// ----- //
+// UTILS //
+// ----- //
+
+namespace KLab { namespace Profiling { namespace Utils
+{
+    /// Utility functions interface
+    typedef IExternUtils IUtils;
+
+
+    /// Converts UTF-16 string to UTF-8 (vectorized for ASCII runs)
+    /// @param utf8String - Output buffer
+    /// @param utf8Capacity - Capacity of output buffer in bytes (including terminator)
+    /// @param utf16String - Input string
+    /// @param utf16Length - Length of input string in characters (stops early at terminator)
+    /// @return the number of bytes written (excluding terminator)
+    /// @remarks Lone surrogates are replaced with U+FFFD; truncation never splits code point
+    size_t ConvertUtf16ToUtf8(char *utf8String, size_t utf8Capacity, const char16_t *utf16String, size_t utf16Length);
+    /// Checks whether UTF-16 string converts to UTF-8 string (as by ::ConvertUtf16ToUtf8 without truncation; vectorized for ASCII runs)
+    /// @param utf8String - UTF-8 string (without embedded terminator)
+    /// @param utf8Length - Length of UTF-8 string in bytes
+    /// @param utf16String - UTF-16 string
+    /// @param utf16Length - Length of UTF-16 string in characters (stops early at terminator)
+    /// @return true if matching; false otherwise
+    bool MatchesUtf16(const char *utf8String, size_t utf8Length, const char16_t *utf16String, size_t utf16Length);
+
+
+    /// Gets utility interface
+    /// @return the singleton interface
+    IUtils &GetUtils();
+}}}
+
+
+// -------------- //
+// PLUGIN CONTEXT //
+// -------------- //
+
+namespace KLab { namespace Profiling { namespace Plugin
+{
+    /// Trace sinks marker events get dispatched to (combined as flags)
+    enum Sink : uint32_t
+    {
+        /// Android native trace
+        Sink_ATrace = (1u << 0),
+        /// C# trace (including continuous and streaming trace)
+        Sink_CSharp = (1u << 1),
+        /// Statistics trace
+        Sink_Stats = (1u << 2),
+        /// Extern trace
+        Sink_Extern = (1u << 3),
+        /// Batch trace (runtime attached sinks)
+        Sink_Batch = (1u << 4),
+        /// Extern trace delivered asynchronously (set along ::Sink_Extern while running)
+        Sink_AsyncExtern = (1u << 5),
+        /// Histogram trace (registered on chosen markers only)
+        Sink_Histogram = (1u << 6),
+        /// Allocation trace (only sink registered on 'GC.Alloc')
+        Sink_Alloc = (1u << 7),
+        /// Call tree trace
+        Sink_CallTree = (1u << 8),
+        /// Live feed
+        Sink_LiveFeed = (1u << 9)
+    };
+
+
+    /// Plugin context
+    struct PluginContext final
+    {
+        // Section metadata of Unity marker descriptor resolved once at creation (passed as callback user data)
+        struct MarkerRecord final
+        {
+            // Section info (without thread ID)
+            Trace::SectionInfo Section;
+            // Interned marker ID
+            uint32_t MarkerID;
+            // Sinks of registered event callback variant (0 if not registered; read by marker callbacks to check unspecialized sinks)
+            std::atomic<uint32_t> RegisteredSinks = { 0 };
+            // Histogram ID of marker (0 if not chosen for histogram trace; published before sinks referring it)
+            std::atomic<uint32_t> HistogramID = { 0 };
+            // Flag whether to capture metadata of marker (updated under guard while marker callbacks read it)
+            std::atomic<uint32_t> CapturesMetadata = { 0 };
+            // Flag whether marker samples managed allocations ('GC.Alloc')
+            uint32_t IsAllocation;
+        };
+
+
+
+        /// Unity context
+        struct
+        {
+            /// Unity interfaces
             IUnityInterfaces *Interfaces = nullptr;
             /// Profiler callbacks
             IUnityProfilerCallbacks *ProfilerCallbacks = nullptr;
@@ -333,13 +2778,49 @@ namespace KLab { namespace Profiling { namespace Plugin
             Trace::ATrace *ATrace = nullptr;
             // C# trace interface
             Trace::CSharpTrace *CSharpTrace = nullptr;
+            // Streaming trace
+            Trace::StreamingTrace *StreamingTrace = nullptr;
+            // Flight recorder
+            Trace::FlightRecorder *FlightRecorder = nullptr;
+            // Statistics trace
+            Trace::StatsTrace *StatsTrace = nullptr;
+            // Batch trace
+            Trace::BatchTrace *BatchTrace = nullptr;
+            // Histogram trace
+            Trace::HistogramTrace *HistogramTrace = nullptr;
+            // Allocation trace
+            Trace::AllocTrace *AllocTrace = nullptr;
+            // Call tree trace
+            Trace::CallTreeTrace *CallTreeTrace = nullptr;
+            // Live feed
+            Trace::LiveFeed *LiveFeed = nullptr;
             // [Optional] Extern trace interface
             Trace::IExternTrace *ExternTrace = nullptr;
-            // Marker groups
-            // INV How much capacity is needed?
-            FixedCapacityList<KLab::Profiling::Trace::SectionGroupInfo, 64> SectionGroups;
+            // Asynchronous extern trace delivery
+            Trace::AsyncExternTrace *AsyncExternTrace = nullptr;
+            // Interned markers
+            Trace::MarkerTable *Markers = nullptr;
+            // Known marker descriptors (records never move as nodes are never erased)
+            std::unordered_map<const UnityProfilerMarkerDesc *, MarkerRecord> MarkerDescriptors;
+            // Filter selecting markers to register on (guarded by marker descriptor guard)
+            Trace::MarkerFilter MarkerFilter;
+            // Filter selecting markers to capture metadata of (capturing none if empty; guarded by marker descriptor guard)
+            Trace::MarkerFilter MetadataFilter;
+            // Sinks marker events are dispatched to (0 if not registering; guarded by marker descriptor guard)
+            uint32_t ActiveSinks = 0;
+            // Guard for marker descriptors
+            std::mutex MarkerDescriptorsMutex;
+            // Unity categories
+            Trace::CategoryTable *Categories = nullptr;
         }
         Trace;
+        // Frame boundary context
+        struct
+        {
+            // Number of frames flipped by Unity frame callback since last C# update (C# update only flipping if none)
+            std::atomic<uint32_t> CallbackFlipCount = { 0 };
+        }
+        Frame;
         // Utilities
         Utils::IUtils *Utils;
 
@@ -367,7 +2848,19 @@ namespace KLab { namespace Profiling { namespace Plugin
     /// @return the singleton instance
     PluginContext &CreatePluginContext(IUnityInterfaces *unity);
 
+    // Plugin context singleton (namespace scope to keep hot path free of guard checks)
+    extern PluginContext _pluginContext;
+
+
     /// Gets plugin context
     /// @return the singleton context
-    PluginContext &GetPluginContext();
+    inline PluginContext &GetPluginContext()
+    {
+        return _pluginContext;
+    }
+
+
+    /// Registers marker event callbacks specialized for currently active sinks (if changed)
+    /// Called every update and right after enabling a sink to not miss events until next update.
+    void UpdateMarkerDispatch();
 }}}
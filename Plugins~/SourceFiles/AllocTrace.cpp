@@ -0,0 +1,616 @@
+// -------------------------------------------------------------------------------------------- //
+//  Copyright (c) KLab Inc.. All rights reserved.                                               //
+//  Licensed under the MIT License. See 'LICENSE' in the project root for license information.  //
+// -------------------------------------------------------------------------------------------- //
+
+#include <KLab/Profiling/Internal.hpp>
+
+
+// -------- //
+// INCLUDES //
+// -------- //
+
+#include <algorithm>
+#include <cstring>
+
+#include <IUnityInterface.h>
+#include <IUnityProfilerCallbacks.h>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    // Tries to get size of allocation sample
+    // @param data - Sample data
+    // @param dataCount - Number of data
+    // @param size - Buffer for size in bytes
+    // @return true if sample holds integral datum; false otherwise
+    static bool _tryGetAllocationSize(const UnityProfilerMarkerData *data, const uint16_t dataCount, uint64_t &size)
+    {
+        for (uint16_t d = 0; d < dataCount; ++d)
+        {
+            switch (data[d].type)
+            {
+                case kUnityProfilerMarkerDataTypeInt32:
+                case kUnityProfilerMarkerDataTypeUInt32:
+                {
+                    uint32_t value = 0;
+
+
+                    if (data[d].size >= sizeof(value))
+                    {
+                        std::memcpy(&value, data[d].ptr, sizeof(value));
+
+
+                        size = value;
+
+
+                        return true;
+                    }
+                    break;
+                }
+
+                case kUnityProfilerMarkerDataTypeInt64:
+                case kUnityProfilerMarkerDataTypeUInt64:
+                {
+                    uint64_t value = 0;
+
+
+                    if (data[d].size >= sizeof(value))
+                    {
+                        std::memcpy(&value, data[d].ptr, sizeof(value));
+
+
+                        size = value;
+
+
+                        return true;
+                    }
+                    break;
+                }
+            }
+        }
+
+
+        return false;
+    }
+
+
+    // Makes key of path by parent and marker
+    // @param parentID - ID of parent path
+    // @param markerID - Interned marker ID
+    // @return the key
+    static inline uint64_t _toPathKey(const uint32_t parentID, const uint32_t markerID)
+    {
+        return ((uint64_t(parentID) << 32) | markerID);
+    }
+}}}
+
+
+// ----------- //
+// ALLOC TRACE //
+// ----------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    bool AllocTrace::IsTracing() const
+    {
+        return _isTracing.load(std::memory_order_relaxed);
+    }
+
+
+    void AllocTrace::Flip()
+    {
+        if (!IsTracing())
+        {
+            return;
+        }
+
+
+        // Seal frame currently recorded
+        const uint64_t frame = _frameIndex.load(std::memory_order_relaxed);
+
+
+        _frameIndex.store((frame + 1), std::memory_order_release);
+
+
+        // Merge frame sealed on previous flip (as late writers might have still committed to it)
+        if (frame > 0)
+        {
+            _merge(uint32_t((frame - 1) % ThreadAllocs::SetCount), (frame - 1));
+        }
+    }
+
+
+    void AllocTrace::EnterSection(ThreadContext &thread, const uint32_t markerID)
+    {
+        auto allocs = _getThreadAllocs(thread);
+
+
+        if (!allocs)
+        {
+            return;
+        }
+
+
+        // Intern path once per thread (attributing allocations of deeper sections to deepest tracked section)
+        if (allocs->Depth < ThreadAllocs::MaxDepth)
+        {
+            const uint32_t parentID = (allocs->Depth ? allocs->Stack[allocs->Depth - 1] : uint32_t(KLab_Profiling_Trace_RootAllocationPathID));
+
+
+            allocs->Stack[allocs->Depth] = _internPath(*allocs, parentID, markerID);
+        }
+
+
+        ++allocs->Depth;
+    }
+
+
+    void AllocTrace::LeaveSection(ThreadContext &thread)
+    {
+        auto allocs = _getThreadAllocs(thread);
+
+
+        // Ignore sections entered before trace began
+        if (!allocs || !allocs->Depth)
+        {
+            return;
+        }
+
+
+        --allocs->Depth;
+    }
+
+
+    void AllocTrace::RecordAllocation(ThreadContext &thread, const UnityProfilerMarkerData *data, const uint16_t dataCount)
+    {
+        uint64_t size   = 0;
+        auto     allocs = _getThreadAllocs(thread);
+
+
+        if (!allocs || !_tryGetAllocationSize(data, dataCount, size))
+        {
+            return;
+        }
+
+
+        // Accumulate into set of current frame
+        const uint32_t depth       = ((allocs->Depth < ThreadAllocs::MaxDepth) ? allocs->Depth : ThreadAllocs::MaxDepth);
+        const uint32_t pathID      = (depth ? allocs->Stack[depth - 1] : uint32_t(KLab_Profiling_Trace_RootAllocationPathID));
+        auto          &set         = allocs->Sets[_frameIndex.load(std::memory_order_acquire) % ThreadAllocs::SetCount];
+        auto           accumulator = ((pathID != MarkerTable::InvalidID) ? set.Paths.GetOrCreate(pathID) : nullptr);
+
+
+        if (!accumulator)
+        {
+            set.DidRunOutOfPaths = true;
+
+
+            return;
+        }
+
+
+        if (!accumulator->Count)
+        {
+            set.TouchedIDs.push_back(pathID);
+        }
+
+
+        ++accumulator->Count;
+
+        accumulator->Bytes += size;
+    }
+
+
+    void AllocTrace::_enable()
+    {
+        std::lock_guard<std::mutex> lock(_resultsMutex);
+
+
+        // Clear accumulators and merged paths left by previous trace
+        for (auto allocs = _threads.load(std::memory_order_acquire); allocs; allocs = allocs->Next)
+        {
+            for (auto &set : allocs->Sets)
+            {
+                for (const uint32_t id : set.TouchedIDs)
+                {
+                    *set.Paths.TryGet(id) = ThreadAllocs::Accumulator();
+                }
+
+
+                set.TouchedIDs.clear();
+
+                set.DidRunOutOfPaths = false;
+            }
+
+
+            allocs->MergedIDs.clear();
+        }
+
+
+        for (const auto &result : _results)
+        {
+            _resultIndices[result.PathID] = 0;
+        }
+
+
+        _results.clear();
+        _paths.assign(1, { KLab_Profiling_Trace_RootAllocationPathID, MarkerTable::InvalidID });
+        _pathIDs.clear();
+
+        _resultInfo = {};
+        _hasResults = false;
+
+
+        // Initialize state
+        _frameIndex.store(0, std::memory_order_relaxed);
+        _generation.fetch_add(1, std::memory_order_acq_rel);
+        _isTracing.store(true, std::memory_order_release);
+    }
+
+
+    void AllocTrace::_disable()
+    {
+        _isTracing.store(false, std::memory_order_release);
+    }
+
+
+    bool AllocTrace::_getResults(AllocationStats *statsBuffer, const uint32_t statsBufferCapacity, KLab_Profiling_Trace_AllocationFrameInfo &info)
+    {
+        std::lock_guard<std::mutex> lock(_resultsMutex);
+
+
+        info           = _resultInfo;
+        info.IsTracing = IsTracing();
+
+
+        if (statsBuffer)
+        {
+            std::copy(_results.begin(), (_results.begin() + std::min(statsBufferCapacity, info.PathCount)), statsBuffer);
+        }
+
+
+        return _hasResults;
+    }
+
+
+    ThreadAllocs *AllocTrace::_getThreadAllocs(ThreadContext &thread)
+    {
+        auto allocs = thread.Allocs;
+
+
+        // Create and register accumulators on first use
+        if (!allocs)
+        {
+            allocs = NewAlignedArray<ThreadAllocs>(1);
+
+
+            if (!allocs)
+            {
+                return nullptr;
+            }
+
+
+            // Intern root path
+            auto root = allocs->Paths.GetOrCreate(KLab_Profiling_Trace_RootAllocationPathID);
+
+
+            if (!root)
+            {
+                DeleteAlignedArray(allocs, 1);
+
+
+                return nullptr;
+            }
+
+
+            *root = { KLab_Profiling_Trace_RootAllocationPathID, MarkerTable::InvalidID };
+
+            allocs->PathCount = 1;
+
+
+            auto head = _threads.load(std::memory_order_relaxed);
+
+
+            do
+            {
+                allocs->Next = head;
+            }
+            while (!_threads.compare_exchange_weak(head, allocs, std::memory_order_release, std::memory_order_relaxed));
+
+
+            thread.Allocs = allocs;
+        }
+
+
+        // Drop sections of previous trace
+        const uint32_t generation = _generation.load(std::memory_order_acquire);
+
+
+        if (allocs->Generation != generation)
+        {
+            allocs->Generation = generation;
+            allocs->Depth      = 0;
+        }
+
+
+        return allocs;
+    }
+
+
+    uint32_t AllocTrace::_internPath(ThreadAllocs &allocs, const uint32_t parentID, const uint32_t markerID)
+    {
+        // Children of dropped paths get dropped as well
+        if (parentID == MarkerTable::InvalidID)
+        {
+            return MarkerTable::InvalidID;
+        }
+
+
+        const uint64_t key   = _toPathKey(parentID, markerID);
+        auto           known = allocs.PathIDs.find(key);
+
+
+        if (known != allocs.PathIDs.end())
+        {
+            return known->second;
+        }
+
+
+        // Store path before it gets referenced (as merging reads paths of other threads)
+        auto path = allocs.Paths.GetOrCreate(allocs.PathCount);
+
+
+        if (!path)
+        {
+            return MarkerTable::InvalidID;
+        }
+
+
+        *path = { parentID, markerID };
+
+        allocs.PathIDs.emplace(key, allocs.PathCount);
+
+
+        return allocs.PathCount++;
+    }
+
+
+    uint32_t AllocTrace::_mergePath(ThreadAllocs &allocs, const uint32_t localID)
+    {
+        if (localID >= allocs.MergedIDs.size())
+        {
+            allocs.MergedIDs.resize((localID + 1), 0);
+        }
+        if (allocs.MergedIDs[localID])
+        {
+            return (allocs.MergedIDs[localID] - 1);
+        }
+
+
+        uint32_t pathID = KLab_Profiling_Trace_RootAllocationPathID;
+
+
+        // Merge ancestors first
+        if (localID != KLab_Profiling_Trace_RootAllocationPathID)
+        {
+            const auto     path     = *allocs.Paths.TryGet(localID);
+            const uint32_t parentID = _mergePath(allocs, path.ParentID);
+            const uint64_t key      = _toPathKey(parentID, path.MarkerID);
+            auto           known    = _pathIDs.find(key);
+
+
+            if (known != _pathIDs.end())
+            {
+                pathID = known->second;
+            }
+            else
+            {
+                pathID = uint32_t(_paths.size());
+
+                _paths.push_back({ parentID, path.MarkerID });
+                _pathIDs.emplace(key, pathID);
+            }
+        }
+
+
+        allocs.MergedIDs[localID] = (pathID + 1);
+
+
+        return pathID;
+    }
+
+
+    AllocationStats &AllocTrace::_getResult(const uint32_t pathID)
+    {
+        if (pathID >= _resultIndices.size())
+        {
+            _resultIndices.resize((pathID + 1), 0);
+        }
+        if (_resultIndices[pathID])
+        {
+            return _results[_resultIndices[pathID] - 1];
+        }
+
+
+        const auto path = _paths[pathID];
+
+
+        // Add ancestors first (so parents precede children)
+        if (pathID != KLab_Profiling_Trace_RootAllocationPathID)
+        {
+            _getResult(path.ParentID);
+        }
+
+
+        AllocationStats result = {};
+
+
+        result.PathID       = pathID;
+        result.ParentPathID = path.ParentID;
+        result.MarkerID     = path.MarkerID;
+
+
+        _results.push_back(result);
+
+        _resultIndices[pathID] = uint32_t(_results.size());
+
+
+        return _results.back();
+    }
+
+
+    void AllocTrace::_merge(const uint32_t set, const uint64_t frameIndex)
+    {
+        std::lock_guard<std::mutex> lock(_resultsMutex);
+
+
+        // Clear previous frame
+        for (const auto &result : _results)
+        {
+            _resultIndices[result.PathID] = 0;
+        }
+
+
+        _results.clear();
+
+
+        KLab_Profiling_Trace_AllocationFrameInfo info = {};
+
+
+        // Merge threads
+        for (auto allocs = _threads.load(std::memory_order_acquire); allocs; allocs = allocs->Next)
+        {
+            auto &accumulators = allocs->Sets[set];
+
+
+            for (const uint32_t id : accumulators.TouchedIDs)
+            {
+                auto          &accumulator = *accumulators.Paths.TryGet(id);
+                const uint32_t pathID      = _mergePath(*allocs, id);
+                auto          &result      = _getResult(pathID);
+
+
+                result.Count += accumulator.Count;
+                result.Bytes += accumulator.Bytes;
+
+
+                // Accumulate inclusive bytes up to root (ancestors already added)
+                for (uint32_t p = pathID;; p = _paths[p].ParentID)
+                {
+                    _results[_resultIndices[p] - 1].TotalBytes += accumulator.Bytes;
+
+
+                    if (p == KLab_Profiling_Trace_RootAllocationPathID)
+                    {
+                        break;
+                    }
+                }
+
+
+                info.TotalBytes += accumulator.Bytes;
+                info.TotalCount += accumulator.Count;
+
+
+                accumulator = ThreadAllocs::Accumulator();
+            }
+
+
+            if (accumulators.DidRunOutOfPaths)
+            {
+                info.DidRunOutOfPaths = 1;
+            }
+
+
+            accumulators.TouchedIDs.clear();
+
+            accumulators.DidRunOutOfPaths = false;
+        }
+
+
+        info.FrameIndex = frameIndex;
+        info.PathCount  = uint32_t(_results.size());
+
+        _resultInfo = info;
+        _hasResults = true;
+    }
+
+
+    AllocTrace &GetAllocTrace()
+    {
+        static AllocTrace trace;
+
+
+        return trace;
+    }
+}}}
+
+
+// ----- //
+// TRACE //
+// ----- //
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginAllocationTrace()
+{
+    auto &trace = KLab::Profiling::Trace::GetAllocTrace();
+
+
+    // Validate state
+    if (trace.IsTracing())
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    trace._enable();
+
+
+    // Dispatch events right away (instead of from next update)
+    KLab::Profiling::Plugin::UpdateMarkerDispatch();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_EndAllocationTrace()
+{
+    auto &trace = KLab::Profiling::Trace::GetAllocTrace();
+
+
+    // Validate state
+    if (!trace.IsTracing())
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    trace._disable();
+
+
+    // Stop dispatching right away (instead of from next update)
+    KLab::Profiling::Plugin::UpdateMarkerDispatch();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetAllocationFrame(KLab_Profiling_Trace_AllocationStats *statsBuffer, const int32_t statsBufferSize, KLab_Profiling_Trace_AllocationFrameInfo *info)
+{
+    // Validate arguments
+    if (!info || (statsBuffer && (statsBufferSize <= 0)))
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    const bool hasResults = KLab::Profiling::Trace::GetAllocTrace()._getResults(statsBuffer, (statsBuffer ? uint32_t(statsBufferSize) : 0u), *info);
+
+
+    return (hasResults ? KLab_Profiling_ErrorCode_NoError : KLab_Profiling_ErrorCode_NotAvailable);
+}
@@ -0,0 +1,539 @@
+// -------------------------------------------------------------------------------------------- //
+//  Copyright (c) KLab Inc.. All rights reserved.                                               //
+//  Licensed under the MIT License. See 'LICENSE' in the project root for license information.  //
+// -------------------------------------------------------------------------------------------- //
+
+#include <KLab/Profiling/Internal.hpp>
+
+
+// ------------------ //
+// ASYNC EXTERN TRACE //
+// ------------------ //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    bool AsyncExternTrace::IsRunning() const
+    {
+        return _isRunning.load(std::memory_order_acquire);
+    }
+
+
+    void AsyncExternTrace::Notify()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+
+
+            _isNotified = true;
+        }
+
+
+        _wakeCondition.notify_one();
+    }
+
+
+    void AsyncExternTrace::EnterSection(ThreadContext &thread, const uint32_t markerID)
+    {
+        auto queue = _getThreadQueue(thread);
+
+
+        if (!queue)
+        {
+            _droppedEventCount.fetch_add(1, std::memory_order_relaxed);
+
+
+            return;
+        }
+
+
+        ++queue->Depth;
+
+
+        // Drop nested sections of dropped section to keep delivered sections balanced
+        if (queue->DropDepth)
+        {
+            _droppedEventCount.fetch_add(1, std::memory_order_relaxed);
+
+
+            return;
+        }
+
+
+        // Queue enter only if its leave is guaranteed to fit as well
+        const ThreadExternQueue::Entry entry = { markerID, KLab_Profiling_Trace_EventType_EnterSection };
+
+
+        if (_enqueue(*queue, entry, (queue->QueuedDepth + 1)))
+        {
+            ++queue->QueuedDepth;
+        }
+        else
+        {
+            queue->DropDepth = queue->Depth;
+
+            _droppedEventCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+
+    void AsyncExternTrace::LeaveSection(ThreadContext &thread, const uint32_t markerID)
+    {
+        auto queue = _getThreadQueue(thread);
+
+
+        if (!queue)
+        {
+            _droppedEventCount.fetch_add(1, std::memory_order_relaxed);
+
+
+            return;
+        }
+
+
+        const ThreadExternQueue::Entry entry = { markerID, KLab_Profiling_Trace_EventType_LeaveSection };
+
+
+        // Leave of section entered before queue got used (nothing reserved)
+        if (!queue->Depth)
+        {
+            if (!_enqueue(*queue, entry, queue->QueuedDepth))
+            {
+                _droppedEventCount.fetch_add(1, std::memory_order_relaxed);
+            }
+
+
+            return;
+        }
+
+
+        // Leave of dropped section
+        if (queue->DropDepth)
+        {
+            if (queue->Depth == queue->DropDepth)
+            {
+                queue->DropDepth = 0;
+            }
+
+
+            --queue->Depth;
+
+            _droppedEventCount.fetch_add(1, std::memory_order_relaxed);
+
+
+            return;
+        }
+
+
+        // Leave of queued section (using entry reserved by its enter)
+        --queue->Depth;
+        --queue->QueuedDepth;
+
+
+        _enqueue(*queue, entry, queue->QueuedDepth);
+    }
+
+
+    KLab_Profiling_ErrorCode AsyncExternTrace::_begin(IExternTrace &trace, const KLab_Profiling_Trace_BackpressurePolicy policy, const uint32_t blockTimeoutUs)
+    {
+        // Initialize state
+        _trace           = &trace;
+        _policy          = policy;
+        _blockNs         = (uint64_t(blockTimeoutUs) * 1000);
+        _isNotified      = false;
+        _isStopRequested = false;
+
+        _timer.Reset();
+
+        _deliveredEventCount = 0;
+        _droppedEventCount   = 0;
+        _maxQueueDepth       = 0;
+
+
+        // Discard events queued after last end and let producers reset their state
+        for (auto queue = _queues.load(std::memory_order_acquire); queue; queue = queue->Next)
+        {
+            queue->Head.store(queue->Tail.load(std::memory_order_acquire), std::memory_order_release);
+        }
+
+
+        _session.fetch_add(1, std::memory_order_release);
+
+
+        // Start consumer
+        _isRunning = true;
+        _thread    = std::thread(&AsyncExternTrace::_run, this);
+
+
+        return KLab_Profiling_ErrorCode_NoError;
+    }
+
+
+    void AsyncExternTrace::_end()
+    {
+        _isRunning = false;
+
+
+        // Let consumer drain remaining events
+        {
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+
+
+            _isStopRequested = true;
+        }
+
+
+        _wakeCondition.notify_one();
+        _thread.join();
+    }
+
+
+    KLab_Profiling_Trace_AsyncExternTraceInfo AsyncExternTrace::_getInfo() const
+    {
+        uint32_t queueDepth = 0;
+        uint32_t queueCount = 0;
+
+
+        for (auto queue = _queues.load(std::memory_order_acquire); queue; queue = queue->Next)
+        {
+            queueDepth += (queue->Tail.load(std::memory_order_acquire) - queue->Head.load(std::memory_order_acquire));
+            queueCount += 1;
+        }
+
+
+        return
+        {
+            _deliveredEventCount.load(std::memory_order_relaxed),
+            _droppedEventCount.load(std::memory_order_relaxed),
+            queueDepth,
+            _maxQueueDepth.load(std::memory_order_relaxed),
+            queueCount,
+            _isRunning.load(std::memory_order_relaxed)
+        };
+    }
+
+
+    void AsyncExternTrace::_run()
+    {
+        for (bool isStopRequested = false; !isStopRequested;)
+        {
+            // Deliver until queues run dry
+            while (_drain())
+            {
+            }
+
+
+            _timer.Calibrate();
+
+
+            // Wait for flip (polling to keep queues short in between)
+            {
+                std::unique_lock<std::mutex> lock(_wakeMutex);
+
+
+                _wakeCondition.wait_for(lock, std::chrono::milliseconds(1), [this]() { return (_isNotified || _isStopRequested); });
+
+                _isNotified     = false;
+                isStopRequested = _isStopRequested;
+            }
+        }
+
+
+        // Deliver events queued until stopped
+        while (_drain())
+        {
+        }
+    }
+
+
+    uint64_t AsyncExternTrace::_toSteadyNs(const uint64_t ticks) const
+    {
+        // Ticks may precede reset if queued while beginning
+        const uint64_t baseTicks = _timer._baseTicks;
+
+
+        return ((ticks >= baseTicks) ? (_timer._baseNs + _timer.ToNs(ticks - baseTicks)) : (_timer._baseNs - _timer.ToNs(baseTicks - ticks)));
+    }
+
+
+    uint32_t AsyncExternTrace::_drain()
+    {
+        // Number of entries consumed before publishing read position
+        static constexpr uint32_t PublishInterval = 256;
+
+
+        const auto &markers        = GetMarkerTable();
+        uint32_t    deliveredCount = 0;
+        uint32_t    queueDepth     = 0;
+
+
+        for (auto queue = _queues.load(std::memory_order_acquire); queue; queue = queue->Next)
+        {
+            uint32_t       head = queue->Head.load(std::memory_order_relaxed);
+            const uint32_t tail = queue->Tail.load(std::memory_order_acquire);
+
+
+            queueDepth += (tail - head);
+
+
+            while (head != tail)
+            {
+                const auto entry  = queue->Entries[head & (ThreadExternQueue::Capacity - 1)];
+                auto       marker = markers.TryGet(entry.MarkerID);
+
+
+                if (marker)
+                {
+                    const SectionInfo section     = { marker->GroupName, marker->Name, queue->ThreadID, marker->Color, 0 };
+                    const uint64_t    timestampNs = _toSteadyNs(entry.Ticks);
+
+
+                    if (entry.Type == KLab_Profiling_Trace_EventType_EnterSection)
+                    {
+                        _trace->EnterSectionAt(section, timestampNs);
+                    }
+                    else
+                    {
+                        _trace->LeaveSectionAt(section, timestampNs);
+                    }
+                }
+
+
+                ++head;
+                ++deliveredCount;
+
+
+                // Free entries for blocked producers early
+                if (!(head % PublishInterval))
+                {
+                    queue->Head.store(head, std::memory_order_release);
+                }
+            }
+
+
+            queue->Head.store(head, std::memory_order_release);
+        }
+
+
+        // Track high-water mark
+        for (auto maxQueueDepth = _maxQueueDepth.load(std::memory_order_relaxed); queueDepth > maxQueueDepth;)
+        {
+            if (_maxQueueDepth.compare_exchange_weak(maxQueueDepth, queueDepth, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+
+
+        _deliveredEventCount.fetch_add(deliveredCount, std::memory_order_relaxed);
+
+
+        return deliveredCount;
+    }
+
+
+    bool AsyncExternTrace::_enqueue(ThreadExternQueue &queue, const ThreadExternQueue::Entry &entry, const uint32_t reservedCount)
+    {
+        // Timestamp event before waiting for free entries
+        const uint64_t ticks = Clock::GetTicks();
+        const uint32_t tail  = queue.Tail.load(std::memory_order_relaxed);
+
+
+        // Check free entries (re-reading read position only if cached one appears full)
+        auto hasSpace = [&]()
+        {
+            return ((tail - queue.CachedHead + 1 + reservedCount) <= ThreadExternQueue::Capacity);
+        };
+
+
+        if (!hasSpace())
+        {
+            queue.CachedHead = queue.Head.load(std::memory_order_acquire);
+
+
+            if (!hasSpace())
+            {
+                if ((_policy != KLab_Profiling_Trace_BackpressurePolicy_Block) || !_blockNs)
+                {
+                    return false;
+                }
+
+
+                // Wait for consumer up to timeout (stalling calling thread; bounded by ::MaxBlockTimeoutUs)
+                const uint64_t deadlineNs = (Clock::GetSteadyNs() + _blockNs);
+
+
+                Notify();
+
+
+                do
+                {
+                    std::this_thread::yield();
+
+                    queue.CachedHead = queue.Head.load(std::memory_order_acquire);
+                }
+                while (!hasSpace() && (Clock::GetSteadyNs() < deadlineNs));
+
+
+                if (!hasSpace())
+                {
+                    return false;
+                }
+            }
+        }
+
+
+        auto &slot = queue.Entries[tail & (ThreadExternQueue::Capacity - 1)];
+
+
+        slot       = entry;
+        slot.Ticks = ticks;
+
+        queue.Tail.store((tail + 1), std::memory_order_release);
+
+
+        return true;
+    }
+
+
+    ThreadExternQueue *AsyncExternTrace::_getThreadQueue(ThreadContext &thread)
+    {
+        auto queue = thread.ExternQueue;
+
+
+        // Create and register queue on first use
+        if (!queue)
+        {
+            queue = NewAlignedArray<ThreadExternQueue>(1);
+
+
+            if (!queue)
+            {
+                return nullptr;
+            }
+
+
+            queue->ThreadID = thread.Info.ThreadID;
+            queue->Session  = _session.load(std::memory_order_acquire);
+
+
+            auto head = _queues.load(std::memory_order_relaxed);
+
+
+            do
+            {
+                queue->Next = head;
+            }
+            while (!_queues.compare_exchange_weak(head, queue, std::memory_order_release, std::memory_order_relaxed));
+
+
+            thread.ExternQueue = queue;
+        }
+
+
+        // Forget sections of previous session
+        const uint32_t session = _session.load(std::memory_order_relaxed);
+
+
+        if (queue->Session != session)
+        {
+            queue->Session     = session;
+            queue->CachedHead  = queue->Head.load(std::memory_order_acquire);
+            queue->Depth       = 0;
+            queue->QueuedDepth = 0;
+            queue->DropDepth   = 0;
+        }
+
+
+        return queue;
+    }
+
+
+    AsyncExternTrace &GetAsyncExternTrace()
+    {
+        static AsyncExternTrace trace;
+
+
+        return trace;
+    }
+}}}
+
+
+// ----- //
+// TRACE //
+// ----- //
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginAsyncExternTrace(const KLab_Profiling_Trace_BackpressurePolicy policy, const int32_t blockTimeoutUs)
+{
+    auto &trace       = KLab::Profiling::Trace::GetAsyncExternTrace();
+    auto  externTrace = KLab::Profiling::Trace::TryGetExternTrace();
+
+
+    // Validate state
+    if (!externTrace)
+    {
+        return KLab_Profiling_ErrorCode_NotAvailable;
+    }
+    if (trace.IsRunning())
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    // Validate arguments
+    if (((policy != KLab_Profiling_Trace_BackpressurePolicy_Drop) && (policy != KLab_Profiling_Trace_BackpressurePolicy_Block)) || (blockTimeoutUs < 0) || (uint32_t(blockTimeoutUs) > KLab::Profiling::Trace::AsyncExternTrace::MaxBlockTimeoutUs))
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    const auto result = trace._begin(*externTrace, policy, uint32_t(blockTimeoutUs));
+
+
+    if (result == KLab_Profiling_ErrorCode_NoError)
+    {
+        // Dispatch events right away (instead of from next update)
+        KLab::Profiling::Plugin::UpdateMarkerDispatch();
+    }
+
+
+    return result;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_EndAsyncExternTrace()
+{
+    auto &trace = KLab::Profiling::Trace::GetAsyncExternTrace();
+
+
+    // Validate state
+    if (!trace.IsRunning())
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    trace._end();
+
+
+    // Restore synchronous delivery right away (events queued after consumer finished draining get discarded rather than delivered late)
+    KLab::Profiling::Plugin::UpdateMarkerDispatch();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetAsyncExternTraceInfo(KLab_Profiling_Trace_AsyncExternTraceInfo *info)
+{
+    // Validate arguments
+    if (!info)
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    *info = KLab::Profiling::Trace::GetAsyncExternTrace()._getInfo();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
@@ -0,0 +1,573 @@
+// -------------------------------------------------------------------------------------------- //
+//  Copyright (c) KLab Inc.. All rights reserved.                                               //
+//  Licensed under the MIT License. See 'LICENSE' in the project root for license information.  //
+// -------------------------------------------------------------------------------------------- //
+
+#include <KLab/Profiling/Internal.hpp>
+
+
+// -------- //
+// INCLUDES //
+// -------- //
+
+#if (_WIN32)
+#include <Windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    // Loads shared object
+    // @param path - Path as null-terminated UTF-8 string
+    // @return the handle on success; null otherwise
+    static void *_loadLibrary(const char *path)
+    {
+        #if (_WIN32)
+        wchar_t widePath[MAX_PATH];
+
+
+        if (!MultiByteToWideChar(CP_UTF8, 0, path, -1, widePath, MAX_PATH))
+        {
+            return nullptr;
+        }
+
+
+        return LoadLibraryW(widePath);
+        #else
+        return dlopen(path, RTLD_NOW | RTLD_LOCAL);
+        #endif
+    }
+
+
+    // Resolves symbol of shared object
+    // @param library - Shared object handle
+    // @param name - Name of symbol
+    // @return the address on success; null otherwise
+    static void *_findSymbol(void *library, const char *name)
+    {
+        #if (_WIN32)
+        return reinterpret_cast<void *>(GetProcAddress(static_cast<HMODULE>(library), name));
+        #else
+        return dlsym(library, name);
+        #endif
+    }
+
+
+    // Unloads shared object
+    // @param library - [Optional] Shared object handle
+    static void _unloadLibrary(void *library)
+    {
+        if (!library)
+        {
+            return;
+        }
+
+
+        #if (_WIN32)
+        FreeLibrary(static_cast<HMODULE>(library));
+        #else
+        dlclose(library);
+        #endif
+    }
+
+
+    // Gets info on interned marker for sinks
+    // @param markerID - Marker ID
+    // @param info - Buffer for info
+    // @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+    static KLab_Profiling_ErrorCode _getMarkerInfo(const uint32_t markerID, KLab_Profiling_Trace_MarkerInfo *info)
+    {
+        return KLab_Profiling_TraceUtility_GetMarkerInfo(markerID, info);
+    }
+
+
+    // Gets info on traced thread for sinks
+    // @param threadIndex - Thread index
+    // @param info - Buffer for info
+    // @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+    static KLab_Profiling_ErrorCode _getThreadInfo(const uint32_t threadIndex, KLab_Profiling_Trace_ThreadInfo *info)
+    {
+        return KLab_Profiling_TraceUtility_GetThreadInfo(threadIndex, info);
+    }
+}}}
+
+
+// ----------- //
+// BATCH TRACE //
+// ----------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    bool BatchTrace::IsTracing() const
+    {
+        return (_sinkCount.load(std::memory_order_relaxed) > 0);
+    }
+
+
+    void BatchTrace::Flip()
+    {
+        if (!IsTracing())
+        {
+            return;
+        }
+
+
+        _timer.Calibrate();
+        _nsPerTick.store(_timer._nsPerTick, std::memory_order_relaxed);
+
+
+        const uint32_t generation = (_generation.fetch_add(1, std::memory_order_acq_rel) + 1);
+
+
+        // Flush own batch right away (untracked threads have none)
+        auto &thread = GetThreadContext();
+        auto  own    = ((thread.Index != ThreadContext::InvalidIndex) ? _getThreadBatch(thread) : nullptr);
+
+
+        if (own)
+        {
+            _hold(*own);
+
+
+            if (own->Length)
+            {
+                _deliver(*own);
+            }
+
+
+            _unhold(*own);
+        }
+
+
+        // Flush batches of threads without events since previous flip (as they might not write again for long)
+        for (auto batch = _batches.load(std::memory_order_acquire); batch; batch = batch->Next)
+        {
+            // Skip batches being written (their threads flush on their next event)
+            if ((batch == own) || batch->IsHeld.exchange(true, std::memory_order_acquire))
+            {
+                continue;
+            }
+
+
+            if (batch->Length && ((generation - batch->Generation) > 1))
+            {
+                _deliver(*batch);
+            }
+
+
+            _unhold(*batch);
+        }
+    }
+
+
+    void BatchTrace::EnterSection(ThreadContext &thread, const uint32_t markerID)
+    {
+        _writeEvent(KLab_Profiling_Trace_EventType_EnterSection, thread, markerID);
+    }
+
+
+    void BatchTrace::LeaveSection(ThreadContext &thread, const uint32_t markerID)
+    {
+        _writeEvent(KLab_Profiling_Trace_EventType_LeaveSection, thread, markerID);
+    }
+
+
+    KLab_Profiling_ErrorCode BatchTrace::_attach(const KLab_Profiling_TraceSink &sink, void *library, int32_t &sinkID)
+    {
+        std::lock_guard<std::mutex> lock(_slotsMutex);
+
+
+        for (uint32_t s = 0; s < MaxSinkCount; ++s)
+        {
+            auto &slot = _slots[s];
+
+
+            if (slot.IsActive.load(std::memory_order_relaxed))
+            {
+                continue;
+            }
+
+
+            // Start timeline with first sink (batches got discarded when last sink detached)
+            if (!_sinkCount.load(std::memory_order_relaxed))
+            {
+                _timer.Reset();
+                _nsPerTick.store(_timer._nsPerTick, std::memory_order_relaxed);
+                _generation.fetch_add(1, std::memory_order_acq_rel);
+            }
+
+
+            slot.Sink    = sink;
+            slot.Library = library;
+
+            slot.IsActive.store(true, std::memory_order_seq_cst);
+            _sinkCount.fetch_add(1, std::memory_order_release);
+
+
+            sinkID = int32_t(s);
+
+
+            return KLab_Profiling_ErrorCode_NoError;
+        }
+
+
+        return KLab_Profiling_ErrorCode_NotAvailable;
+    }
+
+
+    KLab_Profiling_ErrorCode BatchTrace::_detach(const int32_t sinkID)
+    {
+        std::lock_guard<std::mutex> lock(_slotsMutex);
+
+
+        if ((sinkID < 0) || (uint32_t(sinkID) >= MaxSinkCount) || !_slots[sinkID].IsActive.load(std::memory_order_relaxed))
+        {
+            return KLab_Profiling_ErrorCode_InvalidArgument;
+        }
+
+
+        auto &slot = _slots[sinkID];
+
+
+        // Flush pending records (so sink gets all events up to its detach)
+        _flushBatches(true);
+
+
+        slot.IsActive.store(false, std::memory_order_seq_cst);
+        _sinkCount.fetch_sub(1, std::memory_order_release);
+
+
+        // Wait for deliveries that saw sink active
+        while (slot.DeliveryCount.load(std::memory_order_seq_cst))
+        {
+            std::this_thread::yield();
+        }
+
+
+        // Discard records written meanwhile once last sink is gone (as their timestamps belong to ending timeline)
+        if (!_sinkCount.load(std::memory_order_relaxed))
+        {
+            _flushBatches(false);
+        }
+
+
+        if (slot.Sink.Release)
+        {
+            slot.Sink.Release(slot.Sink.UserData);
+        }
+
+
+        _unloadLibrary(slot.Library);
+
+
+        slot.Sink    = KLab_Profiling_TraceSink();
+        slot.Library = nullptr;
+
+
+        return KLab_Profiling_ErrorCode_NoError;
+    }
+
+
+    void BatchTrace::_writeEvent(const KLab_Profiling_Trace_EventType type, ThreadContext &thread, const uint32_t markerID)
+    {
+        auto batch = _getThreadBatch(thread);
+
+
+        if (!batch)
+        {
+            return;
+        }
+
+
+        _hold(*batch);
+
+
+        // Skip events while no sink is attached (checked while holding batch, so detach discarding batches doesn't miss records)
+        if (!_sinkCount.load(std::memory_order_acquire))
+        {
+            _unhold(*batch);
+
+
+            return;
+        }
+
+
+        // Flush records of previous frame first
+        const uint32_t generation = _generation.load(std::memory_order_acquire);
+
+
+        if (batch->Generation != generation)
+        {
+            if (batch->Length)
+            {
+                _deliver(*batch);
+            }
+
+
+            batch->Generation = generation;
+        }
+
+
+        auto &record = batch->Records[batch->Length++];
+
+
+        record.MarkerID    = markerID;
+        record.ThreadIndex = thread.Index;
+        record.Type        = uint16_t(type);
+        record.TimestampNs = _timer.GetTicks();
+
+
+        if (batch->Length == ThreadBatch::Capacity)
+        {
+            _deliver(*batch);
+        }
+
+
+        _unhold(*batch);
+    }
+
+
+    void BatchTrace::_deliver(ThreadBatch &batch)
+    {
+        const double nsPerTick = _nsPerTick.load(std::memory_order_relaxed);
+
+
+        for (uint32_t r = 0; r < batch.Length; ++r)
+        {
+            batch.Records[r].TimestampNs = uint64_t(double(batch.Records[r].TimestampNs) * nsPerTick);
+        }
+
+
+        for (auto &slot : _slots)
+        {
+            // Skip inactive slots without announcing (to not stall detach waiting on other slots)
+            if (!slot.IsActive.load(std::memory_order_relaxed))
+            {
+                continue;
+            }
+
+
+            // Announce delivery before checking sink again to let detach wait for it
+            slot.DeliveryCount.fetch_add(1, std::memory_order_seq_cst);
+
+
+            if (slot.IsActive.load(std::memory_order_seq_cst))
+            {
+                slot.Sink.HandleBatch(slot.Sink.UserData, batch.Records, batch.Length);
+            }
+
+
+            slot.DeliveryCount.fetch_sub(1, std::memory_order_release);
+        }
+
+
+        batch.Length = 0;
+    }
+
+
+    void BatchTrace::_flushBatches(const bool shouldDeliver)
+    {
+        for (auto batch = _batches.load(std::memory_order_acquire); batch; batch = batch->Next)
+        {
+            _hold(*batch);
+
+
+            if (shouldDeliver && batch->Length)
+            {
+                _deliver(*batch);
+            }
+
+
+            batch->Length = 0;
+
+
+            _unhold(*batch);
+        }
+    }
+
+
+    void BatchTrace::_hold(ThreadBatch &batch)
+    {
+        while (batch.IsHeld.exchange(true, std::memory_order_acquire))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+
+    void BatchTrace::_unhold(ThreadBatch &batch)
+    {
+        batch.IsHeld.store(false, std::memory_order_release);
+    }
+
+
+    ThreadBatch *BatchTrace::_getThreadBatch(ThreadContext &thread)
+    {
+        auto batch = thread.Batch;
+
+
+        // Create and register batch on first use
+        if (!batch)
+        {
+            batch = NewAlignedArray<ThreadBatch>(1);
+
+
+            if (!batch)
+            {
+                return nullptr;
+            }
+
+
+            batch->Generation = _generation.load(std::memory_order_acquire);
+
+
+            // Publish batch (flip might flush it from now on)
+            auto head = _batches.load(std::memory_order_relaxed);
+
+
+            do
+            {
+                batch->Next = head;
+            }
+            while (!_batches.compare_exchange_weak(head, batch, std::memory_order_release, std::memory_order_relaxed));
+
+
+            thread.Batch = batch;
+        }
+
+
+        return batch;
+    }
+
+
+    BatchTrace &GetBatchTrace()
+    {
+        static BatchTrace trace;
+
+
+        return trace;
+    }
+}}}
+
+
+// ----- //
+// TRACE //
+// ----- //
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_AttachTraceSink(const KLab_Profiling_TraceSink *sink, int32_t *sinkID)
+{
+    // Validate arguments
+    if (!sink || !sink->HandleBatch || !sinkID)
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    const auto result = KLab::Profiling::Trace::GetBatchTrace()._attach(*sink, nullptr, *sinkID);
+
+
+    if (result == KLab_Profiling_ErrorCode_NoError)
+    {
+        // Dispatch events right away (instead of from next update)
+        KLab::Profiling::Plugin::UpdateMarkerDispatch();
+    }
+
+
+    return result;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_LoadTraceSink(const char *path, int32_t *sinkID)
+{
+    using namespace KLab::Profiling::Trace;
+
+
+    static const KLab_Profiling_TraceSinkHost host =
+    {
+        KLab_Profiling_TraceSink_Version,
+        _getMarkerInfo,
+        _getThreadInfo
+    };
+
+
+    // Validate arguments
+    if (!path || !(*path) || !sinkID)
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    // Load sink
+    auto library = _loadLibrary(path);
+    auto create  = reinterpret_cast<KLab_Profiling_TraceSink_CreateFunction>(library ? _findSymbol(library, "KLab_Profiling_TraceSink_Create") : nullptr);
+
+
+    if (!create)
+    {
+        _unloadLibrary(library);
+
+
+        return KLab_Profiling_ErrorCode_NotAvailable;
+    }
+
+
+    KLab_Profiling_TraceSink sink = {};
+    auto                     result = create(&host, &sink);
+
+
+    if ((result == KLab_Profiling_ErrorCode_NoError) && !sink.HandleBatch)
+    {
+        result = KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    // Attach sink
+    if (result == KLab_Profiling_ErrorCode_NoError)
+    {
+        result = GetBatchTrace()._attach(sink, library, *sinkID);
+
+
+        if ((result != KLab_Profiling_ErrorCode_NoError) && sink.Release)
+        {
+            sink.Release(sink.UserData);
+        }
+    }
+
+
+    if (result != KLab_Profiling_ErrorCode_NoError)
+    {
+        _unloadLibrary(library);
+
+
+        return result;
+    }
+
+
+    // Dispatch events right away (instead of from next update)
+    KLab::Profiling::Plugin::UpdateMarkerDispatch();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_DetachTraceSink(const int32_t sinkID)
+{
+    const auto result = KLab::Profiling::Trace::GetBatchTrace()._detach(sinkID);
+
+
+    if (result == KLab_Profiling_ErrorCode_NoError)
+    {
+        // Stop dispatching right away (instead of from next update)
+        KLab::Profiling::Plugin::UpdateMarkerDispatch();
+    }
+
+
+    return result;
+}
@@ -6,12 +6,40 @@
 #include <KLab/Profiling/Internal.hpp>
 
 
+// -------- //
+// INCLUDES //
+// -------- //
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <IUnityInterface.h>
+#include <IUnityProfilerCallbacks.h>
+
+
 // ------- //
 // HELPERS //
 // ------- //
 
 namespace KLab { namespace Profiling { namespace Trace
 {
+    // Gets number of chunks to reserve for capacity (adding a partly filled chunk per thread)
+    // @param capacity - Capacity in data
+    // @param chunkCapacity - Capacity of chunk in data
+    // @return the number of chunks (0 if capacity is 0)
+    static uint32_t _getChunkCount(const uint32_t capacity, const uint32_t chunkCapacity)
+    {
+        if (!capacity)
+        {
+            return 0;
+        }
+
+
+        return (((capacity + chunkCapacity - 1) / chunkCapacity) + GetThreadTable().GetLength() + CSharpTrace::SpareChunkCount);
+    }
+
+
     // Copies string
     // @param out - Output buffer
     // @param in - Input string
@@ -35,23 +63,241 @@ namespace KLab { namespace Profiling { namespace Trace
     }
 
 
-    // Initializes event KLab_Profiling_Trace_EventInfo
+    // Expands compact event record into KLab_Profiling_Trace_EventInfo
     // @param event - Info to initialize
-    // @param type - Trace event type
-    // @param info - Trace section info
-    // @param timestampNs - Trace event timestamp in nanoseconds
-    static void _initializeEvent(KLab_Profiling_Trace_EventInfo &event, const KLab_Profiling_Trace_EventType type, const SectionInfo &section, const uint64_t timestampNs)
+    // @param record - Event record to expand
+    // @param markers - Marker table
+    // @param threads - Thread table
+    static void _expandEvent(KLab_Profiling_Trace_EventInfo &event, const KLab_Profiling_Trace_EventRecord &record, const MarkerTable &markers, const ThreadTable &threads)
     {
+        static const MarkerInfo unknownMarker = { "", "", 0, 0 };
+        static const ThreadInfo unknownThread = { 0, "", "" };
+
+        auto marker = markers.TryGet(record.MarkerID);
+        auto thread = threads.TryGet(record.ThreadIndex);
+
+
+        marker = (marker ? marker : &unknownMarker);
+        thread = (thread ? thread : &unknownThread);
+
+
         // Store scalars
-        event.Type        = type;
-        event.TimestampNs = timestampNs;
-        event.ThreadID    = section.ThreadID;
-        event.Color       = section.Color;
+        event.Type        = record.Type;
+        event.TimestampNs = record.TimestampNs;
+        event.ThreadID    = thread->ThreadID;
+        event.Color       = marker->Color;
 
 
         // Copy strings
-        _copyString(event.GroupName, section.GroupName, sizeof(event.GroupName));
-        _copyString(event.Name,      section.Name,      sizeof(event.Name));
+        _copyString(event.GroupName, marker->GroupName, sizeof(event.GroupName));
+        _copyString(event.Name,      marker->Name,      sizeof(event.Name));
+    }
+
+
+    // Rounds size up to multiple of 4 bytes
+    // @param size - Size in bytes
+    // @return the rounded size
+    static inline uint32_t _alignToWord(const uint32_t size)
+    {
+        return ((size + 3u) & ~3u);
+    }
+
+
+    // Copies committed metadata out of side arena
+    // @param chunks - Metadata chunks
+    // @param wordIndex - Index of first word of metadata across chunks
+    // @param out - Output buffer
+    // @param outCapacity - Capacity of output buffer in bytes
+    // @param didRunOutOfMemory - Flag to set if output buffer couldn't fit metadata
+    // @return the size of metadata copied in bytes (0 if not copied)
+    static uint32_t _copyMetadata(ThreadChunkPool<CSharpTrace::MetadataChunk> &chunks, const uint32_t wordIndex, uint8_t *out, const uint32_t outCapacity, bool &didRunOutOfMemory)
+    {
+        const uint32_t chunkIndex = (wordIndex / CSharpTrace::MetadataChunk::Capacity);
+        const uint32_t offset     = (wordIndex % CSharpTrace::MetadataChunk::Capacity);
+
+
+        if (chunkIndex >= chunks.GetLength())
+        {
+            return 0;
+        }
+
+
+        // Validate metadata to be committed
+        auto                                chunk  = (chunks.GetBase() + chunkIndex);
+        const uint32_t                      length = chunk->Length.load(std::memory_order_acquire);
+        KLab_Profiling_Trace_MetadataHeader header;
+
+
+        if (offset >= length)
+        {
+            return 0;
+        }
+
+
+        std::memcpy(&header, (chunk->Data + offset), sizeof(header));
+
+
+        if ((header.Size / sizeof(uint32_t)) > (length - offset))
+        {
+            return 0;
+        }
+        if (header.Size > outCapacity)
+        {
+            didRunOutOfMemory = true;
+
+
+            return 0;
+        }
+
+
+        std::memcpy(out, (chunk->Data + offset), header.Size);
+
+
+        return header.Size;
+    }
+
+
+    // Gathers committed records of chunks, converts their ticks to nanoseconds, and merges threads by time
+    // @param chunks - Chunks to gather (chunks of each thread are allocated in order)
+    // @param timer - Timer records were timestamped with
+    // @param records - Buffer for records
+    // @param capacity - Capacity of buffer
+    // @param didRunOutOfMemory - Flag to set if buffer couldn't fit records
+    // @param metadataChunks - [Optional] Metadata chunks referenced by metadata records (dropping metadata records if null)
+    // @param metadata - [Optional] Buffer for metadata (dropping metadata records if null)
+    // @param metadataCapacity - Capacity of metadata buffer in bytes
+    // @param metadataLength - Number of metadata bytes written
+    // @return the number of records gathered
+    static uint32_t _gatherRecords(ThreadChunkPool<CSharpTrace::EventChunk> &chunks, const Stopwatch &timer, KLab_Profiling_Trace_EventRecord *records, const uint32_t capacity, bool &didRunOutOfMemory,
+        ThreadChunkPool<CSharpTrace::MetadataChunk> *metadataChunks = nullptr, uint8_t *metadata = nullptr, const uint32_t metadataCapacity = 0, uint32_t *metadataLength = nullptr)
+    {
+        uint32_t count = 0;
+
+
+        for (auto chunk = chunks.GetBase(), end = (chunk + chunks.GetLength()); chunk < end; ++chunk)
+        {
+            uint32_t length = chunk->Length.load(std::memory_order_acquire);
+
+
+            if (length > (capacity - count))
+            {
+                length            = (capacity - count);
+                didRunOutOfMemory = true;
+            }
+
+
+            std::copy(chunk->Data, (chunk->Data + length), (records + count));
+
+
+            count += length;
+        }
+
+
+        // Resolve metadata records (rebasing them onto metadata buffer or dropping them)
+        uint32_t keptCount   = 0;
+        uint32_t writtenSize = 0;
+
+
+        for (uint32_t r = 0; r < count; ++r)
+        {
+            auto record = records[r];
+
+
+            if (record.Type == KLab_Profiling_Trace_EventType_Metadata)
+            {
+                const uint32_t size = ((metadataChunks && metadata) ? _copyMetadata(*metadataChunks, record.MarkerID, (metadata + writtenSize), (metadataCapacity - writtenSize), didRunOutOfMemory) : 0);
+
+
+                if (!size)
+                {
+                    continue;
+                }
+
+
+                record.MarkerID  = writtenSize;
+                writtenSize     += size;
+            }
+
+
+            records[keptCount++] = record;
+        }
+
+
+        count = keptCount;
+
+
+        if (metadataLength)
+        {
+            *metadataLength = writtenSize;
+        }
+
+
+        for (uint32_t r = 0; r < count; ++r)
+        {
+            records[r].TimestampNs = timer.ToNs(records[r].TimestampNs);
+        }
+
+
+        // Merge threads by time (keeping order of events of same thread)
+        std::stable_sort(records, (records + count), [](const KLab_Profiling_Trace_EventRecord &lhs, const KLab_Profiling_Trace_EventRecord &rhs)
+        {
+            return (lhs.TimestampNs < rhs.TimestampNs);
+        });
+
+
+        return count;
+    }
+
+    // Gathers committed spans of chunks, converts their ticks to nanoseconds, and merges threads by begin (enclosing spans first)
+    // @param chunks - Chunks to gather
+    // @param timer - Timer spans were timestamped with
+    // @param spans - Buffer for spans
+    // @param capacity - Capacity of buffer
+    // @param didRunOutOfMemory - Flag to set if buffer couldn't fit spans
+    // @return the number of spans gathered
+    static uint32_t _gatherSpans(ThreadChunkPool<CSharpTrace::SpanChunk> &chunks, const Stopwatch &timer, KLab_Profiling_Trace_SpanRecord *spans, const uint32_t capacity, bool &didRunOutOfMemory)
+    {
+        uint32_t count = 0;
+
+
+        for (auto chunk = chunks.GetBase(), end = (chunk + chunks.GetLength()); chunk < end; ++chunk)
+        {
+            uint32_t length = chunk->Length.load(std::memory_order_acquire);
+
+
+            if (length > (capacity - count))
+            {
+                length            = (capacity - count);
+                didRunOutOfMemory = true;
+            }
+
+
+            std::copy(chunk->Data, (chunk->Data + length), (spans + count));
+
+
+            count += length;
+        }
+
+
+        // Convert begin and end ticks into begin and duration
+        for (uint32_t s = 0; s < count; ++s)
+        {
+            const uint64_t beginNs = timer.ToNs(spans[s].BeginNs);
+            const uint64_t endNs   = timer.ToNs(spans[s].DurationNs);
+
+
+            spans[s].BeginNs    = beginNs;
+            spans[s].DurationNs = ((endNs > beginNs) ? (endNs - beginNs) : 0);
+        }
+
+
+        std::stable_sort(spans, (spans + count), [](const KLab_Profiling_Trace_SpanRecord &lhs, const KLab_Profiling_Trace_SpanRecord &rhs)
+        {
+            return ((lhs.BeginNs < rhs.BeginNs) || ((lhs.BeginNs == rhs.BeginNs) && (lhs.Depth < rhs.Depth)));
+        });
+
+
+        return count;
     }
 }}}
 
@@ -68,102 +314,753 @@ namespace KLab { namespace Profiling { namespace Trace
     }
 
 
-    void CSharpTrace::EnterSection(const SectionInfo &section)
+    void CSharpTrace::Flip()
     {
-        auto event = _eventBuffer.Allocate();
+        if (_mode != Mode::Continuous)
+        {
+            return;
+        }
+
 
+        std::lock_guard<std::mutex> lock(_framesMutex);
 
-        if (event)
+
+        _timer.Calibrate();
+
+
+        const uint64_t  nowNs   = _timer.GetTimestampNs();
+        auto           &current = _frames[_recordingFrameIndex % _frameCount];
+
+
+        current.DurationNs = (nowNs - current.BeginNs);
+
+
+        ++_recordingFrameIndex;
+
+
+        // Overwrite oldest frame if it hasn't been dequeued in time
+        if ((_recordingFrameIndex - _oldestFrameIndex) >= _frameCount)
+        {
+            ++_oldestFrameIndex;
+            ++_droppedFrameCount;
+        }
+
+
+        // Rotate to next frame buffer
+        auto &next = _frames[_recordingFrameIndex % _frameCount];
+
+
+        next.Chunks.Reset();
+        next.MetadataChunks.Reset();
+        next.SpanChunks.Reset();
+
+        next.Index      = _recordingFrameIndex;
+        next.BeginNs    = nowNs;
+        next.DurationNs = 0;
+
+
+        _activateChunks(&next.Chunks, (_capturesMetadata ? &next.MetadataChunks : nullptr), (_isSpanMode ? &next.SpanChunks : nullptr));
+    }
+
+
+    void CSharpTrace::EnterSection(ThreadContext &thread, const uint32_t markerID)
+    {
+        if (_isSpanMode)
         {
-            _initializeEvent(*event, KLab_Profiling_Trace_EventType_EnterSection, section, _timer.GetTimestampNs());
+            _enterSpan(thread, markerID);
+
+
+            return;
         }
-        else
+
+
+        _writeEvent(KLab_Profiling_Trace_EventType_EnterSection, thread, markerID);
+    }
+
+
+    void CSharpTrace::LeaveSection(ThreadContext &thread, const uint32_t markerID)
+    {
+        if (_isSpanMode)
         {
-            _didEventBufferRunOutOfMemory = true;
+            _leaveSpan(thread, markerID);
+
+
+            return;
         }
+
+
+        _writeEvent(KLab_Profiling_Trace_EventType_LeaveSection, thread, markerID);
     }
 
 
-    void CSharpTrace::LeaveSection(const SectionInfo &section)
+    void CSharpTrace::WriteMetadata(ThreadContext &thread, const UnityProfilerMarkerData *data, const uint16_t dataCount, const uint16_t skippedIndex)
     {
-        auto event = _eventBuffer.Allocate();
+        static constexpr uint32_t MaxSize = (MetadataChunk::Capacity * sizeof(uint32_t));
+
+        const uint32_t generation = _generation.load(std::memory_order_acquire);
+
+
+        // Measure metadata (truncating long data and skipping entries once chunk would overflow)
+        KLab_Profiling_Trace_MetadataHeader header  = { sizeof(KLab_Profiling_Trace_MetadataHeader), 0 };
+        uint16_t                            dataEnd = 0;
+
+
+        for (; dataEnd < dataCount; ++dataEnd)
+        {
+            if (dataEnd == skippedIndex)
+            {
+                continue;
+            }
+
+
+            const uint32_t size      = (data[dataEnd].ptr ? std::min(data[dataEnd].size, uint32_t(KLab_Profiling_Trace_MaxMetadataEntrySize)) : 0u);
+            const uint32_t entrySize = (sizeof(KLab_Profiling_Trace_MetadataEntry) + _alignToWord(size));
+
+
+            if ((header.Size + entrySize) > MaxSize)
+            {
+                break;
+            }
+
+
+            header.Size += entrySize;
+            ++header.EntryCount;
+        }
+
+
+        if (!header.EntryCount)
+        {
+            return;
+        }
+
+
+        // Allocate new chunk on new trace, new frame, or full chunk
+        const uint32_t wordCount = (header.Size / sizeof(uint32_t));
+
+
+        if ((thread.MetadataChunkGeneration != generation) || !thread.Metadata || ((thread.Metadata->Length.load(std::memory_order_relaxed) + wordCount) > MetadataChunk::Capacity))
+        {
+            auto chunks = _activeMetadataChunks.load(std::memory_order_acquire);
+
+
+            thread.MetadataChunkGeneration = generation;
+            thread.Metadata                = (chunks ? chunks->Allocate() : nullptr);
+            thread.MetadataChunkIndex      = (thread.Metadata ? uint32_t(thread.Metadata - chunks->GetBase()) : 0u);
+        }
 
 
-        if (event)
+        if (!thread.Metadata)
         {
-            _initializeEvent(*event, KLab_Profiling_Trace_EventType_LeaveSection, section, _timer.GetTimestampNs());
+            return;
         }
-        else
+
+
+        // Write and commit metadata
+        auto           chunk  = thread.Metadata;
+        const uint32_t length = chunk->Length.load(std::memory_order_relaxed);
+        auto           out    = reinterpret_cast<uint8_t *>(chunk->Data + length);
+
+
+        std::memcpy(out, &header, sizeof(header));
+
+
+        out += sizeof(header);
+
+
+        for (uint16_t d = 0; d < dataEnd; ++d)
         {
-            _didEventBufferRunOutOfMemory = true;
+            if (d == skippedIndex)
+            {
+                continue;
+            }
+
+
+            const uint32_t                          size  = (data[d].ptr ? std::min(data[d].size, uint32_t(KLab_Profiling_Trace_MaxMetadataEntrySize)) : 0u);
+            const KLab_Profiling_Trace_MetadataEntry entry = { uint16_t(data[d].type), uint16_t(size) };
+
+
+            std::memcpy(out, &entry, sizeof(entry));
+            std::memset((out + sizeof(entry)), 0, _alignToWord(size));
+            std::memcpy((out + sizeof(entry)), data[d].ptr, size);
+
+
+            out += (sizeof(entry) + _alignToWord(size));
         }
+
+
+        chunk->Length.store((length + wordCount), std::memory_order_release);
+
+
+        // Reference metadata from event record (by word index across chunks)
+        _writeEvent(KLab_Profiling_Trace_EventType_Metadata, thread, ((thread.MetadataChunkIndex * MetadataChunk::Capacity) + length));
     }
 
 
     bool CSharpTrace::_isEnabled() const
     {
-        return _isTracing;
+        return (_mode != Mode::None);
     }
 
 
-    void CSharpTrace::_enable(KLab_Profiling_Trace_EventInfo *eventBuffer, const uint32_t eventBufferCapacity)
+    bool CSharpTrace::_enable(KLab_Profiling_Trace_EventInfo *eventBuffer, KLab_Profiling_Trace_EventRecord *recordBuffer, const uint32_t eventBufferCapacity)
     {
+        // Reserve enough chunks to fill event buffer (records beyond capacity get clipped on gather)
+        const uint32_t chunkCount = _getChunkCount(eventBufferCapacity, EventChunk::Capacity);
+
+
+        if (!_eventChunks.Reserve(chunkCount))
+        {
+            return false;
+        }
+
+
         // Initialize state
         _timer.Reset();
-        _eventBuffer.Initialize(eventBuffer, eventBufferCapacity);
 
+        _eventBuffer         = eventBuffer;
+        _recordBuffer        = recordBuffer;
+        _eventBufferCapacity = eventBufferCapacity;
+
+        _isSpanMode = false;
+
+        _activateChunks(&_eventChunks, nullptr, nullptr);
+
+        _mode      = Mode::Single;
         _isTracing = true;
+
+
+        return true;
     }
     
 
     KLab_Profiling_Trace_TraceInfo CSharpTrace::_disable()
     {
         _isTracing = false;
+        _mode      = Mode::None;
 
 
-        return
-        {
-            _timer.GetTimestampNs(),
-            _eventBuffer.GetLength(),
-            _didEventBufferRunOutOfMemory
-        };
-    }
+        // Invalidate per-thread cursors
+        _activateChunks(nullptr, nullptr, nullptr);
+        _timer.Calibrate();
 
 
-    CSharpTrace &GetCSharpTrace()
-    {
-        static CSharpTrace trace;
-
+        const uint64_t durationNs        = _timer.GetTimestampNs();
+        bool           didRunOutOfMemory = _eventChunks.DidRunOutOfMemory();
 
-        return trace;
-    }
-}}}
 
+        // Gather records (expanding them into event buffer afterwards if necessary)
+        std::vector<KLab_Profiling_Trace_EventRecord> expandableRecords;
 
-// ----- //
-// TRACE //
-// ----- //
 
-KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginTrace(KLab_Profiling_Trace_EventInfo *eventBuffer, const int32_t eventBufferSize)
-{
-    auto &trace  = KLab::Profiling::Trace::GetCSharpTrace();
+        if (!_recordBuffer)
+        {
+            expandableRecords.resize(_eventBufferCapacity);
+        }
 
 
-    // Validate state
-    if (trace._isEnabled())
-    {
-        return KLab_Profiling_ErrorCode_InvalidState;
-    }
+        auto           records    = (_recordBuffer ? _recordBuffer : expandableRecords.data());
+        const uint32_t eventCount = _gatherRecords(_eventChunks, _timer, records, _eventBufferCapacity, didRunOutOfMemory);
 
 
-    // Validate arguments
-    if (!eventBuffer || (eventBufferSize <= 0))
-    {
-        return KLab_Profiling_ErrorCode_InvalidArgument;
-    }
+        // Expand records
+        if (_eventBuffer)
+        {
+            const auto &markers = GetMarkerTable();
+            const auto &threads = GetThreadTable();
 
 
-    trace._enable(eventBuffer, uint32_t(eventBufferSize));
+            for (uint32_t e = 0; e < eventCount; ++e)
+            {
+                _expandEvent(_eventBuffer[e], records[e], markers, threads);
+            }
+        }
+
+
+        return
+        {
+            durationNs,
+            eventCount,
+            didRunOutOfMemory
+        };
+    }
+
+
+    bool CSharpTrace::_enableContinuous(const uint32_t frameCount, const uint32_t eventsPerFrame, const uint32_t metadataBytesPerFrame, const bool isSpanMode)
+    {
+        static constexpr uint32_t MetadataChunkSize = (MetadataChunk::Capacity * sizeof(uint32_t));
+
+        std::lock_guard<std::mutex> lock(_framesMutex);
+
+
+        // Reserve either event chunks (with metadata) or span chunks
+        const uint32_t chunksPerFrame         = (isSpanMode ? 0 : _getChunkCount(eventsPerFrame, EventChunk::Capacity));
+        const uint32_t metadataChunksPerFrame = (isSpanMode ? 0 : _getChunkCount(metadataBytesPerFrame, MetadataChunkSize));
+        const uint32_t spanChunksPerFrame     = (isSpanMode ? _getChunkCount(eventsPerFrame, SpanChunk::Capacity) : 0);
+
+
+        // (Re)create swapchain (retiring previous one as late writers might still reference its chunks)
+        if (frameCount != _frameCount)
+        {
+            if (_frames)
+            {
+                _retiredFrames.push_back(_frames);
+            }
+
+
+            _frames     = NewAlignedArray<Frame>(frameCount);
+            _frameCount = (_frames ? frameCount : 0);
+        }
+
+
+        if (!_frames)
+        {
+            return false;
+        }
+
+
+        for (uint32_t f = 0; f < _frameCount; ++f)
+        {
+            if (!_frames[f].Chunks.Reserve(chunksPerFrame) || !_frames[f].MetadataChunks.Reserve(metadataChunksPerFrame) || !_frames[f].SpanChunks.Reserve(spanChunksPerFrame))
+            {
+                return false;
+            }
+        }
+
+
+        // Initialize state
+        _timer.Reset();
+
+        _recordingFrameIndex = 0;
+        _oldestFrameIndex    = 0;
+        _droppedFrameCount   = 0;
+
+        _frames[0].Index      = 0;
+        _frames[0].BeginNs    = 0;
+        _frames[0].DurationNs = 0;
+
+        _capturesMetadata = (metadataChunksPerFrame > 0);
+        _isSpanMode       = isSpanMode;
+
+        _spanGeneration.fetch_add(1, std::memory_order_release);
+        _activateChunks(&_frames[0].Chunks, (_capturesMetadata ? &_frames[0].MetadataChunks : nullptr), (_isSpanMode ? &_frames[0].SpanChunks : nullptr));
+
+        _mode      = Mode::Continuous;
+        _isTracing = true;
+
+
+        return true;
+    }
+
+
+    void CSharpTrace::_disableContinuous()
+    {
+        std::lock_guard<std::mutex> lock(_framesMutex);
+
+
+        _isTracing = false;
+        _mode      = Mode::None;
+
+
+        // Invalidate per-thread cursors
+        _activateChunks(nullptr, nullptr, nullptr);
+        _timer.Calibrate();
+
+
+        // Seal frame currently recorded
+        auto &current = _frames[_recordingFrameIndex % _frameCount];
+
+
+        current.DurationNs = (_timer.GetTimestampNs() - current.BeginNs);
+
+
+        ++_recordingFrameIndex;
+    }
+
+
+    bool CSharpTrace::_dequeueFrame(KLab_Profiling_Trace_EventRecord *recordBuffer, const uint32_t recordBufferCapacity, KLab_Profiling_Trace_FrameInfo &info, uint8_t *metadataBuffer, const uint32_t metadataBufferCapacity, uint32_t *metadataLength)
+    {
+        std::lock_guard<std::mutex> lock(_dequeueMutex);
+
+        Stopwatch timer;
+
+
+        if (!_detachCompletedFrame(timer))
+        {
+            return false;
+        }
+
+
+        // Gather without frame guard (as flips on game thread would otherwise wait for sorting)
+        auto &frame             = _dequeuedFrame;
+        bool  didRunOutOfMemory = frame.Chunks.DidRunOutOfMemory();
+
+
+        // Count running out of metadata chunks as running out of memory only if metadata requested
+        if (metadataBuffer && frame.MetadataChunks.DidRunOutOfMemory())
+        {
+            didRunOutOfMemory = true;
+        }
+
+
+        info.EventCount             = _gatherRecords(frame.Chunks, timer, recordBuffer, recordBufferCapacity, didRunOutOfMemory, &frame.MetadataChunks, metadataBuffer, metadataBufferCapacity, metadataLength);
+        info.FrameIndex             = frame.Index;
+        info.BeginNs                = frame.BeginNs;
+        info.DurationNs             = frame.DurationNs;
+        info.DidRunOutOfEventMemory = didRunOutOfMemory;
+
+
+        return true;
+    }
+
+
+    bool CSharpTrace::_dequeueSpanFrame(KLab_Profiling_Trace_SpanRecord *spanBuffer, const uint32_t spanBufferCapacity, KLab_Profiling_Trace_FrameInfo &info)
+    {
+        std::lock_guard<std::mutex> lock(_dequeueMutex);
+
+        Stopwatch timer;
+
+
+        if (!_detachCompletedFrame(timer))
+        {
+            return false;
+        }
+
+
+        // Gather without frame guard (likewise)
+        auto &frame             = _dequeuedFrame;
+        bool  didRunOutOfMemory = frame.SpanChunks.DidRunOutOfMemory();
+
+
+        info.EventCount             = _gatherSpans(frame.SpanChunks, timer, spanBuffer, spanBufferCapacity, didRunOutOfMemory);
+        info.FrameIndex             = frame.Index;
+        info.BeginNs                = frame.BeginNs;
+        info.DurationNs             = frame.DurationNs;
+        info.DidRunOutOfEventMemory = didRunOutOfMemory;
+
+
+        return true;
+    }
+
+
+    bool CSharpTrace::_detachCompletedFrame(Stopwatch &timer)
+    {
+        std::lock_guard<std::mutex> lock(_framesMutex);
+
+
+        auto frame = _tryGetCompletedFrame();
+
+
+        if (!frame)
+        {
+            return false;
+        }
+
+
+        // Grow chunks of dequeued frame to swap in first (only after swapchain grew)
+        auto &dequeued = _dequeuedFrame;
+
+
+        if (((dequeued.Chunks._capacity < frame->Chunks._capacity) && !dequeued.Chunks.Reserve(frame->Chunks._capacity)) ||
+            ((dequeued.MetadataChunks._capacity < frame->MetadataChunks._capacity) && !dequeued.MetadataChunks.Reserve(frame->MetadataChunks._capacity)) ||
+            ((dequeued.SpanChunks._capacity < frame->SpanChunks._capacity) && !dequeued.SpanChunks.Reserve(frame->SpanChunks._capacity)))
+        {
+            return false;
+        }
+
+
+        // Swap chunks (leaving chunks of previously dequeued frame for swapchain to reset on its flip)
+        frame->Chunks.Swap(dequeued.Chunks);
+        frame->MetadataChunks.Swap(dequeued.MetadataChunks);
+        frame->SpanChunks.Swap(dequeued.SpanChunks);
+
+        dequeued.Index      = frame->Index;
+        dequeued.BeginNs    = frame->BeginNs;
+        dequeued.DurationNs = frame->DurationNs;
+
+
+        timer = _timer;
+
+
+        ++_oldestFrameIndex;
+
+
+        return true;
+    }
+
+
+    CSharpTrace::Frame *CSharpTrace::_tryGetCompletedFrame()
+    {
+        // Keep last sealed frame back for a flip while tracing (as late writers might still commit to it)
+        const uint64_t completedFrameEnd = ((_mode != Mode::Continuous) ? _recordingFrameIndex : ((_recordingFrameIndex > 0) ? (_recordingFrameIndex - 1) : 0));
+
+
+        if (!_frames || (_oldestFrameIndex >= completedFrameEnd))
+        {
+            return nullptr;
+        }
+
+
+        return &_frames[_oldestFrameIndex % _frameCount];
+    }
+
+
+    KLab_Profiling_Trace_ContinuousTraceInfo CSharpTrace::_getContinuousInfo()
+    {
+        std::lock_guard<std::mutex> lock(_framesMutex);
+
+
+        const uint64_t completedFrameEnd = ((_mode != Mode::Continuous) ? _recordingFrameIndex : ((_recordingFrameIndex > 0) ? (_recordingFrameIndex - 1) : 0));
+
+
+        return
+        {
+            _recordingFrameIndex,
+            _droppedFrameCount,
+            ((completedFrameEnd > _oldestFrameIndex) ? uint32_t(completedFrameEnd - _oldestFrameIndex) : 0u),
+            (_mode == Mode::Continuous)
+        };
+    }
+
+
+    void CSharpTrace::_activateChunks(ThreadChunkPool<EventChunk> *chunks, ThreadChunkPool<MetadataChunk> *metadataChunks, ThreadChunkPool<SpanChunk> *spanChunks)
+    {
+        _activeChunks.store(chunks, std::memory_order_release);
+        _activeMetadataChunks.store(metadataChunks, std::memory_order_release);
+        _activeSpanChunks.store(spanChunks, std::memory_order_release);
+        _generation.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+
+    void CSharpTrace::_writeEvent(const KLab_Profiling_Trace_EventType type, ThreadContext &thread, const uint32_t markerID)
+    {
+        const uint32_t generation = _generation.load(std::memory_order_acquire);
+
+
+        // Allocate new chunk on new trace, new frame, or full chunk
+        if ((thread.ChunkGeneration != generation) || !thread.Chunk || (thread.Chunk->Length.load(std::memory_order_relaxed) == EventChunk::Capacity))
+        {
+            auto chunks = _activeChunks.load(std::memory_order_acquire);
+
+
+            thread.ChunkGeneration = generation;
+            thread.Chunk           = (chunks ? chunks->Allocate() : nullptr);
+        }
+
+
+        if (!thread.Chunk)
+        {
+            return;
+        }
+
+
+        // Write and commit record
+        auto           chunk  = thread.Chunk;
+        const uint32_t length = chunk->Length.load(std::memory_order_relaxed);
+        auto          &record = chunk->Data[length];
+
+
+        record.MarkerID    = markerID;
+        record.ThreadIndex = thread.Index;
+        record.Type        = uint16_t(type);
+        record.TimestampNs = _timer.GetTicks();
+
+
+        chunk->Length.store((length + 1), std::memory_order_release);
+    }
+
+
+    void CSharpTrace::_enterSpan(ThreadContext &thread, const uint32_t markerID)
+    {
+        auto spans = _getThreadSpans(thread);
+
+
+        if (!spans)
+        {
+            return;
+        }
+
+
+        if (spans->Depth < ThreadSpans::MaxDepth)
+        {
+            spans->Stack[spans->Depth] = { markerID, _timer.GetTicks() };
+        }
+
+
+        ++spans->Depth;
+    }
+
+
+    void CSharpTrace::_leaveSpan(ThreadContext &thread, const uint32_t markerID)
+    {
+        const uint64_t endTicks = _timer.GetTicks();
+        auto           spans    = _getThreadSpans(thread);
+
+
+        // Ignore sections entered before trace began
+        if (!spans || !spans->Depth)
+        {
+            return;
+        }
+
+
+        const uint32_t depth = --spans->Depth;
+
+
+        // Ignore sections too deep to track and mismatched sections
+        if ((depth >= ThreadSpans::MaxDepth) || (spans->Stack[depth].MarkerID != markerID))
+        {
+            return;
+        }
+
+
+        const uint32_t generation = _generation.load(std::memory_order_acquire);
+
+
+        // Allocate new chunk on new trace, new frame, or full chunk
+        if ((thread.SpanChunkGeneration != generation) || !thread.CurrentSpanChunk || (thread.CurrentSpanChunk->Length.load(std::memory_order_relaxed) == SpanChunk::Capacity))
+        {
+            auto chunks = _activeSpanChunks.load(std::memory_order_acquire);
+
+
+            thread.SpanChunkGeneration = generation;
+            thread.CurrentSpanChunk    = (chunks ? chunks->Allocate() : nullptr);
+        }
+
+
+        if (!thread.CurrentSpanChunk)
+        {
+            return;
+        }
+
+
+        // Write and commit span (ticks are converted into begin and duration on dequeue)
+        auto           chunk   = thread.CurrentSpanChunk;
+        const uint32_t length  = chunk->Length.load(std::memory_order_relaxed);
+        auto          &section = spans->Stack[depth];
+        auto          &record  = chunk->Data[length];
+
+
+        record.MarkerID    = markerID;
+        record.ThreadIndex = thread.Index;
+        record.Depth       = uint16_t(depth);
+        record.BeginNs     = section.BeginTicks;
+        record.DurationNs  = endTicks;
+
+
+        chunk->Length.store((length + 1), std::memory_order_release);
+    }
+
+
+    ThreadSpans *CSharpTrace::_getThreadSpans(ThreadContext &thread)
+    {
+        auto spans = thread.Spans;
+
+
+        // Create sections on first use (living as long as thread context)
+        if (!spans)
+        {
+            spans = NewAlignedArray<ThreadSpans>(1);
+
+
+            if (!spans)
+            {
+                return nullptr;
+            }
+
+
+            thread.Spans = spans;
+        }
+
+
+        // Forget sections of previous trace
+        const uint32_t generation = _spanGeneration.load(std::memory_order_acquire);
+
+
+        if (spans->Generation != generation)
+        {
+            spans->Generation = generation;
+            spans->Depth      = 0;
+        }
+
+
+        return spans;
+    }
+
+
+    CSharpTrace &GetCSharpTrace()
+    {
+        static CSharpTrace trace;
+
+
+        return trace;
+    }
+}}}
+
+
+// ----- //
+// TRACE //
+// ----- //
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginTrace(KLab_Profiling_Trace_EventInfo *eventBuffer, const int32_t eventBufferSize)
+{
+    auto &trace  = KLab::Profiling::Trace::GetCSharpTrace();
+
+
+    // Validate state (flight recorder disables C# trace while taking snapshot)
+    if (trace._isEnabled() || KLab::Profiling::Trace::GetFlightRecorder().IsRecording())
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    // Validate arguments
+    if (!eventBuffer || (eventBufferSize <= 0))
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    if (!trace._enable(eventBuffer, nullptr, uint32_t(eventBufferSize)))
+    {
+        return KLab_Profiling_ErrorCode_NotAvailable;
+    }
+
+
+    // Dispatch events right away (instead of from next update)
+    KLab::Profiling::Plugin::UpdateMarkerDispatch();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginCompactTrace(KLab_Profiling_Trace_EventRecord *eventBuffer, const int32_t eventBufferSize)
+{
+    auto &trace  = KLab::Profiling::Trace::GetCSharpTrace();
+
+
+    // Validate state (flight recorder disables C# trace while taking snapshot)
+    if (trace._isEnabled() || KLab::Profiling::Trace::GetFlightRecorder().IsRecording())
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    // Validate arguments
+    if (!eventBuffer || (eventBufferSize <= 0))
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    if (!trace._enable(nullptr, eventBuffer, uint32_t(eventBufferSize)))
+    {
+        return KLab_Profiling_ErrorCode_NotAvailable;
+    }
+
+
+    // Dispatch events right away (instead of from next update)
+    KLab::Profiling::Plugin::UpdateMarkerDispatch();
 
 
     return KLab_Profiling_ErrorCode_NoError;
@@ -176,7 +1073,7 @@ KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUti
 
 
     // Validate state
-    if (!trace._isEnabled())
+    if (trace._mode != KLab::Profiling::Trace::CSharpTrace::Mode::Single)
     {
         return KLab_Profiling_ErrorCode_InvalidState;
     }
@@ -186,5 +1083,191 @@ KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUti
     *info = trace._disable();
 
 
+    // Stop dispatching right away (instead of from next update)
+    KLab::Profiling::Plugin::UpdateMarkerDispatch();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginContinuousTrace(const int32_t frameCount, const int32_t eventsPerFrame)
+{
+    auto &trace = KLab::Profiling::Trace::GetCSharpTrace();
+
+
+    // Validate state (flight recorder disables C# trace while taking snapshot)
+    if (trace._isEnabled() || KLab::Profiling::Trace::GetFlightRecorder().IsRecording())
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    // Validate arguments
+    if ((frameCount < 3) || (eventsPerFrame <= 0))
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    if (!trace._enableContinuous(uint32_t(frameCount), uint32_t(eventsPerFrame), trace._metadataBytesPerFrame.load(std::memory_order_relaxed)))
+    {
+        return KLab_Profiling_ErrorCode_NotAvailable;
+    }
+
+
+    // Dispatch events right away (instead of from next update)
+    KLab::Profiling::Plugin::UpdateMarkerDispatch();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_EndContinuousTrace()
+{
+    auto &trace = KLab::Profiling::Trace::GetCSharpTrace();
+
+
+    // Validate state (streaming trace and flight recorder end themselves)
+    if ((trace._mode != KLab::Profiling::Trace::CSharpTrace::Mode::Continuous) || KLab::Profiling::Trace::GetStreamingTrace().IsStreaming() || KLab::Profiling::Trace::GetFlightRecorder().IsRecording())
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    trace._disableContinuous();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_DequeueFrame(KLab_Profiling_Trace_EventRecord *eventBuffer, const int32_t eventBufferSize, KLab_Profiling_Trace_FrameInfo *info)
+{
+    auto &trace = KLab::Profiling::Trace::GetCSharpTrace();
+
+
+    // Validate state (streaming trace and flight recorder own frames, span trace records spans only)
+    if (trace._isSpanMode || KLab::Profiling::Trace::GetStreamingTrace().IsStreaming() || KLab::Profiling::Trace::GetFlightRecorder().IsRecording())
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    // Validate arguments
+    if (!eventBuffer || (eventBufferSize <= 0) || !info)
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    return (trace._dequeueFrame(eventBuffer, uint32_t(eventBufferSize), *info) ? KLab_Profiling_ErrorCode_NoError : KLab_Profiling_ErrorCode_NotAvailable);
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_DequeueFrameWithMetadata(KLab_Profiling_Trace_EventRecord *eventBuffer, const int32_t eventBufferSize, uint8_t *metadataBuffer, const int32_t metadataBufferSize, int32_t *metadataLength, KLab_Profiling_Trace_FrameInfo *info)
+{
+    auto &trace = KLab::Profiling::Trace::GetCSharpTrace();
+
+
+    // Validate state (streaming trace and flight recorder own frames, span trace records spans only)
+    if (trace._isSpanMode || KLab::Profiling::Trace::GetStreamingTrace().IsStreaming() || KLab::Profiling::Trace::GetFlightRecorder().IsRecording())
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    // Validate arguments
+    if (!eventBuffer || (eventBufferSize <= 0) || !metadataBuffer || (metadataBufferSize <= 0) || !metadataLength || !info)
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    uint32_t length = 0;
+
+
+    if (!trace._dequeueFrame(eventBuffer, uint32_t(eventBufferSize), *info, metadataBuffer, uint32_t(metadataBufferSize), &length))
+    {
+        return KLab_Profiling_ErrorCode_NotAvailable;
+    }
+
+
+    *metadataLength = int32_t(length);
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginSpanTrace(const int32_t frameCount, const int32_t spansPerFrame)
+{
+    auto &trace = KLab::Profiling::Trace::GetCSharpTrace();
+
+
+    // Validate state (flight recorder disables C# trace while taking snapshot)
+    if (trace._isEnabled() || KLab::Profiling::Trace::GetFlightRecorder().IsRecording())
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    // Validate arguments
+    if ((frameCount < 3) || (spansPerFrame <= 0))
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    if (!trace._enableContinuous(uint32_t(frameCount), uint32_t(spansPerFrame), 0, true))
+    {
+        return KLab_Profiling_ErrorCode_NotAvailable;
+    }
+
+
+    // Dispatch events right away (instead of from next update)
+    KLab::Profiling::Plugin::UpdateMarkerDispatch();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_DequeueSpanFrame(KLab_Profiling_Trace_SpanRecord *spanBuffer, const int32_t spanBufferSize, KLab_Profiling_Trace_FrameInfo *info)
+{
+    auto &trace = KLab::Profiling::Trace::GetCSharpTrace();
+
+
+    // Validate state
+    if (!trace._isSpanMode)
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    // Validate arguments
+    if (!spanBuffer || (spanBufferSize <= 0) || !info)
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    return (trace._dequeueSpanFrame(spanBuffer, uint32_t(spanBufferSize), *info) ? KLab_Profiling_ErrorCode_NoError : KLab_Profiling_ErrorCode_NotAvailable);
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetContinuousTraceInfo(KLab_Profiling_Trace_ContinuousTraceInfo *info)
+{
+    // Validate arguments
+    if (!info)
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    *info = KLab::Profiling::Trace::GetCSharpTrace()._getContinuousInfo();
+
+
     return KLab_Profiling_ErrorCode_NoError;
 }
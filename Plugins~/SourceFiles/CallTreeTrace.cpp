@@ -0,0 +1,568 @@
+// -------------------------------------------------------------------------------------------- //
+//  Copyright (c) KLab Inc.. All rights reserved.                                               //
+//  Licensed under the MIT License. See 'LICENSE' in the project root for license information.  //
+// -------------------------------------------------------------------------------------------- //
+
+#include <KLab/Profiling/Internal.hpp>
+
+
+// -------- //
+// INCLUDES //
+// -------- //
+
+#include <algorithm>
+#include <utility>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    // Merges children of node of other tree into node of tree (recursing into children)
+    // @param tree - Tree to merge into
+    // @param node - Index of node to merge into
+    // @param other - Tree to merge
+    // @param otherNode - Index of node to merge
+    static void _mergeChildren(CallTree &tree, const uint32_t node, const CallTree &other, const uint32_t otherNode)
+    {
+        for (uint32_t c = other.Nodes[otherNode].FirstChild; c != CallTree::InvalidIndex; c = other.Nodes[c].NextSibling)
+        {
+            const auto     &source = other.Nodes[c];
+            const uint32_t  child  = tree.Intern(node, source.MarkerID);
+
+
+            if (child == CallTree::InvalidIndex)
+            {
+                continue;
+            }
+
+
+            auto &target = tree.Nodes[child];
+
+
+            target.Calls   += source.Calls;
+            target.TotalNs += source.TotalNs;
+            target.SelfNs  += source.SelfNs;
+
+
+            _mergeChildren(tree, child, other, c);
+        }
+    }
+
+
+    // Copies children of node in pre-order (recursing into children)
+    // @param tree - Tree to copy
+    // @param node - Index of node
+    // @param threadIndex - Dense index of thread tree belongs to
+    // @param depth - Depth of children
+    // @param nodes - [Optional] Buffer for nodes
+    // @param capacity - Capacity of buffer
+    // @param count - Number of nodes listed (counting nodes beyond capacity)
+    static void _listChildren(const CallTree &tree, const uint32_t node, const uint16_t threadIndex, const uint16_t depth, CallTreeNode *nodes, const uint32_t capacity, uint32_t &count)
+    {
+        for (uint32_t c = tree.Nodes[node].FirstChild; c != CallTree::InvalidIndex; c = tree.Nodes[c].NextSibling)
+        {
+            const uint32_t index = count++;
+
+
+            _listChildren(tree, c, threadIndex, uint16_t(depth + 1), nodes, capacity, count);
+
+
+            // Fill in after children to know size of subtree
+            if (nodes && (index < capacity))
+            {
+                const auto &source = tree.Nodes[c];
+                auto       &target = nodes[index];
+
+
+                target.MarkerID        = source.MarkerID;
+                target.ThreadIndex     = threadIndex;
+                target.Depth           = depth;
+                target.Calls           = source.Calls;
+                target.DescendantCount = (count - index - 1);
+                target.TotalNs         = source.TotalNs;
+                target.SelfNs          = source.SelfNs;
+            }
+        }
+    }
+}}}
+
+
+// --------- //
+// CALL TREE //
+// --------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    uint32_t CallTree::Intern(const uint32_t parent, const uint32_t markerID)
+    {
+        // Children of dropped nodes get dropped as well
+        if (parent == InvalidIndex)
+        {
+            return InvalidIndex;
+        }
+
+
+        // Create root on first use
+        if (Nodes.empty())
+        {
+            Nodes.push_back({ MarkerTable::InvalidID, InvalidIndex, InvalidIndex, 0, 0, 0 });
+        }
+
+
+        for (uint32_t c = Nodes[parent].FirstChild; c != InvalidIndex; c = Nodes[c].NextSibling)
+        {
+            if (Nodes[c].MarkerID == markerID)
+            {
+                return c;
+            }
+        }
+
+
+        if (Nodes.size() >= MaxNodeCount)
+        {
+            DidRunOutOfNodes = true;
+
+
+            return InvalidIndex;
+        }
+
+
+        // Link as first child
+        const uint32_t child = uint32_t(Nodes.size());
+        const Node     node  = { markerID, InvalidIndex, Nodes[parent].FirstChild, 0, 0, 0 };
+
+
+        Nodes.push_back(node);
+
+        Nodes[parent].FirstChild = child;
+
+
+        return child;
+    }
+
+
+    void CallTree::Merge(const CallTree &other)
+    {
+        if (other.DidRunOutOfNodes)
+        {
+            DidRunOutOfNodes = true;
+        }
+        if (!other.Nodes.empty())
+        {
+            _mergeChildren(*this, 0, other, 0);
+        }
+    }
+
+
+    void CallTree::Clear()
+    {
+        Nodes.clear();
+
+        DidRunOutOfNodes = false;
+    }
+}}}
+
+
+// --------------- //
+// CALL TREE TRACE //
+// --------------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    bool CallTreeTrace::IsTracing() const
+    {
+        return _isTracing.load(std::memory_order_relaxed);
+    }
+
+
+    void CallTreeTrace::Flip()
+    {
+        if (!IsTracing())
+        {
+            return;
+        }
+
+
+        _timer.Calibrate();
+        _nsPerTick.store(_timer._nsPerTick, std::memory_order_relaxed);
+
+
+        // Seal frame currently recorded
+        const uint64_t frame = _frameIndex.load(std::memory_order_relaxed);
+
+
+        _frameIndex.store((frame + 1), std::memory_order_release);
+
+
+        // Merge frame sealed on previous flip (as late writers might have still committed to it)
+        if (frame > 0)
+        {
+            _merge(uint32_t((frame - 1) % ThreadCallTree::SetCount), (frame - 1));
+        }
+    }
+
+
+    void CallTreeTrace::EnterSection(ThreadContext &thread, const uint32_t markerID)
+    {
+        auto tree = _getThreadCallTree(thread);
+
+
+        if (!tree)
+        {
+            return;
+        }
+
+
+        if (tree->Depth < ThreadCallTree::MaxDepth)
+        {
+            auto          &frameTree = _getFrameTree(*tree);
+            const uint32_t parent    = (tree->Depth ? tree->Stack[tree->Depth - 1].Node : 0);
+
+
+            tree->Stack[tree->Depth] = { markerID, frameTree.Intern(parent, markerID), _timer.GetTicks(), 0 };
+        }
+
+
+        ++tree->Depth;
+    }
+
+
+    void CallTreeTrace::LeaveSection(ThreadContext &thread, const uint32_t markerID)
+    {
+        const uint64_t endTicks = _timer.GetTicks();
+        auto           tree     = _getThreadCallTree(thread);
+
+
+        // Ignore sections entered before trace began
+        if (!tree || !tree->Depth)
+        {
+            return;
+        }
+
+
+        // Count section in frame it ends in (before popping to re-intern it if frame changed)
+        auto          &frameTree = _getFrameTree(*tree);
+        const uint32_t depth     = --tree->Depth;
+
+
+        // Ignore sections too deep to track and mismatched sections
+        if ((depth >= ThreadCallTree::MaxDepth) || (tree->Stack[depth].MarkerID != markerID))
+        {
+            return;
+        }
+
+
+        // Measure section
+        const auto     &section    = tree->Stack[depth];
+        const uint64_t  durationNs = uint64_t(double(endTicks - section.BeginTicks) * _nsPerTick.load(std::memory_order_relaxed));
+        const uint64_t  selfNs     = (durationNs - std::min(section.ChildNs, durationNs));
+
+
+        if (depth > 0)
+        {
+            tree->Stack[depth - 1].ChildNs += durationNs;
+        }
+
+
+        if (section.Node == CallTree::InvalidIndex)
+        {
+            return;
+        }
+
+
+        // Accumulate into node
+        auto &node = frameTree.Nodes[section.Node];
+
+
+        ++node.Calls;
+
+        node.TotalNs += durationNs;
+        node.SelfNs  += selfNs;
+    }
+
+
+    void CallTreeTrace::_enable()
+    {
+        std::lock_guard<std::mutex> lock(_resultsMutex);
+
+
+        // Clear trees left by previous trace
+        for (auto tree = _threads.load(std::memory_order_acquire); tree; tree = tree->Next)
+        {
+            for (auto &set : tree->Sets)
+            {
+                set.Clear();
+            }
+
+
+            tree->Frame.Clear();
+            tree->Window.Clear();
+        }
+
+
+        _resultFrameIndex = 0;
+        _windowFrameCount = 0;
+        _hasResults       = false;
+
+
+        // Initialize state
+        _timer.Reset();
+        _nsPerTick.store(_timer._nsPerTick, std::memory_order_relaxed);
+
+        _frameIndex.store(0, std::memory_order_relaxed);
+        _generation.fetch_add(1, std::memory_order_acq_rel);
+        _isTracing.store(true, std::memory_order_release);
+    }
+
+
+    void CallTreeTrace::_disable()
+    {
+        _isTracing.store(false, std::memory_order_release);
+    }
+
+
+    void CallTreeTrace::_resetWindow()
+    {
+        std::lock_guard<std::mutex> lock(_resultsMutex);
+
+
+        for (auto tree = _threads.load(std::memory_order_acquire); tree; tree = tree->Next)
+        {
+            tree->Window.Clear();
+        }
+
+
+        _windowFrameCount = 0;
+    }
+
+
+    bool CallTreeTrace::_getResults(CallTreeNode *nodeBuffer, const uint32_t nodeBufferCapacity, const KLab_Profiling_Trace_CallTreeScope scope, KLab_Profiling_Trace_CallTreeInfo &info)
+    {
+        std::lock_guard<std::mutex> lock(_resultsMutex);
+
+
+        const bool isWindow         = (scope == KLab_Profiling_Trace_CallTreeScope_Window);
+        uint32_t   count            = 0;
+        bool       didRunOutOfNodes = false;
+
+
+        for (auto tree = _threads.load(std::memory_order_acquire); tree; tree = tree->Next)
+        {
+            const auto &source = (isWindow ? tree->Window : tree->Frame);
+
+
+            if (!source.Nodes.empty())
+            {
+                _listChildren(source, 0, tree->ThreadIndex, 0, nodeBuffer, nodeBufferCapacity, count);
+            }
+            if (source.DidRunOutOfNodes)
+            {
+                didRunOutOfNodes = true;
+            }
+        }
+
+
+        info.FrameIndex       = _resultFrameIndex;
+        info.FrameCount       = (isWindow ? _windowFrameCount : (_hasResults ? 1 : 0));
+        info.NodeCount        = count;
+        info.IsTracing        = IsTracing();
+        info.DidRunOutOfNodes = didRunOutOfNodes;
+
+
+        return _hasResults;
+    }
+
+
+    ThreadCallTree *CallTreeTrace::_getThreadCallTree(ThreadContext &thread)
+    {
+        auto tree = thread.CallTree;
+
+
+        // Create and register trees on first use
+        if (!tree)
+        {
+            tree = NewAlignedArray<ThreadCallTree>(1);
+
+
+            if (!tree)
+            {
+                return nullptr;
+            }
+
+
+            tree->ThreadIndex = thread.Index;
+
+
+            auto head = _threads.load(std::memory_order_relaxed);
+
+
+            do
+            {
+                tree->Next = head;
+            }
+            while (!_threads.compare_exchange_weak(head, tree, std::memory_order_release, std::memory_order_relaxed));
+
+
+            thread.CallTree = tree;
+        }
+
+
+        // Drop sections of previous trace
+        const uint32_t generation = _generation.load(std::memory_order_acquire);
+
+
+        if (tree->Generation != generation)
+        {
+            tree->Generation = generation;
+            tree->Depth      = 0;
+        }
+
+
+        return tree;
+    }
+
+
+    CallTree &CallTreeTrace::_getFrameTree(ThreadCallTree &tree)
+    {
+        const uint64_t frame     = _frameIndex.load(std::memory_order_acquire);
+        auto          &frameTree = tree.Sets[frame % ThreadCallTree::SetCount];
+
+
+        // Re-intern sections open across flip into tree of new frame
+        if (tree.StackFrameIndex != frame)
+        {
+            const uint32_t depth  = ((tree.Depth < ThreadCallTree::MaxDepth) ? tree.Depth : ThreadCallTree::MaxDepth);
+            uint32_t       parent = 0;
+
+
+            for (uint32_t d = 0; d < depth; ++d)
+            {
+                parent = frameTree.Intern(parent, tree.Stack[d].MarkerID);
+
+                tree.Stack[d].Node = parent;
+            }
+
+
+            tree.StackFrameIndex = frame;
+        }
+
+
+        return frameTree;
+    }
+
+
+    void CallTreeTrace::_merge(const uint32_t set, const uint64_t frameIndex)
+    {
+        std::lock_guard<std::mutex> lock(_resultsMutex);
+
+
+        for (auto tree = _threads.load(std::memory_order_acquire); tree; tree = tree->Next)
+        {
+            auto &sealed = tree->Sets[set];
+
+
+            // Take over sealed tree (handing storage of previous frame back to pool)
+            std::swap(tree->Frame.Nodes, sealed.Nodes);
+
+            tree->Frame.DidRunOutOfNodes = sealed.DidRunOutOfNodes;
+
+            sealed.Clear();
+
+
+            tree->Window.Merge(tree->Frame);
+        }
+
+
+        _resultFrameIndex = frameIndex;
+        _hasResults       = true;
+
+        ++_windowFrameCount;
+    }
+
+
+    CallTreeTrace &GetCallTreeTrace()
+    {
+        static CallTreeTrace trace;
+
+
+        return trace;
+    }
+}}}
+
+
+// ----- //
+// TRACE //
+// ----- //
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginCallTreeTrace()
+{
+    auto &trace = KLab::Profiling::Trace::GetCallTreeTrace();
+
+
+    // Validate state
+    if (trace.IsTracing())
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    trace._enable();
+
+
+    // Dispatch events right away (instead of from next update)
+    KLab::Profiling::Plugin::UpdateMarkerDispatch();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_EndCallTreeTrace()
+{
+    auto &trace = KLab::Profiling::Trace::GetCallTreeTrace();
+
+
+    // Validate state
+    if (!trace.IsTracing())
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    trace._disable();
+
+
+    // Stop dispatching right away (instead of from next update)
+    KLab::Profiling::Plugin::UpdateMarkerDispatch();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetCallTree(KLab_Profiling_Trace_CallTreeNode *nodeBuffer, const int32_t nodeBufferSize, const KLab_Profiling_Trace_CallTreeScope scope, KLab_Profiling_Trace_CallTreeInfo *info)
+{
+    // Validate arguments
+    if (!info || (nodeBuffer && (nodeBufferSize <= 0)) || ((scope != KLab_Profiling_Trace_CallTreeScope_Frame) && (scope != KLab_Profiling_Trace_CallTreeScope_Window)))
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    const bool hasResults = KLab::Profiling::Trace::GetCallTreeTrace()._getResults(nodeBuffer, (nodeBuffer ? uint32_t(nodeBufferSize) : 0u), scope, *info);
+
+
+    return (hasResults ? KLab_Profiling_ErrorCode_NoError : KLab_Profiling_ErrorCode_NotAvailable);
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_ResetCallTreeWindow()
+{
+    KLab::Profiling::Trace::GetCallTreeTrace()._resetWindow();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
@@ -0,0 +1,57 @@
+// -------------------------------------------------------------------------------------------- //
+//  Copyright (c) KLab Inc.. All rights reserved.                                               //
+//  Licensed under the MIT License. See 'LICENSE' in the project root for license information.  //
+// -------------------------------------------------------------------------------------------- //
+
+#include <KLab/Profiling/Internal.hpp>
+
+
+// -------------- //
+// CATEGORY TABLE //
+// -------------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    void CategoryTable::Set(const uint32_t id, const char *name, const uint32_t color)
+    {
+        auto entry = _entries.GetOrCreate(id);
+
+
+        if (!entry || !name)
+        {
+            return;
+        }
+
+
+        entry->Color.store(color, std::memory_order_relaxed);
+        entry->Name.store(name, std::memory_order_release);
+    }
+
+
+    SectionGroupInfo CategoryTable::GetOrDefault(const uint32_t id) const
+    {
+        SectionGroupInfo group;
+
+        auto entry = _entries.TryGet(id);
+        auto name  = (entry ? entry->Name.load(std::memory_order_acquire) : nullptr);
+
+
+        if (name)
+        {
+            group.Name  = name;
+            group.Color = entry->Color.load(std::memory_order_relaxed);
+        }
+
+
+        return group;
+    }
+
+
+    CategoryTable &GetCategoryTable()
+    {
+        static CategoryTable table;
+
+
+        return table;
+    }
+}}}
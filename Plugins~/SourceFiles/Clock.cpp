@@ -0,0 +1,99 @@
+// -------------------------------------------------------------------------------------------- //
+//  Copyright (c) KLab Inc.. All rights reserved.                                               //
+//  Licensed under the MIT License. See 'LICENSE' in the project root for license information.  //
+// -------------------------------------------------------------------------------------------- //
+
+#include <KLab/Profiling/Internal.hpp>
+
+
+// -------- //
+// INCLUDES //
+// -------- //
+
+#if (KLAB_PROFILING_HAS_CYCLE_COUNTER) && !(defined(__aarch64__))
+#if (_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+namespace KLab { namespace Profiling
+{
+    // Detects whether raw counter is reliable
+    // @return true if reliable; false otherwise
+    static bool _detectCounterReliability()
+    {
+        #if (KLAB_PROFILING_HAS_CYCLE_COUNTER) && (defined(__aarch64__))
+        // Generic timer is architected and constant rate
+        return true;
+        #elif (KLAB_PROFILING_HAS_CYCLE_COUNTER)
+        // Require invariant TSC (CPUID.80000007H:EDX[8])
+        unsigned int registers[4] = { 0, 0, 0, 0 };
+
+
+        #if (_MSC_VER)
+        __cpuid(reinterpret_cast<int *>(registers), 0x80000000);
+        #else
+        __get_cpuid(0x80000000, &registers[0], &registers[1], &registers[2], &registers[3]);
+        #endif
+
+
+        if (registers[0] < 0x80000007)
+        {
+            return false;
+        }
+
+
+        #if (_MSC_VER)
+        __cpuid(reinterpret_cast<int *>(registers), 0x80000007);
+        #else
+        __get_cpuid(0x80000007, &registers[0], &registers[1], &registers[2], &registers[3]);
+        #endif
+
+
+        return ((registers[3] & (1u << 8)) != 0);
+        #else
+        return false;
+        #endif
+    }
+}}
+
+
+// ----- //
+// CLOCK //
+// ----- //
+
+namespace KLab { namespace Profiling
+{
+    const bool Clock::_isCounterReliable = _detectCounterReliability();
+
+
+    uint64_t Clock::GetNominalFrequency()
+    {
+        if (!_isCounterReliable)
+        {
+            // Steady clock ticks in nanoseconds
+            return 1000000000u;
+        }
+
+
+        #if (KLAB_PROFILING_HAS_CYCLE_COUNTER) && (defined(__aarch64__))
+        uint64_t frequency;
+
+
+        asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+
+
+        return frequency;
+        #else
+        // TSC frequency has to be calibrated
+        return 0;
+        #endif
+    }
+}}
@@ -0,0 +1,474 @@
+// -------------------------------------------------------------------------------------------- //
+//  Copyright (c) KLab Inc.. All rights reserved.                                               //
+//  Licensed under the MIT License. See 'LICENSE' in the project root for license information.  //
+// -------------------------------------------------------------------------------------------- //
+
+#include <KLab/Profiling/Internal.hpp>
+
+
+// -------- //
+// INCLUDES //
+// -------- //
+
+#include <cstring>
+
+
+// --------------- //
+// FLIGHT RECORDER //
+// --------------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    bool FlightRecorder::IsRecording() const
+    {
+        return _isRecording.load(std::memory_order_acquire);
+    }
+
+
+    void FlightRecorder::Flip()
+    {
+        if (!IsRecording())
+        {
+            return;
+        }
+
+
+        const uint64_t nowNs      = Clock::GetSteadyNs();
+        const uint64_t durationNs = (nowNs - _lastFlipNs);
+
+
+        _lastFlipNs = nowNs;
+
+
+        // Resume recording once writer took snapshot
+        if (!_trace->_isEnabled())
+        {
+            if (_isSnapshotting.load(std::memory_order_acquire))
+            {
+                if (_hitchThresholdNs && (durationNs >= _hitchThresholdNs))
+                {
+                    _skippedSnapshotCount.fetch_add(1, std::memory_order_relaxed);
+                }
+
+
+                return;
+            }
+
+
+            _trace->_enableContinuous(_frameCount, _eventsPerFrame);
+
+
+            return;
+        }
+
+
+        // Freeze on hitch (only judging frames recorded as whole) or trigger
+        const bool isHitch = (_hitchThresholdNs && (durationNs >= _hitchThresholdNs));
+
+
+        if (_isTriggered.exchange(false, std::memory_order_acq_rel) || isHitch)
+        {
+            _freeze(isHitch ? durationNs : 0);
+        }
+    }
+
+
+    void FlightRecorder::Trigger()
+    {
+        _isTriggered.store(true, std::memory_order_release);
+    }
+
+
+    KLab_Profiling_ErrorCode FlightRecorder::_begin(const uint32_t frameCount, const uint32_t eventsPerFrame, const uint64_t hitchThresholdNs, const char *pathPrefix)
+    {
+        // Start continuous trace
+        const uint32_t chunksPerFrame = ((eventsPerFrame + CSharpTrace::EventChunk::Capacity - 1) / CSharpTrace::EventChunk::Capacity);
+
+
+        _trace = &GetCSharpTrace();
+
+
+        if (!_trace->_enableContinuous(frameCount, eventsPerFrame))
+        {
+            return KLab_Profiling_ErrorCode_NotAvailable;
+        }
+
+
+        // Initialize state (discarding previous snapshot)
+        {
+            std::lock_guard<std::mutex> lock(_snapshotMutex);
+
+
+            _recordsPerFrame = (chunksPerFrame * CSharpTrace::EventChunk::Capacity);
+
+            _records.resize(size_t(frameCount) * _recordsPerFrame);
+            _frames.resize(frameCount);
+            _stagedRecords.resize(_records.size());
+            _stagedFrames.resize(frameCount);
+
+            _snapshotFrameCount = 0;
+            _dequeuedFrameCount = 0;
+        }
+
+
+        _pathPrefix       = (pathPrefix ? pathPrefix : "");
+        _hitchThresholdNs = hitchThresholdNs;
+        _frameCount       = frameCount;
+        _eventsPerFrame   = eventsPerFrame;
+        _lastFlipNs       = Clock::GetSteadyNs();
+
+        _isSnapshotRequested = false;
+        _isStopRequested     = false;
+
+        _isSnapshotting       = false;
+        _isTriggered          = false;
+        _snapshotCount        = 0;
+        _skippedSnapshotCount = 0;
+        _lastHitchDurationNs  = 0;
+
+        _writer._didFailToWrite = false;
+
+
+        // Start writer
+        _isRecording = true;
+        _thread      = std::thread(&FlightRecorder::_run, this);
+
+
+        return KLab_Profiling_ErrorCode_NoError;
+    }
+
+
+    void FlightRecorder::_end()
+    {
+        // Stop recording unless frozen for snapshot
+        if (_trace->_isEnabled())
+        {
+            _trace->_disableContinuous();
+        }
+
+
+        // Let writer finish snapshot being taken
+        {
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+
+
+            _isStopRequested = true;
+        }
+
+
+        _wakeCondition.notify_one();
+        _thread.join();
+
+
+        _isRecording = false;
+    }
+
+
+    KLab_Profiling_Trace_FlightRecorderInfo FlightRecorder::_getInfo()
+    {
+        std::lock_guard<std::mutex> lock(_snapshotMutex);
+
+
+        return
+        {
+            _snapshotCount.load(std::memory_order_relaxed),
+            _skippedSnapshotCount.load(std::memory_order_relaxed),
+            _lastHitchDurationNs.load(std::memory_order_relaxed),
+            _snapshotFrameCount,
+            (_snapshotFrameCount - _dequeuedFrameCount),
+            _writer._didFailToWrite.load(std::memory_order_relaxed),
+            _isRecording.load(std::memory_order_relaxed)
+        };
+    }
+
+
+    bool FlightRecorder::_dequeueFrame(KLab_Profiling_Trace_EventRecord *recordBuffer, const uint32_t recordBufferCapacity, KLab_Profiling_Trace_FrameInfo &info)
+    {
+        std::lock_guard<std::mutex> lock(_snapshotMutex);
+
+
+        if (_dequeuedFrameCount >= _snapshotFrameCount)
+        {
+            return false;
+        }
+
+
+        const auto &frame = _frames[_dequeuedFrameCount];
+
+
+        info = frame;
+
+
+        // Truncate frame not fitting into buffer
+        if (info.EventCount > recordBufferCapacity)
+        {
+            info.EventCount             = recordBufferCapacity;
+            info.DidRunOutOfEventMemory = true;
+        }
+
+
+        std::memcpy(recordBuffer, (_records.data() + (size_t(_dequeuedFrameCount) * _recordsPerFrame)), (info.EventCount * sizeof(KLab_Profiling_Trace_EventRecord)));
+
+        ++_dequeuedFrameCount;
+
+
+        return true;
+    }
+
+
+    void FlightRecorder::_freeze(const uint64_t hitchDurationNs)
+    {
+        // Seal frame currently recorded (keeping ring dequeueable by writer)
+        _trace->_disableContinuous();
+
+        _lastHitchDurationNs.store(hitchDurationNs, std::memory_order_relaxed);
+        _isSnapshotting.store(true, std::memory_order_release);
+
+
+        // Wake writer
+        {
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+
+
+            _isSnapshotRequested = true;
+        }
+
+
+        _wakeCondition.notify_one();
+    }
+
+
+    void FlightRecorder::_run()
+    {
+        LowerCurrentThreadPriority();
+
+
+        for (bool isStopRequested = false; !isStopRequested;)
+        {
+            bool isSnapshotRequested;
+
+
+            // Wait for freeze
+            {
+                std::unique_lock<std::mutex> lock(_wakeMutex);
+
+
+                _wakeCondition.wait(lock, [this]() { return (_isSnapshotRequested || _isStopRequested); });
+
+                isSnapshotRequested  = _isSnapshotRequested;
+                isStopRequested      = _isStopRequested;
+                _isSnapshotRequested = false;
+            }
+
+
+            if (!isSnapshotRequested)
+            {
+                continue;
+            }
+
+
+            // Copy frozen ring out and resume recording (with next flip) before writing file
+            _takeSnapshot();
+
+
+            const uint64_t snapshotIndex = _snapshotCount.fetch_add(1, std::memory_order_relaxed);
+
+
+            _isSnapshotting.store(false, std::memory_order_release);
+
+
+            if (!_pathPrefix.empty())
+            {
+                _writeSnapshot(snapshotIndex);
+            }
+        }
+    }
+
+
+    void FlightRecorder::_takeSnapshot()
+    {
+        uint32_t frameCount = 0;
+
+
+        // Dequeue into staging without snapshot guard (as C# reading previous snapshot would otherwise wait for gathering)
+        while ((frameCount < _frameCount) && _trace->_dequeueFrame((_stagedRecords.data() + (size_t(frameCount) * _recordsPerFrame)), _recordsPerFrame, _stagedFrames[frameCount]))
+        {
+            ++frameCount;
+        }
+
+
+        // Publish snapshot
+        std::lock_guard<std::mutex> lock(_snapshotMutex);
+
+
+        _records.swap(_stagedRecords);
+        _frames.swap(_stagedFrames);
+
+        _snapshotFrameCount = frameCount;
+        _dequeuedFrameCount = 0;
+    }
+
+
+    void FlightRecorder::_writeSnapshot(const uint64_t snapshotIndex)
+    {
+        const auto path = (_pathPrefix + '-' + std::to_string(snapshotIndex) + ".klpt");
+
+
+        if (!_writer.Open(path.c_str()))
+        {
+            _writer._didFailToWrite = true;
+
+
+            return;
+        }
+
+
+        // Read snapshot without guard as only writer modifies it (dequeues only read)
+        KLab_Profiling_Trace_StreamingTraceInfo info = {};
+
+
+        _writer.WriteDefinitions(true);
+
+
+        for (uint32_t f = 0; f < _snapshotFrameCount; ++f)
+        {
+            const auto &frame = _frames[f];
+
+
+            _writer.WriteBlock(StreamFormat::BlockType_Frame, &frame, sizeof(frame), (_records.data() + (size_t(f) * _recordsPerFrame)), (frame.EventCount * sizeof(KLab_Profiling_Trace_EventRecord)));
+
+
+            if (frame.DidRunOutOfEventMemory)
+            {
+                ++info.OverflowFrameCount;
+            }
+        }
+
+
+        info.BytesWritten      = _writer._bytesWritten.load(std::memory_order_relaxed);
+        info.WriteDurationNs   = _writer._writeDurationNs.load(std::memory_order_relaxed);
+        info.WrittenFrameCount = _snapshotFrameCount;
+        info.DidFailToWrite    = _writer._didFailToWrite.load(std::memory_order_relaxed);
+
+
+        _writer.WriteBlock(StreamFormat::BlockType_End, &info, sizeof(info));
+        _writer.Close();
+    }
+
+
+    FlightRecorder &GetFlightRecorder()
+    {
+        static FlightRecorder recorder;
+
+
+        return recorder;
+    }
+}}}
+
+
+// ----- //
+// TRACE //
+// ----- //
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginFlightRecorder(const int32_t frameCount, const int32_t eventsPerFrame, const int32_t hitchThresholdUs, const char *pathPrefix)
+{
+    auto &recorder = KLab::Profiling::Trace::GetFlightRecorder();
+
+
+    // Validate state
+    if (recorder.IsRecording() || KLab::Profiling::Trace::GetCSharpTrace()._isEnabled() || KLab::Profiling::Trace::GetStreamingTrace().IsStreaming())
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    // Validate arguments
+    if ((frameCount < 3) || (eventsPerFrame <= 0) || (hitchThresholdUs < 0))
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    const auto result = recorder._begin(uint32_t(frameCount), uint32_t(eventsPerFrame), (uint64_t(hitchThresholdUs) * 1000), pathPrefix);
+
+
+    if (result == KLab_Profiling_ErrorCode_NoError)
+    {
+        // Dispatch events right away (instead of from next update)
+        KLab::Profiling::Plugin::UpdateMarkerDispatch();
+    }
+
+
+    return result;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_EndFlightRecorder()
+{
+    auto &recorder = KLab::Profiling::Trace::GetFlightRecorder();
+
+
+    // Validate state
+    if (!recorder.IsRecording())
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    recorder._end();
+
+
+    // Stop dispatching right away (instead of from next update)
+    KLab::Profiling::Plugin::UpdateMarkerDispatch();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_TriggerFlightRecorder()
+{
+    auto &recorder = KLab::Profiling::Trace::GetFlightRecorder();
+
+
+    // Validate state
+    if (!recorder.IsRecording())
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    recorder.Trigger();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetFlightRecorderInfo(KLab_Profiling_Trace_FlightRecorderInfo *info)
+{
+    // Validate arguments
+    if (!info)
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    *info = KLab::Profiling::Trace::GetFlightRecorder()._getInfo();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_DequeueSnapshotFrame(KLab_Profiling_Trace_EventRecord *eventBuffer, const int32_t eventBufferSize, KLab_Profiling_Trace_FrameInfo *info)
+{
+    // Validate arguments
+    if (!eventBuffer || (eventBufferSize <= 0) || !info)
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    return (KLab::Profiling::Trace::GetFlightRecorder()._dequeueFrame(eventBuffer, uint32_t(eventBufferSize), *info) ? KLab_Profiling_ErrorCode_NoError : KLab_Profiling_ErrorCode_NotAvailable);
+}
@@ -0,0 +1,586 @@
+// -------------------------------------------------------------------------------------------- //
+//  Copyright (c) KLab Inc.. All rights reserved.                                               //
+//  Licensed under the MIT License. See 'LICENSE' in the project root for license information.  //
+// -------------------------------------------------------------------------------------------- //
+
+#include <KLab/Profiling/Internal.hpp>
+
+
+// -------- //
+// INCLUDES //
+// -------- //
+
+#include <algorithm>
+#include <cmath>
+
+#if (_MSC_VER)
+#include <intrin.h>
+#endif
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    // Gets index of highest set bit
+    // @param value - Value (expected to be non-zero)
+    // @return the bit index
+    static inline uint32_t _getHighestBit(const uint64_t value)
+    {
+        #if (_MSC_VER)
+        unsigned long index;
+
+
+        _BitScanReverse64(&index, value);
+
+
+        return uint32_t(index);
+        #else
+        return uint32_t(63 - __builtin_clzll(value));
+        #endif
+    }
+
+
+    // Lowers atomic value
+    // @param value - Value to lower
+    // @param candidate - Candidate value
+    static inline void _storeMin(std::atomic<uint64_t> &value, const uint64_t candidate)
+    {
+        for (auto current = value.load(std::memory_order_relaxed); candidate < current;)
+        {
+            if (value.compare_exchange_weak(current, candidate, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+    }
+
+
+    // Raises atomic value
+    // @param value - Value to raise
+    // @param candidate - Candidate value
+    static inline void _storeMax(std::atomic<uint64_t> &value, const uint64_t candidate)
+    {
+        for (auto current = value.load(std::memory_order_relaxed); candidate > current;)
+        {
+            if (value.compare_exchange_weak(current, candidate, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+    }
+}}}
+
+
+// --------- //
+// HISTOGRAM //
+// --------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    uint32_t Histogram::GetBucketIndex(const uint64_t value)
+    {
+        // Values below 2 * sub-bucket count are counted exactly
+        const uint64_t clamped = std::min<uint64_t>(value, ((uint64_t(SubBucketCount) << (MaxShift + 1)) - 1));
+
+
+        if (clamped < (SubBucketCount * 2))
+        {
+            return uint32_t(clamped);
+        }
+
+
+        // Larger values are counted by sub-bucket of their power of 2
+        const uint32_t shift = (_getHighestBit(clamped) - SubBucketBits);
+
+
+        return ((shift * SubBucketCount) + uint32_t(clamped >> shift));
+    }
+
+
+    uint64_t Histogram::GetBucketUpperBound(const uint32_t index)
+    {
+        if (index < (SubBucketCount * 2))
+        {
+            return index;
+        }
+
+
+        const uint32_t shift     = ((index >> SubBucketBits) - 1);
+        const uint64_t subBucket = (index - (shift * SubBucketCount));
+
+
+        return (((subBucket + 1) << shift) - 1);
+    }
+
+
+    void Histogram::Record(const uint64_t durationNs)
+    {
+        _buckets[GetBucketIndex(durationNs)].fetch_add(1, std::memory_order_relaxed);
+        _count.fetch_add(1, std::memory_order_relaxed);
+        _totalNs.fetch_add(durationNs, std::memory_order_relaxed);
+
+        _storeMin(_minNs, durationNs);
+        _storeMax(_maxNs, durationNs);
+    }
+
+
+    void Histogram::Reset()
+    {
+        // Durations recorded concurrently might end up in either window
+        for (auto &bucket : _buckets)
+        {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+
+
+        _count.store(0, std::memory_order_relaxed);
+        _totalNs.store(0, std::memory_order_relaxed);
+        _minNs.store(UINT64_MAX, std::memory_order_relaxed);
+        _maxNs.store(0, std::memory_order_relaxed);
+    }
+
+
+    KLab_Profiling_Trace_HistogramInfo Histogram::GetInfo() const
+    {
+        const uint64_t count = _count.load(std::memory_order_relaxed);
+
+
+        return
+        {
+            count,
+            _totalNs.load(std::memory_order_relaxed),
+            (count ? _minNs.load(std::memory_order_relaxed) : 0),
+            _maxNs.load(std::memory_order_relaxed)
+        };
+    }
+
+
+    void Histogram::GetPercentiles(const double *percentiles, uint64_t *valuesNs, const uint32_t count) const
+    {
+        // Snapshot counts to answer all percentiles from same state
+        std::vector<uint32_t> buckets(BucketCount);
+        uint64_t              total = 0;
+
+
+        for (uint32_t b = 0; b < BucketCount; ++b)
+        {
+            buckets[b] = _buckets[b].load(std::memory_order_relaxed);
+            total     += buckets[b];
+        }
+
+
+        const uint64_t minNs = _minNs.load(std::memory_order_relaxed);
+        const uint64_t maxNs = _maxNs.load(std::memory_order_relaxed);
+
+
+        for (uint32_t p = 0; p < count; ++p)
+        {
+            if (!total)
+            {
+                valuesNs[p] = 0;
+
+
+                continue;
+            }
+
+
+            // Find bucket holding rank of percentile
+            const double   fraction = (std::min(std::max(percentiles[p], 0.0), 100.0) / 100.0);
+            const uint64_t rank     = std::max<uint64_t>(uint64_t(std::ceil(fraction * double(total))), 1);
+            uint64_t       counted  = 0;
+            uint32_t       bucket   = 0;
+
+
+            for (; bucket < (BucketCount - 1); ++bucket)
+            {
+                counted += buckets[bucket];
+
+
+                if (counted >= rank)
+                {
+                    break;
+                }
+            }
+
+
+            valuesNs[p] = std::max(std::min(GetBucketUpperBound(bucket), maxNs), std::min(minNs, maxNs));
+        }
+    }
+}}}
+
+
+// --------------- //
+// HISTOGRAM TRACE //
+// --------------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    bool HistogramTrace::IsTracing() const
+    {
+        return _isTracing.load(std::memory_order_relaxed);
+    }
+
+
+    void HistogramTrace::Flip()
+    {
+        if (!IsTracing())
+        {
+            return;
+        }
+
+
+        _timer.Calibrate();
+        _nsPerTick.store(_timer._nsPerTick, std::memory_order_relaxed);
+
+
+        // Record frame time (starting with first flip)
+        const uint64_t nowTicks = _timer.GetTicks();
+
+
+        if (_frameBeginTicks)
+        {
+            _histograms[KLab_Profiling_Trace_FrameHistogramID].Record(_timer.ToNs(nowTicks - _frameBeginTicks));
+        }
+
+
+        _frameBeginTicks = std::max<uint64_t>(nowTicks, 1);
+    }
+
+
+    void HistogramTrace::EnterSection(ThreadContext &thread, const uint32_t histogramID)
+    {
+        auto histograms = _getThreadHistograms(thread);
+
+
+        if (!histograms)
+        {
+            return;
+        }
+
+
+        if (histograms->Depth < ThreadHistograms::MaxDepth)
+        {
+            histograms->Stack[histograms->Depth] = { histogramID, _timer.GetTicks() };
+        }
+
+
+        ++histograms->Depth;
+    }
+
+
+    void HistogramTrace::LeaveSection(ThreadContext &thread, const uint32_t histogramID)
+    {
+        const uint64_t endTicks   = _timer.GetTicks();
+        auto           histograms = _getThreadHistograms(thread);
+
+
+        // Ignore sections entered before trace began
+        if (!histograms || !histograms->Depth)
+        {
+            return;
+        }
+
+
+        const uint32_t depth = --histograms->Depth;
+
+
+        // Ignore sections too deep to track and mismatched sections
+        if ((depth >= ThreadHistograms::MaxDepth) || (histograms->Stack[depth].HistogramID != histogramID))
+        {
+            return;
+        }
+
+
+        const uint64_t durationNs = uint64_t(double(endTicks - histograms->Stack[depth].BeginTicks) * _nsPerTick.load(std::memory_order_relaxed));
+
+
+        _histograms[histogramID].Record(durationNs);
+    }
+
+
+    uint32_t HistogramTrace::FindMarkerHistogram(const char *name)
+    {
+        std::lock_guard<std::mutex> lock(_namesMutex);
+
+
+        for (uint32_t h = 1; h < _histogramCount.load(std::memory_order_relaxed); ++h)
+        {
+            if (_markerNames[h] == name)
+            {
+                return h;
+            }
+        }
+
+
+        return 0;
+    }
+
+
+    uint32_t HistogramTrace::AddMarkerHistogram(const char *name)
+    {
+        std::lock_guard<std::mutex> lock(_namesMutex);
+
+
+        const uint32_t count = _histogramCount.load(std::memory_order_relaxed);
+
+
+        for (uint32_t h = 1; h < count; ++h)
+        {
+            if (_markerNames[h] == name)
+            {
+                return h;
+            }
+        }
+
+
+        if (count == KLab_Profiling_Trace_MaxHistogramCount)
+        {
+            return 0;
+        }
+
+
+        _markerNames[count] = name;
+        _histogramCount.store((count + 1), std::memory_order_release);
+
+
+        return count;
+    }
+
+
+    Histogram *HistogramTrace::TryGet(const int32_t histogramID)
+    {
+        if (!_histograms || (histogramID < 0) || (uint32_t(histogramID) >= _histogramCount.load(std::memory_order_acquire)))
+        {
+            return nullptr;
+        }
+
+
+        return &_histograms[histogramID];
+    }
+
+
+    bool HistogramTrace::_enable()
+    {
+        // Create histograms once (constant memory from then on)
+        if (!_histograms)
+        {
+            _histograms = NewAlignedArray<Histogram>(KLab_Profiling_Trace_MaxHistogramCount);
+
+
+            if (!_histograms)
+            {
+                return false;
+            }
+        }
+
+
+        for (uint32_t h = 0; h < KLab_Profiling_Trace_MaxHistogramCount; ++h)
+        {
+            _histograms[h].Reset();
+        }
+
+
+        // Initialize state
+        _timer.Reset();
+        _nsPerTick.store(_timer._nsPerTick, std::memory_order_relaxed);
+
+        _frameBeginTicks = 0;
+
+
+        _generation.fetch_add(1, std::memory_order_release);
+        _isTracing.store(true, std::memory_order_release);
+
+
+        return true;
+    }
+
+
+    void HistogramTrace::_disable()
+    {
+        _isTracing.store(false, std::memory_order_release);
+    }
+
+
+    ThreadHistograms *HistogramTrace::_getThreadHistograms(ThreadContext &thread)
+    {
+        auto histograms = thread.Histograms;
+
+
+        // Create and register sections on first use
+        if (!histograms)
+        {
+            histograms = NewAlignedArray<ThreadHistograms>(1);
+
+
+            if (!histograms)
+            {
+                return nullptr;
+            }
+
+
+            auto head = _threads.load(std::memory_order_relaxed);
+
+
+            do
+            {
+                histograms->Next = head;
+            }
+            while (!_threads.compare_exchange_weak(head, histograms, std::memory_order_release, std::memory_order_relaxed));
+
+
+            thread.Histograms = histograms;
+        }
+
+
+        // Forget sections of previous trace
+        const uint32_t generation = _generation.load(std::memory_order_acquire);
+
+
+        if (histograms->Generation != generation)
+        {
+            histograms->Generation = generation;
+            histograms->Depth      = 0;
+        }
+
+
+        return histograms;
+    }
+
+
+    HistogramTrace &GetHistogramTrace()
+    {
+        static HistogramTrace trace;
+
+
+        return trace;
+    }
+}}}
+
+
+// ----- //
+// TRACE //
+// ----- //
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginHistogramTrace()
+{
+    auto &trace = KLab::Profiling::Trace::GetHistogramTrace();
+
+
+    // Validate state
+    if (trace.IsTracing())
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    if (!trace._enable())
+    {
+        return KLab_Profiling_ErrorCode_NotAvailable;
+    }
+
+
+    // Dispatch events right away (instead of from next update)
+    KLab::Profiling::Plugin::UpdateMarkerDispatch();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_EndHistogramTrace()
+{
+    auto &trace = KLab::Profiling::Trace::GetHistogramTrace();
+
+
+    // Validate state
+    if (!trace.IsTracing())
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    trace._disable();
+
+
+    // Stop dispatching right away (instead of from next update)
+    KLab::Profiling::Plugin::UpdateMarkerDispatch();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetHistogramInfo(const int32_t histogramID, KLab_Profiling_Trace_HistogramInfo *info)
+{
+    auto histogram = KLab::Profiling::Trace::GetHistogramTrace().TryGet(histogramID);
+
+
+    // Validate arguments
+    if (!histogram || !info)
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    *info = histogram->GetInfo();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetHistogramPercentiles(const int32_t histogramID, const double *percentiles, uint64_t *valuesNs, const int32_t count)
+{
+    auto histogram = KLab::Profiling::Trace::GetHistogramTrace().TryGet(histogramID);
+
+
+    // Validate arguments
+    if (!histogram || !percentiles || !valuesNs || (count <= 0))
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    histogram->GetPercentiles(percentiles, valuesNs, uint32_t(count));
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_ResetHistogram(const int32_t histogramID)
+{
+    auto &trace = KLab::Profiling::Trace::GetHistogramTrace();
+
+
+    // Reset all histograms
+    if (histogramID == KLab_Profiling_Trace_AllHistogramsID)
+    {
+        for (int32_t h = 0; trace.TryGet(h); ++h)
+        {
+            trace.TryGet(h)->Reset();
+        }
+
+
+        return KLab_Profiling_ErrorCode_NoError;
+    }
+
+
+    auto histogram = trace.TryGet(histogramID);
+
+
+    // Validate arguments
+    if (!histogram)
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    histogram->Reset();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
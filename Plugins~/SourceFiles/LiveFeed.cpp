@@ -0,0 +1,539 @@
+// -------------------------------------------------------------------------------------------- //
+//  Copyright (c) KLab Inc.. All rights reserved.                                               //
+//  Licensed under the MIT License. See 'LICENSE' in the project root for license information.  //
+// -------------------------------------------------------------------------------------------- //
+
+#include <KLab/Profiling/Internal.hpp>
+
+
+// -------- //
+// INCLUDES //
+// -------- //
+
+#include <cstring>
+
+#if (KLAB_PROFILING_HAS_SHARED_MEMORY)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    // Copies name into shared memory (truncating, skipped if unchanged to not tear names readers might be reading)
+    // @param name - Name to write
+    // @param text - [Optional] Name as null-terminated UTF-8 string
+    static void _copyName(LiveFeedFormat::Name &name, const char *text)
+    {
+        if (!text)
+        {
+            text = "";
+        }
+
+
+        if (strncmp(name.Text, text, (LiveFeedFormat::NameSize - 1)) == 0)
+        {
+            return;
+        }
+
+
+        strncpy(name.Text, text, (LiveFeedFormat::NameSize - 1));
+        name.Text[LiveFeedFormat::NameSize - 1] = '\0';
+    }
+}}}
+
+
+// --------- //
+// LIVE FEED //
+// --------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    bool LiveFeed::IsPublishing() const
+    {
+        return (_activeMapping.load(std::memory_order_relaxed) != nullptr);
+    }
+
+
+    void LiveFeed::Flip()
+    {
+        if (!IsPublishing() && !_hasEndedMappings.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+
+        std::lock_guard<std::mutex> guard(_mutex);
+
+
+        ++_flipCount;
+
+
+        // Unmap feeds ended a full frame ago (late writers had frame to finish)
+        _unmapEnded();
+
+
+        // Validate state (feed might have ended meanwhile)
+        auto mapping = _activeMapping.load(std::memory_order_relaxed);
+
+
+        if (!mapping)
+        {
+            return;
+        }
+
+
+        auto header = reinterpret_cast<LiveFeedFormat::Header *>(mapping->Base);
+        auto frames = reinterpret_cast<LiveFeedFormat::Frame *>(mapping->Base + mapping->Layout.FramesOffset);
+
+
+        mapping->Timer.Calibrate();
+        header->NsPerTick.store(mapping->Timer._nsPerTick, std::memory_order_relaxed);
+
+
+        // Publish names before frame, so readers summarizing frame find names of its markers
+        _publishNames(*mapping);
+
+
+        // Publish frame boundary
+        const uint64_t sequence = header->FrameSequence.load(std::memory_order_relaxed);
+
+
+        frames[sequence % LiveFeedFormat::FrameCapacity] = { sequence, mapping->Timer.GetTicks() };
+        header->FrameSequence.store((sequence + 1), std::memory_order_release);
+    }
+
+
+    void LiveFeed::EnterSection(ThreadContext &thread, const uint32_t markerID)
+    {
+        _publish(thread, markerID, KLab_Profiling_Trace_EventType_EnterSection);
+    }
+
+
+    void LiveFeed::LeaveSection(ThreadContext &thread, const uint32_t markerID)
+    {
+        _publish(thread, markerID, KLab_Profiling_Trace_EventType_LeaveSection);
+    }
+
+
+    KLab_Profiling_ErrorCode LiveFeed::_begin(const char *name, const uint32_t regionCount, const uint32_t regionCapacity)
+    {
+        #if (KLAB_PROFILING_HAS_SHARED_MEMORY)
+        std::lock_guard<std::mutex> guard(_mutex);
+
+
+        // Create shared memory object (replacing stale object of crashed session; zero-filled on truncation)
+        const auto layout = LiveFeedFormat::GetLayout(regionCount, regionCapacity);
+
+
+        shm_unlink(name);
+
+
+        const int file = shm_open(name, (O_CREAT | O_EXCL | O_RDWR), 0644);
+
+
+        if (file < 0)
+        {
+            return KLab_Profiling_ErrorCode_NotAvailable;
+        }
+
+
+        if (ftruncate(file, off_t(layout.Size)) != 0)
+        {
+            close(file);
+            shm_unlink(name);
+
+
+            return KLab_Profiling_ErrorCode_NotAvailable;
+        }
+
+
+        void *base = mmap(nullptr, layout.Size, (PROT_READ | PROT_WRITE), MAP_SHARED, file, 0);
+
+
+        close(file);
+
+
+        if (base == MAP_FAILED)
+        {
+            shm_unlink(name);
+
+
+            return KLab_Profiling_ErrorCode_NotAvailable;
+        }
+
+
+        // Describe mapping (leaving mappings of ended feeds to flips, as late writers might still write into them)
+        auto mapping = new _Mapping();
+
+
+        mapping->Base         = static_cast<char *>(base);
+        mapping->Layout       = layout;
+        mapping->Regions      = (mapping->Base + layout.RegionsOffset);
+        mapping->RegionCount  = regionCount;
+        mapping->RegionMask   = (regionCapacity - 1);
+        mapping->EndFlipCount = 0;
+
+
+        mapping->Timer.Reset();
+
+
+        _name = name;
+
+
+        // Write header
+        auto header = new (mapping->Base) LiveFeedFormat::Header();
+
+
+        header->Magic           = LiveFeedFormat::Magic;
+        header->Version         = LiveFeedFormat::Version;
+        header->EventRecordSize = uint32_t(sizeof(KLab_Profiling_Trace_EventRecord));
+        header->RegionCount     = regionCount;
+        header->RegionCapacity  = regionCapacity;
+        header->FrameCapacity   = LiveFeedFormat::FrameCapacity;
+        header->MarkerCapacity  = LiveFeedFormat::MarkerCapacity;
+        header->NameSize        = LiveFeedFormat::NameSize;
+        header->MappingSize     = uint64_t(layout.Size);
+        header->NsPerTick.store(mapping->Timer._nsPerTick, std::memory_order_relaxed);
+
+
+        for (uint32_t r = 0; r < regionCount; ++r)
+        {
+            new (mapping->Regions + (size_t(r) * layout.RegionSize)) LiveFeedFormat::RegionHeader();
+        }
+
+
+        // Publish names and first frame (beginning at feed begin)
+        auto frames = reinterpret_cast<LiveFeedFormat::Frame *>(mapping->Base + layout.FramesOffset);
+
+
+        _publishNames(*mapping);
+
+
+        frames[0] = { 0, 0 };
+        header->FrameSequence.store(1, std::memory_order_relaxed);
+
+
+        // Publish state last (readers attaching earlier wait for it)
+        header->State.store(LiveFeedFormat::State_Publishing, std::memory_order_release);
+
+
+        // Publish mapping to writers
+        _activeMapping.store(mapping, std::memory_order_release);
+
+
+        return KLab_Profiling_ErrorCode_NoError;
+        #else
+        (void)name;
+        (void)regionCount;
+        (void)regionCapacity;
+
+
+        return KLab_Profiling_ErrorCode_NotAvailable;
+        #endif
+    }
+
+
+    void LiveFeed::_end()
+    {
+        #if (KLAB_PROFILING_HAS_SHARED_MEMORY)
+        std::lock_guard<std::mutex> guard(_mutex);
+
+
+        // Validate state (feed might have ended meanwhile)
+        auto mapping = _activeMapping.load(std::memory_order_relaxed);
+
+
+        if (!mapping)
+        {
+            return;
+        }
+
+
+        _activeMapping.store(nullptr, std::memory_order_relaxed);
+
+
+        // Signal readers
+        auto header = reinterpret_cast<LiveFeedFormat::Header *>(mapping->Base);
+
+
+        header->State.store(LiveFeedFormat::State_Ended, std::memory_order_release);
+
+
+        // Unlink shared memory object (attached readers keep their mapping)
+        shm_unlink(_name.c_str());
+
+
+        // Keep mapping until a full frame passed (as late writers might have loaded it before end)
+        _endedInfo = _getInfo(*mapping);
+
+
+        mapping->EndFlipCount = _flipCount;
+
+
+        _endedMappings.push_back(mapping);
+        _hasEndedMappings.store(true, std::memory_order_relaxed);
+        #endif
+    }
+
+
+    KLab_Profiling_Trace_LiveFeedInfo LiveFeed::_getInfo()
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+
+
+        auto mapping = _activeMapping.load(std::memory_order_relaxed);
+
+
+        return (mapping ? _getInfo(*mapping) : _endedInfo);
+    }
+
+
+    KLab_Profiling_Trace_LiveFeedInfo LiveFeed::_getInfo(const _Mapping &mapping)
+    {
+        KLab_Profiling_Trace_LiveFeedInfo info = {};
+
+
+        const auto     header      = reinterpret_cast<const LiveFeedFormat::Header *>(mapping.Base);
+        const uint32_t threadCount = GetThreadTable().GetLength();
+
+
+        for (uint32_t r = 0; r < mapping.RegionCount; ++r)
+        {
+            auto region = reinterpret_cast<const LiveFeedFormat::RegionHeader *>(mapping.Regions + (size_t(r) * mapping.Layout.RegionSize));
+
+
+            info.PublishedEventCount += region->WriteSequence.load(std::memory_order_relaxed);
+        }
+
+
+        info.PublishedFrameCount = header->FrameSequence.load(std::memory_order_relaxed);
+        info.MappingSize         = uint64_t(mapping.Layout.Size);
+        info.RegionCount         = mapping.RegionCount;
+        info.RegionCapacity      = (mapping.RegionMask + 1);
+        info.UnmappedThreadCount = ((threadCount > mapping.RegionCount) ? (threadCount - mapping.RegionCount) : 0);
+        info.IsPublishing        = (_activeMapping.load(std::memory_order_relaxed) == &mapping);
+
+
+        return info;
+    }
+
+
+    void LiveFeed::_publish(ThreadContext &thread, const uint32_t markerID, const KLab_Profiling_Trace_EventType type)
+    {
+        // Load mapping once (as feed might end or restart meanwhile)
+        const auto mapping = _activeMapping.load(std::memory_order_acquire);
+
+
+        // Skip threads without region
+        if (!mapping || (thread.Index >= mapping->RegionCount))
+        {
+            return;
+        }
+
+
+        // Write record, then advance write sequence (single writer per region)
+        auto           region   = reinterpret_cast<LiveFeedFormat::RegionHeader *>(mapping->Regions + (size_t(thread.Index) * mapping->Layout.RegionSize));
+        auto           records  = reinterpret_cast<KLab_Profiling_Trace_EventRecord *>(region + 1);
+        const uint64_t sequence = region->WriteSequence.load(std::memory_order_relaxed);
+        auto          &record   = records[sequence & mapping->RegionMask];
+
+
+        record.MarkerID    = markerID;
+        record.ThreadIndex = thread.Index;
+        record.Type        = uint16_t(type);
+        record.TimestampNs = mapping->Timer.GetTicks();
+
+
+        region->WriteSequence.store((sequence + 1), std::memory_order_release);
+    }
+
+
+    void LiveFeed::_publishNames(_Mapping &mapping)
+    {
+        auto header = reinterpret_cast<LiveFeedFormat::Header *>(mapping.Base);
+
+
+        // Publish new markers
+        const auto     &markers        = GetMarkerTable();
+        auto            markerNames    = reinterpret_cast<LiveFeedFormat::Name *>(mapping.Base + mapping.Layout.MarkerNamesOffset);
+        const uint32_t  markerLength   = markers.GetLength();
+        const uint32_t  markerCapacity = LiveFeedFormat::MarkerCapacity;
+        const uint32_t  markerCount    = ((markerLength < markerCapacity) ? markerLength : markerCapacity);
+
+
+        uint32_t m = header->MarkerCount.load(std::memory_order_relaxed);
+
+
+        for (; m < markerCount; ++m)
+        {
+            auto marker = markers.TryGet(m);
+
+
+            // Stop at first unavailable marker (retrying it on next flip to not publish empty names)
+            if (!marker)
+            {
+                break;
+            }
+
+
+            _copyName(markerNames[m], marker->Name);
+        }
+
+
+        header->MarkerCount.store(m, std::memory_order_release);
+
+
+        // Publish all threads (as threads might get named after their first event)
+        const auto     &threads      = GetThreadTable();
+        auto            threadNames  = reinterpret_cast<LiveFeedFormat::Name *>(mapping.Base + mapping.Layout.ThreadNamesOffset);
+        const uint32_t  threadLength = threads.GetLength();
+        const uint32_t  threadCount  = ((threadLength < mapping.RegionCount) ? threadLength : mapping.RegionCount);
+
+
+        for (uint32_t t = 0; t < threadCount; ++t)
+        {
+            auto thread = threads.TryGet(t);
+
+
+            _copyName(threadNames[t], (thread ? thread->Name : nullptr));
+        }
+
+
+        header->ThreadCount.store(threadCount, std::memory_order_release);
+    }
+
+
+    void LiveFeed::_unmapEnded()
+    {
+        size_t keptCount = 0;
+
+
+        for (auto mapping : _endedMappings)
+        {
+            // Keep mapping until second flip after end (so writers that loaded it before end had whole frame to finish)
+            if ((_flipCount - mapping->EndFlipCount) < 2)
+            {
+                _endedMappings[keptCount++] = mapping;
+
+
+                continue;
+            }
+
+
+            #if (KLAB_PROFILING_HAS_SHARED_MEMORY)
+            munmap(mapping->Base, mapping->Layout.Size);
+            #endif
+
+
+            delete mapping;
+        }
+
+
+        _endedMappings.resize(keptCount);
+        _hasEndedMappings.store((keptCount > 0), std::memory_order_relaxed);
+    }
+
+
+    LiveFeed &GetLiveFeed()
+    {
+        static LiveFeed feed;
+
+
+        return feed;
+    }
+}}}
+
+
+// ----- //
+// TRACE //
+// ----- //
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginLiveFeed(const char *name, const int32_t regionCount, const int32_t eventsPerRegion)
+{
+    auto &feed = KLab::Profiling::Trace::GetLiveFeed();
+
+
+    // Validate state
+    if (feed.IsPublishing())
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    // Validate arguments
+    if (!name || !*name || (regionCount <= 0) || (uint32_t(regionCount) > feed.MaxRegionCount) || (eventsPerRegion <= 0) || (uint32_t(eventsPerRegion) > feed.MaxRegionCapacity))
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    // Round capacity up to power of 2 (to mask write sequences)
+    uint32_t regionCapacity = 1;
+
+
+    while (regionCapacity < uint32_t(eventsPerRegion))
+    {
+        regionCapacity <<= 1;
+    }
+
+
+    const auto error = feed._begin(name, uint32_t(regionCount), regionCapacity);
+
+
+    if (error != KLab_Profiling_ErrorCode_NoError)
+    {
+        return error;
+    }
+
+
+    // Dispatch events right away (instead of from next update)
+    KLab::Profiling::Plugin::UpdateMarkerDispatch();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_EndLiveFeed()
+{
+    auto &feed = KLab::Profiling::Trace::GetLiveFeed();
+
+
+    // Validate state
+    if (!feed.IsPublishing())
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    feed._end();
+
+
+    // Stop dispatching right away (instead of from next update)
+    KLab::Profiling::Plugin::UpdateMarkerDispatch();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetLiveFeedInfo(KLab_Profiling_Trace_LiveFeedInfo *info)
+{
+    // Validate arguments
+    if (!info)
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    *info = KLab::Profiling::Trace::GetLiveFeed()._getInfo();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
@@ -0,0 +1,240 @@
+// -------------------------------------------------------------------------------------------- //
+//  Copyright (c) KLab Inc.. All rights reserved.                                               //
+//  Licensed under the MIT License. See 'LICENSE' in the project root for license information.  //
+// -------------------------------------------------------------------------------------------- //
+
+#include <KLab/Profiling/Internal.hpp>
+
+
+// -------- //
+// INCLUDES //
+// -------- //
+
+#include <algorithm>
+#include <cstring>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    // Matches string against glob pattern
+    // @param string - Null-terminated string
+    // @param pattern - Null-terminated pattern ('*' matching any sequence, '?' matching any byte)
+    // @return true if matching; false otherwise
+    static bool _matchesGlob(const char *string, const char *pattern)
+    {
+        const char *starPattern = nullptr;
+        const char *starString  = nullptr;
+
+
+        while (*string)
+        {
+            if ((*pattern == '?') || ((*pattern == *string) && (*pattern != '*')))
+            {
+                ++string;
+                ++pattern;
+            }
+            else if (*pattern == '*')
+            {
+                starPattern = ++pattern;
+                starString  = string;
+            }
+            else if (starPattern)
+            {
+                // Let last star consume one more byte
+                pattern = starPattern;
+                string  = ++starString;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+
+        while (*pattern == '*')
+        {
+            ++pattern;
+        }
+
+
+        return !*pattern;
+    }
+
+
+    // Checks whether string matches any of patterns
+    // @param string - Null-terminated string
+    // @param patterns - Patterns
+    // @return true if matching; false otherwise
+    static bool _matchesAny(const char *string, const std::vector<std::string> &patterns)
+    {
+        for (const auto &pattern : patterns)
+        {
+            if (_matchesGlob(string, pattern.c_str()))
+            {
+                return true;
+            }
+        }
+
+
+        return false;
+    }
+
+
+    // Checks whether ID is contained
+    // @param id - ID
+    // @param ids - IDs
+    // @return true if contained; false otherwise
+    static inline bool _contains(const uint32_t id, const std::vector<uint32_t> &ids)
+    {
+        return (std::find(ids.begin(), ids.end(), id) != ids.end());
+    }
+
+
+    // Trims whitespace from both ends of range
+    // @param begin - Begin of range
+    // @param end - End of range
+    static void _trim(const char *&begin, const char *&end)
+    {
+        auto isSpace = [](const char c) { return ((c == ' ') || (c == '\t') || (c == '\r')); };
+
+
+        while ((begin < end) && isSpace(*begin))
+        {
+            ++begin;
+        }
+        while ((end > begin) && isSpace(end[-1]))
+        {
+            --end;
+        }
+    }
+}}}
+
+
+// ------------- //
+// MARKER FILTER //
+// ------------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    bool MarkerFilter::Parse(const char *spec)
+    {
+        static const char   CategoryPrefix[]     = "category:";
+        static const size_t CategoryPrefixLength = (sizeof(CategoryPrefix) - 1);
+
+        MarkerFilter filter;
+
+
+        for (auto rule = spec; *rule;)
+        {
+            // Split rule
+            auto begin = rule;
+            auto end   = begin;
+
+
+            while (*end && (*end != ';') && (*end != '\n'))
+            {
+                ++end;
+            }
+
+
+            rule = (*end ? (end + 1) : end);
+
+
+            _trim(begin, end);
+
+
+            if (begin == end)
+            {
+                continue;
+            }
+
+
+            // Parse sign
+            const bool isExclude = (*begin == '-');
+
+
+            if ((*begin == '-') || (*begin == '+'))
+            {
+                ++begin;
+            }
+
+
+            _trim(begin, end);
+
+
+            if (begin == end)
+            {
+                return false;
+            }
+
+
+            // Parse category ID
+            if ((size_t(end - begin) > CategoryPrefixLength) && !std::strncmp(begin, CategoryPrefix, CategoryPrefixLength))
+            {
+                uint32_t id = 0;
+
+
+                for (auto digit = (begin + CategoryPrefixLength); digit < end; ++digit)
+                {
+                    if ((*digit < '0') || (*digit > '9'))
+                    {
+                        return false;
+                    }
+
+
+                    id = ((id * 10) + uint32_t(*digit - '0'));
+
+
+                    // Reject IDs beyond 16 bits (checked per digit to not overflow)
+                    if (id > 0xFFFF)
+                    {
+                        return false;
+                    }
+                }
+
+
+                (isExclude ? filter._excludeCategoryIDs : filter._includeCategoryIDs).push_back(id);
+            }
+
+            // Parse name pattern
+            else
+            {
+                (isExclude ? filter._excludePatterns : filter._includePatterns).emplace_back(begin, end);
+            }
+        }
+
+
+        *this = std::move(filter);
+
+
+        return true;
+    }
+
+
+    bool MarkerFilter::Matches(const char *name, const uint32_t categoryID) const
+    {
+        if (_contains(categoryID, _excludeCategoryIDs) || _matchesAny(name, _excludePatterns))
+        {
+            return false;
+        }
+
+
+        if (_includeCategoryIDs.empty() && _includePatterns.empty())
+        {
+            return true;
+        }
+
+
+        return (_contains(categoryID, _includeCategoryIDs) || _matchesAny(name, _includePatterns));
+    }
+
+
+    bool MarkerFilter::IsEmpty() const
+    {
+        return (_includeCategoryIDs.empty() && _excludeCategoryIDs.empty() && _includePatterns.empty() && _excludePatterns.empty());
+    }
+}}}
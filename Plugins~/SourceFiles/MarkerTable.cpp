@@ -0,0 +1,279 @@
+// -------------------------------------------------------------------------------------------- //
+//  Copyright (c) KLab Inc.. All rights reserved.                                               //
+//  Licensed under the MIT License. See 'LICENSE' in the project root for license information.  //
+// -------------------------------------------------------------------------------------------- //
+
+#include <KLab/Profiling/Internal.hpp>
+
+
+// -------- //
+// INCLUDES //
+// -------- //
+
+#include <algorithm>
+#include <cstring>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    // Hashes string (FNV-1a)
+    // @param string - Null-terminated string to hash
+    // @return the hash
+    static uint32_t _hashString(const char *string)
+    {
+        uint32_t hash = 2166136261u;
+
+
+        for (; *string; ++string)
+        {
+            hash = ((hash ^ uint8_t(*string)) * 16777619u);
+        }
+
+
+        return hash;
+    }
+
+
+    // Hashes UTF-16 string by sampling its length and leading and trailing characters (picking cache entry only)
+    // @param string - UTF-16 string to hash
+    // @param length - Length of string in characters
+    // @return the hash
+    static uint32_t _hashUtf16(const char16_t *string, const size_t length)
+    {
+        const size_t sampleLength = std::min<size_t>(length, 4);
+        uint64_t     head         = 0;
+        uint64_t     tail         = 0;
+
+
+        std::memcpy(&head, string, (sampleLength * sizeof(char16_t)));
+        std::memcpy(&tail, (string + length - sampleLength), (sampleLength * sizeof(char16_t)));
+
+
+        return uint32_t((((head * 0x9e3779b97f4a7c15ull) ^ tail ^ uint64_t(length)) * 0xff51afd7ed558ccdull) >> 32);
+    }
+}}}
+
+
+// ------------ //
+// MARKER TABLE //
+// ------------ //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    uint32_t MarkerTable::GetLength() const
+    {
+        return _length.load(std::memory_order_acquire);
+    }
+
+
+    const MarkerInfo *MarkerTable::TryGet(const uint32_t id) const
+    {
+        return ((id < GetLength()) ? _markers.TryGet(id) : nullptr);
+    }
+
+
+    uint32_t MarkerTable::Intern(const MarkerInfo &info)
+    {
+        // Reserve slot, write entry, then publish it (so readers never see half-written entries)
+        std::lock_guard<std::mutex> lock(_internMutex);
+
+
+        const uint32_t id     = _length.load(std::memory_order_relaxed);
+        auto           marker = _markers.GetOrCreate(id);
+
+
+        if (!marker)
+        {
+            return InvalidID;
+        }
+
+
+        *marker = info;
+
+
+        _length.store((id + 1), std::memory_order_release);
+
+
+        return id;
+    }
+
+
+    uint32_t MarkerTable::InternDynamic(const char *name, const MarkerInfo &base)
+    {
+        // Looks up ID in slots
+        // @param hash - Hash of name
+        // @param outSlot - Storage for first empty slot
+        // @return the marker ID if found; ::InvalidID otherwise
+        auto lookUp = [this, name](const uint32_t hash, std::atomic<uint32_t> **outSlot)
+        {
+            for (uint32_t probe = 0; probe < DynamicCapacity; ++probe)
+            {
+                auto           &slot = _dynamicIDs[(hash + probe) % DynamicCapacity];
+                const uint32_t  id   = slot.load(std::memory_order_acquire);
+
+
+                if (!id)
+                {
+                    *outSlot = &slot;
+
+
+                    return InvalidID;
+                }
+                if (!std::strcmp(_markers.TryGet(id - 1)->Name, name))
+                {
+                    return (id - 1);
+                }
+            }
+
+
+            *outSlot = nullptr;
+
+
+            return InvalidID;
+        };
+
+
+        const uint32_t          hash = _hashString(name);
+        std::atomic<uint32_t>  *slot = nullptr;
+        uint32_t                id   = lookUp(hash, &slot);
+
+
+        // Return interned
+        if (id != InvalidID)
+        {
+            return id;
+        }
+
+
+        // Intern name (looking up again as other thread might have been faster)
+        std::lock_guard<std::mutex> lock(_dynamicMutex);
+
+
+        id = lookUp(hash, &slot);
+
+
+        if ((id != InvalidID) || !slot)
+        {
+            return id;
+        }
+
+
+        const size_t  nameLength = std::strlen(name);
+        auto          nameCopy   = new char[nameLength + 1];
+        MarkerInfo    info       = base;
+
+
+        std::memcpy(nameCopy, name, (nameLength + 1));
+
+
+        info.Name = nameCopy;
+        id        = Intern(info);
+
+
+        if (id == InvalidID)
+        {
+            delete[] nameCopy;
+
+
+            return InvalidID;
+        }
+
+
+        slot->store((id + 1), std::memory_order_release);
+
+
+        return id;
+    }
+
+
+    uint32_t MarkerTable::InternUtf16(const char16_t *name, const size_t length, const MarkerInfo &base)
+    {
+        auto &entry = _utf16Cache[_hashUtf16(name, length) % Utf16CacheCapacity];
+
+
+        // Return cached (if name matches as hashes may collide)
+        const uint64_t cached = entry.load(std::memory_order_acquire);
+
+
+        if (cached)
+        {
+            const uint32_t cachedID = (uint32_t(cached) - 1);
+            auto           marker   = _markers.TryGet(cachedID);
+
+
+            if (Utils::MatchesUtf16(marker->Name, size_t(cached >> 32), name, length))
+            {
+                return cachedID;
+            }
+        }
+
+
+        // Convert and intern
+        char utf8Name[sizeof(Utils::Utf8Buffer::CString)];
+
+
+        const size_t   utf8Length = Utils::ConvertUtf16ToUtf8(utf8Name, sizeof(utf8Name), name, length);
+        const uint32_t id         = InternDynamic(utf8Name, base);
+
+
+        if (id == InvalidID)
+        {
+            return InvalidID;
+        }
+
+
+        // Cache (replacing colliding name)
+        entry.store(((uint64_t(utf8Length) << 32) | (id + 1)), std::memory_order_release);
+
+
+        return id;
+    }
+
+
+    MarkerTable &GetMarkerTable()
+    {
+        static MarkerTable table;
+
+
+        return table;
+    }
+}}}
+
+
+// ----- //
+// TRACE //
+// ----- //
+
+uint32_t KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetMarkerCount()
+{
+    return KLab::Profiling::Trace::GetMarkerTable().GetLength();
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetMarkerInfo(const uint32_t markerID, KLab_Profiling_Trace_MarkerInfo *info)
+{
+    // Validate arguments
+    if (!info)
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    auto marker = KLab::Profiling::Trace::GetMarkerTable().TryGet(markerID);
+
+
+    if (!marker)
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    *info = *marker;
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
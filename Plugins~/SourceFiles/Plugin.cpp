@@ -10,6 +10,10 @@
 // INCLUDES //
 // -------- //
 
+#include <cstring>
+#include <tuple>
+#include <utility>
+
 #include <IUnityInterface.h>
 #include <IUnityProfilerCallbacks.h>
 
@@ -40,6 +44,54 @@ namespace KLab { namespace Profiling { namespace Plugin
         return (context.Trace.CSharpTrace->IsTracing());
     }
 
+    // Checks whether statistics are traced
+    // param contxt - Plugin context
+    // @return true if tracing; false otherwise
+    static inline bool _isStatsTracing(const PluginContext &context)
+    {
+        return (context.Trace.StatsTrace->IsTracing());
+    }
+
+    // Checks whether histograms are traced
+    // param contxt - Plugin context
+    // @return true if tracing; false otherwise
+    static inline bool _isHistogramTracing(const PluginContext &context)
+    {
+        return (context.Trace.HistogramTrace->IsTracing());
+    }
+
+    // Checks whether allocations are traced
+    // param contxt - Plugin context
+    // @return true if tracing; false otherwise
+    static inline bool _isAllocTracing(const PluginContext &context)
+    {
+        return (context.Trace.AllocTrace->IsTracing());
+    }
+
+    // Checks whether call trees are traced
+    // param contxt - Plugin context
+    // @return true if tracing; false otherwise
+    static inline bool _isCallTreeTracing(const PluginContext &context)
+    {
+        return (context.Trace.CallTreeTrace->IsTracing());
+    }
+
+    // Checks whether live feed is publishing
+    // param contxt - Plugin context
+    // @return true if publishing; false otherwise
+    static inline bool _isLiveFeedPublishing(const PluginContext &context)
+    {
+        return (context.Trace.LiveFeed->IsPublishing());
+    }
+
+    // Checks whether sinks are attached to batch trace
+    // param contxt - Plugin context
+    // @return true if tracing; false otherwise
+    static inline bool _isBatchTracing(const PluginContext &context)
+    {
+        return (context.Trace.BatchTrace->IsTracing());
+    }
+
     // Checks whether extern is tracing
     // param contxt - Plugin context
     // @return true if tracing; false otherwise
@@ -52,32 +104,105 @@ namespace KLab { namespace Profiling { namespace Plugin
     #define _isExternTracing(context) (false)
     #endif
 
+    // Gets sinks extern trace gets delivered through
+    // param contxt - Plugin context
+    // @return ::Sink_Extern combined with ::Sink_AsyncExtern if delivered asynchronously
+    static inline uint32_t _getExternSinks(const PluginContext &context)
+    {
+        return (Sink_Extern | (context.Trace.AsyncExternTrace->IsRunning() ? Sink_AsyncExtern : 0u));
+    }
+
+    // Gets sinks currently tracing
+    // @param context - Plugin context
+    // @return the sinks as ::Sink flags
+    static inline uint32_t _getActiveSinks(const PluginContext &context)
+    {
+        return ((_isATraceTracing(context) ? Sink_ATrace : 0u)
+            | (_isCSharpTracing(context) ? Sink_CSharp : 0u)
+            | (_isStatsTracing(context) ? Sink_Stats : 0u)
+            | (_isExternTracing(context) ? _getExternSinks(context) : 0u)
+            | (_isBatchTracing(context) ? Sink_Batch : 0u)
+            | (_isHistogramTracing(context) ? Sink_Histogram : 0u)
+            | (_isAllocTracing(context) ? Sink_Alloc : 0u)
+            | (_isCallTreeTracing(context) ? Sink_CallTree : 0u)
+            | (_isLiveFeedPublishing(context) ? Sink_LiveFeed : 0u));
+    }
+
+
+    // Decodes marker record from callback user data
+    // @param userData - User data
+    // @return the marker record
+    static inline const PluginContext::MarkerRecord &_toMarkerRecord(void *userData)
+    {
+        return *static_cast<const PluginContext::MarkerRecord *>(userData);
+    }
+
+
+    // Sinks marker event handlers get specialized on (other sinks checked per event; Android native trace only where available)
+    // Specializing all sinks measured within noise of checking the others per event (0-4ns per event on x86-64)
+    // while tripling plugin size (512 variants) and exceeding default template depth of the C++11 index sequence
+    #if (KLAB_PROFILING_HAS_ATRACE)
+    static constexpr uint32_t _specializedSinks = (Sink_ATrace | Sink_CSharp | Sink_Stats | Sink_Extern);
+    #else
+    static constexpr uint32_t _specializedSinks = (Sink_CSharp | Sink_Stats | Sink_Extern);
+    #endif
 
-    // Handles Unity marker event
+
+    // Handles Unity marker event (specialized on hot sinks, checking remaining sinks of marker record per event)
     // @param descriptor - Marker descriptor
     // @param type - Event type
     // @param dataCount - Number of data
     // @param data - Data
-    static void UNITY_INTERFACE_API _handleMarkerEvent(const UnityProfilerMarkerDesc *descriptor, UnityProfilerMarkerEventType type, uint16_t dataCount, const UnityProfilerMarkerData *data, void *_unused)
+    // @param userData - Marker record
+    template<uint32_t Sinks>
+    static void UNITY_INTERFACE_API _handleMarkerEvent(const UnityProfilerMarkerDesc *descriptor, UnityProfilerMarkerEventType type, uint16_t dataCount, const UnityProfilerMarkerData *data, void *userData)
     {
         Utils::Utf8Buffer utf8Buffer;
 
-        auto              &context = GetPluginContext();
-        const auto         group   = context.Trace.SectionGroups.GetAtOrDefault(uint32_t(descriptor->categoryId));
-        Trace::SectionInfo section =
+        const auto         &record    = _toMarkerRecord(userData);
+        uint32_t            markerID  = record.MarkerID;
+        auto               &context   = GetPluginContext();
+        auto               &thread    = Trace::GetThreadContext();
+        Trace::SectionInfo  section   = record.Section;
+        uint16_t            nameIndex = dataCount;
+
+
+        // Combine specialized sinks with sinks checked per event (constant-folding checks of specialized ones; acquiring histogram ID along)
+        const uint32_t sinks = (Sinks | (record.RegisteredSinks.load(std::memory_order_acquire) & ~_specializedSinks));
+
+
+        // Drop events of threads beyond thread table capacity
+        if (thread.Index == Trace::ThreadContext::InvalidIndex)
         {
-            group.Name,
-            descriptor->name,
-            context.Utils->GetThreadID(),
-            group.Color
-        };
+            return;
+        }
+
+
+        section.ThreadID = thread.Info.ThreadID;
 
 
-        // Convert 'Profiler.Default' emitted UTF-16 to UTF-8
+        // Resolve 'Profiler.Default' emitted UTF-16 sample name (interned and cached to convert once per name)
         if ((dataCount > 1) && (descriptor == context.Trace.DefaultMarkerDescriptor))
         {
-            utf8Buffer   = context.Utils->ConvertUtf16ToUtf8(reinterpret_cast<const char16_t *>(data[1].ptr), (data[1].size / 2));
-            section.Name = utf8Buffer.CString;
+            auto           utf16Name = reinterpret_cast<const char16_t *>(data[1].ptr);
+            auto           base      = context.Trace.Markers->TryGet(markerID);
+            const uint32_t dynamicID = (base ? context.Trace.Markers->InternUtf16(utf16Name, (data[1].size / 2), *base) : Trace::MarkerTable::InvalidID);
+
+
+            if (dynamicID != Trace::MarkerTable::InvalidID)
+            {
+                markerID     = dynamicID;
+                section.Name = context.Trace.Markers->TryGet(dynamicID)->Name;
+            }
+            else
+            {
+                utf8Buffer   = context.Utils->ConvertUtf16ToUtf8(utf16Name, (data[1].size / 2));
+                section.Name = utf8Buffer.CString;
+            }
+
+
+            // Keep name out of captured metadata
+            nameIndex = 1;
         }
 
 
@@ -87,18 +212,55 @@ namespace KLab { namespace Profiling { namespace Plugin
             // Begin section
             case kUnityProfilerMarkerEventTypeBegin:
             {
-                if (_isATraceTracing(context))
+                if (sinks & Sink_ATrace)
                 {
                     context.Trace.ATrace->EnterSection(section.Name);
                 }
-                if (_isCSharpTracing(context))
+                if (sinks & Sink_CSharp)
+                {
+                    context.Trace.CSharpTrace->EnterSection(thread, markerID);
+
+
+                    if (dataCount && record.CapturesMetadata.load(std::memory_order_relaxed))
+                    {
+                        context.Trace.CSharpTrace->WriteMetadata(thread, data, dataCount, nameIndex);
+                    }
+                }
+                if (sinks & Sink_Stats)
                 {
-                    context.Trace.CSharpTrace->EnterSection(section);
+                    context.Trace.StatsTrace->EnterSection(thread, markerID);
+                }
+                if (sinks & Sink_Batch)
+                {
+                    context.Trace.BatchTrace->EnterSection(thread, markerID);
+                }
+                if (sinks & Sink_Histogram)
+                {
+                    context.Trace.HistogramTrace->EnterSection(thread, record.HistogramID.load(std::memory_order_relaxed));
+                }
+                if (sinks & Sink_Alloc)
+                {
+                    context.Trace.AllocTrace->EnterSection(thread, markerID);
+                }
+                if (sinks & Sink_CallTree)
+                {
+                    context.Trace.CallTreeTrace->EnterSection(thread, markerID);
+                }
+                if (sinks & Sink_LiveFeed)
+                {
+                    context.Trace.LiveFeed->EnterSection(thread, markerID);
                 }
 
-                if (_isExternTracing(context))
+                if (sinks & Sink_Extern)
                 {
-                    context.Trace.ExternTrace->EnterSection(section);
+                    if (sinks & Sink_AsyncExtern)
+                    {
+                        context.Trace.AsyncExternTrace->EnterSection(thread, markerID);
+                    }
+                    else
+                    {
+                        context.Trace.ExternTrace->EnterSection(section);
+                    }
                 }
                 break;
             }
@@ -106,18 +268,59 @@ namespace KLab { namespace Profiling { namespace Plugin
             // End section
             case kUnityProfilerMarkerEventTypeEnd:
             {
-                if (_isATraceTracing(context))
+                if (sinks & Sink_ATrace)
                 {
                     context.Trace.ATrace->LeaveSection();
                 }
-                if (_isCSharpTracing(context))
+                if (sinks & Sink_CSharp)
+                {
+                    context.Trace.CSharpTrace->LeaveSection(thread, markerID);
+                }
+                if (sinks & Sink_Stats)
+                {
+                    context.Trace.StatsTrace->LeaveSection(thread, markerID);
+                }
+                if (sinks & Sink_Batch)
+                {
+                    context.Trace.BatchTrace->LeaveSection(thread, markerID);
+                }
+                if (sinks & Sink_Histogram)
+                {
+                    context.Trace.HistogramTrace->LeaveSection(thread, record.HistogramID.load(std::memory_order_relaxed));
+                }
+                if (sinks & Sink_Alloc)
+                {
+                    context.Trace.AllocTrace->LeaveSection(thread);
+                }
+                if (sinks & Sink_CallTree)
+                {
+                    context.Trace.CallTreeTrace->LeaveSection(thread, markerID);
+                }
+                if (sinks & Sink_LiveFeed)
                 {
-                    context.Trace.CSharpTrace->LeaveSection(section);
+                    context.Trace.LiveFeed->LeaveSection(thread, markerID);
                 }
 
-                if (_isExternTracing(context))
+                if (sinks & Sink_Extern)
                 {
-                    context.Trace.ExternTrace->LeaveSection(section);
+                    if (sinks & Sink_AsyncExtern)
+                    {
+                        context.Trace.AsyncExternTrace->LeaveSection(thread, markerID);
+                    }
+                    else
+                    {
+                        context.Trace.ExternTrace->LeaveSection(section);
+                    }
+                }
+                break;
+            }
+
+            // Sample (only managed allocations handled)
+            case kUnityProfilerMarkerEventTypeSingle:
+            {
+                if ((sinks & Sink_Alloc) && record.IsAllocation)
+                {
+                    context.Trace.AllocTrace->RecordAllocation(thread, data, dataCount);
                 }
                 break;
             }
@@ -125,20 +328,126 @@ namespace KLab { namespace Profiling { namespace Plugin
     }
 
 
+    // Table of marker event handlers indexed by sinks masked to ::_specializedSinks
+    template<uint32_t... Keys>
+    struct _MarkerEventHandlers
+    {
+        // Gets handler
+        // @param key - Sinks masked to ::_specializedSinks
+        // @return the handler
+        static IUnityProfilerMarkerEventCallback Get(const uint32_t key)
+        {
+            static const IUnityProfilerMarkerEventCallback handlers[] = { _handleMarkerEvent<(Keys & _specializedSinks)>... };
+
+
+            return handlers[key];
+        }
+    };
+
+    // Generates handler table for keys [0, Count) (hand-rolled index sequence as Apple targets build as C++11)
+    template<uint32_t Count, uint32_t... Keys>
+    struct _MakeMarkerEventHandlers : _MakeMarkerEventHandlers<(Count - 1), (Count - 1), Keys...>
+    {
+    };
+
+    template<uint32_t... Keys>
+    struct _MakeMarkerEventHandlers<0, Keys...> : _MarkerEventHandlers<Keys...>
+    {
+    };
+
+
+    // Gets marker event handler specialized for sinks
+    // @param sinks - Sinks as ::Sink flags
+    // @return the handler
+    static IUnityProfilerMarkerEventCallback _getMarkerEventHandler(const uint32_t sinks)
+    {
+        return _MakeMarkerEventHandlers<(_specializedSinks + 1)>::Get(sinks & _specializedSinks);
+    }
+
+
     // Handles category creation
     // @param descriptor - Category descriptor
     static void UNITY_INTERFACE_API _handleCreateCategory(const UnityProfilerCategoryDesc *descriptor, void *_unused)
     {
-        Trace::SectionGroupInfo group;
-        
-        auto &context = GetPluginContext();
-        
-        
-        group.Name  = descriptor->name;
-        group.Color = descriptor->rgbaColor;
+        GetPluginContext().Trace.Categories->Set(uint32_t(descriptor->id), descriptor->name, descriptor->rgbaColor);
+    }
 
 
-        context.Trace.SectionGroups.Add(group);
+    // Handles Unity thread creation event
+    // @param descriptor - Thread descriptor
+    static void UNITY_INTERFACE_API _handleCreateThread(const UnityProfilerThreadDesc *descriptor, void *_unused)
+    {
+        Trace::GetThreadTable().SetName(descriptor->threadId, descriptor->groupName, descriptor->name);
+    }
+
+
+    // Registers marker event callback variant matching active sinks if marker passes filter (expecting marker descriptor guard locked)
+    // @param context - Plugin context
+    // @param descriptor - Marker descriptor
+    // @param record - Marker record
+    static void _updateMarkerRegistration(PluginContext &context, const UnityProfilerMarkerDesc *descriptor, PluginContext::MarkerRecord &record)
+    {
+        // Never filter 'Profiler.Default' as its samples are named dynamically
+        const bool isSelected = ((descriptor == context.Trace.DefaultMarkerDescriptor) || context.Trace.MarkerFilter.Matches(descriptor->name, uint32_t(descriptor->categoryId)));
+        uint32_t   sinks      = (isSelected ? context.Trace.ActiveSinks : 0u);
+
+
+        // Feed histograms from chosen markers only
+        if (!record.HistogramID.load(std::memory_order_relaxed))
+        {
+            sinks &= ~uint32_t(Sink_Histogram);
+        }
+
+        // Feed allocation samples to allocation trace only (regardless of filter)
+        if (record.IsAllocation)
+        {
+            sinks = (context.Trace.ActiveSinks & Sink_Alloc);
+        }
+
+
+        const uint32_t registeredSinks = record.RegisteredSinks.load(std::memory_order_relaxed);
+
+
+        if (sinks == registeredSinks)
+        {
+            return;
+        }
+
+
+        // Update sinks checked per event only if variant stays registered
+        if (sinks && registeredSinks && (_getMarkerEventHandler(sinks) == _getMarkerEventHandler(registeredSinks)))
+        {
+            record.RegisteredSinks.store(sinks, std::memory_order_release);
+
+
+            return;
+        }
+
+
+        // Swap variant (unregistering first to rather drop than duplicate events in between)
+        if (registeredSinks)
+        {
+            context.Unity.ProfilerCallbacks->UnregisterMarkerEventCallback(descriptor, _getMarkerEventHandler(registeredSinks), &record);
+        }
+
+
+        record.RegisteredSinks.store(sinks, std::memory_order_release);
+
+
+        if (sinks)
+        {
+            context.Unity.ProfilerCallbacks->RegisterMarkerEventCallback(descriptor, _getMarkerEventHandler(sinks), &record);
+        }
+    }
+
+
+    // Checks whether to capture metadata of marker (expecting marker descriptor guard locked)
+    // @param context - Plugin context
+    // @param descriptor - Marker descriptor
+    // @return true if capturing; false otherwise
+    static bool _capturesMetadata(const PluginContext &context, const UnityProfilerMarkerDesc *descriptor)
+    {
+        return (!context.Trace.MetadataFilter.IsEmpty() && context.Trace.MetadataFilter.Matches(descriptor->name, uint32_t(descriptor->categoryId)));
     }
 
 
@@ -182,36 +491,160 @@ namespace KLab { namespace Profiling { namespace Plugin
         }
 
 
-        // Register callback
-        context.Unity.ProfilerCallbacks->RegisterMarkerEventCallback(descriptor, _handleMarkerEvent, _unused);
+        // Intern marker once per descriptor
+        std::lock_guard<std::mutex> lock(context.Trace.MarkerDescriptorsMutex);
+
+
+        auto known = context.Trace.MarkerDescriptors.find(descriptor);
+
+
+        if (known == context.Trace.MarkerDescriptors.end())
+        {
+            const auto        group  = context.Trace.Categories->GetOrDefault(uint32_t(descriptor->categoryId));
+            Trace::MarkerInfo marker =
+            {
+                descriptor->name,
+                group.Name,
+                group.Color,
+                uint32_t(descriptor->categoryId)
+            };
+
+
+            const uint32_t markerID = context.Trace.Markers->Intern(marker);
+
+
+            if (markerID == Trace::MarkerTable::InvalidID)
+            {
+                return;
+            }
+
+
+            // Construct record in place (as its sinks are atomic)
+            known = context.Trace.MarkerDescriptors.emplace(std::piecewise_construct, std::forward_as_tuple(descriptor), std::forward_as_tuple()).first;
+
+
+            auto &record = known->second;
+
+
+            record.Section      = { group.Name, descriptor->name, 0, group.Color, 0 };
+            record.MarkerID     = markerID;
+            record.IsAllocation = (std::strcmp(descriptor->name, "GC.Alloc") == 0);
+
+            record.HistogramID.store(context.Trace.HistogramTrace->FindMarkerHistogram(descriptor->name), std::memory_order_relaxed);
+            record.CapturesMetadata.store(_capturesMetadata(context, descriptor), std::memory_order_relaxed);
+        }
+
+
+        // Register callback (if passing filter)
+        _updateMarkerRegistration(context, known->first, known->second);
     }
 
 
-    // Updates context
-    static void _update()
+    // Dispatches marker events to sinks updating all known markers
+    // @param context - Plugin context
+    // @param sinks - Sinks as ::Sink flags (0 to unregister)
+    static void _setActiveSinks(PluginContext &context, const uint32_t sinks)
     {
-        auto       &context                 = GetPluginContext();
-        const bool  shouldRegisterCallbacks = (_isATraceTracing(context) || _isCSharpTracing(context) || _isExternTracing(context));
-        static bool hasRegisteredCallbacks  = false;
+        static std::mutex dispatchMutex;
+
+        std::lock_guard<std::mutex> dispatchLock(dispatchMutex);
+        uint32_t                    previousSinks;
 
 
-        // Register/Unregister callbacks dynamically
-        if (shouldRegisterCallbacks != hasRegisteredCallbacks)
         {
-            if (shouldRegisterCallbacks)
+            std::lock_guard<std::mutex> lock(context.Trace.MarkerDescriptorsMutex);
+
+
+            previousSinks = context.Trace.ActiveSinks;
+
+
+            if (sinks == previousSinks)
             {
-                context.Unity.ProfilerCallbacks->RegisterCreateMarkerCallback(_handleCreateMarker, nullptr);
+                return;
             }
-            else
+
+
+            context.Trace.ActiveSinks = sinks;
+
+
+            for (auto &marker : context.Trace.MarkerDescriptors)
             {
-                context.Unity.ProfilerCallbacks->UnregisterCreateMarkerCallback(_handleCreateMarker, nullptr);
-                context.Unity.ProfilerCallbacks->UnregisterMarkerEventCallback(nullptr, _handleMarkerEvent, nullptr);
+                _updateMarkerRegistration(context, marker.first, marker.second);
             }
+        }
 
 
-            hasRegisteredCallbacks = shouldRegisterCallbacks;
+        // Track marker creation while dispatching (outside guard as Unity reports existing markers on registration)
+        if (sinks && !previousSinks)
+        {
+            context.Unity.ProfilerCallbacks->RegisterCreateMarkerCallback(_handleCreateMarker, nullptr);
+        }
+        else if (!sinks && previousSinks)
+        {
+            context.Unity.ProfilerCallbacks->UnregisterCreateMarkerCallback(_handleCreateMarker, nullptr);
         }
     }
+
+
+    void UpdateMarkerDispatch()
+    {
+        auto &context = GetPluginContext();
+
+
+        // Early out if context invalid
+        if (!context)
+        {
+            return;
+        }
+
+
+        _setActiveSinks(context, _getActiveSinks(context));
+    }
+
+
+    // Updates context
+    static void _update()
+    {
+        auto &context = GetPluginContext();
+
+
+        // Flip frame (waking streaming writer and extern consumer to drain it, and freezing flight recorder on hitch)
+        context.Trace.CSharpTrace->Flip();
+        context.Trace.FlightRecorder->Flip();
+        context.Trace.StatsTrace->Flip();
+        context.Trace.BatchTrace->Flip();
+        context.Trace.HistogramTrace->Flip();
+        context.Trace.AllocTrace->Flip();
+        context.Trace.CallTreeTrace->Flip();
+        context.Trace.LiveFeed->Flip();
+
+
+        if (context.Trace.StreamingTrace->IsStreaming())
+        {
+            context.Trace.StreamingTrace->Notify();
+        }
+        if (context.Trace.AsyncExternTrace->IsRunning())
+        {
+            context.Trace.AsyncExternTrace->Notify();
+        }
+
+
+        // Swap callbacks on sink changes
+        UpdateMarkerDispatch();
+    }
+
+
+    // Handles Unity frame begin (flipping at engine frame edge instead of from C# update)
+    static void UNITY_INTERFACE_API _handleFrame(void *_unused)
+    {
+        auto &context = GetPluginContext();
+
+
+        context.Frame.CallbackFlipCount.fetch_add(1, std::memory_order_relaxed);
+
+
+        _update();
+    }
 }}}
 
 
@@ -231,8 +664,18 @@ void KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_Plugin_Update()
     using namespace KLab::Profiling::Plugin;
 
 
+    auto &context = GetPluginContext();
+
+
     // Early out if context invailed
-    if (!GetPluginContext())
+    if (!context)
+    {
+        return;
+    }
+
+
+    // Fall back to flipping here only if Unity frame callback didn't flip since last update (e.g. while callbacks stall)
+    if (context.Frame.CallbackFlipCount.exchange(0, std::memory_order_relaxed) > 0)
     {
         return;
     }
@@ -244,11 +687,26 @@ void KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_Plugin_Update()
 
 void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API UnityPluginLoad(IUnityInterfaces *unity)
 {
-    auto &context = KLab::Profiling::Plugin::CreatePluginContext(unity);
-    
-    
-    // Prevent 'unused' warnings
-    (void)context;
+    using namespace KLab::Profiling::Plugin;
+
+
+    auto &context = CreatePluginContext(unity);
+
+
+    // Early out if context invailed
+    if (!context)
+    {
+        return;
+    }
+
+
+    // Track categories and thread names
+    context.Unity.ProfilerCallbacks->RegisterCreateCategoryCallback(_handleCreateCategory, nullptr);
+    context.Unity.ProfilerCallbacks->RegisterCreateThreadCallback(_handleCreateThread, nullptr);
+
+
+    // Flip frames at engine frame edge
+    context.Unity.ProfilerCallbacks->RegisterFrameCallback(_handleFrame, nullptr);
 }
 
 
@@ -268,11 +726,169 @@ void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API UnityPluginUnload()
 
 
     // Unregister from Unity
-    context.Unity.ProfilerCallbacks->UnregisterMarkerEventCallback(nullptr, _handleMarkerEvent, nullptr);
-    context.Unity.ProfilerCallbacks->UnregisterCreateMarkerCallback(_handleCreateMarker, nullptr);
+    _setActiveSinks(context, 0);
     context.Unity.ProfilerCallbacks->UnregisterCreateCategoryCallback(_handleCreateCategory, nullptr);
+    context.Unity.ProfilerCallbacks->UnregisterCreateThreadCallback(_handleCreateThread, nullptr);
+    context.Unity.ProfilerCallbacks->UnregisterFrameCallback(_handleFrame, nullptr);
 
 
     // Release context
     context.Unload();
 }
+
+
+// ----- //
+// TRACE //
+// ----- //
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_SetMarkerFilter(const char *filter)
+{
+    using namespace KLab::Profiling::Plugin;
+
+
+    auto &context = GetPluginContext();
+
+
+    // Validate arguments
+    if (!filter)
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    // Re-evaluate known markers
+    std::lock_guard<std::mutex> lock(context.Trace.MarkerDescriptorsMutex);
+
+
+    if (!context.Trace.MarkerFilter.Parse(filter))
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    for (auto &marker : context.Trace.MarkerDescriptors)
+    {
+        _updateMarkerRegistration(context, marker.first, marker.second);
+    }
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_SetMetadataCapture(const char *filter, const int32_t bytesPerFrame)
+{
+    using namespace KLab::Profiling::Plugin;
+
+
+    auto &context = GetPluginContext();
+
+
+    // Validate arguments
+    if (!filter || (bytesPerFrame < 0))
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    // Re-evaluate known markers
+    std::lock_guard<std::mutex> lock(context.Trace.MarkerDescriptorsMutex);
+
+
+    if (!context.Trace.MetadataFilter.Parse(filter))
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    for (auto &marker : context.Trace.MarkerDescriptors)
+    {
+        marker.second.CapturesMetadata.store(_capturesMetadata(context, marker.first), std::memory_order_relaxed);
+    }
+
+
+    context.Trace.CSharpTrace->_metadataBytesPerFrame.store(uint32_t(bytesPerFrame), std::memory_order_relaxed);
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetMarkerFilterInfo(KLab_Profiling_Trace_MarkerFilterInfo *info)
+{
+    using namespace KLab::Profiling::Plugin;
+
+
+    auto &context = GetPluginContext();
+
+
+    // Validate arguments
+    if (!info)
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    std::lock_guard<std::mutex> lock(context.Trace.MarkerDescriptorsMutex);
+
+
+    info->KnownMarkerCount      = uint32_t(context.Trace.MarkerDescriptors.size());
+    info->RegisteredMarkerCount = 0;
+
+
+    for (const auto &marker : context.Trace.MarkerDescriptors)
+    {
+        info->RegisteredMarkerCount += (marker.second.RegisteredSinks.load(std::memory_order_relaxed) ? 1 : 0);
+    }
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_AddHistogramMarker(const char *name, int32_t *histogramID)
+{
+    using namespace KLab::Profiling::Plugin;
+
+
+    auto &context = GetPluginContext();
+
+
+    // Validate arguments
+    if (!name || !(*name) || !histogramID)
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    std::lock_guard<std::mutex> lock(context.Trace.MarkerDescriptorsMutex);
+
+
+    const uint32_t id = KLab::Profiling::Trace::GetHistogramTrace().AddMarkerHistogram(name);
+
+
+    if (!id)
+    {
+        return KLab_Profiling_ErrorCode_NotAvailable;
+    }
+
+
+    // Register known markers of name
+    for (auto &marker : context.Trace.MarkerDescriptors)
+    {
+        if (!marker.second.HistogramID.load(std::memory_order_relaxed) && !std::strcmp(marker.first->name, name))
+        {
+            // Publish ID before enabling histogram sink (released along with registered sinks)
+            marker.second.HistogramID.store(id, std::memory_order_release);
+
+
+            _updateMarkerRegistration(context, marker.first, marker.second);
+        }
+    }
+
+
+    *histogramID = int32_t(id);
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
@@ -28,10 +28,33 @@ namespace KLab { namespace Profiling { namespace Plugin
         }
 
 
+        if (Trace.StreamingTrace && Trace.StreamingTrace->IsStreaming())
+        {
+            Trace.StreamingTrace->_end();
+        }
+        if (Trace.FlightRecorder && Trace.FlightRecorder->IsRecording())
+        {
+            Trace.FlightRecorder->_end();
+        }
+        if (Trace.LiveFeed && Trace.LiveFeed->IsPublishing())
+        {
+            Trace.LiveFeed->_end();
+        }
+        if (Trace.BatchTrace)
+        {
+            for (uint32_t s = 0; s < KLab::Profiling::Trace::BatchTrace::MaxSinkCount; ++s)
+            {
+                Trace.BatchTrace->_detach(int32_t(s));
+            }
+        }
         if (Trace.ATrace)
         {
             Trace.ATrace->Unload();
         }
+        if (Trace.AsyncExternTrace && Trace.AsyncExternTrace->IsRunning())
+        {
+            Trace.AsyncExternTrace->_end();
+        }
         if (Trace.ExternTrace)
         {
             Trace.ExternTrace->Unload();
@@ -59,7 +82,18 @@ namespace KLab { namespace Profiling { namespace Plugin
         context.Unity.ProfilerCallbacks = unity->Get<IUnityProfilerCallbacks>();
         context.Trace.ATrace            = KLab::Profiling::Trace::TryGetATrace();
         context.Trace.CSharpTrace       = &KLab::Profiling::Trace::GetCSharpTrace();
+        context.Trace.StreamingTrace    = &KLab::Profiling::Trace::GetStreamingTrace();
+        context.Trace.FlightRecorder    = &KLab::Profiling::Trace::GetFlightRecorder();
+        context.Trace.StatsTrace        = &KLab::Profiling::Trace::GetStatsTrace();
+        context.Trace.BatchTrace        = &KLab::Profiling::Trace::GetBatchTrace();
+        context.Trace.HistogramTrace    = &KLab::Profiling::Trace::GetHistogramTrace();
+        context.Trace.AllocTrace        = &KLab::Profiling::Trace::GetAllocTrace();
+        context.Trace.CallTreeTrace     = &KLab::Profiling::Trace::GetCallTreeTrace();
+        context.Trace.LiveFeed          = &KLab::Profiling::Trace::GetLiveFeed();
         context.Trace.ExternTrace       = KLab::Profiling::Trace::TryGetExternTrace();
+        context.Trace.AsyncExternTrace  = &KLab::Profiling::Trace::GetAsyncExternTrace();
+        context.Trace.Markers           = &KLab::Profiling::Trace::GetMarkerTable();
+        context.Trace.Categories        = &KLab::Profiling::Trace::GetCategoryTable();
         context.Utils                   = &KLab::Profiling::Utils::GetUtils();
 
 
@@ -67,11 +101,5 @@ namespace KLab { namespace Profiling { namespace Plugin
     }
 
 
-    PluginContext &GetPluginContext()
-    {
-        static PluginContext context;
-
-
-        return context;
-    }
+    PluginContext _pluginContext;
 }}}
@@ -0,0 +1,470 @@
+// -------------------------------------------------------------------------------------------- //
+//  Copyright (c) KLab Inc.. All rights reserved.                                               //
+//  Licensed under the MIT License. See 'LICENSE' in the project root for license information.  //
+// -------------------------------------------------------------------------------------------- //
+
+#include <KLab/Profiling/Internal.hpp>
+
+
+// -------- //
+// INCLUDES //
+// -------- //
+
+#include <algorithm>
+#include <iterator>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    // Gets histogram bucket of duration
+    // @param durationNs - Duration in nanoseconds
+    // @return the bucket index
+    static inline uint32_t _getBucket(const uint64_t durationNs)
+    {
+        uint32_t bucket = 0;
+
+
+        for (uint64_t us = (durationNs / 1000); us && (bucket < (KLab_Profiling_Trace_HistogramBucketCount - 1)); us >>= 1)
+        {
+            ++bucket;
+        }
+
+
+        return bucket;
+    }
+
+
+    // Accumulates statistics
+    // @param stats - Statistics to accumulate into (expected to have at least one section)
+    // @param other - Statistics to accumulate
+    static void _accumulate(MarkerStats &stats, const MarkerStats &other)
+    {
+        stats.Count   += other.Count;
+        stats.TotalNs += other.TotalNs;
+        stats.SelfNs  += other.SelfNs;
+        stats.MinNs    = std::min(stats.MinNs, other.MinNs);
+        stats.MaxNs    = std::max(stats.MaxNs, other.MaxNs);
+
+
+        for (uint32_t b = 0; b < KLab_Profiling_Trace_HistogramBucketCount; ++b)
+        {
+            stats.Histogram[b] += other.Histogram[b];
+        }
+    }
+
+
+    // Resets accumulator set
+    // @param set - Set to reset
+    static void _reset(ThreadStats::Set &set)
+    {
+        for (const uint32_t id : set.TouchedIDs)
+        {
+            *set.Markers.TryGet(id) = MarkerStats();
+        }
+
+
+        set.TouchedIDs.clear();
+    }
+}}}
+
+
+// ----------- //
+// STATS TRACE //
+// ----------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    bool StatsTrace::IsTracing() const
+    {
+        return _isTracing.load(std::memory_order_relaxed);
+    }
+
+
+    void StatsTrace::Flip()
+    {
+        if (!IsTracing())
+        {
+            return;
+        }
+
+
+        _timer.Calibrate();
+        _nsPerTick.store(_timer._nsPerTick, std::memory_order_relaxed);
+
+
+        // Seal frame currently recorded
+        const uint64_t frame = _frameIndex.load(std::memory_order_relaxed);
+        const uint64_t nowNs = _timer.GetTimestampNs();
+        const uint32_t set   = uint32_t(frame % ThreadStats::SetCount);
+
+
+        _frameDurationNs[set]                              = (nowNs - _frameBeginNs[set]);
+        _frameBeginNs[(frame + 1) % ThreadStats::SetCount] = nowNs;
+
+        _frameIndex.store((frame + 1), std::memory_order_release);
+
+
+        // Merge frame sealed on previous flip (as late writers might have still committed to it)
+        if (frame > 0)
+        {
+            _merge(uint32_t((frame - 1) % ThreadStats::SetCount), (frame - 1));
+        }
+    }
+
+
+    void StatsTrace::EnterSection(ThreadContext &thread, const uint32_t markerID)
+    {
+        auto stats = _getThreadStats(thread);
+
+
+        if (!stats)
+        {
+            return;
+        }
+
+
+        if (stats->Depth < ThreadStats::MaxDepth)
+        {
+            stats->Stack[stats->Depth] = { markerID, _timer.GetTicks(), 0 };
+        }
+
+
+        ++stats->Depth;
+    }
+
+
+    void StatsTrace::LeaveSection(ThreadContext &thread, const uint32_t markerID)
+    {
+        const uint64_t endTicks = _timer.GetTicks();
+        auto           stats    = _getThreadStats(thread);
+
+
+        // Ignore sections entered before trace began
+        if (!stats || !stats->Depth)
+        {
+            return;
+        }
+
+
+        const uint32_t depth = --stats->Depth;
+
+
+        // Ignore sections too deep to track and mismatched sections
+        if ((depth >= ThreadStats::MaxDepth) || (stats->Stack[depth].MarkerID != markerID))
+        {
+            return;
+        }
+
+
+        // Measure section
+        const auto     &section    = stats->Stack[depth];
+        const uint64_t  durationNs = uint64_t(double(endTicks - section.BeginTicks) * _nsPerTick.load(std::memory_order_relaxed));
+        const uint64_t  selfNs     = (durationNs - std::min(section.ChildNs, durationNs));
+
+
+        if (depth > 0)
+        {
+            stats->Stack[depth - 1].ChildNs += durationNs;
+        }
+
+
+        // Accumulate into set of current frame (resetting it first if left by previous trace)
+        const uint64_t frame = _frameIndex.load(std::memory_order_acquire);
+        auto          &set   = stats->Sets[frame % ThreadStats::SetCount];
+
+
+        if (set.Generation.load(std::memory_order_relaxed) != stats->Generation)
+        {
+            _reset(set);
+
+            set.Generation.store(stats->Generation, std::memory_order_relaxed);
+        }
+
+
+        auto marker = set.Markers.GetOrCreate(markerID);
+
+
+        if (!marker)
+        {
+            return;
+        }
+
+
+        if (!marker->Count)
+        {
+            set.TouchedIDs.push_back(markerID);
+
+            marker->MarkerID = markerID;
+            marker->MinNs    = durationNs;
+        }
+
+
+        ++marker->Count;
+
+        marker->TotalNs += durationNs;
+        marker->SelfNs  += selfNs;
+        marker->MinNs    = std::min(marker->MinNs, durationNs);
+        marker->MaxNs    = std::max(marker->MaxNs, durationNs);
+
+        ++marker->Histogram[_getBucket(durationNs)];
+
+
+        stats->CommittedFrameIndex.store(frame, std::memory_order_release);
+    }
+
+
+    void StatsTrace::_enable()
+    {
+        // Clear results of previous trace (leaving accumulator sets to their threads, as late writers might still write into them)
+        {
+            std::lock_guard<std::mutex> lock(_resultsMutex);
+
+
+            for (const auto &result : _results)
+            {
+                _resultIndices[result.MarkerID] = 0;
+            }
+
+
+            _results.clear();
+
+            _hasResults = false;
+        }
+
+
+        // Start timer once (as only durations get measured, and late writers of previous trace might still read it)
+        if (!_timer._baseNs)
+        {
+            _timer.Reset();
+            _nsPerTick.store(_timer._nsPerTick, std::memory_order_relaxed);
+        }
+
+
+        // Initialize state
+        std::fill(std::begin(_frameBeginNs), std::end(_frameBeginNs), _timer.GetTimestampNs());
+        std::fill(std::begin(_frameDurationNs), std::end(_frameDurationNs), 0);
+
+        _frameIndex.store(0, std::memory_order_relaxed);
+        _generation.fetch_add(1, std::memory_order_acq_rel);
+        _isTracing.store(true, std::memory_order_release);
+    }
+
+
+    void StatsTrace::_disable()
+    {
+        _isTracing.store(false, std::memory_order_release);
+    }
+
+
+    bool StatsTrace::_getResults(MarkerStats *statsBuffer, const uint32_t statsBufferCapacity, KLab_Profiling_Trace_StatsFrameInfo &info)
+    {
+        std::lock_guard<std::mutex> lock(_resultsMutex);
+
+
+        info.FrameIndex  = _resultFrameIndex;
+        info.DurationNs  = _resultDurationNs;
+        info.MarkerCount = uint32_t(_results.size());
+        info.IsTracing   = IsTracing();
+
+
+        if (statsBuffer)
+        {
+            std::copy(_results.begin(), (_results.begin() + std::min(statsBufferCapacity, info.MarkerCount)), statsBuffer);
+        }
+
+
+        return _hasResults;
+    }
+
+
+    ThreadStats *StatsTrace::_getThreadStats(ThreadContext &thread)
+    {
+        auto stats = thread.Stats;
+
+
+        // Create and register accumulators on first use
+        if (!stats)
+        {
+            stats = NewAlignedArray<ThreadStats>(1);
+
+
+            if (!stats)
+            {
+                return nullptr;
+            }
+
+
+            auto head = _threads.load(std::memory_order_relaxed);
+
+
+            do
+            {
+                stats->Next = head;
+            }
+            while (!_threads.compare_exchange_weak(head, stats, std::memory_order_release, std::memory_order_relaxed));
+
+
+            thread.Stats = stats;
+        }
+
+
+        // Drop sections of previous trace
+        const uint32_t generation = _generation.load(std::memory_order_acquire);
+
+
+        if (stats->Generation != generation)
+        {
+            stats->Generation = generation;
+            stats->Depth      = 0;
+        }
+
+
+        return stats;
+    }
+
+
+    void StatsTrace::_merge(const uint32_t set, const uint64_t frameIndex)
+    {
+        std::lock_guard<std::mutex> lock(_resultsMutex);
+
+
+        // Clear previous frame
+        for (const auto &result : _results)
+        {
+            _resultIndices[result.MarkerID] = 0;
+        }
+
+
+        _results.clear();
+
+
+        // Merge threads (skipping threads idle during frame and sets of previous traces)
+        const uint32_t generation = _generation.load(std::memory_order_relaxed);
+
+
+        for (auto stats = _threads.load(std::memory_order_acquire); stats; stats = stats->Next)
+        {
+            auto &accumulators = stats->Sets[set];
+
+
+            if ((stats->CommittedFrameIndex.load(std::memory_order_acquire) < frameIndex) || (accumulators.Generation.load(std::memory_order_relaxed) != generation))
+            {
+                continue;
+            }
+
+
+            for (const uint32_t id : accumulators.TouchedIDs)
+            {
+                const auto &marker = *accumulators.Markers.TryGet(id);
+
+
+                if (id >= _resultIndices.size())
+                {
+                    _resultIndices.resize((id + 1), 0);
+                }
+
+
+                auto &index = _resultIndices[id];
+
+
+                if (index)
+                {
+                    _accumulate(_results[index - 1], marker);
+                }
+                else
+                {
+                    _results.push_back(marker);
+
+                    index = uint32_t(_results.size());
+                }
+            }
+
+
+            _reset(accumulators);
+        }
+
+
+        _resultFrameIndex = frameIndex;
+        _resultDurationNs = _frameDurationNs[set];
+        _hasResults       = true;
+    }
+
+
+    StatsTrace &GetStatsTrace()
+    {
+        static StatsTrace trace;
+
+
+        return trace;
+    }
+}}}
+
+
+// ----- //
+// TRACE //
+// ----- //
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginStatsTrace()
+{
+    auto &trace = KLab::Profiling::Trace::GetStatsTrace();
+
+
+    // Validate state
+    if (trace.IsTracing())
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    trace._enable();
+
+
+    // Dispatch events right away (instead of from next update)
+    KLab::Profiling::Plugin::UpdateMarkerDispatch();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_EndStatsTrace()
+{
+    auto &trace = KLab::Profiling::Trace::GetStatsTrace();
+
+
+    // Validate state
+    if (!trace.IsTracing())
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    trace._disable();
+
+
+    // Stop dispatching right away (instead of from next update)
+    KLab::Profiling::Plugin::UpdateMarkerDispatch();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetStatsFrame(KLab_Profiling_Trace_MarkerStats *statsBuffer, const int32_t statsBufferSize, KLab_Profiling_Trace_StatsFrameInfo *info)
+{
+    // Validate arguments
+    if (!info || (statsBuffer && (statsBufferSize <= 0)))
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    const bool hasResults = KLab::Profiling::Trace::GetStatsTrace()._getResults(statsBuffer, (statsBuffer ? uint32_t(statsBufferSize) : 0u), *info);
+
+
+    return (hasResults ? KLab_Profiling_ErrorCode_NoError : KLab_Profiling_ErrorCode_NotAvailable);
+}
@@ -0,0 +1,679 @@
+// -------------------------------------------------------------------------------------------- //
+//  Copyright (c) KLab Inc.. All rights reserved.                                               //
+//  Licensed under the MIT License. See 'LICENSE' in the project root for license information.  //
+// -------------------------------------------------------------------------------------------- //
+
+#include <KLab/Profiling/Internal.hpp>
+
+
+// -------- //
+// INCLUDES //
+// -------- //
+
+#include <algorithm>
+#include <cstring>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    // Upper bound of encoded event structure in bytes (tag, type, and marker ID varints)
+    static constexpr size_t _maxEncodedStructureSize = (3 + 3 + 5);
+    // Upper bound of encoded timestamp delta in bytes
+    static constexpr size_t _maxEncodedTimestampSize = 10;
+    // Lower bound of encoded event structure in bytes (tag and marker ID varints)
+    static constexpr size_t _minEncodedStructureSize = 2;
+    // Type tag signaling type varint to follow
+    static constexpr uint32_t _extendedType = 3;
+
+
+    // Block compression (byte-aligned LZ77 in the style of LZ4: token of literal and match length nibbles, literals, 16-bit offset)
+    namespace _Block
+    {
+        // Minimum match length
+        static constexpr size_t MinMatch = 4;
+        // Number of bits of match finder hash
+        static constexpr uint32_t HashBits = 12;
+        // Maximum match offset
+        static constexpr size_t MaxOffset = 65535;
+        // Number of bytes at end of block always emitted as literals
+        static constexpr size_t LastLiterals = 5;
+        // Minimum number of bytes left for match to start
+        static constexpr size_t MatchLimit = 12;
+        // Length nibble signaling length bytes to follow
+        static constexpr size_t ExtendedLength = 15;
+    }
+
+
+    // Writes varint
+    // @param out - Buffer to write to
+    // @param value - Value
+    // @return the end of written bytes
+    static inline char *_writeVarint(char *out, uint64_t value)
+    {
+        for (; value >= 0x80; value >>= 7)
+        {
+            *(out++) = char(uint8_t(value) | 0x80);
+        }
+
+
+        *(out++) = char(value);
+
+
+        return out;
+    }
+
+
+    // Reads varint
+    // @param in - Bytes to read from (advanced past varint)
+    // @param end - End of bytes
+    // @param value - Value
+    // @return true on success; false on truncated or overlong varint
+    static inline bool _readVarint(const uint8_t *&in, const uint8_t *end, uint64_t &value)
+    {
+        value = 0;
+
+
+        for (uint32_t shift = 0; (in < end) && (shift < 64); shift += 7)
+        {
+            const uint8_t byte = *(in++);
+
+
+            value |= (uint64_t(byte & 0x7f) << shift);
+
+
+            if (!(byte & 0x80))
+            {
+                return true;
+            }
+        }
+
+
+        return false;
+    }
+
+
+    // Maps signed delta (as two's complement) to unsigned value keeping small magnitudes small
+    // @param delta - Delta
+    // @return the zig-zagged delta
+    static inline uint64_t _zigZag(const uint64_t delta)
+    {
+        return ((delta << 1) ^ (0 - (delta >> 63)));
+    }
+
+
+    // Reverts ::_zigZag
+    // @param value - Zig-zagged delta
+    // @return the delta
+    static inline uint64_t _unZigZag(const uint64_t value)
+    {
+        return ((value >> 1) ^ (0 - (value & 1)));
+    }
+
+
+    // Reads 4 bytes
+    // @param data - Bytes
+    // @return the bytes as integer
+    static inline uint32_t _read32(const char *data)
+    {
+        uint32_t value;
+
+
+        std::memcpy(&value, data, sizeof(value));
+
+
+        return value;
+    }
+
+
+    // Hashes 4-byte sequence for match finder
+    // @param sequence - Sequence
+    // @return the hash
+    static inline uint32_t _hashSequence(const uint32_t sequence)
+    {
+        return ((sequence * 2654435761u) >> (32 - _Block::HashBits));
+    }
+
+
+    // Writes length beyond length nibble
+    // @param out - Buffer to write to
+    // @param length - Length minus ::_Block::ExtendedLength
+    // @return the end of written bytes
+    static char *_writeLength(char *out, size_t length)
+    {
+        for (; length >= 255; length -= 255)
+        {
+            *(out++) = char(255);
+        }
+
+
+        *(out++) = char(length);
+
+
+        return out;
+    }
+
+
+    // Reads length beyond length nibble
+    // @param in - Bytes to read from (advanced past length)
+    // @param end - End of bytes
+    // @param length - Length to add to
+    // @return true on success; false on truncated input
+    static bool _readLength(const uint8_t *&in, const uint8_t *end, size_t &length)
+    {
+        while (in < end)
+        {
+            const uint8_t byte = *(in++);
+
+
+            length += byte;
+
+
+            if (byte != 255)
+            {
+                return true;
+            }
+        }
+
+
+        return false;
+    }
+
+
+    // Writes sequence of literals and match
+    // @param out - Buffer to write to
+    // @param literals - Literals
+    // @param literalLength - Number of literals
+    // @param offset - Distance of match
+    // @param matchLength - Length of match (0 for final literals)
+    // @return the end of written bytes
+    static char *_writeSequence(char *out, const char *literals, const size_t literalLength, const size_t offset, const size_t matchLength)
+    {
+        const size_t matchCode = (matchLength ? (matchLength - _Block::MinMatch) : 0);
+        char        *token     = out++;
+
+
+        *token = char((((literalLength < _Block::ExtendedLength) ? literalLength : _Block::ExtendedLength) << 4) | ((matchCode < _Block::ExtendedLength) ? matchCode : _Block::ExtendedLength));
+
+
+        if (literalLength >= _Block::ExtendedLength)
+        {
+            out = _writeLength(out, (literalLength - _Block::ExtendedLength));
+        }
+
+
+        std::memcpy(out, literals, literalLength);
+
+        out += literalLength;
+
+
+        if (matchLength)
+        {
+            *(out++) = char(offset & 0xff);
+            *(out++) = char(offset >> 8);
+
+
+            if (matchCode >= _Block::ExtendedLength)
+            {
+                out = _writeLength(out, (matchCode - _Block::ExtendedLength));
+            }
+        }
+
+
+        return out;
+    }
+
+
+    // Compresses block (matching against dictionary preceding it)
+    // @param data - Dictionary followed by bytes to compress
+    // @param dictionarySize - Size of dictionary in bytes
+    // @param size - Number of bytes to compress
+    // @param positions - Match finder table
+    // @param out - Buffer to append compressed bytes to
+    static void _compressBlock(const char *data, const size_t dictionarySize, const size_t size, std::vector<uint32_t> &positions, std::string &out)
+    {
+        const size_t begin = out.size();
+        const size_t end   = (dictionarySize + size);
+
+
+        // Reserve for incompressible data
+        out.resize(begin + size + (size / 255) + 16);
+
+
+        char   *cursor = (&out[0] + begin);
+        size_t  anchor = dictionarySize;
+
+
+        if (size > _Block::MatchLimit)
+        {
+            const size_t matchEnd = (end - _Block::LastLiterals);
+
+
+            // Index dictionary (storing positions off by one, 0 marking empty slot)
+            positions.assign((size_t(1) << _Block::HashBits), 0);
+
+
+            for (size_t position = 0; (position + _Block::MinMatch) <= dictionarySize; ++position)
+            {
+                positions[_hashSequence(_read32(data + position))] = uint32_t(position + 1);
+            }
+
+
+            for (size_t position = dictionarySize; position <= (end - _Block::MatchLimit);)
+            {
+                const uint32_t  sequence  = _read32(data + position);
+                auto           &slot      = positions[_hashSequence(sequence)];
+                const size_t    candidate = slot;
+
+
+                slot = uint32_t(position + 1);
+
+
+                if (!candidate || ((position + 1 - candidate) > _Block::MaxOffset) || (_read32(data + candidate - 1) != sequence))
+                {
+                    // Skip faster through incompressible data
+                    position += (1 + ((position - anchor) >> 6));
+
+
+                    continue;
+                }
+
+
+                const size_t match  = (candidate - 1);
+                size_t       length = _Block::MinMatch;
+
+
+                while (((position + length) < matchEnd) && (data[match + length] == data[position + length]))
+                {
+                    ++length;
+                }
+
+
+                cursor = _writeSequence(cursor, (data + anchor), (position - anchor), (position - match), length);
+
+                position += length;
+                anchor    = position;
+            }
+        }
+
+
+        cursor = _writeSequence(cursor, (data + anchor), (end - anchor), 0, 0);
+
+
+        out.resize(size_t(cursor - &out[0]));
+    }
+
+
+    // Decompresses block (matching against dictionary preceding it)
+    // @param data - Compressed bytes
+    // @param size - Number of compressed bytes
+    // @param out - Dictionary followed by buffer for decompressed bytes
+    // @param dictionarySize - Size of dictionary in bytes
+    // @param outSize - Number of decompressed bytes
+    // @return true on success; false on corrupt input
+    static bool _decompressBlock(const char *data, const size_t size, char *out, const size_t dictionarySize, const size_t outSize)
+    {
+        auto         in     = reinterpret_cast<const uint8_t *>(data);
+        auto         end    = (in + size);
+        size_t       cursor = dictionarySize;
+        const size_t outEnd = (dictionarySize + outSize);
+
+
+        while (in < end)
+        {
+            const uint32_t token         = *(in++);
+            size_t         literalLength = (token >> 4);
+
+
+            // Copy literals
+            if ((literalLength == _Block::ExtendedLength) && !_readLength(in, end, literalLength))
+            {
+                return false;
+            }
+            if ((literalLength > size_t(end - in)) || (literalLength > (outEnd - cursor)))
+            {
+                return false;
+            }
+
+
+            if (literalLength)
+            {
+                std::memcpy((out + cursor), in, literalLength);
+            }
+
+
+            in     += literalLength;
+            cursor += literalLength;
+
+
+            // Final sequence lacks match
+            if (in == end)
+            {
+                break;
+            }
+
+
+            // Copy match (byte by byte if overlapping)
+            if ((end - in) < 2)
+            {
+                return false;
+            }
+
+
+            const size_t offset      = (size_t(in[0]) | (size_t(in[1]) << 8));
+            size_t       matchLength = (token & 0x0f);
+
+
+            in += 2;
+
+
+            if ((matchLength == _Block::ExtendedLength) && !_readLength(in, end, matchLength))
+            {
+                return false;
+            }
+
+
+            matchLength += _Block::MinMatch;
+
+
+            if (!offset || (offset > cursor) || (matchLength > (outEnd - cursor)))
+            {
+                return false;
+            }
+
+
+            if (offset >= matchLength)
+            {
+                std::memcpy((out + cursor), (out + cursor - offset), matchLength);
+
+                cursor += matchLength;
+            }
+            else
+            {
+                for (const size_t matchEnd = (cursor + matchLength); cursor < matchEnd; ++cursor)
+                {
+                    out[cursor] = out[cursor - offset];
+                }
+            }
+        }
+
+
+        return (cursor == outEnd);
+    }
+}}}
+
+
+// -------------- //
+// STREAM ENCODER //
+// -------------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    void StreamEncoder::Encode(const KLab_Profiling_Trace_EventRecord *records, const uint32_t recordCount, const KLab_Profiling_Trace_StreamCompression compression, std::string &out)
+    {
+        // Keep structure of previous frame as dictionary (within reach of match offsets)
+        if (_history.size() > _Block::MaxOffset)
+        {
+            _history.erase(0, (_history.size() - _Block::MaxOffset));
+        }
+
+
+        const size_t dictionarySize = ((compression == KLab_Profiling_Trace_StreamCompression_DeltaBlock) ? _history.size() : 0);
+
+
+        // Restart deltas on every frame
+        std::fill(_timestamps.begin(), _timestamps.end(), 0);
+
+        _history.resize(dictionarySize + (size_t(recordCount) * _maxEncodedStructureSize));
+        _timestampColumn.resize(size_t(recordCount) * _maxEncodedTimestampSize);
+
+
+        char *cursor          = (&_history[0] + dictionarySize);
+        char *timestampCursor = &_timestampColumn[0];
+
+
+        for (uint32_t r = 0; r < recordCount; ++r)
+        {
+            const auto &record = records[r];
+
+
+            if (record.ThreadIndex >= _timestamps.size())
+            {
+                _timestamps.resize((size_t(record.ThreadIndex) + 1), 0);
+            }
+
+
+            auto          &timestamp = _timestamps[record.ThreadIndex];
+            const uint32_t type      = ((record.Type < _extendedType) ? record.Type : _extendedType);
+
+
+            cursor = _writeVarint(cursor, ((uint64_t(record.ThreadIndex) << 2) | type));
+
+
+            if (type == _extendedType)
+            {
+                cursor = _writeVarint(cursor, record.Type);
+            }
+
+
+            cursor          = _writeVarint(cursor, record.MarkerID);
+            timestampCursor = _writeVarint(timestampCursor, _zigZag(record.TimestampNs - timestamp));
+
+            timestamp = record.TimestampNs;
+        }
+
+
+        const size_t structureSize = (size_t(cursor - &_history[0]) - dictionarySize);
+
+
+        _history.resize(dictionarySize + structureSize);
+
+
+        // Stage header (patching compression in once block compression paid off)
+        StreamFormat::EncodedFrameHeader header = { uint32_t(KLab_Profiling_Trace_StreamCompression_Delta), uint32_t(structureSize), uint32_t(structureSize) };
+
+
+        out.assign(reinterpret_cast<const char *>(&header), sizeof(header));
+
+
+        if (compression == KLab_Profiling_Trace_StreamCompression_DeltaBlock)
+        {
+            _compressBlock(_history.data(), dictionarySize, structureSize, _positions, out);
+
+
+            const size_t storedSize = (out.size() - sizeof(header));
+
+
+            if (storedSize < structureSize)
+            {
+                header.Compression         = uint32_t(KLab_Profiling_Trace_StreamCompression_DeltaBlock);
+                header.StoredStructureSize = uint32_t(storedSize);
+
+
+                std::memcpy(&out[0], &header, sizeof(header));
+            }
+            else
+            {
+                // Store incompressible structure as is
+                out.resize(sizeof(header));
+            }
+        }
+
+
+        if (header.Compression == KLab_Profiling_Trace_StreamCompression_Delta)
+        {
+            out.append((_history.data() + dictionarySize), structureSize);
+        }
+
+
+        out.append(_timestampColumn.data(), size_t(timestampCursor - &_timestampColumn[0]));
+
+
+        // Keep structure only as next dictionary
+        _history.erase(0, dictionarySize);
+    }
+
+
+    void StreamEncoder::Reset()
+    {
+        _history.clear();
+    }
+}}}
+
+
+// -------------- //
+// STREAM DECODER //
+// -------------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    bool StreamDecoder::Decode(const char *data, const size_t size, const uint32_t recordCount, std::vector<KLab_Profiling_Trace_EventRecord> &out)
+    {
+        StreamFormat::EncodedFrameHeader header;
+
+
+        if (size < sizeof(header))
+        {
+            return false;
+        }
+
+
+        std::memcpy(&header, data, sizeof(header));
+
+
+        if ((header.StoredStructureSize > (size - sizeof(header))) || (recordCount > (header.StructureSize / _minEncodedStructureSize)))
+        {
+            return false;
+        }
+
+
+        // Keep structure of previous frame as dictionary (mirroring encoder)
+        if (_history.size() > _Block::MaxOffset)
+        {
+            _history.erase(_history.begin(), (_history.end() - _Block::MaxOffset));
+        }
+
+
+        const char   *structure      = (data + sizeof(header));
+        const size_t  dictionarySize = _history.size();
+
+
+        _history.resize(dictionarySize + header.StructureSize);
+
+
+        // Undo block compression
+        switch (header.Compression)
+        {
+            case KLab_Profiling_Trace_StreamCompression_Delta:
+            {
+                if (header.StoredStructureSize != header.StructureSize)
+                {
+                    return false;
+                }
+
+
+                if (header.StructureSize)
+                {
+                    std::memcpy((_history.data() + dictionarySize), structure, header.StructureSize);
+                }
+                break;
+            }
+
+            case KLab_Profiling_Trace_StreamCompression_DeltaBlock:
+            {
+                if (!_decompressBlock(structure, header.StoredStructureSize, _history.data(), dictionarySize, header.StructureSize))
+                {
+                    return false;
+                }
+                break;
+            }
+
+            default:
+            {
+                return false;
+            }
+        }
+
+
+        // Undo delta encoding
+        auto in           = reinterpret_cast<const uint8_t *>(_history.data() + dictionarySize);
+        auto end          = (in + header.StructureSize);
+        auto timestampIn  = reinterpret_cast<const uint8_t *>(structure + header.StoredStructureSize);
+        auto timestampEnd = reinterpret_cast<const uint8_t *>(data + size);
+
+
+        std::fill(_timestamps.begin(), _timestamps.end(), 0);
+        out.resize(recordCount);
+
+
+        for (auto &record : out)
+        {
+            uint64_t tag;
+            uint64_t type;
+            uint64_t markerID;
+            uint64_t delta;
+
+
+            if (!_readVarint(in, end, tag))
+            {
+                return false;
+            }
+
+
+            type = (tag & 3);
+
+
+            if ((type == _extendedType) && !_readVarint(in, end, type))
+            {
+                return false;
+            }
+            if (!_readVarint(in, end, markerID) || !_readVarint(timestampIn, timestampEnd, delta))
+            {
+                return false;
+            }
+
+
+            const uint64_t threadIndex = (tag >> 2);
+
+
+            if ((threadIndex > 0xffff) || (type > 0xffff) || (markerID > 0xffffffff))
+            {
+                return false;
+            }
+
+
+            if (threadIndex >= _timestamps.size())
+            {
+                _timestamps.resize((size_t(threadIndex) + 1), 0);
+            }
+
+
+            auto &timestamp = _timestamps[size_t(threadIndex)];
+
+
+            timestamp += _unZigZag(delta);
+
+
+            record.MarkerID    = uint32_t(markerID);
+            record.ThreadIndex = uint16_t(threadIndex);
+            record.Type        = uint16_t(type);
+            record.TimestampNs = timestamp;
+        }
+
+
+        // Keep structure only as next dictionary
+        _history.erase(_history.begin(), (_history.begin() + dictionarySize));
+
+
+        return ((in == end) && (timestampIn == timestampEnd));
+    }
+
+
+    void StreamDecoder::Reset()
+    {
+        _history.clear();
+    }
+}}}
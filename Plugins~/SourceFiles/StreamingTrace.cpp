@@ -0,0 +1,518 @@
+// -------------------------------------------------------------------------------------------- //
+//  Copyright (c) KLab Inc.. All rights reserved.                                               //
+//  Licensed under the MIT License. See 'LICENSE' in the project root for license information.  //
+// -------------------------------------------------------------------------------------------- //
+
+#include <KLab/Profiling/Internal.hpp>
+
+
+// -------- //
+// INCLUDES //
+// -------- //
+
+#include <cstring>
+
+#if (_WIN32)
+#include <Windows.h>
+#elif (__APPLE__)
+#include <pthread.h>
+#elif (__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    // Stages null-terminated strings as single buffer
+    // @param out - Buffer to append to
+    // @param first - First string
+    // @param second - Second string
+    static void _appendStrings(std::string &out, const char *first, const char *second)
+    {
+        out.append(first, (std::strlen(first) + 1));
+        out.append(second, (std::strlen(second) + 1));
+    }
+}}}
+
+
+// ------------- //
+// STREAM WRITER //
+// ------------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    void LowerCurrentThreadPriority()
+    {
+        #if (_WIN32)
+        SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+        #elif (__APPLE__)
+        pthread_set_qos_class_self_np(QOS_CLASS_UTILITY, 0);
+        #elif (__linux__)
+        // Linux (and Android) apply niceness per thread
+        setpriority(PRIO_PROCESS, id_t(syscall(SYS_gettid)), 10);
+        #endif
+    }
+
+
+    bool StreamWriter::Open(const char *path)
+    {
+        _file = std::fopen(path, "wb");
+
+
+        if (!_file)
+        {
+            return false;
+        }
+
+
+        // Write staging buffer with single unbuffered call
+        std::setvbuf(_file, nullptr, _IONBF, 0);
+
+
+        // Initialize state
+        _buffer.resize(BufferSize);
+
+        _bufferLength       = 0;
+        _writtenMarkerCount = 0;
+        _writtenThreadCount = 0;
+
+        _bytesWritten    = 0;
+        _writeDurationNs = 0;
+        _didFailToWrite  = false;
+
+
+        const StreamFormat::FileHeader header = { StreamFormat::Magic, StreamFormat::Version, uint32_t(sizeof(KLab_Profiling_Trace_EventRecord)), 0 };
+
+
+        _stage(&header, sizeof(header));
+
+
+        return true;
+    }
+
+
+    void StreamWriter::Close()
+    {
+        Flush();
+
+
+        std::fclose(_file);
+
+        _file = nullptr;
+
+
+        std::vector<char>().swap(_buffer);
+    }
+
+
+    void StreamWriter::WriteDefinitions(const bool shouldRewriteThreads)
+    {
+        const auto &markers = GetMarkerTable();
+        const auto &threads = GetThreadTable();
+        std::string payload;
+
+
+        // Write new markers
+        for (const uint32_t markerCount = markers.GetLength(); _writtenMarkerCount < markerCount; ++_writtenMarkerCount)
+        {
+            auto marker = markers.TryGet(_writtenMarkerCount);
+
+
+            // Stop at first unavailable marker (retrying it on next frame instead of skipping its definition)
+            if (!marker)
+            {
+                break;
+            }
+
+
+            const uint32_t scalars[] = { _writtenMarkerCount, marker->Color, marker->CategoryID };
+
+
+            payload.assign(reinterpret_cast<const char *>(scalars), sizeof(scalars));
+            _appendStrings(payload, marker->Name, marker->GroupName);
+            WriteBlock(StreamFormat::BlockType_Marker, payload.data(), payload.size());
+        }
+
+
+        // Write new (or all) threads
+        if (shouldRewriteThreads)
+        {
+            _writtenThreadCount = 0;
+        }
+
+
+        for (const uint32_t threadCount = threads.GetLength(); _writtenThreadCount < threadCount; ++_writtenThreadCount)
+        {
+            auto thread = threads.TryGet(_writtenThreadCount);
+
+
+            // Stop at first unavailable thread (likewise)
+            if (!thread)
+            {
+                break;
+            }
+
+
+            const uint32_t index[] = { _writtenThreadCount, 0 };
+
+
+            payload.assign(reinterpret_cast<const char *>(index), sizeof(index));
+            payload.append(reinterpret_cast<const char *>(&thread->ThreadID), sizeof(thread->ThreadID));
+            _appendStrings(payload, thread->GroupName, thread->Name);
+            WriteBlock(StreamFormat::BlockType_Thread, payload.data(), payload.size());
+        }
+    }
+
+
+    void StreamWriter::WriteBlock(const uint32_t type, const void *payload, const size_t payloadSize, const void *extra, const size_t extraSize)
+    {
+        const StreamFormat::BlockHeader header = { type, uint32_t(payloadSize + extraSize) };
+
+
+        _stage(&header, sizeof(header));
+        _stage(payload, payloadSize);
+        _stage(extra, extraSize);
+    }
+
+
+    void StreamWriter::Flush()
+    {
+        if (!_bufferLength)
+        {
+            return;
+        }
+
+
+        const uint64_t beginNs = Clock::GetSteadyNs();
+        const size_t   written = std::fwrite(_buffer.data(), 1, _bufferLength, _file);
+
+
+        _writeDurationNs.fetch_add((Clock::GetSteadyNs() - beginNs), std::memory_order_relaxed);
+        _bytesWritten.fetch_add(written, std::memory_order_relaxed);
+
+
+        // Keep writing on error (dropping data) to not stall capture
+        if (written != _bufferLength)
+        {
+            _didFailToWrite = true;
+        }
+
+
+        _bufferLength = 0;
+    }
+
+
+    void StreamWriter::_stage(const void *data, size_t size)
+    {
+        auto bytes = static_cast<const char *>(data);
+
+
+        while (size > 0)
+        {
+            const size_t available = (_buffer.size() - _bufferLength);
+            const size_t length    = ((size < available) ? size : available);
+
+
+            std::memcpy((_buffer.data() + _bufferLength), bytes, length);
+
+            _bufferLength += length;
+            bytes         += length;
+            size          -= length;
+
+
+            if (_bufferLength == _buffer.size())
+            {
+                Flush();
+            }
+        }
+    }
+}}}
+
+
+// --------------- //
+// STREAMING TRACE //
+// --------------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    bool StreamingTrace::IsStreaming() const
+    {
+        return _isStreaming.load(std::memory_order_acquire);
+    }
+
+
+    void StreamingTrace::Notify()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+
+
+            _isNotified = true;
+        }
+
+
+        _wakeCondition.notify_one();
+    }
+
+
+    KLab_Profiling_ErrorCode StreamingTrace::_begin(const char *path, const uint32_t frameCount, const uint32_t eventsPerFrame, const KLab_Profiling_Trace_StreamCompression compression)
+    {
+        // Open file
+        if (!_writer.Open(path))
+        {
+            return KLab_Profiling_ErrorCode_InvalidArgument;
+        }
+
+
+        // Start continuous trace
+        const uint32_t chunksPerFrame = ((eventsPerFrame + CSharpTrace::EventChunk::Capacity - 1) / CSharpTrace::EventChunk::Capacity);
+
+
+        _trace = &GetCSharpTrace();
+
+
+        if (!_trace->_enableContinuous(frameCount, eventsPerFrame))
+        {
+            _writer.Close();
+
+
+            return KLab_Profiling_ErrorCode_NotAvailable;
+        }
+
+
+        // Initialize state
+        _records.resize(chunksPerFrame * CSharpTrace::EventChunk::Capacity);
+
+        _compression = compression;
+
+        _encoder.Reset();
+
+        _isNotified      = false;
+        _isStopRequested = false;
+
+        _writtenFrameCount  = 0;
+        _overflowFrameCount = 0;
+        _rawEventBytes      = 0;
+        _encodedEventBytes  = 0;
+
+
+        // Start writer
+        _isStreaming = true;
+        _thread      = std::thread(&StreamingTrace::_run, this);
+
+
+        return KLab_Profiling_ErrorCode_NoError;
+    }
+
+
+    void StreamingTrace::_end()
+    {
+        // Seal frame currently recorded
+        _trace->_disableContinuous();
+
+
+        // Let writer drain remaining frames
+        {
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+
+
+            _isStopRequested = true;
+        }
+
+
+        _wakeCondition.notify_one();
+        _thread.join();
+
+
+        // Finish file
+        auto info = _getInfo();
+
+
+        info.IsStreaming = false;
+
+
+        _writer.WriteDefinitions(true);
+        _writer.WriteBlock(StreamFormat::BlockType_End, &info, sizeof(info));
+        _writer.Close();
+
+        _isStreaming = false;
+
+
+        // Free buffers
+        std::vector<KLab_Profiling_Trace_EventRecord>().swap(_records);
+        std::string().swap(_encoded);
+    }
+
+
+    KLab_Profiling_Trace_StreamingTraceInfo StreamingTrace::_getInfo() const
+    {
+        return
+        {
+            _writer._bytesWritten.load(std::memory_order_relaxed),
+            _writer._writeDurationNs.load(std::memory_order_relaxed),
+            _writtenFrameCount.load(std::memory_order_relaxed),
+            (_trace ? _trace->_getContinuousInfo().DroppedFrameCount : 0),
+            _overflowFrameCount.load(std::memory_order_relaxed),
+            _rawEventBytes.load(std::memory_order_relaxed),
+            _encodedEventBytes.load(std::memory_order_relaxed),
+            _writer._didFailToWrite.load(std::memory_order_relaxed),
+            _isStreaming.load(std::memory_order_relaxed)
+        };
+    }
+
+
+    void StreamingTrace::_run()
+    {
+        LowerCurrentThreadPriority();
+
+
+        for (bool isStopRequested = false; !isStopRequested;)
+        {
+            // Wait for flip (polling to pick up frames sealed while not notified)
+            {
+                std::unique_lock<std::mutex> lock(_wakeMutex);
+
+
+                _wakeCondition.wait_for(lock, std::chrono::milliseconds(100), [this]() { return (_isNotified || _isStopRequested); });
+
+                _isNotified     = false;
+                isStopRequested = _isStopRequested;
+            }
+
+
+            // Drain completed frames (all of them once stopped as trace got sealed before)
+            KLab_Profiling_Trace_FrameInfo frame;
+
+
+            while (_trace->_dequeueFrame(_records.data(), uint32_t(_records.size()), frame))
+            {
+                const size_t rawEventSize = (frame.EventCount * sizeof(KLab_Profiling_Trace_EventRecord));
+
+
+                _writer.WriteDefinitions(false);
+
+
+                if (_compression == KLab_Profiling_Trace_StreamCompression_None)
+                {
+                    _writer.WriteBlock(StreamFormat::BlockType_Frame, &frame, sizeof(frame), _records.data(), rawEventSize);
+                    _encodedEventBytes.fetch_add(rawEventSize, std::memory_order_relaxed);
+                }
+                else
+                {
+                    _encoder.Encode(_records.data(), frame.EventCount, _compression, _encoded);
+                    _writer.WriteBlock(StreamFormat::BlockType_EncodedFrame, &frame, sizeof(frame), _encoded.data(), _encoded.size());
+                    _encodedEventBytes.fetch_add(_encoded.size(), std::memory_order_relaxed);
+                }
+
+
+                _rawEventBytes.fetch_add(rawEventSize, std::memory_order_relaxed);
+
+
+                if (frame.DidRunOutOfEventMemory)
+                {
+                    _overflowFrameCount.fetch_add(1, std::memory_order_relaxed);
+                }
+
+
+                _writtenFrameCount.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+
+    StreamingTrace &GetStreamingTrace()
+    {
+        static StreamingTrace trace;
+
+
+        return trace;
+    }
+}}}
+
+
+// ----- //
+// TRACE //
+// ----- //
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginStreamingTrace(const char *path, const int32_t frameCount, const int32_t eventsPerFrame)
+{
+    return KLab_Profiling_TraceUtility_BeginCompressedStreamingTrace(path, frameCount, eventsPerFrame, KLab_Profiling_Trace_StreamCompression_None);
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_BeginCompressedStreamingTrace(const char *path, const int32_t frameCount, const int32_t eventsPerFrame, const KLab_Profiling_Trace_StreamCompression compression)
+{
+    auto &trace = KLab::Profiling::Trace::GetStreamingTrace();
+
+
+    // Validate state
+    if (trace.IsStreaming() || KLab::Profiling::Trace::GetCSharpTrace()._isEnabled() || KLab::Profiling::Trace::GetFlightRecorder().IsRecording())
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    // Validate arguments
+    if (!path || !(*path) || (frameCount < 3) || (eventsPerFrame <= 0) || (compression < KLab_Profiling_Trace_StreamCompression_None) || (compression > KLab_Profiling_Trace_StreamCompression_DeltaBlock))
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    const auto result = trace._begin(path, uint32_t(frameCount), uint32_t(eventsPerFrame), compression);
+
+
+    if (result == KLab_Profiling_ErrorCode_NoError)
+    {
+        // Dispatch events right away (instead of from next update)
+        KLab::Profiling::Plugin::UpdateMarkerDispatch();
+    }
+
+
+    return result;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_EndStreamingTrace()
+{
+    auto &trace = KLab::Profiling::Trace::GetStreamingTrace();
+
+
+    // Validate state
+    if (!trace.IsStreaming())
+    {
+        return KLab_Profiling_ErrorCode_InvalidState;
+    }
+
+
+    trace._end();
+
+
+    // Stop dispatching right away (instead of from next update)
+    KLab::Profiling::Plugin::UpdateMarkerDispatch();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetStreamingTraceInfo(KLab_Profiling_Trace_StreamingTraceInfo *info)
+{
+    // Validate arguments
+    if (!info)
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    *info = KLab::Profiling::Trace::GetStreamingTrace()._getInfo();
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
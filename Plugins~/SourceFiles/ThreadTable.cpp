@@ -0,0 +1,172 @@
+// -------------------------------------------------------------------------------------------- //
+//  Copyright (c) KLab Inc.. All rights reserved.                                               //
+//  Licensed under the MIT License. See 'LICENSE' in the project root for license information.  //
+// -------------------------------------------------------------------------------------------- //
+
+#include <KLab/Profiling/Internal.hpp>
+
+
+// ------------ //
+// THREAD TABLE //
+// ------------ //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    uint32_t ThreadTable::GetLength() const
+    {
+        const uint32_t length = _length.load(std::memory_order_acquire);
+
+
+        return ((length < ThreadContext::InvalidIndex) ? length : ThreadContext::InvalidIndex);
+    }
+
+
+    const ThreadInfo *ThreadTable::TryGet(const uint32_t index) const
+    {
+        auto thread = ((index < GetLength()) ? _threads.TryGet(index) : nullptr);
+
+
+        if (!thread)
+        {
+            return nullptr;
+        }
+
+
+        // Skip contexts not published yet
+        return thread->NamedInfo.load(std::memory_order_acquire);
+    }
+
+
+    ThreadContext &ThreadTable::CreateCurrent()
+    {
+        const uint32_t index  = _length.fetch_add(1, std::memory_order_acq_rel);
+        auto           thread = ((index < ThreadContext::InvalidIndex) ? _threads.GetOrCreate(index) : nullptr);
+
+
+        // Hand out untracked context of calling thread once ran full (dispatch drops its events)
+        if (!thread)
+        {
+            static thread_local ThreadContext untracked = {};
+
+
+            untracked.Index         = ThreadContext::InvalidIndex;
+            untracked.Info.ThreadID = Utils::GetUtils().GetThreadID();
+
+
+            return untracked;
+        }
+
+
+        std::lock_guard<std::mutex> lock(_namesMutex);
+
+
+        thread->Index          = uint16_t(index);
+        thread->Info.ThreadID  = Utils::GetUtils().GetThreadID();
+        thread->Info.GroupName = "";
+        thread->Info.Name      = "";
+
+
+        // Publish context (attaching name if Unity already announced thread)
+        auto name = _names.find(thread->Info.ThreadID);
+
+
+        thread->NamedInfo.store(((name != _names.end()) ? &name->second->Info : &thread->Info), std::memory_order_release);
+
+
+        return *thread;
+    }
+
+
+    void ThreadTable::SetName(const uint64_t threadID, const char *groupName, const char *name)
+    {
+        std::lock_guard<std::mutex> lock(_namesMutex);
+
+
+        if (!groupName)
+        {
+            groupName = "";
+        }
+        if (!name)
+        {
+            name = "";
+        }
+
+
+        // Reuse name if unchanged (Unity might announce threads repeatedly)
+        auto &storage = _names[threadID];
+
+
+        if (storage && (storage->GroupName == groupName) && (storage->Name == name))
+        {
+            return;
+        }
+
+
+        // Create name (retiring previous one without freeing it as readers might still reference its strings)
+        auto renamed = new _Name { groupName, name, ThreadInfo() };
+
+
+        renamed->Info.ThreadID  = threadID;
+        renamed->Info.GroupName = renamed->GroupName.c_str();
+        renamed->Info.Name      = renamed->Name.c_str();
+        storage                 = renamed;
+
+
+        // Attach name to already published context (contexts published later find it on their own)
+        for (uint32_t t = 0, length = GetLength(); t < length; ++t)
+        {
+            auto thread = _threads.TryGet(t);
+            auto info   = (thread ? thread->NamedInfo.load(std::memory_order_relaxed) : nullptr);
+
+
+            if (info && (info->ThreadID == threadID))
+            {
+                thread->NamedInfo.store(&renamed->Info, std::memory_order_release);
+            }
+        }
+    }
+
+
+    ThreadTable &GetThreadTable()
+    {
+        static ThreadTable table;
+
+
+        return table;
+    }
+}}}
+
+
+// ----- //
+// TRACE //
+// ----- //
+
+uint32_t KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetThreadCount()
+{
+    return KLab::Profiling::Trace::GetThreadTable().GetLength();
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_GetThreadInfo(const uint32_t threadIndex, KLab_Profiling_Trace_ThreadInfo *info)
+{
+    // Validate arguments
+    if (!info)
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    auto thread = KLab::Profiling::Trace::GetThreadTable().TryGet(threadIndex);
+
+
+    if (!thread)
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    *info = *thread;
+
+
+    return KLab_Profiling_ErrorCode_NoError;
+}
@@ -0,0 +1,721 @@
+// -------------------------------------------------------------------------------------------- //
+//  Copyright (c) KLab Inc.. All rights reserved.                                               //
+//  Licensed under the MIT License. See 'LICENSE' in the project root for license information.  //
+// -------------------------------------------------------------------------------------------- //
+
+#include <KLab/Profiling/Internal.hpp>
+
+
+// -------- //
+// INCLUDES //
+// -------- //
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    // Process ID used for all tracks
+    static constexpr uint32_t _processID = 1;
+
+
+    // Perfetto protobuf field numbers (see perfetto/trace/*.proto)
+    namespace _Perfetto
+    {
+        // Trace.packet
+        static constexpr uint32_t Trace_Packet = 1;
+        // TracePacket fields
+        static constexpr uint32_t TracePacket_Timestamp               = 8;
+        static constexpr uint32_t TracePacket_TrustedPacketSequenceID = 10;
+        static constexpr uint32_t TracePacket_TrackEvent              = 11;
+        static constexpr uint32_t TracePacket_SequenceFlags           = 13;
+        static constexpr uint32_t TracePacket_TrackDescriptor         = 60;
+        // TrackDescriptor fields
+        static constexpr uint32_t TrackDescriptor_UUID   = 1;
+        static constexpr uint32_t TrackDescriptor_Name   = 2;
+        static constexpr uint32_t TrackDescriptor_Thread = 4;
+        // ThreadDescriptor fields
+        static constexpr uint32_t ThreadDescriptor_PID        = 1;
+        static constexpr uint32_t ThreadDescriptor_TID        = 2;
+        static constexpr uint32_t ThreadDescriptor_ThreadName = 5;
+        // TrackEvent fields
+        static constexpr uint32_t TrackEvent_DebugAnnotations = 4;
+        static constexpr uint32_t TrackEvent_Type             = 9;
+        static constexpr uint32_t TrackEvent_TrackUUID        = 11;
+        static constexpr uint32_t TrackEvent_Categories       = 22;
+        static constexpr uint32_t TrackEvent_Name             = 23;
+        // DebugAnnotation fields
+        static constexpr uint32_t DebugAnnotation_StringValue = 6;
+        static constexpr uint32_t DebugAnnotation_Name        = 10;
+        // TrackEvent.Type values
+        static constexpr uint32_t TrackEventType_SliceBegin = 1;
+        static constexpr uint32_t TrackEventType_SliceEnd   = 2;
+        // TracePacket.SequenceFlags values
+        static constexpr uint32_t SequenceFlags_IncrementalStateCleared = 1;
+        // Sequence ID of all packets
+        static constexpr uint32_t SequenceID = 1;
+    }
+
+
+    // Appends varint
+    // @param out - Buffer to append to
+    // @param value - Value
+    static void _appendVarint(std::string &out, uint64_t value)
+    {
+        for (; value >= 0x80; value >>= 7)
+        {
+            out.push_back(char(uint8_t(value) | 0x80));
+        }
+
+
+        out.push_back(char(value));
+    }
+
+
+    // Appends varint field
+    // @param out - Buffer to append to
+    // @param field - Field number
+    // @param value - Value
+    static void _appendVarintField(std::string &out, const uint32_t field, const uint64_t value)
+    {
+        _appendVarint(out, (uint64_t(field) << 3));
+        _appendVarint(out, value);
+    }
+
+
+    // Appends length-delimited field
+    // @param out - Buffer to append to
+    // @param field - Field number
+    // @param data - Data
+    // @param size - Size of data in bytes
+    static void _appendBytesField(std::string &out, const uint32_t field, const char *data, const size_t size)
+    {
+        _appendVarint(out, ((uint64_t(field) << 3) | 2));
+        _appendVarint(out, size);
+
+        out.append(data, size);
+    }
+
+
+    // Appends string field
+    // @param out - Buffer to append to
+    // @param field - Field number
+    // @param string - Null-terminated string
+    static void _appendStringField(std::string &out, const uint32_t field, const char *string)
+    {
+        _appendBytesField(out, field, string, std::strlen(string));
+    }
+
+
+    // Appends JSON string literal
+    // @param out - Buffer to append to
+    // @param string - Null-terminated UTF-8 string
+    static void _appendJsonString(std::string &out, const char *string)
+    {
+        static const char hexDigits[] = "0123456789abcdef";
+
+
+        out.push_back('"');
+
+
+        for (; *string; ++string)
+        {
+            const uint8_t c = uint8_t(*string);
+
+
+            if ((c == '"') || (c == '\\'))
+            {
+                out.push_back('\\');
+                out.push_back(char(c));
+            }
+            else if (c < 0x20)
+            {
+                out.append("\\u00");
+                out.push_back(hexDigits[c >> 4]);
+                out.push_back(hexDigits[c & 0xf]);
+            }
+            else
+            {
+                out.push_back(char(c));
+            }
+        }
+
+
+        out.push_back('"');
+    }
+
+
+    // Formats RGBA color as CSS hex color
+    // @param out - Buffer (at least 8 characters)
+    // @param color - RGBA color
+    static void _formatColor(char *out, const uint32_t color)
+    {
+        std::snprintf(out, 8, "#%06x", unsigned(color >> 8));
+    }
+
+
+    // Formats thread name
+    // @param groupName - Thread group name
+    // @param name - Thread name
+    // @param threadID - C-casted thread ID (used if unnamed)
+    // @return the display name
+    static std::string _formatThreadName(const char *groupName, const char *name, const uint64_t threadID)
+    {
+        if (!(*name))
+        {
+            char fallback[32];
+
+
+            std::snprintf(fallback, sizeof(fallback), "Thread %" PRIu64, threadID);
+
+
+            return fallback;
+        }
+
+
+        return ((*groupName) ? (std::string(groupName) + ": " + name) : std::string(name));
+    }
+
+
+    // Reads exactly size bytes
+    // @param input - File to read from
+    // @param data - Buffer
+    // @param size - Number of bytes
+    // @return true on success; false on truncated input
+    static bool _read(std::FILE *input, void *data, const size_t size)
+    {
+        return (std::fread(data, 1, size, input) == size);
+    }
+}}}
+
+
+// ------------ //
+// TRACE EXPORT //
+// ------------ //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    void TraceExporter::Begin(std::FILE *file, const KLab_Profiling_Trace_ExportFormat format)
+    {
+        _file            = file;
+        _format          = format;
+        _hasWrittenEvent = false;
+
+        _buffer.clear();
+        _tracks.clear();
+
+
+        if (_format == KLab_Profiling_Trace_ExportFormat_ChromeJson)
+        {
+            _buffer.append("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+        }
+        else
+        {
+            // Start sequence without incremental state
+            _message.clear();
+
+            _appendVarintField(_message, _Perfetto::TracePacket_TrustedPacketSequenceID, _Perfetto::SequenceID);
+            _appendVarintField(_message, _Perfetto::TracePacket_SequenceFlags, _Perfetto::SequenceFlags_IncrementalStateCleared);
+            _appendBytesField(_buffer, _Perfetto::Trace_Packet, _message.data(), _message.size());
+        }
+    }
+
+
+    void TraceExporter::WriteThread(const uint64_t threadID, const char *groupName, const char *name)
+    {
+        const auto track = _tracks.emplace(threadID, uint32_t(_tracks.size())).first;
+
+
+        _writeTrack(track->second, _formatThreadName(groupName, name, threadID).c_str());
+    }
+
+
+    void TraceExporter::WriteEvent(const uint32_t type, const uint64_t timestampNs, const uint64_t threadID, const char *name, const char *groupName, const uint32_t color)
+    {
+        const uint32_t track      = _getTrack(threadID);
+        const bool     isBegin    = (type == KLab_Profiling_Trace_EventType_EnterSection);
+        char           colorHex[8];
+
+
+        _formatColor(colorHex, color);
+
+
+        if (_format == KLab_Profiling_Trace_ExportFormat_ChromeJson)
+        {
+            char scalars[96];
+
+
+            _buffer.append(_hasWrittenEvent ? ",\n{" : "\n{");
+
+            _hasWrittenEvent = true;
+
+
+            if (isBegin)
+            {
+                _buffer.append("\"name\":");
+                _appendJsonString(_buffer, name);
+                _buffer.append(",\"cat\":");
+                _appendJsonString(_buffer, groupName);
+                _buffer.append(",");
+            }
+
+
+            // Timestamps in microseconds (keeping nanosecond precision)
+            std::snprintf(scalars, sizeof(scalars), "\"ph\":\"%s\",\"ts\":%" PRIu64 ".%03u,\"pid\":%u,\"tid\":%u", (isBegin ? "B" : "E"), (timestampNs / 1000), unsigned(timestampNs % 1000), _processID, (track + 1));
+
+            _buffer.append(scalars);
+
+
+            if (isBegin)
+            {
+                _buffer.append(",\"args\":{\"color\":\"");
+                _buffer.append(colorHex);
+                _buffer.append("\"}");
+            }
+
+
+            _buffer.push_back('}');
+        }
+        else
+        {
+            std::string event;
+
+
+            _appendVarintField(event, _Perfetto::TrackEvent_Type, (isBegin ? _Perfetto::TrackEventType_SliceBegin : _Perfetto::TrackEventType_SliceEnd));
+            _appendVarintField(event, _Perfetto::TrackEvent_TrackUUID, (track + 1));
+
+
+            if (isBegin)
+            {
+                std::string annotation;
+
+
+                _appendStringField(annotation, _Perfetto::DebugAnnotation_Name, "color");
+                _appendStringField(annotation, _Perfetto::DebugAnnotation_StringValue, colorHex);
+
+                _appendStringField(event, _Perfetto::TrackEvent_Name, name);
+                _appendStringField(event, _Perfetto::TrackEvent_Categories, groupName);
+                _appendBytesField(event, _Perfetto::TrackEvent_DebugAnnotations, annotation.data(), annotation.size());
+            }
+
+
+            _message.clear();
+
+            _appendVarintField(_message, _Perfetto::TracePacket_Timestamp, timestampNs);
+            _appendVarintField(_message, _Perfetto::TracePacket_TrustedPacketSequenceID, _Perfetto::SequenceID);
+            _appendBytesField(_message, _Perfetto::TracePacket_TrackEvent, event.data(), event.size());
+            _appendBytesField(_buffer, _Perfetto::Trace_Packet, _message.data(), _message.size());
+        }
+
+
+        _flush(false);
+    }
+
+
+    bool TraceExporter::End()
+    {
+        if (_format == KLab_Profiling_Trace_ExportFormat_ChromeJson)
+        {
+            _buffer.append("\n]}\n");
+        }
+
+
+        _flush(true);
+
+
+        return (std::fflush(_file) == 0) && !std::ferror(_file);
+    }
+
+
+    uint32_t TraceExporter::_getTrack(const uint64_t threadID)
+    {
+        auto track = _tracks.find(threadID);
+
+
+        if (track != _tracks.end())
+        {
+            return track->second;
+        }
+
+
+        const uint32_t index = uint32_t(_tracks.size());
+
+
+        _tracks.emplace(threadID, index);
+        _writeTrack(index, _formatThreadName("", "", threadID).c_str());
+
+
+        return index;
+    }
+
+
+    void TraceExporter::_writeTrack(const uint32_t track, const char *name)
+    {
+        if (_format == KLab_Profiling_Trace_ExportFormat_ChromeJson)
+        {
+            char scalars[64];
+
+
+            std::snprintf(scalars, sizeof(scalars), "\"ph\":\"M\",\"pid\":%u,\"tid\":%u", _processID, (track + 1));
+
+            _buffer.append(_hasWrittenEvent ? ",\n{\"name\":\"thread_name\"," : "\n{\"name\":\"thread_name\",");
+            _buffer.append(scalars);
+            _buffer.append(",\"args\":{\"name\":");
+            _appendJsonString(_buffer, name);
+            _buffer.append("}}");
+
+            _hasWrittenEvent = true;
+        }
+        else
+        {
+            std::string thread;
+            std::string descriptor;
+
+
+            _appendVarintField(thread, _Perfetto::ThreadDescriptor_PID, _processID);
+            _appendVarintField(thread, _Perfetto::ThreadDescriptor_TID, (track + 1));
+            _appendStringField(thread, _Perfetto::ThreadDescriptor_ThreadName, name);
+
+            _appendVarintField(descriptor, _Perfetto::TrackDescriptor_UUID, (track + 1));
+            _appendStringField(descriptor, _Perfetto::TrackDescriptor_Name, name);
+            _appendBytesField(descriptor, _Perfetto::TrackDescriptor_Thread, thread.data(), thread.size());
+
+
+            _message.clear();
+
+            _appendVarintField(_message, _Perfetto::TracePacket_TrustedPacketSequenceID, _Perfetto::SequenceID);
+            _appendBytesField(_message, _Perfetto::TracePacket_TrackDescriptor, descriptor.data(), descriptor.size());
+            _appendBytesField(_buffer, _Perfetto::Trace_Packet, _message.data(), _message.size());
+        }
+
+    }
+
+
+    void TraceExporter::_flush(const bool shouldForce)
+    {
+        if (_buffer.empty() || (!shouldForce && (_buffer.size() < FlushThreshold)))
+        {
+            return;
+        }
+
+
+        std::fwrite(_buffer.data(), 1, _buffer.size(), _file);
+        _buffer.clear();
+    }
+
+
+    KLab_Profiling_ErrorCode ExportStream(std::FILE *input, std::FILE *output, const KLab_Profiling_Trace_ExportFormat format)
+    {
+        // Marker definition
+        struct Marker final
+        {
+            // Name
+            std::string Name;
+            // Group name
+            std::string GroupName;
+            // RGBA color
+            uint32_t Color;
+        };
+
+
+        // Upper bound of block size (rejecting corrupt input)
+        constexpr uint32_t maxBlockSize = (1u << 30);
+
+        StreamFormat::FileHeader                      fileHeader;
+        StreamFormat::BlockHeader                     blockHeader;
+        std::vector<char>                             payload;
+        std::vector<Marker>                           markers;
+        std::vector<uint64_t>                         threadIDs;
+        StreamDecoder                                 decoder;
+        std::vector<KLab_Profiling_Trace_EventRecord> records;
+        TraceExporter                                 exporter;
+        const Marker                                  unknownMarker = { "", "", 0 };
+
+
+        // Writes event of frame
+        auto writeEvent = [&](const KLab_Profiling_Trace_EventRecord &record)
+        {
+            const auto     &marker   = ((record.MarkerID < markers.size()) ? markers[record.MarkerID] : unknownMarker);
+            const uint64_t  threadID = ((record.ThreadIndex < threadIDs.size()) ? threadIDs[record.ThreadIndex] : ~uint64_t(0));
+
+
+            exporter.WriteEvent(record.Type, record.TimestampNs, threadID, marker.Name.c_str(), marker.GroupName.c_str(), marker.Color);
+        };
+
+
+        // Validate header
+        if (!_read(input, &fileHeader, sizeof(fileHeader)) || (fileHeader.Magic != StreamFormat::Magic) || (fileHeader.Version < StreamFormat::OldestVersion) || (fileHeader.Version > StreamFormat::Version) || (fileHeader.EventRecordSize != sizeof(KLab_Profiling_Trace_EventRecord)))
+        {
+            return KLab_Profiling_ErrorCode_InvalidArgument;
+        }
+
+
+        exporter.Begin(output, format);
+
+
+        // Convert blocks one by one
+        while (_read(input, &blockHeader, sizeof(blockHeader)))
+        {
+            if (blockHeader.Size > maxBlockSize)
+            {
+                return KLab_Profiling_ErrorCode_InvalidArgument;
+            }
+
+
+            payload.resize(size_t(blockHeader.Size) + 1);
+
+
+            if (!_read(input, payload.data(), blockHeader.Size))
+            {
+                return KLab_Profiling_ErrorCode_InvalidArgument;
+            }
+
+
+            // Guarantee strings to be terminated
+            payload[blockHeader.Size] = '\0';
+
+
+            switch (blockHeader.Type)
+            {
+                case StreamFormat::BlockType_Marker:
+                {
+                    uint32_t scalars[3];
+
+
+                    if (blockHeader.Size < sizeof(scalars))
+                    {
+                        return KLab_Profiling_ErrorCode_InvalidArgument;
+                    }
+
+
+                    std::memcpy(scalars, payload.data(), sizeof(scalars));
+
+
+                    const char *name      = (payload.data() + sizeof(scalars));
+                    const char *groupName = std::min<const char *>((name + std::strlen(name) + 1), (payload.data() + blockHeader.Size));
+
+
+                    if (scalars[0] >= markers.size())
+                    {
+                        markers.resize(scalars[0] + 1, unknownMarker);
+                    }
+
+
+                    markers[scalars[0]] = { name, groupName, scalars[1] };
+                    break;
+                }
+
+                case StreamFormat::BlockType_Thread:
+                {
+                    uint32_t index[2];
+                    uint64_t threadID;
+
+
+                    if (blockHeader.Size < (sizeof(index) + sizeof(threadID)))
+                    {
+                        return KLab_Profiling_ErrorCode_InvalidArgument;
+                    }
+
+
+                    std::memcpy(index, payload.data(), sizeof(index));
+                    std::memcpy(&threadID, (payload.data() + sizeof(index)), sizeof(threadID));
+
+
+                    const char *groupName = (payload.data() + sizeof(index) + sizeof(threadID));
+                    const char *name      = std::min<const char *>((groupName + std::strlen(groupName) + 1), (payload.data() + blockHeader.Size));
+
+
+                    if (index[0] >= threadIDs.size())
+                    {
+                        threadIDs.resize(index[0] + 1, ~uint64_t(0));
+                    }
+
+
+                    threadIDs[index[0]] = threadID;
+
+                    exporter.WriteThread(threadID, groupName, name);
+                    break;
+                }
+
+                case StreamFormat::BlockType_Frame:
+                {
+                    KLab_Profiling_Trace_FrameInfo frame;
+
+
+                    if (blockHeader.Size < sizeof(frame))
+                    {
+                        return KLab_Profiling_ErrorCode_InvalidArgument;
+                    }
+
+
+                    std::memcpy(&frame, payload.data(), sizeof(frame));
+
+
+                    if (frame.EventCount > ((blockHeader.Size - sizeof(frame)) / sizeof(KLab_Profiling_Trace_EventRecord)))
+                    {
+                        return KLab_Profiling_ErrorCode_InvalidArgument;
+                    }
+
+
+                    for (uint32_t e = 0; e < frame.EventCount; ++e)
+                    {
+                        KLab_Profiling_Trace_EventRecord record;
+
+
+                        std::memcpy(&record, (payload.data() + sizeof(frame) + (e * sizeof(record))), sizeof(record));
+
+                        writeEvent(record);
+                    }
+                    break;
+                }
+
+                case StreamFormat::BlockType_EncodedFrame:
+                {
+                    KLab_Profiling_Trace_FrameInfo frame;
+
+
+                    if (blockHeader.Size < sizeof(frame))
+                    {
+                        return KLab_Profiling_ErrorCode_InvalidArgument;
+                    }
+
+
+                    std::memcpy(&frame, payload.data(), sizeof(frame));
+
+
+                    if (!decoder.Decode((payload.data() + sizeof(frame)), (blockHeader.Size - sizeof(frame)), frame.EventCount, records))
+                    {
+                        return KLab_Profiling_ErrorCode_InvalidArgument;
+                    }
+
+
+                    for (const auto &record : records)
+                    {
+                        writeEvent(record);
+                    }
+                    break;
+                }
+
+                default:
+                {
+                    // Skip end and unknown blocks
+                    break;
+                }
+            }
+        }
+
+
+        return (exporter.End() ? KLab_Profiling_ErrorCode_NoError : KLab_Profiling_ErrorCode_NotAvailable);
+    }
+}}}
+
+
+// ----- //
+// TRACE //
+// ----- //
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_ExportEvents(const char *path, const KLab_Profiling_Trace_ExportFormat format, const KLab_Profiling_Trace_EventInfo *events, const int32_t eventCount)
+{
+    using namespace KLab::Profiling::Trace;
+
+
+    // Validate arguments
+    if (!path || !(*path) || ((format != KLab_Profiling_Trace_ExportFormat_ChromeJson) && (format != KLab_Profiling_Trace_ExportFormat_Perfetto)) || (!events && (eventCount > 0)) || (eventCount < 0))
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    auto file = std::fopen(path, "wb");
+
+
+    if (!file)
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    TraceExporter  exporter;
+    const auto    &threads = GetThreadTable();
+
+
+    exporter.Begin(file, format);
+
+
+    // Name known threads
+    for (uint32_t t = 0; t < threads.GetLength(); ++t)
+    {
+        auto thread = threads.TryGet(t);
+
+
+        if (thread && *(thread->Name))
+        {
+            exporter.WriteThread(thread->ThreadID, thread->GroupName, thread->Name);
+        }
+    }
+
+
+    for (int32_t e = 0; e < eventCount; ++e)
+    {
+        const auto &event = events[e];
+
+
+        exporter.WriteEvent(event.Type, event.TimestampNs, event.ThreadID, event.Name, event.GroupName, event.Color);
+    }
+
+
+    const bool didSucceed = exporter.End();
+
+
+    std::fclose(file);
+
+
+    return (didSucceed ? KLab_Profiling_ErrorCode_NoError : KLab_Profiling_ErrorCode_NotAvailable);
+}
+
+
+KLab_Profiling_ErrorCode KLAB_PROFILING_CSHARP_INTERFACE KLab_Profiling_TraceUtility_ExportStreamingTrace(const char *inputPath, const char *outputPath, const KLab_Profiling_Trace_ExportFormat format)
+{
+    // Validate arguments
+    if (!inputPath || !outputPath || ((format != KLab_Profiling_Trace_ExportFormat_ChromeJson) && (format != KLab_Profiling_Trace_ExportFormat_Perfetto)))
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    auto input = std::fopen(inputPath, "rb");
+
+
+    if (!input)
+    {
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    auto output = std::fopen(outputPath, "wb");
+
+
+    if (!output)
+    {
+        std::fclose(input);
+
+
+        return KLab_Profiling_ErrorCode_InvalidArgument;
+    }
+
+
+    const auto result = KLab::Profiling::Trace::ExportStream(input, output, format);
+
+
+    std::fclose(output);
+    std::fclose(input);
+
+
+    return result;
+}
@@ -10,15 +10,117 @@
 // INCLUDES //
 // -------- //
 
-#if !(KLAB_PROFILING_HAS_EXTERN_UTILS)
+#include <algorithm>
+
 #if (_WIN32)
 #include <Windows.h>
 #elif (KLAB_PROFILING_HAS_PTHREAD)
 #include <pthread.h>
 #endif
+
+#if (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define KLAB_PROFILING_HAS_SSE2 1
+#elif (defined(__aarch64__))
+#include <arm_neon.h>
+#define KLAB_PROFILING_HAS_NEON 1
 #endif
 
 
+// ------- //
+// HELPERS //
+// ------- //
+
+namespace KLab { namespace Profiling { namespace Utils
+{
+    // Converts run of 8 ASCII characters if possible
+    // @param out - Output (at least 8 bytes)
+    // @param in - Input (at least 8 characters)
+    // @return true if all characters ASCII and converted; false otherwise
+    static inline bool _tryConvertAscii8(char *out, const char16_t *in)
+    {
+        #if (KLAB_PROFILING_HAS_SSE2)
+        const __m128i characters = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+        const __m128i nonAscii   = _mm_and_si128(characters, _mm_set1_epi16(short(0xff80)));
+
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(nonAscii, _mm_setzero_si128())) != 0xffff)
+        {
+            return false;
+        }
+
+
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(out), _mm_packus_epi16(characters, characters));
+
+
+        return true;
+        #elif (KLAB_PROFILING_HAS_NEON)
+        const uint16x8_t characters = vld1q_u16(reinterpret_cast<const uint16_t *>(in));
+
+
+        if (vmaxvq_u16(characters) >= 0x80)
+        {
+            return false;
+        }
+
+
+        vst1_u8(reinterpret_cast<uint8_t *>(out), vmovn_u16(characters));
+
+
+        return true;
+        #else
+        for (uint32_t c = 0; c < 8; ++c)
+        {
+            if (in[c] >= 0x80)
+            {
+                return false;
+            }
+        }
+        for (uint32_t c = 0; c < 8; ++c)
+        {
+            out[c] = char(in[c]);
+        }
+
+
+        return true;
+        #endif
+    }
+
+    // Checks whether run of 8 characters is ASCII matching UTF-8 bytes
+    // @param utf8 - UTF-8 bytes (at least 8 bytes)
+    // @param in - Input (at least 8 characters)
+    // @return true if matching; false otherwise
+    static inline bool _matchesAscii8(const char *utf8, const char16_t *in)
+    {
+        #if (KLAB_PROFILING_HAS_SSE2)
+        const __m128i characters = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+        const __m128i expected   = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(utf8)), _mm_setzero_si128());
+        const __m128i isAscii    = _mm_cmpeq_epi16(_mm_and_si128(characters, _mm_set1_epi16(short(0xff80))), _mm_setzero_si128());
+
+
+        return (_mm_movemask_epi8(_mm_and_si128(isAscii, _mm_cmpeq_epi16(characters, expected))) == 0xffff);
+        #elif (KLAB_PROFILING_HAS_NEON)
+        const uint16x8_t characters = vld1q_u16(reinterpret_cast<const uint16_t *>(in));
+        const uint16x8_t expected   = vmovl_u8(vld1_u8(reinterpret_cast<const uint8_t *>(utf8)));
+
+
+        return ((vmaxvq_u16(characters) < 0x80) && (vminvq_u16(vceqq_u16(characters, expected)) == 0xffff));
+        #else
+        for (uint32_t c = 0; c < 8; ++c)
+        {
+            if ((in[c] >= 0x80) || (in[c] != uint8_t(utf8[c])))
+            {
+                return false;
+            }
+        }
+
+
+        return true;
+        #endif
+    }
+}}}
+
+
 // ----- //
 // UTILS //
 // ----- //
@@ -50,35 +152,230 @@ namespace KLab { namespace Profiling { namespace Utils
             utf8.CString[0] = '\0';
         }
         #else
-        // Memcopy
-        auto storage = reinterpret_cast<const char *>(utf16String);
-        auto end     = storage + (utf16Length * 2 ) + 1;
+        Utils::ConvertUtf16ToUtf8(utf8.CString, sizeof(utf8.CString), utf16String, utf16Length);
+        #endif
+
+
+        return utf8;
+    }
+
+
+    size_t ConvertUtf16ToUtf8(char *utf8String, const size_t utf8Capacity, const char16_t *utf16String, const size_t utf16Length)
+    {
+        auto out    = utf8String;
+        auto outEnd = (utf8String + utf8Capacity - 1);
+        auto in     = utf16String;
+        auto inEnd  = (utf16String + utf16Length);
 
 
-        if ((end - storage) > sizeof(utf8.CString))
+        while ((in < inEnd) && (out < outEnd))
         {
-            end = ( storage + sizeof(utf8.CString));
+            // Vectorized ASCII fast path
+            if (((inEnd - in) >= 8) && ((outEnd - out) >= 8) && _tryConvertAscii8(out, in))
+            {
+                // Stop at embedded terminator
+                auto terminator = std::find(out, (out + 8), '\0');
+
+
+                if (terminator != (out + 8))
+                {
+                    out = terminator;
+
+
+                    break;
+                }
+
+
+                in  += 8;
+                out += 8;
+
+
+                continue;
+            }
+
+
+            // Scalar path
+            uint32_t codePoint = *in++;
+
+
+            if (!codePoint)
+            {
+                break;
+            }
+
+
+            // Decode surrogate pair (replacing lone surrogates)
+            if ((codePoint >= 0xd800) && (codePoint <= 0xdfff))
+            {
+                if ((codePoint <= 0xdbff) && (in < inEnd) && (*in >= 0xdc00) && (*in <= 0xdfff))
+                {
+                    codePoint = (0x10000 + ((codePoint - 0xd800) << 10) + (uint32_t(*in++) - 0xdc00));
+                }
+                else
+                {
+                    codePoint = 0xfffd;
+                }
+            }
+
+
+            // Encode (never splitting code point on truncation)
+            const ptrdiff_t available = (outEnd - out);
+
+
+            if (codePoint < 0x80)
+            {
+                *out++ = char(codePoint);
+            }
+            else if (codePoint < 0x800)
+            {
+                if (available < 2)
+                {
+                    break;
+                }
+
+
+                *out++ = char(0xc0 | (codePoint >> 6));
+                *out++ = char(0x80 | (codePoint & 0x3f));
+            }
+            else if (codePoint < 0x10000)
+            {
+                if (available < 3)
+                {
+                    break;
+                }
+
+
+                *out++ = char(0xe0 | (codePoint >> 12));
+                *out++ = char(0x80 | ((codePoint >> 6) & 0x3f));
+                *out++ = char(0x80 | (codePoint & 0x3f));
+            }
+            else
+            {
+                if (available < 4)
+                {
+                    break;
+                }
+
+
+                *out++ = char(0xf0 | (codePoint >> 18));
+                *out++ = char(0x80 | ((codePoint >> 12) & 0x3f));
+                *out++ = char(0x80 | ((codePoint >> 6) & 0x3f));
+                *out++ = char(0x80 | (codePoint & 0x3f));
+            }
         }
 
 
-        for (size_t c = size_t(0); storage < end; ++storage, ++c)
+        *out = '\0';
+
+
+        return size_t(out - utf8String);
+    }
+
+
+    bool MatchesUtf16(const char *utf8String, const size_t utf8Length, const char16_t *utf16String, const size_t utf16Length)
+    {
+        size_t offset = 0;
+        auto   in     = utf16String;
+        auto   inEnd  = (utf16String + utf16Length);
+
+
+        while (in < inEnd)
         {
-            utf8.CString[c] = *storage;
+            // Vectorized ASCII fast path (falling back to scalar path to locate mismatch or terminator)
+            if (((inEnd - in) >= 8) && ((utf8Length - offset) >= 8) && _matchesAscii8((utf8String + offset), in))
+            {
+                in     += 8;
+                offset += 8;
+
+
+                continue;
+            }
+
+
+            // Scalar path (decoding and encoding as ::ConvertUtf16ToUtf8 does)
+            uint32_t codePoint = *in++;
+
+
+            if (!codePoint)
+            {
+                break;
+            }
+
+
+            if ((codePoint >= 0xd800) && (codePoint <= 0xdfff))
+            {
+                if ((codePoint <= 0xdbff) && (in < inEnd) && (*in >= 0xdc00) && (*in <= 0xdfff))
+                {
+                    codePoint = (0x10000 + ((codePoint - 0xd800) << 10) + (uint32_t(*in++) - 0xdc00));
+                }
+                else
+                {
+                    codePoint = 0xfffd;
+                }
+            }
+
+
+            uint8_t encoded[4];
+            size_t  encodedLength;
+
+
+            if (codePoint < 0x80)
+            {
+                encoded[0]    = uint8_t(codePoint);
+                encodedLength = 1;
+            }
+            else if (codePoint < 0x800)
+            {
+                encoded[0]    = uint8_t(0xc0 | (codePoint >> 6));
+                encoded[1]    = uint8_t(0x80 | (codePoint & 0x3f));
+                encodedLength = 2;
+            }
+            else if (codePoint < 0x10000)
+            {
+                encoded[0]    = uint8_t(0xe0 | (codePoint >> 12));
+                encoded[1]    = uint8_t(0x80 | ((codePoint >> 6) & 0x3f));
+                encoded[2]    = uint8_t(0x80 | (codePoint & 0x3f));
+                encodedLength = 3;
+            }
+            else
+            {
+                encoded[0]    = uint8_t(0xf0 | (codePoint >> 18));
+                encoded[1]    = uint8_t(0x80 | ((codePoint >> 12) & 0x3f));
+                encoded[2]    = uint8_t(0x80 | ((codePoint >> 6) & 0x3f));
+                encoded[3]    = uint8_t(0x80 | (codePoint & 0x3f));
+                encodedLength = 4;
+            }
+
+
+            if ((utf8Length - offset) < encodedLength)
+            {
+                return false;
+            }
+
+
+            for (size_t b = 0; b < encodedLength; ++b, ++offset)
+            {
+                if (uint8_t(utf8String[offset]) != encoded[b])
+                {
+                    return false;
+                }
+            }
         }
-        #endif
 
 
-        return utf8;
+        return (offset == utf8Length);
     }
 
 
     IUtils &GetUtils()
     {
         #if (KLAB_PROFILING_HAS_EXTERN_UTILS)
-        static IUtils *utils = LoadExternUtils();
+        // Pass default interface for extern interface to fall back on
+        static IUtils  defaultUtils;
+        static IUtils &utils = LoadExternUtils(defaultUtils);
 
 
-        return &utils;
+        return utils;
         #else
         static IUtils utils;
 
@@ -0,0 +1,533 @@
+// -------------------------------------------------------------------------------------------- //
+//  Copyright (c) KLab Inc.. All rights reserved.                                               //
+//  Licensed under the MIT License. See 'LICENSE' in the project root for license information.  //
+// -------------------------------------------------------------------------------------------- //
+
+#include <KLab/Profiling/Internal.hpp>
+
+
+// -------- //
+// INCLUDES //
+// -------- //
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+namespace
+{
+    namespace Format = KLab::Profiling::Trace::LiveFeedFormat;
+
+
+    // Maximum section depth tracked per thread
+    constexpr uint32_t _maxDepth = 64;
+
+
+    // Open section
+    struct _Section final
+    {
+        // Interned marker ID
+        uint32_t MarkerID;
+        // Enter timestamp in ticks
+        uint64_t BeginTicks;
+    };
+
+
+    // Read state of thread region
+    struct _Region final
+    {
+        // Sequence of next record to read
+        uint64_t ReadSequence = 0;
+        // Open sections (cleared whenever records got overwritten)
+        std::vector<_Section> Stack;
+    };
+
+
+    // Totals of marker over frame
+    struct _MarkerTotal final
+    {
+        // Number of sections left
+        uint32_t Count = 0;
+        // Total inclusive time in ticks
+        uint64_t Ticks = 0;
+    };
+
+
+    // Frame summarized until two later frames began (so late events still land in it)
+    struct _Frame final
+    {
+        // Frame index
+        uint64_t Index;
+        // Frame begin in ticks since feed begin
+        uint64_t BeginTicks;
+        // Number of events read
+        uint64_t EventCount = 0;
+        // Totals by marker ID (sections counted in frame they end in)
+        std::unordered_map<uint32_t, _MarkerTotal> Markers;
+    };
+
+
+    // Reader settings
+    struct _Settings final
+    {
+        // Name of shared memory object
+        const char *Name = nullptr;
+        // Number of frames to print before exiting (0 to print until feed ends)
+        uint64_t FrameCount = 0;
+        // Number of markers printed per frame
+        uint32_t TopCount = 3;
+        // Poll interval in milliseconds
+        uint32_t IntervalMs = 2;
+    };
+
+
+    // Prints usage
+    // @param executable - Name of executable
+    void _printUsage(const char *executable)
+    {
+        std::fprintf(stderr,
+            "Prints per-frame summaries of live feed published by profiling plugin into shared memory\n"
+            "Usage: %s <name> [--frames <count>] [--top <count>] [--interval-ms <ms>]\n"
+            "Name is the shared memory object passed to 'BeginLiveFeed' (e.g. '/klab-profiling')\n",
+            executable);
+    }
+
+
+    // Parses command line
+    // @param argc - Number of arguments
+    // @param argv - Arguments
+    // @param settings - Buffer for settings
+    // @return true on success; false otherwise
+    bool _parseArguments(int argc, char **argv, _Settings &settings)
+    {
+        if ((argc < 2) || ((argc % 2) != 0))
+        {
+            return false;
+        }
+
+
+        settings.Name = argv[1];
+
+
+        for (int a = 2; a < argc; a += 2)
+        {
+            const unsigned long long value = std::strtoull(argv[a + 1], nullptr, 10);
+
+
+            if (!std::strcmp(argv[a], "--frames"))
+            {
+                settings.FrameCount = value;
+            }
+            else if (!std::strcmp(argv[a], "--top"))
+            {
+                settings.TopCount = uint32_t(value);
+            }
+            else if (!std::strcmp(argv[a], "--interval-ms") && (value > 0))
+            {
+                settings.IntervalMs = uint32_t(value);
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+
+        return true;
+    }
+
+
+    // Maps shared memory object read-only (waiting for writer to publish)
+    // @param name - Name of shared memory object
+    // @param size - Buffer for size of mapping
+    // @return a valid pointer on success; null otherwise
+    const char *_attach(const char *name, size_t &size)
+    {
+        int file = -1;
+
+
+        // Wait for object to be created
+        for (bool didLog = false; (file = shm_open(name, O_RDONLY, 0)) < 0; didLog = true)
+        {
+            if (!didLog)
+            {
+                std::fprintf(stderr, "Waiting for live feed '%s'...\n", name);
+            }
+
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+
+
+        // Map header first to learn size (writer sizes object before publishing state)
+        struct stat status;
+
+
+        if ((fstat(file, &status) != 0) || (size_t(status.st_size) < sizeof(Format::Header)))
+        {
+            close(file);
+
+
+            return nullptr;
+        }
+
+
+        size = size_t(status.st_size);
+
+
+        void *mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, file, 0);
+
+
+        close(file);
+
+
+        if (mapping == MAP_FAILED)
+        {
+            return nullptr;
+        }
+
+
+        // Wait for header to be published
+        auto header = static_cast<const Format::Header *>(mapping);
+
+
+        while (!header->State.load(std::memory_order_acquire))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+
+        if ((header->Magic != Format::Magic) || (header->Version != Format::Version) || (header->EventRecordSize != sizeof(KLab_Profiling_Trace_EventRecord)) || (header->MappingSize != size))
+        {
+            munmap(mapping, size);
+
+
+            return nullptr;
+        }
+
+
+        return static_cast<const char *>(mapping);
+    }
+
+
+    // Gets name of marker
+    // @param mapping - Shared memory
+    // @param layout - Layout of shared memory
+    // @param markerID - Interned marker ID
+    // @param buffer - Buffer for name (used if marker not named yet)
+    // @return the name
+    const char *_getMarkerName(const char *mapping, const Format::Layout &layout, const uint32_t markerID, char (&buffer)[Format::NameSize])
+    {
+        auto header = reinterpret_cast<const Format::Header *>(mapping);
+        auto names  = reinterpret_cast<const Format::Name *>(mapping + layout.MarkerNamesOffset);
+
+
+        if (markerID < header->MarkerCount.load(std::memory_order_acquire))
+        {
+            std::memcpy(buffer, names[markerID].Text, sizeof(buffer));
+            buffer[Format::NameSize - 1] = '\0';
+        }
+        else
+        {
+            std::snprintf(buffer, sizeof(buffer), "#%u", markerID);
+        }
+
+
+        return buffer;
+    }
+
+
+    // Finds frame event belongs to
+    // @param frames - Pending frames
+    // @param ticks - Event timestamp in ticks
+    // @return a valid pointer if event within pending frames; null otherwise
+    _Frame *_findFrame(std::deque<_Frame> &frames, const uint64_t ticks)
+    {
+        for (auto f = frames.rbegin(); f != frames.rend(); ++f)
+        {
+            if (ticks >= f->BeginTicks)
+            {
+                return &*f;
+            }
+        }
+
+
+        return nullptr;
+    }
+
+
+    // Prints summary of frame
+    // @param mapping - Shared memory
+    // @param layout - Layout of shared memory
+    // @param frame - Frame to print
+    // @param endTicks - Frame end in ticks
+    // @param latestFrameIndex - Index of frame writer currently publishes
+    // @param backlog - Number of events unread at last poll
+    // @param overwrittenCount - Number of events overwritten before being read since last summary
+    // @param settings - Reader settings
+    void _printFrame(const char *mapping, const Format::Layout &layout, const _Frame &frame, const uint64_t endTicks, const uint64_t latestFrameIndex, const uint64_t backlog, const uint64_t overwrittenCount, const _Settings &settings)
+    {
+        auto         header    = reinterpret_cast<const Format::Header *>(mapping);
+        const double nsPerTick = header->NsPerTick.load(std::memory_order_relaxed);
+
+
+        // Pick markers with longest inclusive time
+        std::vector<std::pair<uint32_t, _MarkerTotal>> markers(frame.Markers.begin(), frame.Markers.end());
+        const size_t                                   topCount = std::min(markers.size(), size_t(settings.TopCount));
+
+
+        std::partial_sort(markers.begin(), (markers.begin() + topCount), markers.end(), [](const std::pair<uint32_t, _MarkerTotal> &a, const std::pair<uint32_t, _MarkerTotal> &b)
+        {
+            return (a.second.Ticks > b.second.Ticks);
+        });
+
+
+        std::printf("frame %8llu %8.2f ms %8llu events  lag %llu frames / %llu events  overwritten %llu",
+            static_cast<unsigned long long>(frame.Index),
+            (double(endTicks - frame.BeginTicks) * nsPerTick * 1e-6),
+            static_cast<unsigned long long>(frame.EventCount),
+            static_cast<unsigned long long>(latestFrameIndex - frame.Index),
+            static_cast<unsigned long long>(backlog),
+            static_cast<unsigned long long>(overwrittenCount));
+
+
+        for (size_t m = 0; m < topCount; ++m)
+        {
+            char name[Format::NameSize];
+
+
+            std::printf("%s %s %.2f ms (x%u)",
+                (m ? "," : "  |"),
+                _getMarkerName(mapping, layout, markers[m].first, name),
+                (double(markers[m].second.Ticks) * nsPerTick * 1e-6),
+                markers[m].second.Count);
+        }
+
+
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+}
+
+
+// ---- //
+// MAIN //
+// ---- //
+
+int main(int argc, char **argv)
+{
+    _Settings settings;
+
+
+    if (!_parseArguments(argc, argv, settings))
+    {
+        _printUsage(argv[0]);
+
+
+        return 1;
+    }
+
+
+    // Attach to feed
+    size_t      mappingSize = 0;
+    const char *mapping     = _attach(settings.Name, mappingSize);
+
+
+    if (!mapping)
+    {
+        std::fprintf(stderr, "Failed to attach to live feed '%s' (not a live feed or incompatible version)\n", settings.Name);
+
+
+        return 1;
+    }
+
+
+    auto           header   = reinterpret_cast<const Format::Header *>(mapping);
+    const auto     layout   = Format::GetLayout(header->RegionCount, header->RegionCapacity);
+    auto           frames   = reinterpret_cast<const Format::Frame *>(mapping + layout.FramesOffset);
+    const uint64_t capacity = header->RegionCapacity;
+    const uint64_t mask     = (capacity - 1);
+
+
+    std::fprintf(stderr, "Attached to live feed '%s' (%u regions of %u events, %.1f MB)\n",
+        settings.Name,
+        header->RegionCount,
+        header->RegionCapacity,
+        (double(mappingSize) / (1024.0 * 1024.0)));
+
+
+    // Start reading at current position (history before attaching doesn't count as overwritten)
+    std::vector<_Region> regions(header->RegionCount);
+    std::deque<_Frame>   pendingFrames;
+    uint64_t             frameSequence = (header->FrameSequence.load(std::memory_order_acquire) - 1);
+    uint64_t             printedCount  = 0;
+    uint64_t             overwritten   = 0;
+
+
+    for (uint32_t r = 0; r < header->RegionCount; ++r)
+    {
+        auto region = reinterpret_cast<const Format::RegionHeader *>(mapping + layout.RegionsOffset + (size_t(r) * layout.RegionSize));
+
+
+        regions[r].ReadSequence = region->WriteSequence.load(std::memory_order_acquire);
+    }
+
+
+    for (;;)
+    {
+        const bool hasEnded = (header->State.load(std::memory_order_acquire) == Format::State_Ended);
+
+
+        // Read new frame boundaries (skipping frames dropped out of ring)
+        const uint64_t latestFrameSequence = header->FrameSequence.load(std::memory_order_acquire);
+
+
+        if ((latestFrameSequence - frameSequence) > Format::FrameCapacity)
+        {
+            frameSequence = (latestFrameSequence - Format::FrameCapacity);
+        }
+
+
+        for (; frameSequence < latestFrameSequence; ++frameSequence)
+        {
+            const auto &frame = frames[frameSequence % Format::FrameCapacity];
+
+
+            pendingFrames.emplace_back();
+            pendingFrames.back().Index      = frame.Index;
+            pendingFrames.back().BeginTicks = frame.BeginTicks;
+        }
+
+
+        // Drain thread regions in place
+        uint64_t backlog = 0;
+
+
+        for (uint32_t r = 0; r < header->RegionCount; ++r)
+        {
+            auto           region        = reinterpret_cast<const Format::RegionHeader *>(mapping + layout.RegionsOffset + (size_t(r) * layout.RegionSize));
+            auto           records       = reinterpret_cast<const KLab_Profiling_Trace_EventRecord *>(region + 1);
+            auto          &state         = regions[r];
+            const uint64_t writeSequence = region->WriteSequence.load(std::memory_order_acquire);
+
+
+            backlog += (writeSequence - state.ReadSequence);
+
+
+            // Skip records writer lapped
+            if ((writeSequence - state.ReadSequence) > capacity)
+            {
+                overwritten        += (writeSequence - capacity - state.ReadSequence);
+                state.ReadSequence  = (writeSequence - capacity);
+                state.Stack.clear();
+            }
+
+
+            for (uint64_t s = state.ReadSequence; s < writeSequence; ++s)
+            {
+                const auto &record = records[s & mask];
+                auto        frame  = _findFrame(pendingFrames, record.TimestampNs);
+
+
+                if (frame)
+                {
+                    ++frame->EventCount;
+                }
+
+
+                if (record.Type == KLab_Profiling_Trace_EventType_EnterSection)
+                {
+                    if (state.Stack.size() < _maxDepth)
+                    {
+                        state.Stack.push_back({ record.MarkerID, record.TimestampNs });
+                    }
+                }
+                else if (record.Type == KLab_Profiling_Trace_EventType_LeaveSection)
+                {
+                    if (!state.Stack.empty() && (state.Stack.back().MarkerID == record.MarkerID))
+                    {
+                        if (frame)
+                        {
+                            auto &total = frame->Markers[record.MarkerID];
+
+
+                            total.Count += 1;
+                            total.Ticks += (record.TimestampNs - state.Stack.back().BeginTicks);
+                        }
+
+
+                        state.Stack.pop_back();
+                    }
+                }
+            }
+
+
+            // Count records writer lapped while being read (already summarized, so summaries might be off around overwrites)
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+
+            const uint64_t lappedSequence = region->WriteSequence.load(std::memory_order_relaxed);
+
+
+            if ((lappedSequence - state.ReadSequence) > capacity)
+            {
+                overwritten += (std::min(writeSequence, (lappedSequence - capacity)) - state.ReadSequence);
+                state.Stack.clear();
+            }
+
+
+            state.ReadSequence = writeSequence;
+        }
+
+
+        // Print frames two later frames began for (or all on end)
+        const uint64_t latestFrameIndex = (pendingFrames.empty() ? 0 : pendingFrames.back().Index);
+
+
+        while ((pendingFrames.size() >= 3) || (hasEnded && (pendingFrames.size() >= 2)))
+        {
+            _printFrame(mapping, layout, pendingFrames[0], pendingFrames[1].BeginTicks, latestFrameIndex, backlog, overwritten, settings);
+
+
+            pendingFrames.pop_front();
+            overwritten = 0;
+
+
+            if (settings.FrameCount && (++printedCount >= settings.FrameCount))
+            {
+                munmap(const_cast<char *>(mapping), mappingSize);
+
+
+                return 0;
+            }
+        }
+
+
+        if (hasEnded)
+        {
+            std::fprintf(stderr, "Live feed ended\n");
+
+
+            break;
+        }
+
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(settings.IntervalMs));
+    }
+
+
+    munmap(const_cast<char *>(mapping), mappingSize);
+
+
+    return 0;
+}
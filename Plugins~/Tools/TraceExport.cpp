@@ -0,0 +1,113 @@
+// -------------------------------------------------------------------------------------------- //
+//  Copyright (c) KLab Inc.. All rights reserved.                                               //
+//  Licensed under the MIT License. See 'LICENSE' in the project root for license information.  //
+// -------------------------------------------------------------------------------------------- //
+
+#include <KLab/Profiling/Internal.hpp>
+
+
+// -------- //
+// INCLUDES //
+// -------- //
+
+#include <cstring>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+namespace
+{
+    // Prints usage
+    // @param executable - Name of executable
+    void _printUsage(const char *executable)
+    {
+        std::fprintf(stderr,
+            "Converts streamed trace file (raw or compressed) to viewer format\n"
+            "Usage: %s <input.klpt> <output> [--format chrome|perfetto]\n"
+            "Format defaults to Perfetto for '.pftrace' and '.perfetto-trace' outputs and Chrome JSON otherwise\n",
+            executable);
+    }
+
+
+    // Checks whether string ends with suffix
+    // @param string - String
+    // @param suffix - Suffix
+    // @return true if string ends with suffix; false otherwise
+    bool _endsWith(const char *string, const char *suffix)
+    {
+        const size_t stringLength = std::strlen(string);
+        const size_t suffixLength = std::strlen(suffix);
+
+
+        return ((stringLength >= suffixLength) && !std::strcmp((string + stringLength - suffixLength), suffix));
+    }
+}
+
+
+// ---- //
+// MAIN //
+// ---- //
+
+int main(int argc, char **argv)
+{
+    if ((argc != 3) && (argc != 5))
+    {
+        _printUsage(argv[0]);
+
+
+        return 1;
+    }
+
+
+    // Parse format
+    const char                        *inputPath  = argv[1];
+    const char                        *outputPath = argv[2];
+    KLab_Profiling_Trace_ExportFormat  format     = ((_endsWith(outputPath, ".pftrace") || _endsWith(outputPath, ".perfetto-trace")) ? KLab_Profiling_Trace_ExportFormat_Perfetto : KLab_Profiling_Trace_ExportFormat_ChromeJson);
+
+
+    if (argc == 5)
+    {
+        if (std::strcmp(argv[3], "--format"))
+        {
+            _printUsage(argv[0]);
+
+
+            return 1;
+        }
+
+
+        if (!std::strcmp(argv[4], "chrome"))
+        {
+            format = KLab_Profiling_Trace_ExportFormat_ChromeJson;
+        }
+        else if (!std::strcmp(argv[4], "perfetto"))
+        {
+            format = KLab_Profiling_Trace_ExportFormat_Perfetto;
+        }
+        else
+        {
+            _printUsage(argv[0]);
+
+
+            return 1;
+        }
+    }
+
+
+    // Convert
+    const auto result = KLab_Profiling_TraceUtility_ExportStreamingTrace(inputPath, outputPath, format);
+
+
+    if (result != KLab_Profiling_ErrorCode_NoError)
+    {
+        std::fprintf(stderr, "[ERROR] Failed to convert '%s' (error %d)\n", inputPath, int(result));
+
+
+        return 1;
+    }
+
+
+    return 0;
+}
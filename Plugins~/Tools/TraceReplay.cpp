@@ -0,0 +1,927 @@
+// -------------------------------------------------------------------------------------------- //
+//  Copyright (c) KLab Inc.. All rights reserved.                                               //
+//  Licensed under the MIT License. See 'LICENSE' in the project root for license information.  //
+// -------------------------------------------------------------------------------------------- //
+
+#include <KLab/Profiling/Internal.hpp>
+
+
+// -------- //
+// INCLUDES //
+// -------- //
+
+#include <IUnityInterface.h>
+#include <IUnityProfilerCallbacks.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+// ------- //
+// HELPERS //
+// ------- //
+
+namespace
+{
+    using namespace KLab::Profiling;
+
+
+    // Prints usage
+    // @param executable - Name of executable
+    // @param file - [Optional] File to print to (defaults to standard error)
+    void _printUsage(const char *executable, std::FILE *file = stderr)
+    {
+        std::fprintf(file,
+            "Replays streamed trace file into plugin through mock Unity host\n"
+            "Usage: %s <input.klpt> [--speed <factor>] [--repeat <count>] [--sink <sink>]... [--json]\n"
+            "       %s --help\n"
+            "  --help    Prints this usage (also as -h)\n"
+            "  --speed   Replays with original timing sped up by factor (as fast as possible if omitted or 0)\n"
+            "  --repeat  Replays trace count times (defaults to 1)\n"
+            "  --sink    Enables sink: csharp (default), stats, extern, async-extern, or streaming:<output.klpt>\n"
+            "  --json    Prints results as JSON\n",
+            executable, executable);
+    }
+
+
+    // Marker definition
+    struct _Marker final
+    {
+        // Name
+        std::string Name;
+        // Category ID
+        uint16_t CategoryID;
+    };
+
+
+    // Events of single thread
+    struct _Thread final
+    {
+        // Events in original order
+        std::vector<KLab_Profiling_Trace_EventRecord> Events;
+        // End offsets of events by frame
+        std::vector<uint32_t> FrameEnds;
+    };
+
+
+    // Captured trace
+    struct _Trace final
+    {
+        // Markers by ID
+        std::vector<_Marker> Markers;
+        // Threads by index
+        std::vector<_Thread> Threads;
+        // Frames
+        std::vector<KLab_Profiling_Trace_FrameInfo> Frames;
+        // Total number of events
+        uint64_t EventCount;
+    };
+
+
+    // Reads bytes
+    // @param input - File to read from
+    // @param data - Buffer
+    // @param size - Number of bytes
+    // @return true on success; false otherwise
+    bool _read(std::FILE *input, void *data, const size_t size)
+    {
+        return (std::fread(data, 1, size, input) == size);
+    }
+
+
+    // Loads streamed trace file
+    // @param path - Path of file
+    // @param trace - Trace to load into
+    // @return true on success; false otherwise
+    bool _loadTrace(const char *path, _Trace &trace)
+    {
+        // Upper bound of block size (rejecting corrupt input)
+        constexpr uint32_t maxBlockSize = (1u << 30);
+
+        Trace::StreamFormat::FileHeader               fileHeader;
+        Trace::StreamFormat::BlockHeader              blockHeader;
+        std::vector<char>                             payload;
+        Trace::StreamDecoder                          decoder;
+        std::vector<KLab_Profiling_Trace_EventRecord> records;
+        auto                                          input  = std::fopen(path, "rb");
+        bool                                          result = true;
+
+
+        if (!input)
+        {
+            return false;
+        }
+
+
+        // Validate header
+        if (!_read(input, &fileHeader, sizeof(fileHeader)) || (fileHeader.Magic != Trace::StreamFormat::Magic) || (fileHeader.Version < Trace::StreamFormat::OldestVersion) || (fileHeader.Version > Trace::StreamFormat::Version) || (fileHeader.EventRecordSize != sizeof(KLab_Profiling_Trace_EventRecord)))
+        {
+            std::fclose(input);
+
+
+            return false;
+        }
+
+
+        trace.EventCount = 0;
+
+
+        // Collect markers and split frames by thread
+        while (result && _read(input, &blockHeader, sizeof(blockHeader)))
+        {
+            if (blockHeader.Size > maxBlockSize)
+            {
+                result = false;
+                break;
+            }
+
+
+            payload.resize(size_t(blockHeader.Size) + 1);
+
+
+            if (!_read(input, payload.data(), blockHeader.Size))
+            {
+                result = false;
+                break;
+            }
+
+
+            // Guarantee strings to be terminated
+            payload[blockHeader.Size] = '\0';
+
+
+            if (blockHeader.Type == Trace::StreamFormat::BlockType_Marker)
+            {
+                uint32_t scalars[3];
+
+
+                if (blockHeader.Size < sizeof(scalars))
+                {
+                    result = false;
+                    break;
+                }
+
+
+                std::memcpy(scalars, payload.data(), sizeof(scalars));
+
+
+                if (scalars[0] >= trace.Markers.size())
+                {
+                    trace.Markers.resize(scalars[0] + 1, { "Unknown", 0 });
+                }
+
+
+                trace.Markers[scalars[0]] = { (payload.data() + sizeof(scalars)), uint16_t(scalars[2]) };
+            }
+            else if ((blockHeader.Type == Trace::StreamFormat::BlockType_Frame) || (blockHeader.Type == Trace::StreamFormat::BlockType_EncodedFrame))
+            {
+                KLab_Profiling_Trace_FrameInfo frame;
+
+
+                if (blockHeader.Size < sizeof(frame))
+                {
+                    result = false;
+                    break;
+                }
+
+
+                std::memcpy(&frame, payload.data(), sizeof(frame));
+
+
+                // Decode events (encoded frames relying on previous ones and thus decoded in order)
+                if (blockHeader.Type == Trace::StreamFormat::BlockType_EncodedFrame)
+                {
+                    if (!decoder.Decode((payload.data() + sizeof(frame)), (blockHeader.Size - sizeof(frame)), frame.EventCount, records))
+                    {
+                        result = false;
+                        break;
+                    }
+                }
+                else
+                {
+                    if (frame.EventCount > ((blockHeader.Size - sizeof(frame)) / sizeof(KLab_Profiling_Trace_EventRecord)))
+                    {
+                        result = false;
+                        break;
+                    }
+
+
+                    records.resize(frame.EventCount);
+
+
+                    if (frame.EventCount)
+                    {
+                        std::memcpy(records.data(), (payload.data() + sizeof(frame)), (frame.EventCount * sizeof(KLab_Profiling_Trace_EventRecord)));
+                    }
+                }
+
+
+                for (const auto &record : records)
+                {
+                    // Add threads without events in previous frames
+                    while (record.ThreadIndex >= trace.Threads.size())
+                    {
+                        trace.Threads.emplace_back();
+                        trace.Threads.back().FrameEnds.resize(trace.Frames.size(), 0);
+                    }
+
+
+                    trace.Threads[record.ThreadIndex].Events.push_back(record);
+                }
+
+
+                trace.Frames.push_back(frame);
+                trace.EventCount += frame.EventCount;
+
+
+                for (auto &thread : trace.Threads)
+                {
+                    thread.FrameEnds.resize(trace.Frames.size(), uint32_t(thread.Events.size()));
+                }
+            }
+        }
+
+
+        std::fclose(input);
+
+
+        // Fill in markers never defined
+        for (auto &thread : trace.Threads)
+        {
+            for (const auto &event : thread.Events)
+            {
+                if (event.MarkerID >= trace.Markers.size())
+                {
+                    trace.Markers.resize(event.MarkerID + 1, { "Unknown", 0 });
+                }
+            }
+        }
+
+
+        return result;
+    }
+
+
+    // Unity host mock reporting replayed markers and capturing their event callbacks
+    struct _MockHost final
+    {
+        // Registered marker event callback
+        struct Registration final
+        {
+            // Callback
+            IUnityProfilerMarkerEventCallback Handler;
+            // User data
+            void *UserData;
+        };
+
+
+        // Interfaces
+        IUnityInterfaces Interfaces;
+        // Profiler callbacks
+        IUnityProfilerCallbacks Callbacks;
+        // Marker descriptors by marker ID
+        std::vector<UnityProfilerMarkerDesc> Markers;
+        // Registered callbacks by marker ID (only changed between frames)
+        std::vector<Registration> Registrations;
+        // Registered frame callback
+        IUnityProfilerFrameCallback FrameCallback;
+        // Registered frame callback user data
+        void *FrameUserData;
+    };
+
+    _MockHost _host;
+
+
+    // Mocks Unity interface lookup
+    IUnityInterface *UNITY_INTERFACE_API _getInterface(UnityInterfaceGUID)
+    {
+        return &_host.Callbacks;
+    }
+
+    // Mocks (un)registering category callback
+    int UNITY_INTERFACE_API _ignoreCategoryCallback(IUnityProfilerCreateCategoryCallback, void *)
+    {
+        return 0;
+    }
+
+    // Mocks (un)registering thread callback
+    int UNITY_INTERFACE_API _ignoreThreadCallback(IUnityProfilerCreateThreadCallback, void *)
+    {
+        return 0;
+    }
+
+    // Mocks registering frame callback
+    int UNITY_INTERFACE_API _registerFrameCallback(IUnityProfilerFrameCallback callback, void *userData)
+    {
+        _host.FrameCallback = callback;
+        _host.FrameUserData = userData;
+
+
+        return 0;
+    }
+
+    // Mocks unregistering frame callback
+    int UNITY_INTERFACE_API _unregisterFrameCallback(IUnityProfilerFrameCallback, void *)
+    {
+        _host.FrameCallback = nullptr;
+        _host.FrameUserData = nullptr;
+
+
+        return 0;
+    }
+
+    // Mocks registering marker creation callback (reporting all markers)
+    int UNITY_INTERFACE_API _registerCreateMarkerCallback(IUnityProfilerCreateMarkerCallback callback, void *userData)
+    {
+        for (const auto &marker : _host.Markers)
+        {
+            callback(&marker, userData);
+        }
+
+
+        return 0;
+    }
+
+    // Mocks unregistering marker creation callback
+    int UNITY_INTERFACE_API _unregisterCreateMarkerCallback(IUnityProfilerCreateMarkerCallback, void *)
+    {
+        return 0;
+    }
+
+    // Mocks registering marker event callback
+    int UNITY_INTERFACE_API _registerMarkerEventCallback(const UnityProfilerMarkerDesc *descriptor, IUnityProfilerMarkerEventCallback callback, void *userData)
+    {
+        _host.Registrations[size_t(descriptor - _host.Markers.data())] = { callback, userData };
+
+
+        return 0;
+    }
+
+    // Mocks unregistering marker event callback
+    int UNITY_INTERFACE_API _unregisterMarkerEventCallback(const UnityProfilerMarkerDesc *descriptor, IUnityProfilerMarkerEventCallback, void *)
+    {
+        _host.Registrations[size_t(descriptor - _host.Markers.data())] = { nullptr, nullptr };
+
+
+        return 0;
+    }
+
+
+    // Loads plugin into mock host
+    // @param trace - Trace providing markers
+    void _loadMockHost(const _Trace &trace)
+    {
+        _host.Interfaces.GetInterface                    = _getInterface;
+        _host.Callbacks.RegisterCreateCategoryCallback   = _ignoreCategoryCallback;
+        _host.Callbacks.UnregisterCreateCategoryCallback = _ignoreCategoryCallback;
+        _host.Callbacks.RegisterCreateThreadCallback     = _ignoreThreadCallback;
+        _host.Callbacks.UnregisterCreateThreadCallback   = _ignoreThreadCallback;
+        _host.Callbacks.RegisterCreateMarkerCallback     = _registerCreateMarkerCallback;
+        _host.Callbacks.UnregisterCreateMarkerCallback   = _unregisterCreateMarkerCallback;
+        _host.Callbacks.RegisterMarkerEventCallback      = _registerMarkerEventCallback;
+        _host.Callbacks.UnregisterMarkerEventCallback    = _unregisterMarkerEventCallback;
+        _host.Callbacks.RegisterFrameCallback            = _registerFrameCallback;
+        _host.Callbacks.UnregisterFrameCallback          = _unregisterFrameCallback;
+
+        _host.Markers.resize(trace.Markers.size(), UnityProfilerMarkerDesc());
+        _host.Registrations.resize(trace.Markers.size(), { nullptr, nullptr });
+
+
+        for (size_t m = 0; m < trace.Markers.size(); ++m)
+        {
+            _host.Markers[m].categoryId = trace.Markers[m].CategoryID;
+            _host.Markers[m].name       = trace.Markers[m].Name.c_str();
+        }
+
+
+        UnityPluginLoad(&_host.Interfaces);
+    }
+
+
+    // Stand-in extern trace (counting sections to keep calls observable)
+    struct _ReplayExternTrace final : Trace::IExternTrace
+    {
+        // Flag whether tracing
+        std::atomic<bool> IsEnabled = { false };
+
+        bool IsTracing() override
+        {
+            return IsEnabled.load(std::memory_order_relaxed);
+        }
+
+        void EnterSection(const Trace::SectionInfo &) override
+        {
+            ++_sectionCount;
+        }
+
+        void LeaveSection(const Trace::SectionInfo &) override
+        {
+            --_sectionCount;
+        }
+
+        // Open section count of calling thread
+        static thread_local uint64_t _sectionCount;
+    };
+
+    thread_local uint64_t _ReplayExternTrace::_sectionCount = 0;
+
+    _ReplayExternTrace _externTrace;
+
+
+    // Barrier replay threads meet at per frame
+    struct _FrameBarrier final
+    {
+        // Guard
+        std::mutex Mutex;
+        // Signal
+        std::condition_variable Condition;
+        // Number of threads done with current frame
+        uint32_t DoneCount = 0;
+        // Frame threads may replay (incremented by driver)
+        uint64_t Frame = 0;
+        // Flag whether replay is over
+        bool IsOver = false;
+    };
+
+
+    // Waits until steady time is reached (sleeping for long waits and spinning for short ones)
+    // @param targetNs - Steady time in nanoseconds
+    void _waitUntil(const uint64_t targetNs)
+    {
+        for (uint64_t nowNs = Clock::GetSteadyNs(); nowNs < targetNs; nowNs = Clock::GetSteadyNs())
+        {
+            if ((targetNs - nowNs) > 1000000)
+            {
+                std::this_thread::sleep_for(std::chrono::nanoseconds(targetNs - nowNs - 500000));
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+
+    // Replay settings
+    struct _Settings final
+    {
+        // Speed-up factor of original timing (0 for replaying as fast as possible)
+        double Speed = 0;
+        // Number of times to replay trace
+        uint32_t RepeatCount = 1;
+        // Sinks as ::Plugin::Sink flags
+        uint32_t Sinks = 0;
+        // [Optional] Path of streamed trace file
+        const char *StreamingPath = nullptr;
+        // Flag whether to print JSON
+        bool IsJson = false;
+    };
+
+
+    // Replays events of single thread frame by frame
+    // @param trace - Trace
+    // @param thread - Events of thread
+    // @param settings - Replay settings
+    // @param barrier - Frame barrier
+    // @param beginNs - Steady time replay began at
+    void _replayThread(const _Trace &trace, const _Thread &thread, const _Settings &settings, _FrameBarrier &barrier, const uint64_t &beginNs)
+    {
+        const uint32_t frameCount = uint32_t(trace.Frames.size());
+
+
+        for (uint64_t frame = 0;; ++frame)
+        {
+            // Wait for frame
+            {
+                std::unique_lock<std::mutex> lock(barrier.Mutex);
+
+
+                barrier.Condition.wait(lock, [&barrier, frame]() { return ((barrier.Frame > frame) || barrier.IsOver); });
+
+
+                if (barrier.IsOver)
+                {
+                    return;
+                }
+            }
+
+
+            // Replay events (offsetting timestamps of repeated passes by duration of trace)
+            const uint32_t f       = uint32_t(frame % frameCount);
+            const uint64_t firstNs = trace.Frames.front().BeginNs;
+            const uint64_t passNs  = ((frame / frameCount) * (trace.Frames.back().BeginNs + trace.Frames.back().DurationNs - firstNs));
+            const uint32_t begin   = (f ? thread.FrameEnds[f - 1] : 0);
+            const uint32_t end     = thread.FrameEnds[f];
+
+
+            for (uint32_t e = begin; e < end; ++e)
+            {
+                const auto &event        = thread.Events[e];
+                const auto &registration = _host.Registrations[event.MarkerID];
+
+
+                if (settings.Speed > 0)
+                {
+                    _waitUntil(beginNs + uint64_t(double(passNs + event.TimestampNs - std::min(firstNs, event.TimestampNs)) / settings.Speed));
+                }
+
+
+                if (registration.Handler)
+                {
+                    registration.Handler(&_host.Markers[event.MarkerID], UnityProfilerMarkerEventType(event.Type), 0, nullptr, registration.UserData);
+                }
+            }
+
+
+            // Report frame done
+            {
+                std::lock_guard<std::mutex> lock(barrier.Mutex);
+
+
+                ++barrier.DoneCount;
+            }
+
+
+            barrier.Condition.notify_all();
+        }
+    }
+
+
+    // Enables sinks
+    // @param settings - Replay settings
+    // @param eventsPerFrame - Event capacity of each frame buffer
+    // @return ::KLab_Profiling_ErrorCode_NoError on success; an error code otherwise
+    KLab_Profiling_ErrorCode _beginSinks(const _Settings &settings, const uint32_t eventsPerFrame)
+    {
+        KLab_Profiling_ErrorCode result = KLab_Profiling_ErrorCode_NoError;
+
+
+        if (settings.Sinks & Plugin::Sink_CSharp)
+        {
+            result = (settings.StreamingPath
+                ? KLab_Profiling_TraceUtility_BeginStreamingTrace(settings.StreamingPath, 8, int32_t(eventsPerFrame))
+                : KLab_Profiling_TraceUtility_BeginContinuousTrace(8, int32_t(eventsPerFrame)));
+        }
+        if ((result == KLab_Profiling_ErrorCode_NoError) && (settings.Sinks & Plugin::Sink_Stats))
+        {
+            result = KLab_Profiling_TraceUtility_BeginStatsTrace();
+        }
+        if ((result == KLab_Profiling_ErrorCode_NoError) && (settings.Sinks & Plugin::Sink_AsyncExtern))
+        {
+            result = KLab_Profiling_TraceUtility_BeginAsyncExternTrace(KLab_Profiling_Trace_BackpressurePolicy_Drop, 0);
+        }
+
+
+        _externTrace.IsEnabled = ((settings.Sinks & (Plugin::Sink_Extern | Plugin::Sink_AsyncExtern)) != 0);
+
+
+        // Swap to dispatch of sinks (picking up extern trace)
+        KLab_Profiling_Plugin_Update();
+
+
+        return result;
+    }
+
+
+    // Replays trace
+    // @param trace - Trace
+    // @param settings - Replay settings
+    // @return 0 on success; 1 otherwise
+    int _replay(const _Trace &trace, const _Settings &settings)
+    {
+        // Size frame buffers by busiest frame (plus partially filled chunk per thread)
+        uint32_t maxEventsPerFrame = 1;
+
+
+        for (const auto &frame : trace.Frames)
+        {
+            maxEventsPerFrame = std::max(maxEventsPerFrame, frame.EventCount);
+        }
+
+
+        maxEventsPerFrame += (uint32_t(trace.Threads.size()) * Trace::EventChunk::Capacity);
+
+
+        _loadMockHost(trace);
+
+
+        const auto result = _beginSinks(settings, maxEventsPerFrame);
+
+
+        if (result != KLab_Profiling_ErrorCode_NoError)
+        {
+            std::fprintf(stderr, "[ERROR] Failed to enable sinks (error %d)\n", int(result));
+
+
+            UnityPluginUnload();
+
+
+            return 1;
+        }
+
+
+        // Start replay threads (one per captured thread)
+        std::vector<KLab_Profiling_Trace_EventRecord> records(maxEventsPerFrame);
+        std::vector<std::thread>                      threads;
+        _FrameBarrier                                 barrier;
+        uint64_t                                      beginNs         = Clock::GetSteadyNs();
+        uint64_t                                      maxFlipNs       = 0;
+        uint64_t                                      dequeuedEvents  = 0;
+        const uint64_t                                totalFrameCount = (uint64_t(trace.Frames.size()) * settings.RepeatCount);
+
+
+        for (const auto &thread : trace.Threads)
+        {
+            threads.emplace_back(_replayThread, std::cref(trace), std::cref(thread), std::cref(settings), std::ref(barrier), std::cref(beginNs));
+        }
+
+
+        beginNs = Clock::GetSteadyNs();
+
+
+        // Drive frames
+        for (uint64_t frame = 0; frame < totalFrameCount; ++frame)
+        {
+            {
+                std::unique_lock<std::mutex> lock(barrier.Mutex);
+
+
+                barrier.DoneCount = 0;
+                barrier.Frame     = (frame + 1);
+            }
+
+
+            barrier.Condition.notify_all();
+
+
+            {
+                std::unique_lock<std::mutex> lock(barrier.Mutex);
+
+
+                barrier.Condition.wait(lock, [&barrier, &threads]() { return (barrier.DoneCount == threads.size()); });
+            }
+
+
+            // Flip frame at frame edge the way Unity does (and drain continuous trace the way C# would)
+            const uint64_t flipBeginNs = Clock::GetSteadyNs();
+
+
+            _host.FrameCallback(_host.FrameUserData);
+
+
+            if ((settings.Sinks & Plugin::Sink_CSharp) && !settings.StreamingPath)
+            {
+                KLab_Profiling_Trace_FrameInfo info;
+
+
+                while (KLab_Profiling_TraceUtility_DequeueFrame(records.data(), int32_t(records.size()), &info) == KLab_Profiling_ErrorCode_NoError)
+                {
+                    dequeuedEvents += info.EventCount;
+                }
+            }
+
+
+            maxFlipNs = std::max(maxFlipNs, (Clock::GetSteadyNs() - flipBeginNs));
+        }
+
+
+        const uint64_t wallNs = (Clock::GetSteadyNs() - beginNs);
+
+
+        // Stop replay threads
+        {
+            std::lock_guard<std::mutex> lock(barrier.Mutex);
+
+
+            barrier.IsOver = true;
+        }
+
+
+        barrier.Condition.notify_all();
+
+
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+
+        // Collect sink info before ending sinks
+        KLab_Profiling_Trace_ContinuousTraceInfo  continuousInfo = {};
+        KLab_Profiling_Trace_StreamingTraceInfo   streamingInfo  = {};
+        KLab_Profiling_Trace_AsyncExternTraceInfo asyncInfo      = {};
+
+
+        KLab_Profiling_TraceUtility_GetContinuousTraceInfo(&continuousInfo);
+
+
+        if (settings.StreamingPath)
+        {
+            KLab_Profiling_TraceUtility_EndStreamingTrace();
+            KLab_Profiling_TraceUtility_GetStreamingTraceInfo(&streamingInfo);
+        }
+        else if (settings.Sinks & Plugin::Sink_CSharp)
+        {
+            KLab_Profiling_TraceUtility_EndContinuousTrace();
+        }
+        if (settings.Sinks & Plugin::Sink_Stats)
+        {
+            KLab_Profiling_TraceUtility_EndStatsTrace();
+        }
+        if (settings.Sinks & Plugin::Sink_AsyncExtern)
+        {
+            KLab_Profiling_TraceUtility_EndAsyncExternTrace();
+            KLab_Profiling_TraceUtility_GetAsyncExternTraceInfo(&asyncInfo);
+        }
+
+
+        _externTrace.IsEnabled = false;
+
+
+        UnityPluginUnload();
+
+
+        // Report
+        const uint64_t eventCount = (trace.EventCount * settings.RepeatCount);
+        const double   nsPerEvent = (eventCount ? (double(wallNs) / double(eventCount)) : 0.0);
+
+
+        if (settings.IsJson)
+        {
+            std::printf("{\n  \"threads\": %u,\n  \"frames\": %llu,\n  \"events\": %llu,\n  \"speed\": %.3f,\n  \"wallNs\": %llu,\n  \"nsPerEvent\": %.3f,\n  \"eventsPerSecond\": %.0f,\n  \"maxFlipNs\": %llu,\n",
+                uint32_t(threads.size()), (unsigned long long)totalFrameCount, (unsigned long long)eventCount, settings.Speed, (unsigned long long)wallNs, nsPerEvent, (nsPerEvent ? (1e9 / nsPerEvent) : 0.0), (unsigned long long)maxFlipNs);
+            std::printf("  \"droppedFrames\": %llu,\n  \"dequeuedEvents\": %llu,\n  \"streamedFrames\": %llu,\n  \"streamedBytes\": %llu,\n  \"overflowedFrames\": %llu,\n  \"asyncDeliveredEvents\": %llu,\n  \"asyncDroppedEvents\": %llu\n}\n",
+                (unsigned long long)(settings.StreamingPath ? streamingInfo.DroppedFrameCount : continuousInfo.DroppedFrameCount), (unsigned long long)dequeuedEvents,
+                (unsigned long long)streamingInfo.WrittenFrameCount, (unsigned long long)streamingInfo.BytesWritten, (unsigned long long)streamingInfo.OverflowFrameCount,
+                (unsigned long long)asyncInfo.DeliveredEventCount, (unsigned long long)asyncInfo.DroppedEventCount);
+        }
+        else
+        {
+            std::printf("%-24s %u\n", "Threads", uint32_t(threads.size()));
+            std::printf("%-24s %llu\n", "Frames", (unsigned long long)totalFrameCount);
+            std::printf("%-24s %llu\n", "Events", (unsigned long long)eventCount);
+            std::printf("%-24s %.3f\n", "Wall time [ms]", (double(wallNs) / 1e6));
+            std::printf("%-24s %.2f\n", "Cost [ns/event]", nsPerEvent);
+            std::printf("%-24s %.0f\n", "Throughput [events/s]", (nsPerEvent ? (1e9 / nsPerEvent) : 0.0));
+            std::printf("%-24s %.3f\n", "Longest flip [ms]", (double(maxFlipNs) / 1e6));
+
+
+            if (settings.Sinks & Plugin::Sink_CSharp)
+            {
+                std::printf("%-24s %llu\n", "Dropped frames", (unsigned long long)(settings.StreamingPath ? streamingInfo.DroppedFrameCount : continuousInfo.DroppedFrameCount));
+            }
+            if ((settings.Sinks & Plugin::Sink_CSharp) && !settings.StreamingPath)
+            {
+                std::printf("%-24s %llu\n", "Dequeued events", (unsigned long long)dequeuedEvents);
+            }
+            if (settings.StreamingPath)
+            {
+                std::printf("%-24s %llu\n", "Streamed frames", (unsigned long long)streamingInfo.WrittenFrameCount);
+                std::printf("%-24s %llu\n", "Streamed bytes", (unsigned long long)streamingInfo.BytesWritten);
+                std::printf("%-24s %llu\n", "Overflowed frames", (unsigned long long)streamingInfo.OverflowFrameCount);
+            }
+            if (settings.Sinks & Plugin::Sink_AsyncExtern)
+            {
+                std::printf("%-24s %llu\n", "Delivered extern events", (unsigned long long)asyncInfo.DeliveredEventCount);
+                std::printf("%-24s %llu\n", "Dropped extern events", (unsigned long long)asyncInfo.DroppedEventCount);
+            }
+        }
+
+
+        return 0;
+    }
+}
+
+
+// ------------ //
+// EXTERN TRACE //
+// ------------ //
+
+namespace KLab { namespace Profiling { namespace Trace
+{
+    IExternTrace &LoadExternTrace()
+    {
+        return _externTrace;
+    }
+}}}
+
+
+// ---- //
+// MAIN //
+// ---- //
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        _printUsage(argv[0]);
+
+
+        return 1;
+    }
+
+
+    // Print usage on request (before treating first argument as input)
+    for (int a = 1; a < argc; ++a)
+    {
+        if (!std::strcmp(argv[a], "--help") || !std::strcmp(argv[a], "-h"))
+        {
+            _printUsage(argv[0], stdout);
+
+
+            return 0;
+        }
+    }
+
+
+    // Parse arguments
+    _Settings settings;
+
+
+    for (int a = 2; a < argc; ++a)
+    {
+        const bool hasValue = ((a + 1) < argc);
+
+
+        if (!std::strcmp(argv[a], "--speed") && hasValue)
+        {
+            settings.Speed = std::atof(argv[++a]);
+        }
+        else if (!std::strcmp(argv[a], "--repeat") && hasValue)
+        {
+            settings.RepeatCount = uint32_t(std::max(1, std::atoi(argv[++a])));
+        }
+        else if (!std::strcmp(argv[a], "--json"))
+        {
+            settings.IsJson = true;
+        }
+        else if (!std::strcmp(argv[a], "--sink") && hasValue)
+        {
+            const char *sink = argv[++a];
+
+
+            if (!std::strcmp(sink, "csharp"))
+            {
+                settings.Sinks |= Plugin::Sink_CSharp;
+            }
+            else if (!std::strcmp(sink, "stats"))
+            {
+                settings.Sinks |= Plugin::Sink_Stats;
+            }
+            else if (!std::strcmp(sink, "extern"))
+            {
+                settings.Sinks |= Plugin::Sink_Extern;
+            }
+            else if (!std::strcmp(sink, "async-extern"))
+            {
+                settings.Sinks |= Plugin::Sink_AsyncExtern;
+            }
+            else if (!std::strncmp(sink, "streaming:", 10) && sink[10])
+            {
+                settings.Sinks         |= Plugin::Sink_CSharp;
+                settings.StreamingPath  = (sink + 10);
+            }
+            else
+            {
+                _printUsage(argv[0]);
+
+
+                return 1;
+            }
+        }
+        else
+        {
+            _printUsage(argv[0]);
+
+
+            return 1;
+        }
+    }
+
+
+    if (!settings.Sinks)
+    {
+        settings.Sinks = Plugin::Sink_CSharp;
+    }
+
+
+    // Load trace
+    _Trace trace;
+
+
+    if (!_loadTrace(argv[1], trace) || trace.Frames.empty())
+    {
+        std::fprintf(stderr, "[ERROR] Failed to load '%s'\n", argv[1]);
+
+
+        return 1;
+    }
+
+
+    return _replay(trace, settings);
+}
@@ -5,6 +5,7 @@
 
 using System;
 using System.Runtime.InteropServices;
+using System.Text;
 
 
 namespace KLab.Profiling.LowLevel
@@ -24,7 +25,85 @@ namespace KLab.Profiling.LowLevel
             /// <summary>
             /// Leave section event
             /// </summary>
-            LeaveSection = 1
+            LeaveSection = 1,
+
+            /// <summary>
+            /// Metadata of section entered last by same thread (<see cref="EventRecord.MarkerID"/> holding byte offset of <see cref="MetadataHeader"/> in metadata buffer)
+            /// </summary>
+            Metadata = 2
+        }
+
+
+        /// <summary>
+        /// Policy applied by asynchronous extern trace once queue of thread is full
+        /// </summary>
+        public enum BackpressurePolicy : int
+        {
+            /// <summary>
+            /// Drop events right away
+            /// </summary>
+            Drop = 0,
+
+            /// <summary>
+            /// Wait for consumer up to timeout before dropping events (stalling thread emitting marker, e.g. Unity main thread)
+            /// </summary>
+            Block = 1
+        }
+
+
+        /// <summary>
+        /// Trace export format
+        /// </summary>
+        public enum ExportFormat : int
+        {
+            /// <summary>
+            /// Chrome Trace Event JSON
+            /// </summary>
+            ChromeJson = 0,
+
+            /// <summary>
+            /// Perfetto protobuf trace
+            /// </summary>
+            Perfetto = 1
+        }
+
+
+        /// <summary>
+        /// Compression of frames streamed to trace file
+        /// </summary>
+        public enum StreamCompression : int
+        {
+            /// <summary>
+            /// Raw event records
+            /// </summary>
+            None = 0,
+
+            /// <summary>
+            /// Timestamps delta-encoded per thread and IDs varint-encoded
+            /// </summary>
+            Delta = 1,
+
+            /// <summary>
+            /// Delta encoding followed by LZ block compression of call structure against previous frame
+            /// </summary>
+            DeltaBlock = 2
+        }
+
+
+        /// <summary>
+        /// Scope of call tree
+        /// </summary>
+        public enum CallTreeScope : int
+        {
+            /// <summary>
+            /// Last merged frame
+            /// </summary>
+            Frame = 0,
+
+            /// <summary>
+            /// All frames merged since trace begin or window reset
+            /// </summary>
+            Window = 1
         }
 
 
@@ -67,87 +146,2165 @@ namespace KLab.Profiling.LowLevel
 
 
         /// <summary>
-        /// Info on trace frame flip
+        /// Compact trace event record
         /// </summary>
         [StructLayout(LayoutKind.Sequential)]
-        public struct TraceInfo
+        public struct EventRecord
         {
             /// <summary>
-            /// Duration of traced frame in nanoseconds 
+            /// Interned marker ID (see <see cref="TraceUtility.GetMarkerInfo"/>)
+            /// </summary>
+            public uint MarkerID;
+
+            /// <summary>
+            /// Dense thread index (see <see cref="TraceUtility.GetThreadInfo"/>)
+            /// </summary>
+            public ushort ThreadIndex;
+
+            /// <summary>
+            /// Event type
+            /// </summary>
+            public ushort Type;
+
+            /// <summary>
+            /// Offset since trace begin in nanoseconds
+            /// </summary>
+            public ulong TimestampNs;
+        }
+
+
+        /// <summary>
+        /// Trace span record (single record per section emitted once section is left)
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct SpanRecord
+        {
+            /// <summary>
+            /// Interned marker ID (see <see cref="TraceUtility.GetMarkerInfo"/>)
+            /// </summary>
+            public uint MarkerID;
+
+            /// <summary>
+            /// Dense thread index (see <see cref="TraceUtility.GetThreadInfo"/>)
+            /// </summary>
+            public ushort ThreadIndex;
+
+            /// <summary>
+            /// Nesting depth on thread (0 for outermost sections)
+            /// </summary>
+            public ushort Depth;
+
+            /// <summary>
+            /// Offset of section enter since trace begin in nanoseconds
+            /// </summary>
+            public ulong BeginNs;
+
+            /// <summary>
+            /// Duration of section in nanoseconds
             /// </summary>
             public ulong DurationNs;
+        }
+
 
+        /// <summary>
+        /// Header of metadata captured on section enter (followed by <see cref="MetadataEntry"/>s, each padded to 4 bytes)
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct MetadataHeader
+        {
             /// <summary>
-            /// Number of trace events
+            /// Size of metadata including header in bytes
             /// </summary>
-            public uint EventCount;
+            public uint Size;
 
             /// <summary>
-            /// Flag whether event buffer ran out of memory
+            /// Number of entries
             /// </summary>
-            public uint DidRunOutOfEventMemory;
+            public uint EntryCount;
         }
-    }
 
 
-    /// <summary>
-    /// Utilities for C# callback-driven tracing
-    /// </summary>
-    public static class TraceUtility
-    {
         /// <summary>
-        /// C functions
+        /// Header of metadata entry (followed by data)
         /// </summary>
-        private static class C
+        [StructLayout(LayoutKind.Sequential)]
+        public struct MetadataEntry
         {
-            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_BeginTrace")]
-            public static extern ErrorCode BeginTrace(IntPtr eventBufferFrame, int eventBufferCapacity);
+            /// <summary>
+            /// Maximum size of data in bytes (longer data gets truncated)
+            /// </summary>
+            public const int MaxSize = 1024;
 
 
-            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_EndTrace")]
-            public static extern ErrorCode EndTrace(ref Trace.TraceInfo info);
+            /// <summary>
+            /// Unity data type ('Unity.Profiling.LowLevel.ProfilerMarkerDataType')
+            /// </summary>
+            public ushort Type;
+
+            /// <summary>
+            /// Size of data in bytes
+            /// </summary>
+            public ushort Size;
         }
 
 
         /// <summary>
-        /// Begins tracing
+        /// Info on interned marker
         /// </summary>
-        /// <param name="eventBuffer"><see cref="TraceEventInfo"/> array buffer</param>
-        /// <param name="eventBufferCapacity">Capacity of buffer for <see cref="TraceEventInfo"/></param>
-        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
-        public static ErrorCode BeginTrace(IntPtr eventBuffer, int eventBufferCapacity)
+        [StructLayout(LayoutKind.Sequential)]
+        public struct MarkerInfo
         {
-            // Validate availability
-            if (!PluginInfo.IsPluginAvailable)
+            /// <summary>
+            /// Marker name as null-terminated UTF-8 string
+            /// </summary>
+            public IntPtr Name;
+
+            /// <summary>
+            /// Group name as null-terminated UTF-8 string
+            /// </summary>
+            public IntPtr GroupName;
+
+            /// <summary>
+            /// RGBA marker color
+            /// </summary>
+            public uint Color;
+
+            /// <summary>
+            /// Unity category ID
+            /// </summary>
+            public uint CategoryID;
+
+
+            /// <summary>
+            /// Gets marker name
+            /// </summary>
+            /// <returns>The marker name</returns>
+            public string GetName()
             {
-                return ErrorCode.NotAvailable;
+                return TraceUtility.PtrToStringUtf8(Name);
             }
 
-            
-            // Validate arguments
-            if ((eventBuffer == IntPtr.Zero) || (eventBufferCapacity <= 0))
+            /// <summary>
+            /// Gets group name
+            /// </summary>
+            /// <returns>The group name</returns>
+            public string GetGroupName()
             {
-                return ErrorCode.InvalidArgument;
+                return TraceUtility.PtrToStringUtf8(GroupName);
             }
+        }
 
 
-            return C.BeginTrace(eventBuffer, eventBufferCapacity);
+        /// <summary>
+        /// Info on traced thread
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct ThreadInfo
+        {
+            /// <summary>
+            /// C-casted thread ID
+            /// </summary>
+            public ulong ThreadID;
+
+            /// <summary>
+            /// Thread group name as null-terminated UTF-8 string (empty if unknown)
+            /// </summary>
+            public IntPtr GroupName;
+
+            /// <summary>
+            /// Thread name as null-terminated UTF-8 string (empty if unknown)
+            /// </summary>
+            public IntPtr Name;
+
+
+            /// <summary>
+            /// Gets thread group name
+            /// </summary>
+            /// <returns>The group name (e.g. "Job")</returns>
+            public string GetGroupName()
+            {
+                return TraceUtility.PtrToStringUtf8(GroupName);
+            }
+
+            /// <summary>
+            /// Gets thread name
+            /// </summary>
+            /// <returns>The thread name (e.g. "Worker 3")</returns>
+            public string GetName()
+            {
+                return TraceUtility.PtrToStringUtf8(Name);
+            }
         }
 
 
         /// <summary>
-        /// Ends tracing
+        /// Info on frame of continuous trace
         /// </summary>
-        public static ErrorCode EndTrace(ref Trace.TraceInfo info)
+        [StructLayout(LayoutKind.Sequential)]
+        public struct FrameInfo
         {
-            // Validate availability
-            if (!PluginInfo.IsPluginAvailable)
+            /// <summary>
+            /// Index of frame since trace begin
+            /// </summary>
+            public ulong FrameIndex;
+
+            /// <summary>
+            /// Offset of frame begin since trace begin in nanoseconds
+            /// </summary>
+            public ulong BeginNs;
+
+            /// <summary>
+            /// Duration of frame in nanoseconds
+            /// </summary>
+            public ulong DurationNs;
+
+            /// <summary>
+            /// Number of trace event records
+            /// </summary>
+            public uint EventCount;
+
+            /// <summary>
+            /// Flag whether frame buffer or output buffer ran out of memory
+            /// </summary>
+            public uint DidRunOutOfEventMemory;
+        }
+
+
+        /// <summary>
+        /// Info on continuous trace
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct ContinuousTraceInfo
+        {
+            /// <summary>
+            /// Number of frames recorded since trace begin
+            /// </summary>
+            public ulong RecordedFrameCount;
+
+            /// <summary>
+            /// Number of frames overwritten before being dequeued
+            /// </summary>
+            public ulong DroppedFrameCount;
+
+            /// <summary>
+            /// Number of completed frames waiting to be dequeued
+            /// </summary>
+            public uint PendingFrameCount;
+
+            /// <summary>
+            /// Flag whether continuous trace is running
+            /// </summary>
+            public uint IsTracing;
+        }
+
+
+        /// <summary>
+        /// Info on streaming trace
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct StreamingTraceInfo
+        {
+            /// <summary>
+            /// Number of bytes written to trace file
+            /// </summary>
+            public ulong BytesWritten;
+
+            /// <summary>
+            /// Time spent writing to trace file in nanoseconds
+            /// </summary>
+            public ulong WriteDurationNs;
+
+            /// <summary>
+            /// Number of frames written
+            /// </summary>
+            public ulong WrittenFrameCount;
+
+            /// <summary>
+            /// Number of frames overwritten before being written
+            /// </summary>
+            public ulong DroppedFrameCount;
+
+            /// <summary>
+            /// Number of frames that ran out of event chunks
+            /// </summary>
+            public ulong OverflowFrameCount;
+
+            /// <summary>
+            /// Number of event bytes of written frames before compression
+            /// </summary>
+            public ulong RawEventBytes;
+
+            /// <summary>
+            /// Number of event bytes of written frames after compression
+            /// </summary>
+            public ulong EncodedEventBytes;
+
+            /// <summary>
+            /// Flag whether writing to trace file failed
+            /// </summary>
+            public uint DidFailToWrite;
+
+            /// <summary>
+            /// Flag whether streaming trace is running
+            /// </summary>
+            public uint IsStreaming;
+
+
+            /// <summary>
+            /// Gets disk throughput
+            /// </summary>
+            /// <returns>The number of bytes written per second spent writing</returns>
+            public double GetBytesPerSecond()
             {
-                return ErrorCode.NotAvailable;
+                return ((WriteDurationNs > 0) ? ((BytesWritten * 1e9) / WriteDurationNs) : 0.0);
             }
 
 
-            return C.EndTrace(ref info);
+            /// <summary>
+            /// Gets compression ratio of events
+            /// </summary>
+            /// <returns>The ratio of raw to encoded event bytes</returns>
+            public double GetCompressionRatio()
+            {
+                return ((EncodedEventBytes > 0) ? ((double)RawEventBytes / EncodedEventBytes) : 1.0);
+            }
+        }
+
+
+        /// <summary>
+        /// Info on live feed
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct LiveFeedInfo
+        {
+            /// <summary>
+            /// Number of events published over all thread regions
+            /// </summary>
+            public ulong PublishedEventCount;
+
+            /// <summary>
+            /// Number of frames published
+            /// </summary>
+            public ulong PublishedFrameCount;
+
+            /// <summary>
+            /// Size of shared memory mapping in bytes
+            /// </summary>
+            public ulong MappingSize;
+
+            /// <summary>
+            /// Number of thread regions
+            /// </summary>
+            public uint RegionCount;
+
+            /// <summary>
+            /// Event capacity of each thread region
+            /// </summary>
+            public uint RegionCapacity;
+
+            /// <summary>
+            /// Number of threads not publishing as their index exceeds region count
+            /// </summary>
+            public uint UnmappedThreadCount;
+
+            /// <summary>
+            /// Flag whether live feed is publishing
+            /// </summary>
+            public uint IsPublishing;
+        }
+
+
+        /// <summary>
+        /// Statistics of marker over single frame (merged over all threads)
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public unsafe struct MarkerStats
+        {
+            /// <summary>
+            /// Number of latency histogram buckets
+            /// </summary>
+            public const int HistogramBucketCount = 20;
+
+
+            /// <summary>
+            /// Interned marker ID (see <see cref="TraceUtility.GetMarkerInfo"/>)
+            /// </summary>
+            public uint MarkerID;
+
+            /// <summary>
+            /// Number of sections left
+            /// </summary>
+            public uint Count;
+
+            /// <summary>
+            /// Total inclusive time in nanoseconds
+            /// </summary>
+            public ulong TotalNs;
+
+            /// <summary>
+            /// Total exclusive time (excluding child sections on same thread) in nanoseconds
+            /// </summary>
+            public ulong SelfNs;
+
+            /// <summary>
+            /// Shortest inclusive time in nanoseconds
+            /// </summary>
+            public ulong MinNs;
+
+            /// <summary>
+            /// Longest inclusive time in nanoseconds
+            /// </summary>
+            public ulong MaxNs;
+
+            /// <summary>
+            /// Inclusive time histogram (bucket 0 below 1us, bucket n in [2^(n-1), 2^n) us, last bucket unbounded)
+            /// </summary>
+            public fixed uint Histogram[HistogramBucketCount];
+        }
+
+
+        /// <summary>
+        /// Info on frame of statistics trace
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct StatsFrameInfo
+        {
+            /// <summary>
+            /// Index of frame since trace begin
+            /// </summary>
+            public ulong FrameIndex;
+
+            /// <summary>
+            /// Duration of frame in nanoseconds
+            /// </summary>
+            public ulong DurationNs;
+
+            /// <summary>
+            /// Number of markers with statistics in frame (may exceed capacity of buffer)
+            /// </summary>
+            public uint MarkerCount;
+
+            /// <summary>
+            /// Flag whether statistics trace is running
+            /// </summary>
+            public uint IsTracing;
+        }
+
+
+        /// <summary>
+        /// Info on asynchronous extern trace
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct AsyncExternTraceInfo
+        {
+            /// <summary>
+            /// Number of events delivered to extern trace
+            /// </summary>
+            public ulong DeliveredEventCount;
+
+            /// <summary>
+            /// Number of events dropped due to full queues
+            /// </summary>
+            public ulong DroppedEventCount;
+
+            /// <summary>
+            /// Number of events currently queued over all threads
+            /// </summary>
+            public uint QueueDepth;
+
+            /// <summary>
+            /// Number of events queued at once at most
+            /// </summary>
+            public uint MaxQueueDepth;
+
+            /// <summary>
+            /// Number of thread queues
+            /// </summary>
+            public uint QueueCount;
+
+            /// <summary>
+            /// Flag whether asynchronous extern trace is running
+            /// </summary>
+            public uint IsRunning;
+        }
+
+
+        /// <summary>
+        /// Info on flight recorder
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct FlightRecorderInfo
+        {
+            /// <summary>
+            /// Number of snapshots taken
+            /// </summary>
+            public ulong SnapshotCount;
+
+            /// <summary>
+            /// Number of snapshots skipped as previous snapshot was still being taken
+            /// </summary>
+            public ulong SkippedSnapshotCount;
+
+            /// <summary>
+            /// Duration of frame that triggered last snapshot in nanoseconds (0 if triggered explicitly)
+            /// </summary>
+            public ulong LastHitchDurationNs;
+
+            /// <summary>
+            /// Number of frames in last snapshot
+            /// </summary>
+            public uint SnapshotFrameCount;
+
+            /// <summary>
+            /// Number of frames of last snapshot waiting to be dequeued
+            /// </summary>
+            public uint PendingFrameCount;
+
+            /// <summary>
+            /// Flag whether writing last snapshot file failed
+            /// </summary>
+            public uint DidFailToWrite;
+
+            /// <summary>
+            /// Flag whether flight recorder is running
+            /// </summary>
+            public uint IsRecording;
+        }
+
+
+        /// <summary>
+        /// Well-known histogram IDs
+        /// </summary>
+        public static class HistogramID
+        {
+            /// <summary>
+            /// Histogram of frame times
+            /// </summary>
+            public const int Frame = 0;
+
+            /// <summary>
+            /// Pseudo ID addressing all histograms
+            /// </summary>
+            public const int All = -1;
+        }
+
+
+        /// <summary>
+        /// Summary of histogram
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct HistogramInfo
+        {
+            /// <summary>
+            /// Number of recorded durations
+            /// </summary>
+            public ulong Count;
+
+            /// <summary>
+            /// Sum of recorded durations in nanoseconds
+            /// </summary>
+            public ulong TotalNs;
+
+            /// <summary>
+            /// Shortest recorded duration in nanoseconds
+            /// </summary>
+            public ulong MinNs;
+
+            /// <summary>
+            /// Longest recorded duration in nanoseconds
+            /// </summary>
+            public ulong MaxNs;
+        }
+
+
+        /// <summary>
+        /// Managed allocations of marker path over single frame (merged over all threads)
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct AllocationStats
+        {
+            /// <summary>
+            /// Path of allocations made outside traced sections (parent of outermost paths)
+            /// </summary>
+            public const uint RootPathID = 0;
+
+
+            /// <summary>
+            /// Path ID (stable while trace runs)
+            /// </summary>
+            public uint PathID;
+
+            /// <summary>
+            /// ID of parent path (<see cref="RootPathID"/> for root path itself)
+            /// </summary>
+            public uint ParentPathID;
+
+            /// <summary>
+            /// Interned marker ID of innermost section of path (<see cref="uint.MaxValue"/> for root path)
+            /// </summary>
+            public uint MarkerID;
+
+            /// <summary>
+            /// Number of allocations made directly in path
+            /// </summary>
+            public uint Count;
+
+            /// <summary>
+            /// Bytes allocated directly in path
+            /// </summary>
+            public ulong Bytes;
+
+            /// <summary>
+            /// Bytes allocated in path including child paths
+            /// </summary>
+            public ulong TotalBytes;
+        }
+
+
+        /// <summary>
+        /// Info on frame of allocation trace
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct AllocationFrameInfo
+        {
+            /// <summary>
+            /// Index of frame since trace begin
+            /// </summary>
+            public ulong FrameIndex;
+
+            /// <summary>
+            /// Bytes allocated in frame
+            /// </summary>
+            public ulong TotalBytes;
+
+            /// <summary>
+            /// Number of allocations in frame
+            /// </summary>
+            public uint TotalCount;
+
+            /// <summary>
+            /// Number of paths in frame including ancestors without allocations (may exceed capacity of buffer)
+            /// </summary>
+            public uint PathCount;
+
+            /// <summary>
+            /// Flag whether allocation trace is running
+            /// </summary>
+            public uint IsTracing;
+
+            /// <summary>
+            /// Flag whether allocations got dropped as thread ran out of paths
+            /// </summary>
+            public uint DidRunOutOfPaths;
+        }
+
+
+        /// <summary>
+        /// Call tree node (nodes listed in pre-order per thread, children following parent)
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct CallTreeNode
+        {
+            /// <summary>
+            /// Interned marker ID
+            /// </summary>
+            public uint MarkerID;
+
+            /// <summary>
+            /// Dense thread index
+            /// </summary>
+            public ushort ThreadIndex;
+
+            /// <summary>
+            /// Depth in tree of thread (0 for outermost sections)
+            /// </summary>
+            public ushort Depth;
+
+            /// <summary>
+            /// Number of sections left
+            /// </summary>
+            public uint Calls;
+
+            /// <summary>
+            /// Number of nodes in subtree (excluding node itself)
+            /// </summary>
+            public uint DescendantCount;
+
+            /// <summary>
+            /// Total inclusive time in nanoseconds
+            /// </summary>
+            public ulong TotalNs;
+
+            /// <summary>
+            /// Total exclusive time (excluding child sections) in nanoseconds
+            /// </summary>
+            public ulong SelfNs;
+        }
+
+
+        /// <summary>
+        /// Info on call tree
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct CallTreeInfo
+        {
+            /// <summary>
+            /// Index of last merged frame
+            /// </summary>
+            public ulong FrameIndex;
+
+            /// <summary>
+            /// Number of frames merged into tree
+            /// </summary>
+            public ulong FrameCount;
+
+            /// <summary>
+            /// Number of nodes (may exceed capacity of buffer)
+            /// </summary>
+            public uint NodeCount;
+
+            /// <summary>
+            /// Flag whether call tree trace is running
+            /// </summary>
+            public uint IsTracing;
+
+            /// <summary>
+            /// Flag whether sections got dropped as thread ran out of nodes
+            /// </summary>
+            public uint DidRunOutOfNodes;
+        }
+
+
+        /// <summary>
+        /// Info on marker filter
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct MarkerFilterInfo
+        {
+            /// <summary>
+            /// Number of Unity markers seen
+            /// </summary>
+            public uint KnownMarkerCount;
+
+            /// <summary>
+            /// Number of Unity markers with event callback registered
+            /// </summary>
+            public uint RegisteredMarkerCount;
+        }
+
+
+        /// <summary>
+        /// Info on trace frame flip
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct TraceInfo
+        {
+            /// <summary>
+            /// Duration of traced frame in nanoseconds 
+            /// </summary>
+            public ulong DurationNs;
+
+            /// <summary>
+            /// Number of trace events
+            /// </summary>
+            public uint EventCount;
+
+            /// <summary>
+            /// Flag whether event buffer ran out of memory
+            /// </summary>
+            public uint DidRunOutOfEventMemory;
+        }
+    }
+
+
+    /// <summary>
+    /// Utilities for C# callback-driven tracing
+    /// </summary>
+    public static class TraceUtility
+    {
+        /// <summary>
+        /// C functions
+        /// </summary>
+        private static class C
+        {
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_BeginTrace")]
+            public static extern ErrorCode BeginTrace(IntPtr eventBufferFrame, int eventBufferCapacity);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_BeginCompactTrace")]
+            public static extern ErrorCode BeginCompactTrace(IntPtr eventBuffer, int eventBufferCapacity);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_EndTrace")]
+            public static extern ErrorCode EndTrace(ref Trace.TraceInfo info);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_BeginContinuousTrace")]
+            public static extern ErrorCode BeginContinuousTrace(int frameCount, int eventsPerFrame);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_EndContinuousTrace")]
+            public static extern ErrorCode EndContinuousTrace();
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_DequeueFrame")]
+            public static extern ErrorCode DequeueFrame(IntPtr eventBuffer, int eventBufferCapacity, ref Trace.FrameInfo info);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_DequeueFrameWithMetadata")]
+            public static extern ErrorCode DequeueFrameWithMetadata(IntPtr eventBuffer, int eventBufferCapacity, IntPtr metadataBuffer, int metadataBufferCapacity, ref int metadataLength, ref Trace.FrameInfo info);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_BeginSpanTrace")]
+            public static extern ErrorCode BeginSpanTrace(int frameCount, int spansPerFrame);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_DequeueSpanFrame")]
+            public static extern ErrorCode DequeueSpanFrame(IntPtr spanBuffer, int spanBufferCapacity, ref Trace.FrameInfo info);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_GetContinuousTraceInfo")]
+            public static extern ErrorCode GetContinuousTraceInfo(ref Trace.ContinuousTraceInfo info);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_BeginStreamingTrace")]
+            public static extern ErrorCode BeginStreamingTrace(byte[] path, int frameCount, int eventsPerFrame);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_BeginCompressedStreamingTrace")]
+            public static extern ErrorCode BeginCompressedStreamingTrace(byte[] path, int frameCount, int eventsPerFrame, Trace.StreamCompression compression);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_EndStreamingTrace")]
+            public static extern ErrorCode EndStreamingTrace();
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_GetStreamingTraceInfo")]
+            public static extern ErrorCode GetStreamingTraceInfo(ref Trace.StreamingTraceInfo info);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_BeginLiveFeed")]
+            public static extern ErrorCode BeginLiveFeed(byte[] name, int regionCount, int eventsPerRegion);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_EndLiveFeed")]
+            public static extern ErrorCode EndLiveFeed();
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_GetLiveFeedInfo")]
+            public static extern ErrorCode GetLiveFeedInfo(ref Trace.LiveFeedInfo info);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_BeginStatsTrace")]
+            public static extern ErrorCode BeginStatsTrace();
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_EndStatsTrace")]
+            public static extern ErrorCode EndStatsTrace();
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_GetStatsFrame")]
+            public static extern ErrorCode GetStatsFrame(IntPtr statsBuffer, int statsBufferCapacity, ref Trace.StatsFrameInfo info);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_BeginAllocationTrace")]
+            public static extern ErrorCode BeginAllocationTrace();
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_EndAllocationTrace")]
+            public static extern ErrorCode EndAllocationTrace();
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_GetAllocationFrame")]
+            public static extern ErrorCode GetAllocationFrame(IntPtr statsBuffer, int statsBufferCapacity, ref Trace.AllocationFrameInfo info);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_BeginCallTreeTrace")]
+            public static extern ErrorCode BeginCallTreeTrace();
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_EndCallTreeTrace")]
+            public static extern ErrorCode EndCallTreeTrace();
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_GetCallTree")]
+            public static extern ErrorCode GetCallTree(IntPtr nodeBuffer, int nodeBufferCapacity, Trace.CallTreeScope scope, ref Trace.CallTreeInfo info);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_ResetCallTreeWindow")]
+            public static extern ErrorCode ResetCallTreeWindow();
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_ExportEvents")]
+            public static extern ErrorCode ExportEvents(byte[] path, Trace.ExportFormat format, IntPtr events, int eventCount);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_ExportStreamingTrace")]
+            public static extern ErrorCode ExportStreamingTrace(byte[] inputPath, byte[] outputPath, Trace.ExportFormat format);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_BeginHistogramTrace")]
+            public static extern ErrorCode BeginHistogramTrace();
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_EndHistogramTrace")]
+            public static extern ErrorCode EndHistogramTrace();
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_AddHistogramMarker")]
+            public static extern ErrorCode AddHistogramMarker(byte[] name, ref int histogramID);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_GetHistogramInfo")]
+            public static extern ErrorCode GetHistogramInfo(int histogramID, ref Trace.HistogramInfo info);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_GetHistogramPercentiles")]
+            public static extern ErrorCode GetHistogramPercentiles(int histogramID, double[] percentiles, [Out] ulong[] valuesNs, int count);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_ResetHistogram")]
+            public static extern ErrorCode ResetHistogram(int histogramID);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_SetMarkerFilter")]
+            public static extern ErrorCode SetMarkerFilter(byte[] filter);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_SetMetadataCapture")]
+            public static extern ErrorCode SetMetadataCapture(byte[] filter, int bytesPerFrame);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_GetMarkerFilterInfo")]
+            public static extern ErrorCode GetMarkerFilterInfo(ref Trace.MarkerFilterInfo info);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_LoadTraceSink")]
+            public static extern ErrorCode LoadTraceSink(byte[] path, ref int sinkID);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_DetachTraceSink")]
+            public static extern ErrorCode DetachTraceSink(int sinkID);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_BeginAsyncExternTrace")]
+            public static extern ErrorCode BeginAsyncExternTrace(Trace.BackpressurePolicy policy, int blockTimeoutUs);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_EndAsyncExternTrace")]
+            public static extern ErrorCode EndAsyncExternTrace();
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_GetAsyncExternTraceInfo")]
+            public static extern ErrorCode GetAsyncExternTraceInfo(ref Trace.AsyncExternTraceInfo info);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_BeginFlightRecorder")]
+            public static extern ErrorCode BeginFlightRecorder(int frameCount, int eventsPerFrame, int hitchThresholdUs, byte[] pathPrefix);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_EndFlightRecorder")]
+            public static extern ErrorCode EndFlightRecorder();
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_TriggerFlightRecorder")]
+            public static extern ErrorCode TriggerFlightRecorder();
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_GetFlightRecorderInfo")]
+            public static extern ErrorCode GetFlightRecorderInfo(ref Trace.FlightRecorderInfo info);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_DequeueSnapshotFrame")]
+            public static extern ErrorCode DequeueSnapshotFrame(IntPtr eventBuffer, int eventBufferCapacity, ref Trace.FrameInfo info);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_GetMarkerCount")]
+            public static extern uint GetMarkerCount();
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_GetMarkerInfo")]
+            public static extern ErrorCode GetMarkerInfo(uint markerID, ref Trace.MarkerInfo info);
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_GetThreadCount")]
+            public static extern uint GetThreadCount();
+
+
+            [DllImport(PluginInfo.DllName, EntryPoint = "KLab_Profiling_TraceUtility_GetThreadInfo")]
+            public static extern ErrorCode GetThreadInfo(uint threadIndex, ref Trace.ThreadInfo info);
+        }
+
+
+        /// <summary>
+        /// Begins tracing
+        /// </summary>
+        /// <param name="eventBuffer"><see cref="TraceEventInfo"/> array buffer</param>
+        /// <param name="eventBufferCapacity">Capacity of buffer for <see cref="TraceEventInfo"/></param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode BeginTrace(IntPtr eventBuffer, int eventBufferCapacity)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+            
+            // Validate arguments
+            if ((eventBuffer == IntPtr.Zero) || (eventBufferCapacity <= 0))
+            {
+                return ErrorCode.InvalidArgument;
+            }
+
+
+            return C.BeginTrace(eventBuffer, eventBufferCapacity);
+        }
+
+
+        /// <summary>
+        /// Begins tracing into compact event records
+        /// </summary>
+        /// <param name="eventBuffer"><see cref="Trace.EventRecord"/> array buffer</param>
+        /// <param name="eventBufferCapacity">Capacity of buffer for <see cref="Trace.EventRecord"/></param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode BeginCompactTrace(IntPtr eventBuffer, int eventBufferCapacity)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            // Validate arguments
+            if ((eventBuffer == IntPtr.Zero) || (eventBufferCapacity <= 0))
+            {
+                return ErrorCode.InvalidArgument;
+            }
+
+
+            return C.BeginCompactTrace(eventBuffer, eventBufferCapacity);
+        }
+
+
+        /// <summary>
+        /// Ends tracing
+        /// </summary>
+        public static ErrorCode EndTrace(ref Trace.TraceInfo info)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.EndTrace(ref info);
+        }
+
+
+        /// <summary>
+        /// Begins continuous tracing into native frame buffers rotated every frame
+        /// </summary>
+        /// <param name="frameCount">Number of frame buffers (at least 3)</param>
+        /// <param name="eventsPerFrame">Event capacity of each frame buffer</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode BeginContinuousTrace(int frameCount, int eventsPerFrame)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            // Validate arguments
+            if ((frameCount < 3) || (eventsPerFrame <= 0))
+            {
+                return ErrorCode.InvalidArgument;
+            }
+
+
+            return C.BeginContinuousTrace(frameCount, eventsPerFrame);
+        }
+
+
+        /// <summary>
+        /// Ends continuous tracing (frames recorded so far stay dequeueable)
+        /// </summary>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode EndContinuousTrace()
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.EndContinuousTrace();
+        }
+
+
+        /// <summary>
+        /// Dequeues oldest completed frame of continuous trace
+        /// </summary>
+        /// <param name="eventBuffer"><see cref="Trace.EventRecord"/> array buffer</param>
+        /// <param name="eventBufferCapacity">Capacity of buffer for <see cref="Trace.EventRecord"/></param>
+        /// <param name="info">Info on frame</param>
+        /// <returns><see cref="ErrorCode.NoError"/> if frame dequeued; <see cref="ErrorCode.NotAvailable"/> if no frame completed; an error otherwise</returns>
+        public static ErrorCode DequeueFrame(IntPtr eventBuffer, int eventBufferCapacity, ref Trace.FrameInfo info)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            // Validate arguments
+            if ((eventBuffer == IntPtr.Zero) || (eventBufferCapacity <= 0))
+            {
+                return ErrorCode.InvalidArgument;
+            }
+
+
+            return C.DequeueFrame(eventBuffer, eventBufferCapacity, ref info);
+        }
+
+
+        /// <summary>
+        /// Dequeues oldest completed frame of continuous trace together with metadata captured (see <see cref="SetMetadataCapture"/>)
+        /// </summary>
+        /// <param name="eventBuffer"><see cref="Trace.EventRecord"/> array buffer</param>
+        /// <param name="eventBufferCapacity">Capacity of buffer for <see cref="Trace.EventRecord"/></param>
+        /// <param name="metadataBuffer">Byte buffer for metadata</param>
+        /// <param name="metadataBufferCapacity">Capacity of metadata buffer in bytes</param>
+        /// <param name="metadataLength">Number of metadata bytes written</param>
+        /// <param name="info">Info on frame</param>
+        /// <returns><see cref="ErrorCode.NoError"/> if frame dequeued; <see cref="ErrorCode.NotAvailable"/> if no frame completed; an error otherwise</returns>
+        public static ErrorCode DequeueFrameWithMetadata(IntPtr eventBuffer, int eventBufferCapacity, IntPtr metadataBuffer, int metadataBufferCapacity, ref int metadataLength, ref Trace.FrameInfo info)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            // Validate arguments
+            if ((eventBuffer == IntPtr.Zero) || (eventBufferCapacity <= 0) || (metadataBuffer == IntPtr.Zero) || (metadataBufferCapacity <= 0))
+            {
+                return ErrorCode.InvalidArgument;
+            }
+
+
+            return C.DequeueFrameWithMetadata(eventBuffer, eventBufferCapacity, metadataBuffer, metadataBufferCapacity, ref metadataLength, ref info);
+        }
+
+
+        /// <summary>
+        /// Begins continuous tracing of spans (pairing section enter and leave natively instead of recording both events)
+        /// </summary>
+        /// <remarks>
+        /// Spans get reported in frame they end in. End and query trace through <see cref="EndContinuousTrace"/> and <see cref="GetContinuousTraceInfo"/>.
+        /// </remarks>
+        /// <param name="frameCount">Number of frame buffers (at least 3)</param>
+        /// <param name="spansPerFrame">Span capacity of each frame buffer</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode BeginSpanTrace(int frameCount, int spansPerFrame)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            // Validate arguments
+            if ((frameCount < 3) || (spansPerFrame <= 0))
+            {
+                return ErrorCode.InvalidArgument;
+            }
+
+
+            return C.BeginSpanTrace(frameCount, spansPerFrame);
+        }
+
+
+        /// <summary>
+        /// Dequeues oldest completed frame of span trace (spans ordered by begin)
+        /// </summary>
+        /// <param name="spanBuffer"><see cref="Trace.SpanRecord"/> array buffer</param>
+        /// <param name="spanBufferCapacity">Capacity of buffer for <see cref="Trace.SpanRecord"/></param>
+        /// <param name="info">Info on frame (<see cref="Trace.FrameInfo.EventCount"/> holding number of spans)</param>
+        /// <returns><see cref="ErrorCode.NoError"/> if frame dequeued; <see cref="ErrorCode.NotAvailable"/> if no frame completed; an error otherwise</returns>
+        public static ErrorCode DequeueSpanFrame(IntPtr spanBuffer, int spanBufferCapacity, ref Trace.FrameInfo info)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            // Validate arguments
+            if ((spanBuffer == IntPtr.Zero) || (spanBufferCapacity <= 0))
+            {
+                return ErrorCode.InvalidArgument;
+            }
+
+
+            return C.DequeueSpanFrame(spanBuffer, spanBufferCapacity, ref info);
+        }
+
+
+        /// <summary>
+        /// Gets info on continuous trace
+        /// </summary>
+        /// <param name="info">Info on trace</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode GetContinuousTraceInfo(ref Trace.ContinuousTraceInfo info)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.GetContinuousTraceInfo(ref info);
+        }
+
+
+        /// <summary>
+        /// Begins continuous tracing streamed to binary trace file by native background thread
+        /// </summary>
+        /// <param name="path">Path of trace file (truncated if existing)</param>
+        /// <param name="frameCount">Number of frame buffers (at least 3)</param>
+        /// <param name="eventsPerFrame">Event capacity of each frame buffer</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode BeginStreamingTrace(string path, int frameCount, int eventsPerFrame)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            // Validate arguments
+            if (string.IsNullOrEmpty(path) || (frameCount < 3) || (eventsPerFrame <= 0))
+            {
+                return ErrorCode.InvalidArgument;
+            }
+
+
+            return C.BeginStreamingTrace(Encoding.UTF8.GetBytes(path + '\0'), frameCount, eventsPerFrame);
+        }
+
+
+        /// <summary>
+        /// Begins continuous tracing streamed to binary trace file by native background thread compressing completed frames
+        /// </summary>
+        /// <param name="path">Path of trace file (truncated if existing)</param>
+        /// <param name="frameCount">Number of frame buffers (at least 3)</param>
+        /// <param name="eventsPerFrame">Event capacity of each frame buffer</param>
+        /// <param name="compression">Compression of frames</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode BeginCompressedStreamingTrace(string path, int frameCount, int eventsPerFrame, Trace.StreamCompression compression)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            // Validate arguments
+            if (string.IsNullOrEmpty(path) || (frameCount < 3) || (eventsPerFrame <= 0))
+            {
+                return ErrorCode.InvalidArgument;
+            }
+
+
+            return C.BeginCompressedStreamingTrace(Encoding.UTF8.GetBytes(path + '\0'), frameCount, eventsPerFrame, compression);
+        }
+
+
+        /// <summary>
+        /// Ends streaming trace (blocking until remaining frames are written)
+        /// </summary>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode EndStreamingTrace()
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.EndStreamingTrace();
+        }
+
+
+        /// <summary>
+        /// Gets info on streaming trace
+        /// </summary>
+        /// <param name="info">Info on trace</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode GetStreamingTraceInfo(ref Trace.StreamingTraceInfo info)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.GetStreamingTraceInfo(ref info);
+        }
+
+
+        /// <summary>
+        /// Begins publishing events into POSIX shared memory for external reader processes (e.g. 'KLab_Profiling_LiveFeedReader')
+        /// </summary>
+        /// <param name="name">Name of shared memory object (e.g. '/klab-profiling'; replaced if existing)</param>
+        /// <param name="regionCount">Number of thread regions (threads with higher dense index don't publish)</param>
+        /// <param name="eventsPerRegion">Event capacity of each thread region (rounded up to power of 2)</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; <see cref="ErrorCode.NotAvailable"/> if platform lacks shared memory; an error otherwise</returns>
+        public static ErrorCode BeginLiveFeed(string name, int regionCount, int eventsPerRegion)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            // Validate arguments
+            if (string.IsNullOrEmpty(name) || (regionCount <= 0) || (eventsPerRegion <= 0))
+            {
+                return ErrorCode.InvalidArgument;
+            }
+
+
+            return C.BeginLiveFeed(Encoding.UTF8.GetBytes(name + '\0'), regionCount, eventsPerRegion);
+        }
+
+
+        /// <summary>
+        /// Ends live feed (unlinking shared memory object; attached readers see feed ended)
+        /// </summary>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode EndLiveFeed()
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.EndLiveFeed();
+        }
+
+
+        /// <summary>
+        /// Gets info on live feed
+        /// </summary>
+        /// <param name="info">Info on feed</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode GetLiveFeedInfo(ref Trace.LiveFeedInfo info)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.GetLiveFeedInfo(ref info);
+        }
+
+
+        /// <summary>
+        /// Begins statistics trace aggregating per-marker statistics per frame instead of capturing events
+        /// </summary>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode BeginStatsTrace()
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.BeginStatsTrace();
+        }
+
+
+        /// <summary>
+        /// Ends statistics trace (last merged frame stays readable)
+        /// </summary>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode EndStatsTrace()
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.EndStatsTrace();
+        }
+
+
+        /// <summary>
+        /// Gets marker statistics of last merged frame (frames get merged one frame after they completed)
+        /// </summary>
+        /// <param name="statsBuffer"><see cref="Trace.MarkerStats"/> array buffer (may be <see cref="IntPtr.Zero"/> to query info only)</param>
+        /// <param name="statsBufferCapacity">Capacity of buffer for <see cref="Trace.MarkerStats"/></param>
+        /// <param name="info">Info on frame</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; <see cref="ErrorCode.NotAvailable"/> if no frame merged yet; an error otherwise</returns>
+        public static ErrorCode GetStatsFrame(IntPtr statsBuffer, int statsBufferCapacity, ref Trace.StatsFrameInfo info)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            // Validate arguments
+            if ((statsBuffer != IntPtr.Zero) && (statsBufferCapacity <= 0))
+            {
+                return ErrorCode.InvalidArgument;
+            }
+
+
+            return C.GetStatsFrame(statsBuffer, statsBufferCapacity, ref info);
+        }
+
+
+        /// <summary>
+        /// Begins allocation trace attributing managed allocations ('GC.Alloc' samples) to marker path of allocating thread per frame
+        /// </summary>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode BeginAllocationTrace()
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.BeginAllocationTrace();
+        }
+
+
+        /// <summary>
+        /// Ends allocation trace (last merged frame stays readable)
+        /// </summary>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode EndAllocationTrace()
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.EndAllocationTrace();
+        }
+
+
+        /// <summary>
+        /// Gets allocations by marker path of last merged frame (frames get merged one frame after they completed; parents precede children)
+        /// </summary>
+        /// <param name="statsBuffer"><see cref="Trace.AllocationStats"/> array buffer (may be <see cref="IntPtr.Zero"/> to query info only)</param>
+        /// <param name="statsBufferCapacity">Capacity of buffer for <see cref="Trace.AllocationStats"/></param>
+        /// <param name="info">Info on frame</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; <see cref="ErrorCode.NotAvailable"/> if no frame merged yet; an error otherwise</returns>
+        public static ErrorCode GetAllocationFrame(IntPtr statsBuffer, int statsBufferCapacity, ref Trace.AllocationFrameInfo info)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            // Validate arguments
+            if ((statsBuffer != IntPtr.Zero) && (statsBufferCapacity <= 0))
+            {
+                return ErrorCode.InvalidArgument;
+            }
+
+
+            return C.GetAllocationFrame(statsBuffer, statsBufferCapacity, ref info);
+        }
+
+
+        /// <summary>
+        /// Begins call tree trace merging sections into call tree per thread and frame
+        /// </summary>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode BeginCallTreeTrace()
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.BeginCallTreeTrace();
+        }
+
+
+        /// <summary>
+        /// Ends call tree trace (merged trees stay readable)
+        /// </summary>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode EndCallTreeTrace()
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.EndCallTreeTrace();
+        }
+
+
+        /// <summary>
+        /// Gets call trees of all threads (frames get merged one frame after they completed; sections get counted in frame they end in)
+        /// </summary>
+        /// <param name="nodeBuffer"><see cref="Trace.CallTreeNode"/> array buffer (may be <see cref="IntPtr.Zero"/> to query info only)</param>
+        /// <param name="nodeBufferCapacity">Capacity of buffer for <see cref="Trace.CallTreeNode"/></param>
+        /// <param name="scope">Scope of trees</param>
+        /// <param name="info">Info on trees</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; <see cref="ErrorCode.NotAvailable"/> if no frame merged yet; an error otherwise</returns>
+        public static ErrorCode GetCallTree(IntPtr nodeBuffer, int nodeBufferCapacity, Trace.CallTreeScope scope, ref Trace.CallTreeInfo info)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            // Validate arguments
+            if ((nodeBuffer != IntPtr.Zero) && (nodeBufferCapacity <= 0))
+            {
+                return ErrorCode.InvalidArgument;
+            }
+
+
+            return C.GetCallTree(nodeBuffer, nodeBufferCapacity, scope, ref info);
+        }
+
+
+        /// <summary>
+        /// Clears call trees merged over frames to start new window
+        /// </summary>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode ResetCallTreeWindow()
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.ResetCallTreeWindow();
+        }
+
+
+        /// <summary>
+        /// Exports trace events natively to viewer format
+        /// </summary>
+        /// <param name="path">Path of output file</param>
+        /// <param name="format">Export format</param>
+        /// <param name="events"><see cref="Trace.EventInfo"/> array buffer (e.g. filled by <see cref="EndTrace"/>)</param>
+        /// <param name="eventCount">Number of events in buffer</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode ExportEvents(string path, Trace.ExportFormat format, IntPtr events, int eventCount)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            // Validate arguments
+            if (string.IsNullOrEmpty(path) || ((events == IntPtr.Zero) && (eventCount > 0)) || (eventCount < 0))
+            {
+                return ErrorCode.InvalidArgument;
+            }
+
+
+            return C.ExportEvents(Encoding.UTF8.GetBytes(path + '\0'), format, events, eventCount);
+        }
+
+
+        /// <summary>
+        /// Exports streamed trace file (see <see cref="BeginStreamingTrace"/>; decoding compressed frames) natively to viewer format
+        /// </summary>
+        /// <param name="inputPath">Path of streamed trace file</param>
+        /// <param name="outputPath">Path of output file</param>
+        /// <param name="format">Export format</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode ExportStreamingTrace(string inputPath, string outputPath, Trace.ExportFormat format)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            // Validate arguments
+            if (string.IsNullOrEmpty(inputPath) || string.IsNullOrEmpty(outputPath))
+            {
+                return ErrorCode.InvalidArgument;
+            }
+
+
+            return C.ExportStreamingTrace(Encoding.UTF8.GetBytes(inputPath + '\0'), Encoding.UTF8.GetBytes(outputPath + '\0'), format);
+        }
+
+
+        /// <summary>
+        /// Begins recording frame times and durations of chosen markers into histograms (clearing histograms)
+        /// </summary>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode BeginHistogramTrace()
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.BeginHistogramTrace();
+        }
+
+
+        /// <summary>
+        /// Ends histogram trace (histograms stay queryable)
+        /// </summary>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode EndHistogramTrace()
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.EndHistogramTrace();
+        }
+
+
+        /// <summary>
+        /// Chooses marker to record durations of into histogram
+        /// </summary>
+        /// <param name="name">Marker name</param>
+        /// <param name="histogramID">ID of histogram</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode AddHistogramMarker(string name, ref int histogramID)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            // Validate arguments
+            if (string.IsNullOrEmpty(name))
+            {
+                return ErrorCode.InvalidArgument;
+            }
+
+
+            return C.AddHistogramMarker(Encoding.UTF8.GetBytes(name + '\0'), ref histogramID);
+        }
+
+
+        /// <summary>
+        /// Gets summary of histogram
+        /// </summary>
+        /// <param name="histogramID">ID of histogram</param>
+        /// <param name="info">Summary</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode GetHistogramInfo(int histogramID, ref Trace.HistogramInfo info)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.GetHistogramInfo(histogramID, ref info);
+        }
+
+
+        /// <summary>
+        /// Gets durations at percentiles of histogram
+        /// </summary>
+        /// <param name="histogramID">ID of histogram</param>
+        /// <param name="percentiles">Percentiles in range [0, 100]</param>
+        /// <param name="valuesNs">Buffer for durations in nanoseconds (at least as long as percentiles)</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode GetHistogramPercentiles(int histogramID, double[] percentiles, ulong[] valuesNs)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            // Validate arguments
+            if ((percentiles == null) || (valuesNs == null) || (valuesNs.Length < percentiles.Length))
+            {
+                return ErrorCode.InvalidArgument;
+            }
+
+
+            return C.GetHistogramPercentiles(histogramID, percentiles, valuesNs, percentiles.Length);
+        }
+
+
+        /// <summary>
+        /// Clears histogram to start new window
+        /// </summary>
+        /// <param name="histogramID">ID of histogram (<see cref="Trace.HistogramID.All"/> for all)</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode ResetHistogram(int histogramID)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.ResetHistogram(histogramID);
+        }
+
+
+        /// <summary>
+        /// Sets filter selecting Unity markers to trace (re-registering only markers whose selection changed)
+        /// </summary>
+        /// <remarks>
+        /// Rules are separated by ';' or new lines, prefixed with '+' to include (default) or '-' to exclude,
+        /// and either match category IDs ("category:&lt;ID&gt;") or marker names (glob with '*' and '?', e.g. "Physics.*").
+        /// Excludes take precedence, and no includes select all markers. 'Profiler.Default' is never filtered.
+        /// </remarks>
+        /// <param name="filter">Rules (empty to clear filter)</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode SetMarkerFilter(string filter)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            // Validate arguments
+            if (filter == null)
+            {
+                return ErrorCode.InvalidArgument;
+            }
+
+
+            return C.SetMarkerFilter(Encoding.UTF8.GetBytes(filter + '\0'));
+        }
+
+
+        /// <summary>
+        /// Sets filter selecting Unity markers whose metadata (e.g. instance IDs, sizes) continuous trace captures on section enter
+        /// </summary>
+        /// <remarks>
+        /// Rules follow <see cref="SetMarkerFilter"/>, except that no rules capture nothing; 'Profiler.Default' selects all its samples.
+        /// Metadata is only kept while dequeuing through <see cref="DequeueFrameWithMetadata"/>.
+        /// </remarks>
+        /// <param name="filter">Rules (empty to stop capturing)</param>
+        /// <param name="bytesPerFrame">Metadata capacity of each frame buffer in bytes (applied on next <see cref="BeginContinuousTrace"/>)</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode SetMetadataCapture(string filter, int bytesPerFrame)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            // Validate arguments
+            if ((filter == null) || (bytesPerFrame < 0))
+            {
+                return ErrorCode.InvalidArgument;
+            }
+
+
+            return C.SetMetadataCapture(Encoding.UTF8.GetBytes(filter + '\0'), bytesPerFrame);
+        }
+
+
+        /// <summary>
+        /// Gets info on marker filter
+        /// </summary>
+        /// <param name="info">Info on filter</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode GetMarkerFilterInfo(ref Trace.MarkerFilterInfo info)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.GetMarkerFilterInfo(ref info);
+        }
+
+
+        /// <summary>
+        /// Loads trace sink from shared object exporting 'KLab_Profiling_TraceSink_Create' (see 'KLab/Profiling/TraceSink.h')
+        /// </summary>
+        /// <param name="path">Path of shared object</param>
+        /// <param name="sinkID">ID of loaded sink</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode LoadTraceSink(string path, ref int sinkID)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            // Validate arguments
+            if (string.IsNullOrEmpty(path))
+            {
+                return ErrorCode.InvalidArgument;
+            }
+
+
+            return C.LoadTraceSink(Encoding.UTF8.GetBytes(path + '\0'), ref sinkID);
+        }
+
+
+        /// <summary>
+        /// Detaches trace sink (blocking until sink got released)
+        /// </summary>
+        /// <param name="sinkID">ID of sink</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode DetachTraceSink(int sinkID)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.DetachTraceSink(sinkID);
+        }
+
+
+        /// <summary>
+        /// Delivers events to extern trace from consumer thread instead of from marker callbacks (see <see cref="PluginInfo.SupportsExternTrace"/>)
+        /// </summary>
+        /// <param name="policy">Policy applied once queue of thread is full</param>
+        /// <param name="blockTimeoutUs">Time to wait for free queue entries per event before dropping in microseconds (<see cref="Trace.BackpressurePolicy.Block"/> only; 1000 at most)</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode BeginAsyncExternTrace(Trace.BackpressurePolicy policy, int blockTimeoutUs = 0)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            // Validate arguments
+            if ((blockTimeoutUs < 0) || (blockTimeoutUs > 1000))
+            {
+                return ErrorCode.InvalidArgument;
+            }
+
+
+            return C.BeginAsyncExternTrace(policy, blockTimeoutUs);
+        }
+
+
+        /// <summary>
+        /// Ends asynchronous extern trace (delivering remaining events)
+        /// </summary>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode EndAsyncExternTrace()
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.EndAsyncExternTrace();
+        }
+
+
+        /// <summary>
+        /// Gets info on asynchronous extern trace
+        /// </summary>
+        /// <param name="info">Info on trace</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode GetAsyncExternTraceInfo(ref Trace.AsyncExternTraceInfo info)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.GetAsyncExternTraceInfo(ref info);
+        }
+
+
+        /// <summary>
+        /// Begins flight recorder keeping all marker events of last frames and freezing them into snapshot once frame exceeds threshold or on <see cref="TriggerFlightRecorder"/>
+        /// </summary>
+        /// <param name="frameCount">Number of frames kept (at least 3)</param>
+        /// <param name="eventsPerFrame">Event capacity of each frame</param>
+        /// <param name="hitchThresholdUs">Frame duration triggering snapshot in microseconds (0 to only snapshot on trigger)</param>
+        /// <param name="pathPrefix">[Optional] Path prefix of snapshot files written as '&lt;pathPrefix&gt;-&lt;snapshot index&gt;.klpt' in streamed trace format</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode BeginFlightRecorder(int frameCount, int eventsPerFrame, int hitchThresholdUs, string pathPrefix = null)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            // Validate arguments
+            if ((frameCount < 3) || (eventsPerFrame <= 0) || (hitchThresholdUs < 0))
+            {
+                return ErrorCode.InvalidArgument;
+            }
+
+
+            return C.BeginFlightRecorder(frameCount, eventsPerFrame, hitchThresholdUs, (string.IsNullOrEmpty(pathPrefix) ? null : Encoding.UTF8.GetBytes(pathPrefix + '\0')));
+        }
+
+
+        /// <summary>
+        /// Ends flight recorder (last snapshot stays dequeueable)
+        /// </summary>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode EndFlightRecorder()
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.EndFlightRecorder();
+        }
+
+
+        /// <summary>
+        /// Requests snapshot of flight recorder (taken on next frame)
+        /// </summary>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode TriggerFlightRecorder()
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.TriggerFlightRecorder();
+        }
+
+
+        /// <summary>
+        /// Gets info on flight recorder
+        /// </summary>
+        /// <param name="info">Info on recorder</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode GetFlightRecorderInfo(ref Trace.FlightRecorderInfo info)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.GetFlightRecorderInfo(ref info);
+        }
+
+
+        /// <summary>
+        /// Dequeues oldest frame of last flight recorder snapshot
+        /// </summary>
+        /// <param name="eventBuffer"><see cref="Trace.EventRecord"/> array buffer</param>
+        /// <param name="eventBufferCapacity">Capacity of buffer for <see cref="Trace.EventRecord"/></param>
+        /// <param name="info">Info on frame</param>
+        /// <returns><see cref="ErrorCode.NoError"/> if frame dequeued; <see cref="ErrorCode.NotAvailable"/> if no frame pending; an error otherwise</returns>
+        public static ErrorCode DequeueSnapshotFrame(IntPtr eventBuffer, int eventBufferCapacity, ref Trace.FrameInfo info)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            // Validate arguments
+            if ((eventBuffer == IntPtr.Zero) || (eventBufferCapacity <= 0))
+            {
+                return ErrorCode.InvalidArgument;
+            }
+
+
+            return C.DequeueSnapshotFrame(eventBuffer, eventBufferCapacity, ref info);
+        }
+
+
+        /// <summary>
+        /// Gets number of interned markers
+        /// </summary>
+        /// <returns>The number of markers</returns>
+        public static uint GetMarkerCount()
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return 0;
+            }
+
+
+            return C.GetMarkerCount();
+        }
+
+
+        /// <summary>
+        /// Gets info on interned marker
+        /// </summary>
+        /// <param name="markerID">ID of marker (see <see cref="Trace.EventRecord.MarkerID"/>)</param>
+        /// <param name="info">Info on marker</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode GetMarkerInfo(uint markerID, ref Trace.MarkerInfo info)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.GetMarkerInfo(markerID, ref info);
+        }
+
+
+        /// <summary>
+        /// Gets number of traced threads
+        /// </summary>
+        /// <returns>The number of threads</returns>
+        public static uint GetThreadCount()
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return 0;
+            }
+
+
+            return C.GetThreadCount();
+        }
+
+
+        /// <summary>
+        /// Gets info on traced thread
+        /// </summary>
+        /// <param name="threadIndex">Index of thread (see <see cref="Trace.EventRecord.ThreadIndex"/>)</param>
+        /// <param name="info">Info on thread</param>
+        /// <returns><see cref="ErrorCode.NoError"/> on success; an error otherwise</returns>
+        public static ErrorCode GetThreadInfo(uint threadIndex, ref Trace.ThreadInfo info)
+        {
+            // Validate availability
+            if (!PluginInfo.IsPluginAvailable)
+            {
+                return ErrorCode.NotAvailable;
+            }
+
+
+            return C.GetThreadInfo(threadIndex, ref info);
+        }
+
+
+        /// <summary>
+        /// Converts null-terminated UTF-8 string to managed string
+        /// </summary>
+        /// <param name="utf8String">Null-terminated UTF-8 string</param>
+        /// <returns>The managed string</returns>
+        internal static string PtrToStringUtf8(IntPtr utf8String)
+        {
+            if (utf8String == IntPtr.Zero)
+            {
+                return string.Empty;
+            }
+
+
+            unsafe
+            {
+                var bytes  = (byte*)utf8String;
+                var length = 0;
+
+
+                while (bytes[length] != 0)
+                {
+                    ++length;
+                }
+
+
+                var managedBytes = new byte[length];
+
+
+                Marshal.Copy(utf8String, managedBytes, 0, length);
+
+
+                return Encoding.UTF8.GetString(managedBytes);
+            }
         }
     }
 }
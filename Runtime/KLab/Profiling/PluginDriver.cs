@@ -92,7 +92,7 @@ namespace KLab.Profiling
 
 
         /// <summary>
-        /// Flips frame
+        /// Flips frame as fallback (plugin flips at engine frame edge as long as Unity frame callback fires)
         /// </summary>
         /// <returns>Scheduling timer</returns>
         private IEnumerator CUpdate()
@@ -2,8 +2,12 @@
 using NUnit.Framework;
 using System;
 using System.Collections;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
 using Unity.Collections;
 using Unity.Collections.LowLevel.Unsafe;
+using Unity.Profiling.LowLevel;
+using Unity.Profiling.LowLevel.Unsafe;
 using UnityEngine;
 using UnityEngine.TestTools;
 
@@ -48,6 +52,893 @@ namespace KLab.Profiling.Tests.LowLevel
             FreeEventBuffer(eventBuffer);
         }
 
+        [UnityTest]
+        public IEnumerator BeginCompactTrace_EndTrace_ResolvesMarkers()
+        {
+            // Arrange
+            var eventBuffer = AllocateRecordBuffer(2048);
+            var result      = new Profiling.LowLevel.Trace.TraceInfo();
+
+
+            // Act
+            {
+                TraceUtility.BeginCompactTrace(eventBuffer, 2048);
+
+
+                // Trace some frames
+                yield return new WaitForEndOfFrame();
+                yield return new WaitForEndOfFrame();
+                yield return new WaitForEndOfFrame();
+
+
+                TraceUtility.EndTrace(ref result);
+            }
+
+
+            // Assert
+            {
+                Assert.Greater(result.EventCount, 0, "Expected trace events");
+
+
+                unsafe
+                {
+                    var record = *(Profiling.LowLevel.Trace.EventRecord*)eventBuffer;
+                    var marker = new Profiling.LowLevel.Trace.MarkerInfo();
+                    var thread = new Profiling.LowLevel.Trace.ThreadInfo();
+
+
+                    Assert.AreEqual(ErrorCode.NoError, TraceUtility.GetMarkerInfo(record.MarkerID, ref marker), "Expected marker to be interned");
+                    Assert.IsNotEmpty(marker.GetName(), "Expected marker name");
+                    Assert.AreEqual(ErrorCode.NoError, TraceUtility.GetThreadInfo(record.ThreadIndex, ref thread), "Expected thread to be registered");
+                }
+            }
+
+
+            // Clean up
+            FreeEventBuffer(eventBuffer);
+        }
+
+        [UnityTest]
+        public IEnumerator BeginCompactTrace_BeginSample_ConvertsUtf16Name()
+        {
+            // Arrange
+            const string sampleName = "\u30B5\u30F3\u30D7\u30EB.Caf\u00E9 \U0001F3AE";
+
+            var eventBuffer = AllocateRecordBuffer(2048);
+            var result      = new Profiling.LowLevel.Trace.TraceInfo();
+            var isFound     = false;
+
+
+            // Act
+            {
+                TraceUtility.BeginCompactTrace(eventBuffer, 2048);
+
+
+                // Emit sample (twice to hit cache)
+                for (var s = 0; s < 2; ++s)
+                {
+                    UnityEngine.Profiling.Profiler.BeginSample(sampleName);
+                    UnityEngine.Profiling.Profiler.EndSample();
+                }
+
+
+                yield return new WaitForEndOfFrame();
+
+
+                TraceUtility.EndTrace(ref result);
+            }
+
+
+            // Assert
+            {
+                var marker = new Profiling.LowLevel.Trace.MarkerInfo();
+
+
+                for (var m = 0u; m < TraceUtility.GetMarkerCount(); ++m)
+                {
+                    if ((TraceUtility.GetMarkerInfo(m, ref marker) == ErrorCode.NoError) && (marker.GetName() == sampleName))
+                    {
+                        isFound = true;
+                    }
+                }
+
+
+                Assert.IsTrue(isFound, "Expected sample name to round-trip as UTF-8");
+            }
+
+
+            // Clean up
+            FreeEventBuffer(eventBuffer);
+        }
+
+        [UnityTest]
+        public IEnumerator BeginContinuousTrace_DequeueFrame_DrainsFrames()
+        {
+            // Arrange
+            var eventBuffer = AllocateRecordBuffer(8192);
+            var frame       = new Profiling.LowLevel.Trace.FrameInfo();
+            var frameCount  = 0;
+
+
+            // Act
+            {
+                TraceUtility.BeginContinuousTrace(4, 8192);
+
+
+                // Trace some frames draining them while tracing
+                for (var f = 0; f < 6; ++f)
+                {
+                    yield return new WaitForEndOfFrame();
+
+
+                    while (TraceUtility.DequeueFrame(eventBuffer, 8192, ref frame) == ErrorCode.NoError)
+                    {
+                        ++frameCount;
+                    }
+                }
+
+
+                TraceUtility.EndContinuousTrace();
+            }
+
+
+            // Assert
+            {
+                var info = new Profiling.LowLevel.Trace.ContinuousTraceInfo();
+
+
+                TraceUtility.GetContinuousTraceInfo(ref info);
+
+
+                Assert.Greater(frameCount, 0, "Expected completed frames");
+                Assert.AreEqual(0, info.DroppedFrameCount, "Expected no frames to be dropped");
+            }
+
+
+            // Clean up
+            FreeEventBuffer(eventBuffer);
+        }
+
+        [UnityTest]
+        public IEnumerator BeginContinuousTrace_FrameCallback_FlipsOncePerFrame()
+        {
+            // Arrange
+            var info       = new Profiling.LowLevel.Trace.ContinuousTraceInfo();
+            var frameCount = 10;
+
+
+            // Act
+            {
+                TraceUtility.BeginContinuousTrace(4, 8192);
+
+
+                for (var f = 0; f < frameCount; ++f)
+                {
+                    yield return null;
+                }
+
+
+                TraceUtility.GetContinuousTraceInfo(ref info);
+                TraceUtility.EndContinuousTrace();
+            }
+
+
+            // Assert
+            {
+                Assert.Greater(info.RecordedFrameCount, 0, "Expected frames to be flipped");
+                Assert.LessOrEqual(info.RecordedFrameCount, (ulong)(frameCount + 1), "Expected frame callback and update not to both flip same frame");
+            }
+        }
+
+        [UnityTest]
+        public IEnumerator BeginStreamingTrace_EndStreamingTrace_WritesFile()
+        {
+            // Arrange
+            var path = System.IO.Path.Combine(Application.temporaryCachePath, "StreamingTrace.klpt");
+            var info = new Profiling.LowLevel.Trace.StreamingTraceInfo();
+
+
+            // Act
+            {
+                Assert.AreEqual(ErrorCode.NoError, TraceUtility.BeginStreamingTrace(path, 4, 8192), "Expected streaming to begin");
+
+
+                // Trace some frames
+                for (var f = 0; f < 6; ++f)
+                {
+                    yield return new WaitForEndOfFrame();
+                }
+
+
+                TraceUtility.EndStreamingTrace();
+            }
+
+
+            // Assert
+            {
+                TraceUtility.GetStreamingTraceInfo(ref info);
+
+
+                Assert.Greater(info.WrittenFrameCount, 0, "Expected frames to be written");
+                Assert.AreEqual(0, info.DidFailToWrite, "Expected writes to succeed");
+                Assert.AreEqual((long)info.BytesWritten, new System.IO.FileInfo(path).Length, "Expected file to contain written bytes");
+            }
+
+
+            // Clean up
+            System.IO.File.Delete(path);
+        }
+
+        [UnityTest]
+        public IEnumerator BeginCompressedStreamingTrace_ExportStreamingTrace_DecodesFrames()
+        {
+            // Arrange
+            var path       = System.IO.Path.Combine(Application.temporaryCachePath, "CompressedStreamingTrace.klpt");
+            var outputPath = System.IO.Path.Combine(Application.temporaryCachePath, "CompressedStreamingTrace.json");
+            var info       = new Profiling.LowLevel.Trace.StreamingTraceInfo();
+            var error      = ErrorCode.NotAvailable;
+
+
+            // Act
+            {
+                Assert.AreEqual(ErrorCode.NoError, TraceUtility.BeginCompressedStreamingTrace(path, 4, 8192, Profiling.LowLevel.Trace.StreamCompression.DeltaBlock), "Expected streaming to begin");
+
+
+                // Trace some frames
+                for (var f = 0; f < 6; ++f)
+                {
+                    yield return new WaitForEndOfFrame();
+                }
+
+
+                TraceUtility.EndStreamingTrace();
+                TraceUtility.GetStreamingTraceInfo(ref info);
+
+                error = TraceUtility.ExportStreamingTrace(path, outputPath, Profiling.LowLevel.Trace.ExportFormat.ChromeJson);
+            }
+
+
+            // Assert
+            {
+                Assert.Greater(info.WrittenFrameCount, 0, "Expected frames to be written");
+                Assert.Less(info.EncodedEventBytes, info.RawEventBytes, "Expected events to be compressed");
+                Assert.AreEqual(ErrorCode.NoError, error, "Expected compressed frames to decode");
+                StringAssert.Contains("traceEvents", System.IO.File.ReadAllText(outputPath), "Expected trace events");
+            }
+
+
+            // Clean up
+            System.IO.File.Delete(path);
+            System.IO.File.Delete(outputPath);
+        }
+
+        [UnityTest]
+        public IEnumerator BeginLiveFeed_GetLiveFeedInfo_PublishesEventsAndFrames()
+        {
+            // Arrange
+            var info  = new Profiling.LowLevel.Trace.LiveFeedInfo();
+            var error = TraceUtility.BeginLiveFeed("/klab-profiling-tests", 16, 4096);
+
+
+            if (error == ErrorCode.NotAvailable)
+            {
+                Assert.Ignore("Shared memory not available on platform");
+            }
+
+
+            // Act
+            {
+                Assert.AreEqual(ErrorCode.NoError, error, "Expected live feed to begin");
+
+
+                // Publish some frames
+                for (var f = 0; f < 3; ++f)
+                {
+                    yield return new WaitForEndOfFrame();
+                }
+
+
+                TraceUtility.GetLiveFeedInfo(ref info);
+                TraceUtility.EndLiveFeed();
+            }
+
+
+            // Assert
+            {
+                Assert.Greater(info.PublishedEventCount, 0, "Expected events to be published");
+                Assert.Greater(info.PublishedFrameCount, 1, "Expected frames to be published");
+                Assert.AreEqual(4096, info.RegionCapacity, "Expected region capacity");
+                Assert.AreEqual(1, info.IsPublishing, "Expected live feed to be publishing");
+            }
+        }
+
+        [UnityTest]
+        public IEnumerator ExportEvents_ChromeJson_WritesTraceEvents()
+        {
+            // Arrange
+            var path        = System.IO.Path.Combine(Application.temporaryCachePath, "Trace.json");
+            var eventBuffer = AllocateEventBuffer(2048);
+            var result      = new Profiling.LowLevel.Trace.TraceInfo();
+
+
+            // Act
+            {
+                TraceUtility.BeginTrace(eventBuffer, 2048);
+
+
+                yield return new WaitForEndOfFrame();
+
+
+                TraceUtility.EndTrace(ref result);
+            }
+
+
+            // Assert
+            {
+                Assert.AreEqual(ErrorCode.NoError, TraceUtility.ExportEvents(path, Profiling.LowLevel.Trace.ExportFormat.ChromeJson, eventBuffer, (int)result.EventCount), "Expected export to succeed");
+                StringAssert.StartsWith("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", System.IO.File.ReadAllText(path), "Expected Chrome trace");
+            }
+
+
+            // Clean up
+            FreeEventBuffer(eventBuffer);
+            System.IO.File.Delete(path);
+        }
+
+        [UnityTest]
+        public IEnumerator BeginStatsTrace_GetStatsFrame_AggregatesMarkers()
+        {
+            // Arrange
+            var info  = new Profiling.LowLevel.Trace.StatsFrameInfo();
+            var error = ErrorCode.NotAvailable;
+
+
+            // Act
+            {
+                TraceUtility.BeginStatsTrace();
+
+
+                // Trace enough frames for first frame to be merged
+                for (var f = 0; f < 4; ++f)
+                {
+                    yield return new WaitForEndOfFrame();
+                }
+
+
+                error = TraceUtility.GetStatsFrame(IntPtr.Zero, 0, ref info);
+
+                TraceUtility.EndStatsTrace();
+            }
+
+
+            // Assert
+            {
+                Assert.AreEqual(ErrorCode.NoError, error, "Expected merged frame");
+                Assert.Greater(info.MarkerCount, 0, "Expected marker statistics");
+            }
+        }
+
+        [UnityTest]
+        public IEnumerator BeginAllocationTrace_GetAllocationFrame_AttributesAllocations()
+        {
+            // Arrange
+            var info        = new Profiling.LowLevel.Trace.AllocationFrameInfo();
+            var error       = ErrorCode.NotAvailable;
+            var allocations = new List<byte[]>();
+
+
+            // Act
+            {
+                TraceUtility.BeginAllocationTrace();
+
+
+                // Allocate in every frame (so merged frame has allocations)
+                for (var f = 0; f < 4; ++f)
+                {
+                    yield return new WaitForEndOfFrame();
+
+
+                    UnityEngine.Profiling.Profiler.BeginSample("TraceUtilityTests.AllocationSample");
+                    allocations.Add(new byte[4096]);
+                    UnityEngine.Profiling.Profiler.EndSample();
+                }
+
+
+                error = TraceUtility.GetAllocationFrame(IntPtr.Zero, 0, ref info);
+
+                TraceUtility.EndAllocationTrace();
+            }
+
+
+            // Assert
+            {
+                Assert.AreEqual(ErrorCode.NoError, error, "Expected merged frame");
+                Assert.GreaterOrEqual(info.TotalBytes, 4096ul, "Expected allocation to be attributed");
+                Assert.Greater(info.PathCount, 1, "Expected allocation under sample path");
+            }
+        }
+
+        [UnityTest]
+        public IEnumerator BeginCallTreeTrace_GetCallTree_MergesNestedSamples()
+        {
+            // Arrange
+            var window = new Profiling.LowLevel.Trace.CallTreeInfo();
+            var reset  = new Profiling.LowLevel.Trace.CallTreeInfo();
+            var error  = ErrorCode.NotAvailable;
+
+
+            // Act
+            {
+                TraceUtility.BeginCallTreeTrace();
+
+
+                // Nest samples in every frame (so merged frames hold both)
+                for (var f = 0; f < 4; ++f)
+                {
+                    yield return new WaitForEndOfFrame();
+
+
+                    UnityEngine.Profiling.Profiler.BeginSample("TraceUtilityTests.OuterSample");
+                    UnityEngine.Profiling.Profiler.BeginSample("TraceUtilityTests.InnerSample");
+                    UnityEngine.Profiling.Profiler.EndSample();
+                    UnityEngine.Profiling.Profiler.EndSample();
+                }
+
+
+                error = TraceUtility.GetCallTree(IntPtr.Zero, 0, Profiling.LowLevel.Trace.CallTreeScope.Window, ref window);
+
+                TraceUtility.ResetCallTreeWindow();
+                TraceUtility.GetCallTree(IntPtr.Zero, 0, Profiling.LowLevel.Trace.CallTreeScope.Window, ref reset);
+
+                TraceUtility.EndCallTreeTrace();
+            }
+
+
+            // Assert
+            {
+                Assert.AreEqual(ErrorCode.NoError, error, "Expected merged frame");
+                Assert.Greater(window.FrameCount, 0ul, "Expected frames merged into window");
+                Assert.GreaterOrEqual(window.NodeCount, 2, "Expected outer and inner sample nodes");
+                Assert.AreEqual(0ul, reset.FrameCount, "Expected window to be cleared");
+            }
+        }
+
+        [UnityTest]
+        public IEnumerator SetMarkerFilter_ExcludeAll_RegistersDefaultMarkerOnly()
+        {
+            // Arrange
+            var filtered   = new Profiling.LowLevel.Trace.MarkerFilterInfo();
+            var unfiltered = new Profiling.LowLevel.Trace.MarkerFilterInfo();
+
+
+            // Act
+            {
+                TraceUtility.BeginStatsTrace();
+
+                yield return new WaitForEndOfFrame();
+
+                TraceUtility.SetMarkerFilter("-*");
+                TraceUtility.GetMarkerFilterInfo(ref filtered);
+                TraceUtility.SetMarkerFilter("");
+                TraceUtility.GetMarkerFilterInfo(ref unfiltered);
+
+                TraceUtility.EndStatsTrace();
+            }
+
+
+            // Assert
+            {
+                Assert.AreEqual(ErrorCode.InvalidArgument, TraceUtility.SetMarkerFilter("+category:x"), "Expected syntax error");
+                Assert.LessOrEqual(filtered.RegisteredMarkerCount, 1, "Expected only 'Profiler.Default' to stay registered");
+                Assert.AreEqual(unfiltered.KnownMarkerCount, unfiltered.RegisteredMarkerCount, "Expected all markers registered");
+            }
+        }
+
+        [UnityTest]
+        public IEnumerator BeginStatsTrace_EndStatsTrace_RefreshesMarkerDispatchRightAway()
+        {
+            // Arrange
+            var before = new Profiling.LowLevel.Trace.MarkerFilterInfo();
+            var begun  = new Profiling.LowLevel.Trace.MarkerFilterInfo();
+            var ended  = new Profiling.LowLevel.Trace.MarkerFilterInfo();
+
+
+            // Act (without frames in between, so only begin and end can update registrations)
+            {
+                yield return new WaitForEndOfFrame();
+
+                TraceUtility.GetMarkerFilterInfo(ref before);
+                TraceUtility.BeginStatsTrace();
+                TraceUtility.BeginCallTreeTrace();
+                TraceUtility.GetMarkerFilterInfo(ref begun);
+                TraceUtility.EndCallTreeTrace();
+                TraceUtility.EndStatsTrace();
+                TraceUtility.GetMarkerFilterInfo(ref ended);
+            }
+
+
+            // Assert
+            {
+                Assert.Greater(begun.RegisteredMarkerCount, 0u, "Expected markers registered on begin");
+                Assert.GreaterOrEqual(begun.RegisteredMarkerCount, before.RegisteredMarkerCount, "Expected no markers unregistered on begin");
+                Assert.AreEqual(before.RegisteredMarkerCount, ended.RegisteredMarkerCount, "Expected registrations restored on end");
+            }
+        }
+
+        [UnityTest]
+        public IEnumerator BeginStatsTrace_ProfilerMarker_ResolvesCategoryGroup()
+        {
+            // Arrange
+            var profilerMarker = new Unity.Profiling.ProfilerMarker(Unity.Profiling.ProfilerCategory.Physics, "TraceUtilityTests.CategoryMarker");
+            var groupName      = (string)null;
+
+
+            // Act
+            {
+                TraceUtility.BeginStatsTrace();
+
+                yield return new WaitForEndOfFrame();
+
+                profilerMarker.Begin();
+                profilerMarker.End();
+
+                TraceUtility.EndStatsTrace();
+            }
+
+
+            // Assert
+            {
+                var marker = new Profiling.LowLevel.Trace.MarkerInfo();
+
+
+                for (var m = 0u; m < TraceUtility.GetMarkerCount(); ++m)
+                {
+                    if ((TraceUtility.GetMarkerInfo(m, ref marker) == ErrorCode.NoError) && (marker.GetName() == "TraceUtilityTests.CategoryMarker"))
+                    {
+                        groupName = marker.GetGroupName();
+                    }
+                }
+
+
+                Assert.AreEqual("Physics", groupName, "Expected marker group to resolve to category name");
+            }
+        }
+
+        [UnityTest]
+        public IEnumerator LoadTraceSink_MissingLibrary_ReturnsNotAvailable()
+        {
+            // Arrange
+            var path   = System.IO.Path.Combine(Application.temporaryCachePath, "MissingTraceSink.so");
+            var sinkID = -1;
+            var error  = ErrorCode.NoError;
+
+
+            // Act
+            {
+                error = TraceUtility.LoadTraceSink(path, ref sinkID);
+
+                yield return new WaitForEndOfFrame();
+            }
+
+
+            // Assert
+            {
+                Assert.AreEqual(ErrorCode.NotAvailable, error, "Expected missing sink to fail to load");
+                Assert.AreEqual(-1, sinkID, "Expected no sink ID");
+                Assert.AreEqual(ErrorCode.InvalidArgument, TraceUtility.DetachTraceSink(0), "Expected no sink to be attached");
+            }
+        }
+
+        [UnityTest]
+        public IEnumerator BeginAsyncExternTrace_EndAsyncExternTrace_DrainsQueues()
+        {
+            // Arrange
+            var info  = new Profiling.LowLevel.Trace.AsyncExternTraceInfo();
+            var error = ErrorCode.NoError;
+
+
+            // Act
+            {
+                error = TraceUtility.BeginAsyncExternTrace(Profiling.LowLevel.Trace.BackpressurePolicy.Block, 100);
+
+
+                // Trace some frames
+                for (var f = 0; f < 3; ++f)
+                {
+                    yield return new WaitForEndOfFrame();
+                }
+
+
+                TraceUtility.EndAsyncExternTrace();
+                TraceUtility.GetAsyncExternTraceInfo(ref info);
+            }
+
+
+            // Assert
+            {
+                if (!PluginInfo.SupportsExternTrace)
+                {
+                    Assert.AreEqual(ErrorCode.NotAvailable, error, "Expected no extern trace to deliver to");
+
+
+                    yield break;
+                }
+
+
+                Assert.AreEqual(ErrorCode.NoError, error, "Expected asynchronous delivery to begin");
+                Assert.AreEqual(0, info.QueueDepth, "Expected queues to be drained");
+                Assert.AreEqual(0, info.IsRunning, "Expected asynchronous delivery to end");
+            }
+        }
+
+        [UnityTest]
+        public IEnumerator BeginAsyncExternTrace_ExcessiveBlockTimeout_Fails()
+        {
+            // Act
+            var error = TraceUtility.BeginAsyncExternTrace(Profiling.LowLevel.Trace.BackpressurePolicy.Block, 1001);
+
+
+            yield return null;
+
+
+            // Assert
+            {
+                Assert.AreEqual(ErrorCode.InvalidArgument, error, "Expected timeout to be bounded");
+                Assert.AreEqual(ErrorCode.InvalidState, TraceUtility.EndAsyncExternTrace(), "Expected asynchronous delivery not to begin");
+            }
+        }
+
+        [UnityTest]
+        public IEnumerator BeginHistogramTrace_GetHistogramPercentiles_OrdersFrameTimes()
+        {
+            // Arrange
+            var percentiles = new[] { 50.0, 95.0, 99.0 };
+            var valuesNs    = new ulong[3];
+            var info        = new Profiling.LowLevel.Trace.HistogramInfo();
+            var histogramID = 0;
+
+
+            // Act
+            {
+                TraceUtility.AddHistogramMarker("PlayerLoop", ref histogramID);
+                TraceUtility.BeginHistogramTrace();
+
+
+                // Trace some frames
+                for (var f = 0; f < 6; ++f)
+                {
+                    yield return new WaitForEndOfFrame();
+                }
+
+
+                TraceUtility.EndHistogramTrace();
+                TraceUtility.GetHistogramInfo(Profiling.LowLevel.Trace.HistogramID.Frame, ref info);
+                TraceUtility.GetHistogramPercentiles(Profiling.LowLevel.Trace.HistogramID.Frame, percentiles, valuesNs);
+            }
+
+
+            // Assert
+            {
+                Assert.Greater(histogramID, Profiling.LowLevel.Trace.HistogramID.Frame, "Expected marker histogram");
+                Assert.Greater(info.Count, 0, "Expected frame times");
+                Assert.LessOrEqual(valuesNs[0], valuesNs[1], "Expected p50 not to exceed p95");
+                Assert.LessOrEqual(valuesNs[1], valuesNs[2], "Expected p95 not to exceed p99");
+                Assert.LessOrEqual(valuesNs[2], info.MaxNs, "Expected p99 not to exceed maximum");
+            }
+        }
+
+        [UnityTest]
+        public IEnumerator TriggerFlightRecorder_DequeueSnapshotFrame_CopiesRecentFrames()
+        {
+            // Arrange
+            var eventBuffer = AllocateRecordBuffer(8192);
+            var frame       = new Profiling.LowLevel.Trace.FrameInfo();
+            var info        = new Profiling.LowLevel.Trace.FlightRecorderInfo();
+            var frameCount  = 0;
+
+
+            // Act
+            {
+                TraceUtility.BeginFlightRecorder(4, 8192, 0);
+
+
+                // Record some frames before triggering
+                for (var f = 0; f < 6; ++f)
+                {
+                    yield return new WaitForEndOfFrame();
+                }
+
+
+                TraceUtility.TriggerFlightRecorder();
+
+
+                // Wait for snapshot
+                for (var f = 0; (f < 60) && (info.SnapshotCount == 0); ++f)
+                {
+                    yield return new WaitForEndOfFrame();
+
+
+                    TraceUtility.GetFlightRecorderInfo(ref info);
+                }
+
+
+                TraceUtility.EndFlightRecorder();
+
+
+                while (TraceUtility.DequeueSnapshotFrame(eventBuffer, 8192, ref frame) == ErrorCode.NoError)
+                {
+                    ++frameCount;
+                }
+            }
+
+
+            // Assert
+            {
+                Assert.AreEqual(1, info.SnapshotCount, "Expected single snapshot");
+                Assert.AreEqual(0, info.LastHitchDurationNs, "Expected snapshot to be triggered explicitly");
+                Assert.AreEqual(info.SnapshotFrameCount, frameCount, "Expected all snapshot frames to be dequeued");
+                Assert.LessOrEqual(frameCount, 4, "Expected snapshot not to exceed frame ring");
+            }
+
+
+            // Clean up
+            FreeEventBuffer(eventBuffer);
+        }
+
+        [UnityTest]
+        public IEnumerator SetMetadataCapture_DequeueFrameWithMetadata_CopiesMarkerMetadata()
+        {
+            // Arrange
+            var eventBuffer    = AllocateRecordBuffer(8192);
+            var metadataBuffer = Marshal.AllocHGlobal(65536);
+            var frame          = new Profiling.LowLevel.Trace.FrameInfo();
+            var markerHandle   = ProfilerUnsafeUtility.CreateMarker("TraceUtilityTests.MetadataMarker", ProfilerUnsafeUtility.CategoryScripts, MarkerFlags.Default, 1);
+            var value          = 0;
+
+
+            ProfilerUnsafeUtility.SetMarkerMetadata(markerHandle, 0, "Value", (byte)ProfilerMarkerDataType.Int32, (byte)ProfilerMarkerDataUnit.Count);
+
+
+            // Act
+            {
+                TraceUtility.SetMetadataCapture("TraceUtilityTests.MetadataMarker", 65536);
+                TraceUtility.BeginContinuousTrace(4, 8192);
+
+
+                // Emit samples with metadata in some frames
+                for (var f = 0; f < 3; ++f)
+                {
+                    yield return new WaitForEndOfFrame();
+
+
+                    unsafe
+                    {
+                        var sampleValue = 42;
+                        var data        = new ProfilerMarkerData { Type = (byte)ProfilerMarkerDataType.Int32, Size = sizeof(int), Ptr = &sampleValue };
+
+
+                        ProfilerUnsafeUtility.BeginSampleWithMetadata(markerHandle, 1, &data);
+                        ProfilerUnsafeUtility.EndSample(markerHandle);
+                    }
+                }
+
+
+                TraceUtility.EndContinuousTrace();
+
+
+                // Read first metadata value
+                var metadataLength = 0;
+
+
+                while (TraceUtility.DequeueFrameWithMetadata(eventBuffer, 8192, metadataBuffer, 65536, ref metadataLength, ref frame) == ErrorCode.NoError)
+                {
+                    for (var e = 0; (e < frame.EventCount) && (value == 0); ++e)
+                    {
+                        var record = Marshal.PtrToStructure<Profiling.LowLevel.Trace.EventRecord>(eventBuffer + (e * Marshal.SizeOf<Profiling.LowLevel.Trace.EventRecord>()));
+
+
+                        if (record.Type == (ushort)Profiling.LowLevel.Trace.EventType.Metadata)
+                        {
+                            var headerSize = Marshal.SizeOf<Profiling.LowLevel.Trace.MetadataHeader>();
+                            var entrySize  = Marshal.SizeOf<Profiling.LowLevel.Trace.MetadataEntry>();
+
+
+                            value = Marshal.ReadInt32(metadataBuffer + (int)record.MarkerID + headerSize + entrySize);
+                        }
+                    }
+                }
+            }
+
+
+            // Assert
+            {
+                Assert.AreEqual(42, value, "Expected metadata value to be captured");
+            }
+
+
+            // Clean up
+            TraceUtility.SetMetadataCapture("", 0);
+            Marshal.FreeHGlobal(metadataBuffer);
+            FreeEventBuffer(eventBuffer);
+        }
+
+        [UnityTest]
+        public IEnumerator BeginSpanTrace_DequeueSpanFrame_PairsNestedSamples()
+        {
+            // Arrange
+            var spanSize   = Marshal.SizeOf<Profiling.LowLevel.Trace.SpanRecord>();
+            var spanBuffer = Marshal.AllocHGlobal(spanSize * 8192);
+            var frame      = new Profiling.LowLevel.Trace.FrameInfo();
+            var outer      = new Profiling.LowLevel.Trace.SpanRecord();
+            var inner      = new Profiling.LowLevel.Trace.SpanRecord();
+            var isFound    = false;
+
+
+            // Act
+            {
+                TraceUtility.BeginSpanTrace(4, 8192);
+
+
+                // Emit nested samples in some frames
+                for (var f = 0; f < 3; ++f)
+                {
+                    yield return new WaitForEndOfFrame();
+
+
+                    UnityEngine.Profiling.Profiler.BeginSample("TraceUtilityTests.OuterSpan");
+                    UnityEngine.Profiling.Profiler.BeginSample("TraceUtilityTests.InnerSpan");
+                    UnityEngine.Profiling.Profiler.EndSample();
+                    UnityEngine.Profiling.Profiler.EndSample();
+                }
+
+
+                TraceUtility.EndContinuousTrace();
+
+
+                // Find samples among spans
+                var marker = new Profiling.LowLevel.Trace.MarkerInfo();
+
+
+                while (TraceUtility.DequeueSpanFrame(spanBuffer, 8192, ref frame) == ErrorCode.NoError)
+                {
+                    for (var s = 0; (s < frame.EventCount) && !isFound; ++s)
+                    {
+                        var span = Marshal.PtrToStructure<Profiling.LowLevel.Trace.SpanRecord>(spanBuffer + (s * spanSize));
+
+
+                        if (TraceUtility.GetMarkerInfo(span.MarkerID, ref marker) != ErrorCode.NoError)
+                        {
+                            continue;
+                        }
+
+
+                        if (marker.GetName() == "TraceUtilityTests.OuterSpan")
+                        {
+                            outer = span;
+                        }
+                        else if (marker.GetName() == "TraceUtilityTests.InnerSpan")
+                        {
+                            inner   = span;
+                            isFound = true;
+                        }
+                    }
+                }
+            }
+
+
+            // Assert
+            {
+                Assert.IsTrue(isFound, "Expected spans to be recorded");
+                Assert.AreEqual(outer.Depth + 1, inner.Depth, "Expected inner span to nest in outer span");
+                Assert.GreaterOrEqual(inner.BeginNs, outer.BeginNs, "Expected inner span to begin within outer span");
+                Assert.LessOrEqual(inner.BeginNs + inner.DurationNs, outer.BeginNs + outer.DurationNs, "Expected inner span to end within outer span");
+            }
+
+
+            // Clean up
+            Marshal.FreeHGlobal(spanBuffer);
+        }
+
         #region Helpers
 
         /// <summary>
@@ -65,6 +956,21 @@ namespace KLab.Profiling.Tests.LowLevel
             }
         }
 
+        /// <summary>
+        /// Allocates event record buffer
+        /// </summary>
+        /// <param name="capacity">Capacity</param>
+        private static IntPtr AllocateRecordBuffer(int capacity = 2048)
+        {
+            unsafe
+            {
+                var sizeof_ = UnsafeUtility.SizeOf<Profiling.LowLevel.Trace.EventRecord>();
+                var alignof_ = UnsafeUtility.AlignOf<Profiling.LowLevel.Trace.EventRecord>();
+
+                return (IntPtr)UnsafeUtility.Malloc((sizeof_ * capacity), alignof_, Allocator.Persistent);
+            }
+        }
+
         /// <summary>
         /// Frees event buffer
         /// </summary>